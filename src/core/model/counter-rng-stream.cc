@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "counter-rng-stream.h"
+
+/**
+ * \file
+ * \ingroup rngimpl
+ * ns3::CounterRngStream implementation.
+ */
+
+namespace {
+
+/**
+ * \ingroup rngimpl
+ * The SplitMix64 finalizer, used to derive the key of the generator.
+ *
+ * \param [in] x The value to mix.
+ * \returns The mixed value.
+ */
+uint64_t
+Mix64 (uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+} // unnamed namespace
+
+namespace ns3 {
+
+CounterRngStream::CounterRngStream (uint32_t seed, uint64_t stream, uint64_t run)
+{
+  uint64_t key = Mix64 (Mix64 (Mix64 (seed) ^ stream) ^ run);
+  m_key[0] = static_cast<uint32_t> (key);
+  m_key[1] = static_cast<uint32_t> (key >> 32);
+  SetCounter (0, 0);
+}
+
+void
+CounterRngStream::SetCounter (uint64_t key, uint32_t index)
+{
+  m_counter[0] = static_cast<uint32_t> (key);
+  m_counter[1] = static_cast<uint32_t> (key >> 32);
+  m_counter[2] = index;
+  m_counter[3] = 0;
+  m_next = 4;
+}
+
+double
+CounterRngStream::RandU01 (void)
+{
+  if (m_next == 4)
+    {
+      Philox4x32 (m_key, m_counter, m_block);
+      m_counter[3]++;
+      m_next = 0;
+    }
+  // 2^-32, the values are the centers of 2^32 intervals of (0,1)
+  return (m_block[m_next++] + 0.5) * 2.3283064365386963e-10;
+}
+
+void
+CounterRngStream::Philox4x32 (const uint32_t key[2], const uint32_t counter[4], uint32_t result[4])
+{
+  const uint32_t m0 = 0xD2511F53;
+  const uint32_t m1 = 0xCD9E8D57;
+  const uint32_t w0 = 0x9E3779B9;
+  const uint32_t w1 = 0xBB67AE85;
+
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  uint32_t c0 = counter[0];
+  uint32_t c1 = counter[1];
+  uint32_t c2 = counter[2];
+  uint32_t c3 = counter[3];
+  for (int round = 0; round < 10; round++)
+    {
+      uint64_t p0 = static_cast<uint64_t> (m0) * c0;
+      uint64_t p1 = static_cast<uint64_t> (m1) * c2;
+      uint32_t hi0 = static_cast<uint32_t> (p0 >> 32);
+      uint32_t lo0 = static_cast<uint32_t> (p0);
+      uint32_t hi1 = static_cast<uint32_t> (p1 >> 32);
+      uint32_t lo1 = static_cast<uint32_t> (p1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += w0;
+      k1 += w1;
+    }
+  result[0] = c0;
+  result[1] = c1;
+  result[2] = c2;
+  result[3] = c3;
+}
+
+} // namespace ns3
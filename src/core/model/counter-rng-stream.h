@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COUNTER_RNG_STREAM_H
+#define COUNTER_RNG_STREAM_H
+
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup rngimpl
+ * ns3::CounterRngStream declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup rngimpl
+ *
+ * \brief Counter-based generator Philox4x32-10
+ *
+ * The values of a counter-based generator are a function of a key and
+ * of a counter, instead of the result of a recursion on a state, so
+ * any of them can be computed without computing the previous ones.
+ * This class implements the Philox4x32-10 generator described in:
+ * J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw, "Parallel random
+ * numbers: as easy as 1, 2, 3", SC '11.
+ *
+ * The 64 bit key of the generator is derived from the seed, the stream
+ * and the run number, as for RngStream.  The 128 bit counter is made of
+ * the 64 bit key and the 32 bit index set by SetCounter (), and of the
+ * index of the 4 x 32 bit block of values being drawn.  The values drawn
+ * after SetCounter (key, index) are thus only a function of the seed, the
+ * run, the stream, the key and the index.
+ */
+class CounterRngStream
+{
+public:
+  /**
+   * Construct from explicit seed, stream and run values.
+   *
+   * \param [in] seed The starting seed.
+   * \param [in] stream The stream number.
+   * \param [in] run The run number.
+   */
+  CounterRngStream (uint32_t seed, uint64_t stream, uint64_t run);
+
+  /**
+   * Restart the draws from the values of a key and an index.
+   *
+   * \param [in] key The key, e.g. identifying a link.
+   * \param [in] index The index, e.g. of the realization of a link.
+   */
+  void SetCounter (uint64_t key, uint32_t index);
+
+  /**
+   * Generate the next random number for this stream.
+   * Uniformly distributed between 0 and 1, both excluded.
+   *
+   * \returns The next random.
+   */
+  double RandU01 (void);
+
+  /**
+   * Compute a block of the Philox4x32-10 generator.
+   *
+   * \param [in] key The key of the generator.
+   * \param [in] counter The counter.
+   * \param [out] result The four 32 bit random values.
+   */
+  static void Philox4x32 (const uint32_t key[2], const uint32_t counter[4], uint32_t result[4]);
+
+private:
+  uint32_t m_key[2];      //!< The key of the generator.
+  uint32_t m_counter[4];  //!< The counter of the next block.
+  uint32_t m_block[4];    //!< The current block of values.
+  uint32_t m_next;        //!< Index of the next value of m_block, 4 if it is used up.
+};
+
+} // namespace ns3
+
+#endif /* COUNTER_RNG_STREAM_H */
@@ -46,6 +46,9 @@ NS_LOG_COMPONENT_DEFINE ("Object");
 
 NS_OBJECT_ENSURE_REGISTERED (Object);
 
+/** Counters of the DoGetObject() lookup cache. */
+static Object::GetObjectCacheStats g_getObjectCacheStats = { 0, 0 };
+
 Object::AggregateIterator::AggregateIterator ()
   : m_object (0),
     m_current (0)
@@ -102,6 +105,7 @@ Object::Object ()
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
+  m_aggregates->cache = 0;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object ()
@@ -120,6 +124,8 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // the cache may still point to this object
+  FreeGetObjectCache (m_aggregates);
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -136,6 +142,7 @@ Object::Object (const Object &o)
     m_getObjectCount (0)
 {
   m_aggregates->n = 1;
+  m_aggregates->cache = 0;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -151,6 +158,19 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
+  // The aggregate buffer only changes through AggregateObject, which
+  // allocates a new buffer without cache, and the destructor, which
+  // releases it, so a cached slot always refers to a live aggregated Object.
+  uint16_t uid = tid.GetUid ();
+  uint32_t slot = uid & (GET_OBJECT_CACHE_SLOTS - 1);
+  struct GetObjectCache *cache = m_aggregates->cache;
+  if (cache != 0 && cache->tid[slot] == uid)
+    {
+      g_getObjectCacheStats.hits++;
+      return const_cast<Object *> (cache->object[slot]);
+    }
+  g_getObjectCacheStats.misses++;
+
   uint32_t n = m_aggregates->n;
   TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
@@ -173,6 +193,14 @@ Object::DoGetObject (TypeId tid) const
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
+          // remember the match for the next lookup of the same TypeId
+          if (cache == 0)
+            {
+              cache = (struct GetObjectCache *) std::calloc (1, sizeof (struct GetObjectCache));
+              m_aggregates->cache = cache;
+            }
+          cache->tid[slot] = uid;
+          cache->object[slot] = current;
           // finally, return the match
           return const_cast<Object *> (current);
         }
@@ -180,6 +208,26 @@ Object::DoGetObject (TypeId tid) const
   return 0;
 }
 void
+Object::FreeGetObjectCache (struct Aggregates *aggregates)
+{
+  NS_LOG_FUNCTION (aggregates);
+  std::free (aggregates->cache);
+  aggregates->cache = 0;
+}
+Object::GetObjectCacheStats
+Object::GetGetObjectCacheStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return g_getObjectCacheStats;
+}
+void
+Object::ResetGetObjectCacheStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  g_getObjectCacheStats.hits = 0;
+  g_getObjectCacheStats.misses = 0;
+}
+void
 Object::Initialize (void)
 {
   /**
@@ -263,6 +311,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates =
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates) + (total - 1) * sizeof(Object*));
   aggregates->n = total;
+  aggregates->cache = 0;
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0],
@@ -314,6 +363,8 @@ Object::AggregateObject (Ptr<Object> o)
     }
 
   // Now that we are done with them, we can free our old aggregate buffers
+  FreeGetObjectCache (a);
+  FreeGetObjectCache (b);
   std::free (a);
   std::free (b);
 }
@@ -149,6 +149,10 @@ public:
    * Get a pointer to the requested aggregated Object.  If the type of object
    * requested is ns3::Object, a Ptr to the calling object is returned.
    *
+   * GetObject() is not thread-safe: it fills a lookup cache shared by
+   * all the aggregated Objects, so the Objects of an aggregate must not
+   * be looked up from several threads at the same time.
+   *
    * \tparam T \explicit The type of the aggregated Object to retrieve.
    * \returns A pointer to the requested Object, or zero
    *          if it could not be found.
@@ -230,6 +234,31 @@ public:
    */
   bool IsInitialized (void) const;
 
+  /**
+   * Hit and miss counters of the DoGetObject() lookup cache.
+   *
+   * A hit is a lookup answered from the per-aggregate cache slot of
+   * the requested TypeId; a miss falls back to the scan over the
+   * aggregate buffer (and its IsChildOf walks).
+   */
+  struct GetObjectCacheStats
+  {
+    uint64_t hits;   //!< Lookups answered from the cache.
+    uint64_t misses; //!< Lookups which scanned the aggregate buffer.
+  };
+
+  /**
+   * Get the GetObject() cache counters.
+   *
+   * \returns The hit and miss counts since the start of the program
+   *          or the last call to ResetGetObjectCacheStats().
+   */
+  static GetObjectCacheStats GetGetObjectCacheStats (void);
+  /**
+   * Reset the GetObject() cache counters to zero.
+   */
+  static void ResetGetObjectCacheStats (void);
+
 protected:
   /**
    * Notify all Objects aggregated to this one of a new Object being
@@ -330,6 +359,30 @@ private:
   friend struct ObjectDeleter;
   /**@}*/
 
+  /**
+   * Number of direct-mapped slots in the DoGetObject() lookup cache
+   * of an aggregate.  Must be a power of two.
+   */
+  static const uint32_t GET_OBJECT_CACHE_SLOTS = 8;
+
+  /**
+   * The DoGetObject() lookup cache of an aggregate.
+   *
+   * It is allocated by the first successful lookup, so that the
+   * aggregates which are never looked up only pay for the pointer
+   * in Aggregates.
+   */
+  struct GetObjectCache
+  {
+    /**
+     * TypeId uids of the cached DoGetObject() results, indexed by
+     * the low bits of the uid; 0 marks an empty slot.
+     */
+    uint16_t tid[GET_OBJECT_CACHE_SLOTS];
+    /** The Objects matching the TypeIds in \c tid. */
+    Object *object[GET_OBJECT_CACHE_SLOTS];
+  };
+
   /**
    * The list of Objects aggregated to this one.
    *
@@ -346,6 +399,8 @@ private:
   {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The DoGetObject() lookup cache, or 0 if not allocated yet. */
+    struct GetObjectCache *cache;
     /** The array of Objects. */
     Object *buffer[1];
   };
@@ -357,6 +412,12 @@ private:
    * \return The matching Object, if it is found
    */
   Ptr<Object> DoGetObject (TypeId tid) const;
+  /**
+   * Release the DoGetObject() lookup cache of a list of aggregates.
+   *
+   * \param [in,out] aggregates The list of aggregated Objects.
+   */
+  static void FreeGetObjectCache (struct Aggregates *aggregates);
   /**
    * Verify that this Object is still live, by checking it's reference count.
    * \return \c true if the reference count is non zero.
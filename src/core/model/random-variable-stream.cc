@@ -32,6 +32,7 @@
 #include "pointer.h"
 #include "log.h"
 #include "rng-stream.h"
+#include "counter-rng-stream.h"
 #include "rng-seed-manager.h"
 #include "unused.h"
 #include <cmath>
@@ -74,7 +75,9 @@ RandomVariableStream::GetTypeId (void)
 }
 
 RandomVariableStream::RandomVariableStream ()
-  : m_rng (0)
+  : m_rng (0),
+    m_counterRng (0),
+    m_useCounterRng (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -82,6 +85,7 @@ RandomVariableStream::~RandomVariableStream ()
 {
   NS_LOG_FUNCTION (this);
   delete m_rng;
+  delete m_counterRng;
 }
 
 void
@@ -103,26 +107,29 @@ RandomVariableStream::SetStream (int64_t stream)
   // negative values are not legal.
   NS_ASSERT (stream >= -1);
   delete m_rng;
+  delete m_counterRng;
+  uint64_t target;
   if (stream == -1)
     {
       // The first 2^63 streams are reserved for automatic stream
       // number assignment.
-      uint64_t nextStream = RngSeedManager::GetNextStreamIndex ();
-      NS_ASSERT (nextStream <= ((1ULL) << 63));
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             nextStream,
-                             RngSeedManager::GetRun ());
+      target = RngSeedManager::GetNextStreamIndex ();
+      NS_ASSERT (target <= ((1ULL) << 63));
     }
   else
     {
       // The last 2^63 streams are reserved for deterministic stream
       // number assignment.
       uint64_t base = ((1ULL) << 63);
-      uint64_t target = base + stream;
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             target,
-                             RngSeedManager::GetRun ());
+      target = base + stream;
     }
+  m_rng = new RngStream (RngSeedManager::GetSeed (),
+                         target,
+                         RngSeedManager::GetRun ());
+  m_counterRng = new CounterRngStream (RngSeedManager::GetSeed (),
+                                       target,
+                                       RngSeedManager::GetRun ());
+  m_useCounterRng = false;
   m_stream = stream;
 }
 int64_t
@@ -139,6 +146,34 @@ RandomVariableStream::Peek (void) const
   return m_rng;
 }
 
+void
+RandomVariableStream::SetCounterKey (uint64_t key, uint32_t index)
+{
+  NS_LOG_FUNCTION (this << key << index);
+  m_counterRng->SetCounter (key, index);
+  m_useCounterRng = true;
+  DiscardCachedValues ();
+}
+
+void
+RandomVariableStream::UnsetCounterKey (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_useCounterRng = false;
+  DiscardCachedValues ();
+}
+
+double
+RandomVariableStream::RandU01 (void)
+{
+  return m_useCounterRng ? m_counterRng->RandU01 () : m_rng->RandU01 ();
+}
+
+void
+RandomVariableStream::DiscardCachedValues (void)
+{
+}
+
 NS_OBJECT_ENSURE_REGISTERED (UniformRandomVariable);
 
 TypeId
@@ -182,7 +217,7 @@ double
 UniformRandomVariable::GetValue (double min, double max)
 {
   NS_LOG_FUNCTION (this << min << max);
-  double v = min + Peek ()->RandU01 () * (max - min);
+  double v = min + RandU01 () * (max - min);
   if (IsAntithetic ())
     {
       v = min + (max - v);
@@ -410,7 +445,7 @@ ExponentialRandomVariable::GetValue (double mean, double bound)
   while (1)
     {
       // Get a uniform random variable in [0,1].
-      double v = Peek ()->RandU01 ();
+      double v = RandU01 ();
       if (IsAntithetic ())
         {
           v = (1 - v);
@@ -514,7 +549,7 @@ ParetoRandomVariable::GetValue (double scale, double shape, double bound)
   while (1)
     {
       // Get a uniform random variable in [0,1].
-      double v = Peek ()->RandU01 ();
+      double v = RandU01 ();
       if (IsAntithetic ())
         {
           v = (1 - v);
@@ -608,7 +643,7 @@ WeibullRandomVariable::GetValue (double scale, double shape, double bound)
   while (1)
     {
       // Get a uniform random variable in [0,1].
-      double v = Peek ()->RandU01 ();
+      double v = RandU01 ();
       if (IsAntithetic ())
         {
           v = (1 - v);
@@ -711,8 +746,8 @@ NormalRandomVariable::GetValue (double mean, double variance, double bound)
     { // See Simulation Modeling and Analysis p. 466 (Averill Law)
       // for algorithm; basically a Box-Muller transform:
       // http://en.wikipedia.org/wiki/Box-Muller_transform
-      double u1 = Peek ()->RandU01 ();
-      double u2 = Peek ()->RandU01 ();
+      double u1 = RandU01 ();
+      double u2 = RandU01 ();
       if (IsAntithetic ())
         {
           u1 = (1 - u1);
@@ -744,6 +779,13 @@ NormalRandomVariable::GetValue (double mean, double variance, double bound)
     }
 }
 
+void
+NormalRandomVariable::DiscardCachedValues (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nextValid = false;
+}
+
 uint32_t
 NormalRandomVariable::GetInteger (uint32_t mean, uint32_t variance, uint32_t bound)
 {
@@ -841,8 +883,8 @@ LogNormalRandomVariable::GetValue (double mu, double sigma)
     {
       /* choose x,y in uniform square (-1,-1) to (+1,+1) */
 
-      double u1 = Peek ()->RandU01 ();
-      double u2 = Peek ()->RandU01 ();
+      double u1 = RandU01 ();
+      double u2 = RandU01 ();
       if (IsAntithetic ())
         {
           u1 = (1 - u1);
@@ -948,7 +990,7 @@ GammaRandomVariable::GetValue (double alpha, double beta)
   NS_LOG_FUNCTION (this << alpha << beta);
   if (alpha < 1)
     {
-      double u = Peek ()->RandU01 ();
+      double u = RandU01 ();
       if (IsAntithetic ())
         {
           u = (1 - u);
@@ -976,7 +1018,7 @@ GammaRandomVariable::GetValue (double alpha, double beta)
       while (v <= 0);
 
       v = v * v * v;
-      u = Peek ()->RandU01 ();
+      u = RandU01 ();
       if (IsAntithetic ())
         {
           u = (1 - u);
@@ -1014,6 +1056,13 @@ GammaRandomVariable::GetInteger (void)
   return (uint32_t)GetValue (m_alpha, m_beta);
 }
 
+void
+GammaRandomVariable::DiscardCachedValues (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nextValid = false;
+}
+
 double
 GammaRandomVariable::GetNormalValue (double mean, double variance, double bound)
 {
@@ -1027,8 +1076,8 @@ GammaRandomVariable::GetNormalValue (double mean, double variance, double bound)
     { // See Simulation Modeling and Analysis p. 466 (Averill Law)
       // for algorithm; basically a Box-Muller transform:
       // http://en.wikipedia.org/wiki/Box-Muller_transform
-      double u1 = Peek ()->RandU01 ();
-      double u2 = Peek ()->RandU01 ();
+      double u1 = RandU01 ();
+      double u2 = RandU01 ();
       if (IsAntithetic ())
         {
           u1 = (1 - u1);
@@ -1155,7 +1204,7 @@ ErlangRandomVariable::GetExponentialValue (double mean, double bound)
   while (1)
     {
       // Get a uniform random variable in [0,1].
-      double v = Peek ()->RandU01 ();
+      double v = RandU01 ();
       if (IsAntithetic ())
         {
           v = (1 - v);
@@ -1230,7 +1279,7 @@ TriangularRandomVariable::GetValue (double mean, double min, double max)
   double mode = 3.0 * mean - min - max;
 
   // Get a uniform random variable in [0,1].
-  double u = Peek ()->RandU01 ();
+  double u = RandU01 ();
   if (IsAntithetic ())
     {
       u = (1 - u);
@@ -1319,7 +1368,7 @@ ZipfRandomVariable::GetValue (uint32_t n, double alpha)
   m_c = 1.0 / m_c;
 
   // Get a uniform random variable in [0,1].
-  double u = Peek ()->RandU01 ();
+  double u = RandU01 ();
   if (IsAntithetic ())
     {
       u = (1 - u);
@@ -1400,14 +1449,14 @@ ZetaRandomVariable::GetValue (double alpha)
   do
     {
       // Get a uniform random variable in [0,1].
-      u = Peek ()->RandU01 ();
+      u = RandU01 ();
       if (IsAntithetic ())
         {
           u = (1 - u);
         }
 
       // Get a uniform random variable in [0,1].
-      v = Peek ()->RandU01 ();
+      v = RandU01 ();
       if (IsAntithetic ())
         {
           v = (1 - v);
@@ -1589,7 +1638,7 @@ EmpiricalRandomVariable::PreSample (double & value)
     }
  
   // Get a uniform random variable in [0, 1].
-  double r = Peek ()->RandU01 ();
+  double r = RandU01 ();
   if (IsAntithetic ())
     {
       r = (1 - r);
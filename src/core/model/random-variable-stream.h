@@ -70,6 +70,7 @@ namespace ns3 {
  */
 
 class RngStream;
+class CounterRngStream;
 
 /**
  * \ingroup randomvariable
@@ -93,6 +94,14 @@ class RngStream;
  * Instances can be configured to return "antithetic" values.
  * See the documentation for the specific distributions to see
  * how this modifies the returned values.
+ *
+ * The values drawn from a stream depend on the number of values drawn
+ * before them.  After SetCounterKey () is called, the values are instead
+ * drawn from a counter-based generator (CounterRngStream), and only depend
+ * on the seed, the run number, the stream number, and the key and index
+ * passed to SetCounterKey ().  For example, a propagation loss model can
+ * key the draws of a link with the identifiers of its nodes, so that the
+ * values do not change with the order in which the links are evaluated.
  */
 class RandomVariableStream : public Object
 {
@@ -137,6 +146,25 @@ public:
    */
   bool IsAntithetic (void) const;
 
+  /**
+   * \brief Draw the next values from the counter-based generator.
+   *
+   * The values drawn after this call only depend on the seed, the run
+   * number, the stream number, and on key and index.  Calling it again
+   * with the same key and index draws the same values again.
+   *
+   * \param [in] key The key of the draws, e.g. identifying a link.
+   * \param [in] index The index of the draws with this key, e.g. the
+   * number of realizations of the link drawn before.
+   */
+  void SetCounterKey (uint64_t key, uint32_t index = 0);
+
+  /**
+   * \brief Draw the next values from the RngStream again, continuing
+   * from the last value drawn from it before SetCounterKey ().
+   */
+  void UnsetCounterKey (void);
+
   /**
    * \brief Get the next random value as a double drawn from the distribution.
    * \return A floating point random value.
@@ -156,6 +184,19 @@ protected:
    */
   RngStream * Peek (void) const;
 
+  /**
+   * \brief Get the next uniform value, from the underlying RngStream, or
+   * from the counter-based generator if SetCounterKey () has been called.
+   * \return A value uniformly distributed in (0,1).
+   */
+  double RandU01 (void);
+
+  /**
+   * \brief Discard the values generated in advance, if any, since the
+   * draws are restarting from a new key.
+   */
+  virtual void DiscardCachedValues (void);
+
 private:
   /**
    * Copy constructor.  These objects are not copyable.
@@ -181,6 +222,12 @@ private:
   /** Pointer to the underlying RngStream. */
   RngStream *m_rng;
 
+  /** Pointer to the counter-based generator. */
+  CounterRngStream *m_counterRng;
+
+  /** Indicates if the values are drawn from m_counterRng. */
+  bool m_useCounterRng;
+
   /** Indicates if antithetic values should be generated by this RNG stream. */
   bool m_isAntithetic;
 
@@ -1227,6 +1274,10 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+protected:
+  // Inherited from RandomVariableStream
+  virtual void DiscardCachedValues (void);
+
 private:
   /** The mean value for the normal distribution returned by this RNG stream. */
   double m_mean;
@@ -1586,6 +1637,10 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+protected:
+  // Inherited from RandomVariableStream
+  virtual void DiscardCachedValues (void);
+
 private:
   /**
    * \brief Returns a random double from a normal distribution with the specified mean, variance, and bound.
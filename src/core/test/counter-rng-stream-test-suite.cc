@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/counter-rng-stream.h"
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup randomvariable-tests
+ * Tests for the counter-based generator and the counter keys of the
+ * random variable streams.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup randomvariable-tests
+ * Test case for the known answers of the Philox4x32-10 generator
+ */
+class CounterRngStreamPhiloxTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  CounterRngStreamPhiloxTestCase ();
+  /** Destructor. */
+  virtual ~CounterRngStreamPhiloxTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CounterRngStreamPhiloxTestCase::CounterRngStreamPhiloxTestCase ()
+  : TestCase ("Philox4x32-10 known answers")
+{}
+
+CounterRngStreamPhiloxTestCase::~CounterRngStreamPhiloxTestCase ()
+{}
+
+void
+CounterRngStreamPhiloxTestCase::DoRun (void)
+{
+  // Known answers of the Random123 reference implementation
+  const uint32_t keys[3][2] = {
+    {0x00000000, 0x00000000},
+    {0xffffffff, 0xffffffff},
+    {0xa4093822, 0x299f31d0}
+  };
+  const uint32_t counters[3][4] = {
+    {0x00000000, 0x00000000, 0x00000000, 0x00000000},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}
+  };
+  const uint32_t expected[3][4] = {
+    {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+  };
+
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      uint32_t result[4];
+      CounterRngStream::Philox4x32 (keys[i], counters[i], result);
+      for (uint32_t j = 0; j < 4; ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (result[j], expected[i][j], "Wrong value " << j << " of vector " << i);
+        }
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Test case for the draws of the random variable streams with a counter key
+ */
+class CounterRngStreamKeyTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  CounterRngStreamKeyTestCase ();
+  /** Destructor. */
+  virtual ~CounterRngStreamKeyTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CounterRngStreamKeyTestCase::CounterRngStreamKeyTestCase ()
+  : TestCase ("Random variable stream draws with a counter key")
+{}
+
+CounterRngStreamKeyTestCase::~CounterRngStreamKeyTestCase ()
+{}
+
+void
+CounterRngStreamKeyTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  Ptr<NormalRandomVariable> x = CreateObject<NormalRandomVariable> ();
+  x->SetStream (7);
+
+  // Draw the values of three keys in order.
+  std::vector<double> values[3];
+  for (uint32_t key = 0; key < 3; ++key)
+    {
+      x->SetCounterKey (key, 5);
+      for (uint32_t i = 0; i < 3; ++i)
+        {
+          values[key].push_back (x->GetValue ());
+        }
+    }
+
+  // Draw them again in the reverse order, leaving a cached normal value
+  // behind after each key, and check that they have not changed.
+  for (uint32_t key = 3; key-- > 0; )
+    {
+      x->SetCounterKey (key, 5);
+      for (uint32_t i = 0; i < 3; ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (x->GetValue (), values[key][i], "Value " << i << " of key " << key << " changed");
+        }
+      x->GetValue ();
+    }
+  NS_TEST_ASSERT_MSG_NE (values[0][0], values[1][0], "Same value for different keys");
+  x->SetCounterKey (0, 6);
+  NS_TEST_ASSERT_MSG_NE (x->GetValue (), values[0][0], "Same value for different indices");
+
+  Ptr<NormalRandomVariable> y = CreateObject<NormalRandomVariable> ();
+  y->SetStream (8);
+  y->SetCounterKey (0, 5);
+  NS_TEST_ASSERT_MSG_NE (y->GetValue (), values[0][0], "Same value for different streams");
+
+  // Check that the sequential draws continue where they were left.
+  Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> v = CreateObject<UniformRandomVariable> ();
+  u->SetStream (9);
+  v->SetStream (9);
+  NS_TEST_ASSERT_MSG_EQ (u->GetValue (), v->GetValue (), "Different first values");
+  u->SetCounterKey (1);
+  u->GetValue ();
+  u->UnsetCounterKey ();
+  NS_TEST_ASSERT_MSG_EQ (u->GetValue (), v->GetValue (), "Sequential draws changed by the counter key");
+
+  // Check the mean of the values drawn with different keys.
+  const uint32_t count = 100000;
+  double sum = 0.0;
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      u->SetCounterKey (i);
+      sum += u->GetValue ();
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (sum / count, 0.5, 0.01, "Wrong mean value.");
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Test suite for the counter-based generator
+ */
+class CounterRngStreamTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  CounterRngStreamTestSuite ();
+};
+
+CounterRngStreamTestSuite::CounterRngStreamTestSuite ()
+  : TestSuite ("counter-rng-stream", UNIT)
+{
+  AddTestCase (new CounterRngStreamPhiloxTestCase);
+  AddTestCase (new CounterRngStreamKeyTestCase);
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * CounterRngStreamTestSuite instance variable.
+ */
+static CounterRngStreamTestSuite g_counterRngStreamTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -475,6 +475,72 @@ ObjectFactoryTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (a->GetObject<DerivedA> (), 0, "Unexpectedly able to work around C++ type system");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the GetObject() lookup cache of aggregated Objects.
+ */
+class GetObjectCacheTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  GetObjectCacheTestCase ();
+  /** Destructor. */
+  virtual ~GetObjectCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GetObjectCacheTestCase::GetObjectCacheTestCase ()
+  : TestCase ("Check the GetObject lookup cache")
+{}
+
+GetObjectCacheTestCase::~GetObjectCacheTestCase ()
+{}
+
+void
+GetObjectCacheTestCase::DoRun (void)
+{
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+
+  //
+  // A lookup which fails must not leave anything behind in the cache.
+  //
+  Object::ResetGetObjectCacheStats ();
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (BaseB::GetTypeId ()), 0, "Unexpectedly found a BaseB through derivedA");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (BaseB::GetTypeId ()), 0, "Unexpectedly found a BaseB through derivedA");
+  Object::GetObjectCacheStats stats = Object::GetGetObjectCacheStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.hits, 0, "Failed lookups hit the cache");
+  NS_TEST_ASSERT_MSG_EQ (stats.misses, 2, "Failed lookups were not counted as misses");
+
+  //
+  // After aggregation, the first lookup of a TypeId scans the aggregates and
+  // the following ones are answered from the cache with the same Object,
+  // through any member of the aggregate.
+  //
+  derivedA->AggregateObject (derivedB);
+  Object::ResetGetObjectCacheStats ();
+  Ptr<BaseB> baseB = derivedA->GetObject<BaseB> (BaseB::GetTypeId ());
+  NS_TEST_ASSERT_MSG_EQ (baseB, derivedB, "Cannot GetObject (through derivedA) for BaseB Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (BaseB::GetTypeId ()), derivedB, "Cached lookup returned a different BaseB");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseB> (BaseB::GetTypeId ()), derivedB, "Cached lookup returned a different BaseB");
+  stats = Object::GetGetObjectCacheStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.hits, 2, "Repeated lookups did not hit the cache");
+  NS_TEST_ASSERT_MSG_EQ (stats.misses, 1, "First lookup was not counted as a miss");
+
+  //
+  // The parent and the derived TypeId are cached independently.
+  //
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (BaseA::GetTypeId ()), derivedA, "Cannot GetObject (through derivedB) for BaseA Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (DerivedA::GetTypeId ()), derivedA, "Cannot GetObject (through derivedB) for DerivedA Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (BaseA::GetTypeId ()), derivedA, "Cached lookup returned a different BaseA");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (DerivedA::GetTypeId ()), derivedA, "Cached lookup returned a different DerivedA");
+  stats = Object::GetGetObjectCacheStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.hits, 4, "Repeated lookups did not hit the cache");
+  NS_TEST_ASSERT_MSG_EQ (stats.misses, 3, "First lookups were not counted as misses");
+}
+
 /**
  * \ingroup object-tests
  * The Test Suite that glues the Test Cases together.
@@ -492,6 +558,7 @@ ObjectTestSuite::ObjectTestSuite ()
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
   AddTestCase (new ObjectFactoryTestCase);
+  AddTestCase (new GetObjectCacheTestCase);
 }
 
 /**
@@ -0,0 +1,471 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "coverage-map-helper.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/string.h>
+#include <ns3/simulator.h>
+#include <ns3/core-config.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-value.h>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#include <ns3/system-mutex.h>
+#endif
+
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("CoverageMapHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (CoverageMapHelper);
+
+/// State of a thread computing the tiles of the map
+class CoverageMapHelper::Worker
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param helper the helper
+   * \param index the index of the thread
+   * \param numThreads the number of threads
+   * \param numTiles the number of tiles of the map
+   */
+  Worker (CoverageMapHelper *helper, uint32_t index, uint32_t numThreads, uint32_t numTiles)
+    : m_helper (helper),
+      m_index (index),
+      m_numThreads (numThreads),
+      m_numTiles (numTiles)
+  {
+  }
+
+  /// Compute the tiles assigned to the thread
+  void Run (void)
+  {
+    for (uint32_t tile = m_index; tile < m_numTiles; tile += m_numThreads)
+      {
+        m_helper->ComputeTile (this, tile);
+      }
+  }
+
+  CoverageMapHelper *m_helper;  ///< the helper
+  uint32_t m_index;             ///< index of the thread
+  uint32_t m_numThreads;        ///< number of threads
+  uint32_t m_numTiles;          ///< number of tiles of the map
+  Ptr<PropagationLossModel> m_loss;  ///< propagation loss chain of the thread
+  std::vector<Ptr<MobilityModel> > m_txMobility;  ///< mobility models of the transmitters
+  Ptr<MobilityModel> m_rxMobility;  ///< mobility model of the receiver
+  /// received powers in the current tile, in dBm, indexed by transmitter and then by point
+  std::vector<double> m_rxPowerDbm;
+};
+
+CoverageMapHelper::CoverageMapHelper ()
+  : m_spectrumMutex (0)
+{
+#ifdef HAVE_PTHREAD_H
+  m_spectrumMutex = new SystemMutex ();
+#endif
+}
+
+
+CoverageMapHelper::~CoverageMapHelper ()
+{
+#ifdef HAVE_PTHREAD_H
+  delete m_spectrumMutex;
+#endif
+}
+
+
+void
+CoverageMapHelper::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_spectrumLoss = 0;
+  m_spectrumTxPsd = 0;
+  m_transmitters.clear ();
+  for (uint32_t l = 0; l < NUM_LAYERS; l++)
+    {
+      m_layers[l].clear ();
+    }
+}
+
+TypeId
+CoverageMapHelper::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CoverageMapHelper")
+    .SetParent<Object> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<CoverageMapHelper> ()
+    .AddAttribute ("OutputFile", "the filename to which the coverage map is saved, "
+                   "nothing is saved if empty",
+                   StringValue ("coverage.bin"),
+                   MakeStringAccessor (&CoverageMapHelper::m_outputFile),
+                   MakeStringChecker ())
+    .AddAttribute ("XMin", "The min x coordinate of the map.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_xMin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("YMin", "The min y coordinate of the map.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_yMin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("XMax", "The max x coordinate of the map.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_xMax),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("YMax", "The max y coordinate of the map.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_yMax),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("XRes", "The resolution (number of points) of the map along the x axis.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&CoverageMapHelper::m_xRes),
+                   MakeUintegerChecker<uint16_t> (2,std::numeric_limits<uint16_t>::max ()))
+    .AddAttribute ("YRes", "The resolution (number of points) of the map along the y axis.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&CoverageMapHelper::m_yRes),
+                   MakeUintegerChecker<uint16_t> (2,std::numeric_limits<uint16_t>::max ()))
+    .AddAttribute ("Z", "The value of the z coordinate for which the map is to be generated",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_z),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("NumThreads", "The number of threads computing the map, "
+                   "0 to use one thread per online processor",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&CoverageMapHelper::m_numThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("TileSize", "The size (number of points per side) of the square tiles "
+                   "in which the map is divided among the threads",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&CoverageMapHelper::m_tileSize),
+                   MakeUintegerChecker<uint32_t> (1,std::numeric_limits<uint16_t>::max ()))
+    .AddAttribute ("Bandwidth", "The bandwidth of the transmissions, in Hz, "
+                   "over which the noise of the SINR is computed",
+                   DoubleValue (20e6),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_bandwidth),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("SubcarrierSpacing", "The subcarrier spacing, in Hz, "
+                   "the RSRP is the received power of one subcarrier",
+                   DoubleValue (15e3),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_subcarrierSpacing),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("NoiseFigure", "The noise figure of the receiver, in dB",
+                   DoubleValue (9.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_noiseFigure),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("RxAntennaGain", "The antenna gain of the receiver, in dB",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&CoverageMapHelper::m_rxAntennaGain),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+void
+CoverageMapHelper::AddPropagationLoss (std::string type,
+                                       std::string n0, const AttributeValue &v0,
+                                       std::string n1, const AttributeValue &v1,
+                                       std::string n2, const AttributeValue &v2,
+                                       std::string n3, const AttributeValue &v3,
+                                       std::string n4, const AttributeValue &v4,
+                                       std::string n5, const AttributeValue &v5,
+                                       std::string n6, const AttributeValue &v6,
+                                       std::string n7, const AttributeValue &v7)
+{
+  NS_LOG_FUNCTION (this << type);
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  factory.Set (n0, v0);
+  factory.Set (n1, v1);
+  factory.Set (n2, v2);
+  factory.Set (n3, v3);
+  factory.Set (n4, v4);
+  factory.Set (n5, v5);
+  factory.Set (n6, v6);
+  factory.Set (n7, v7);
+  m_propagationLoss.push_back (factory);
+}
+
+void
+CoverageMapHelper::SetSpectrumPropagationLossModel (Ptr<SpectrumPropagationLossModel> model,
+                                                    Ptr<const SpectrumModel> spectrumModel)
+{
+  NS_LOG_FUNCTION (this << model << spectrumModel);
+  m_spectrumLoss = model;
+  m_spectrumTxPsd = 0;
+  if (model != 0)
+    {
+      NS_ABORT_MSG_IF (spectrumModel == 0, "a spectrum model is needed to evaluate " << model);
+      m_spectrumTxPsd = Create<SpectrumValue> (spectrumModel);
+      (*m_spectrumTxPsd) = 1.0;
+    }
+}
+
+uint32_t
+CoverageMapHelper::AddTransmitter (Vector position, double txPowerDbm, Ptr<AntennaModel> antenna)
+{
+  NS_LOG_FUNCTION (this << position << txPowerDbm << antenna);
+  Transmitter tx;
+  tx.position = position;
+  tx.txPowerDbm = txPowerDbm;
+  tx.antenna = antenna;
+  m_transmitters.push_back (tx);
+  return m_transmitters.size () - 1;
+}
+
+Vector
+CoverageMapHelper::GetPosition (uint32_t ix, uint32_t iy) const
+{
+  double xStep = (m_xMax - m_xMin) / (m_xRes - 1);
+  double yStep = (m_yMax - m_yMin) / (m_yRes - 1);
+  return Vector (m_xMin + ix * xStep, m_yMin + iy * yStep, m_z);
+}
+
+float
+CoverageMapHelper::GetValue (Layer layer, uint32_t ix, uint32_t iy) const
+{
+  NS_ASSERT (layer < NUM_LAYERS);
+  NS_ASSERT_MSG (ix < m_xRes && iy < m_yRes && !m_layers[layer].empty (),
+                 "point (" << ix << ", " << iy << ") not computed");
+  return m_layers[layer][iy * m_xRes + ix];
+}
+
+void
+CoverageMapHelper::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_propagationLoss.empty (), "no propagation loss model, see AddPropagationLoss ()");
+  NS_ABORT_MSG_IF (m_transmitters.empty (), "no transmitter, see AddTransmitter ()");
+
+  for (uint32_t l = 0; l < NUM_LAYERS; l++)
+    {
+      m_layers[l].assign (static_cast<std::size_t> (m_xRes) * m_yRes, 0.0);
+    }
+
+  uint32_t tilesX = (m_xRes + m_tileSize - 1) / m_tileSize;
+  uint32_t tilesY = (m_yRes + m_tileSize - 1) / m_tileSize;
+  uint32_t numTiles = tilesX * tilesY;
+  uint32_t numThreads = 1;
+#ifdef HAVE_PTHREAD_H
+  numThreads = m_numThreads;
+  if (numThreads == 0)
+    {
+      long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+      numThreads = cpus > 0 ? cpus : 1;
+    }
+  numThreads = std::min (numThreads, numTiles);
+#endif
+  NS_LOG_INFO ("computing " << m_xRes << "x" << m_yRes << " points in " << numTiles
+               << " tiles with " << numThreads << " threads");
+
+  // the simulator implementation is created lazily, create it here so that
+  // the threads do not race to do it if the models look at the time
+  Simulator::Now ();
+
+  // the objects used by each thread are created here, since neither the
+  // reference counts nor the attribute system are thread safe
+  std::vector<Worker> workers;
+  workers.reserve (numThreads);
+  for (uint32_t k = 0; k < numThreads; k++)
+    {
+      workers.push_back (Worker (this, k, numThreads, numTiles));
+      Worker &worker = workers.back ();
+      Ptr<PropagationLossModel> prev = 0;
+      for (std::vector<ObjectFactory>::const_iterator i = m_propagationLoss.begin (); i != m_propagationLoss.end (); ++i)
+        {
+          Ptr<PropagationLossModel> cur = i->Create<PropagationLossModel> ();
+          if (prev != 0)
+            {
+              prev->SetNext (cur);
+            }
+          else
+            {
+              worker.m_loss = cur;
+            }
+          prev = cur;
+        }
+      for (std::vector<Transmitter>::const_iterator it = m_transmitters.begin (); it != m_transmitters.end (); ++it)
+        {
+          Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+          mm->SetPosition (it->position);
+          worker.m_txMobility.push_back (mm);
+        }
+      worker.m_rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+    }
+
+  if (numThreads == 1)
+    {
+      workers[0].Run ();
+    }
+  else
+    {
+#ifdef HAVE_PTHREAD_H
+      std::vector<Ptr<SystemThread> > threads;
+      for (uint32_t k = 0; k < numThreads; k++)
+        {
+          threads.push_back (Create<SystemThread> (MakeCallback (&Worker::Run, &workers[k])));
+          threads.back ()->Start ();
+        }
+      for (uint32_t k = 0; k < numThreads; k++)
+        {
+          threads[k]->Join ();
+        }
+#endif
+    }
+
+  if (!m_outputFile.empty ())
+    {
+      WriteOutputFile ();
+    }
+}
+
+void
+CoverageMapHelper::ComputeTile (Worker *worker, uint32_t tile)
+{
+  uint32_t tilesX = (m_xRes + m_tileSize - 1) / m_tileSize;
+  uint32_t x0 = (tile % tilesX) * m_tileSize;
+  uint32_t y0 = (tile / tilesX) * m_tileSize;
+  uint32_t nx = std::min<uint32_t> (m_tileSize, m_xRes - x0);
+  uint32_t ny = std::min<uint32_t> (m_tileSize, m_yRes - y0);
+  uint32_t points = nx * ny;
+  uint32_t numTx = m_transmitters.size ();
+  worker->m_rxPowerDbm.resize (numTx * points);
+
+  // received power of each transmitter over the whole tile
+  for (uint32_t i = 0; i < numTx; i++)
+    {
+      const Transmitter &tx = m_transmitters[i];
+      double *rxPowerDbm = &worker->m_rxPowerDbm[i * points];
+      for (uint32_t iy = 0; iy < ny; iy++)
+        {
+          for (uint32_t ix = 0; ix < nx; ix++)
+            {
+              Vector position = GetPosition (x0 + ix, y0 + iy);
+              worker->m_rxMobility->SetPosition (position);
+              double gainDb = m_rxAntennaGain;
+              if (tx.antenna != 0)
+                {
+                  gainDb += tx.antenna->GetGainDb (Angles (position, tx.position));
+                }
+              double powerDbm = worker->m_loss->CalcRxPower (tx.txPowerDbm + gainDb,
+                                                             worker->m_txMobility[i],
+                                                             worker->m_rxMobility);
+              if (m_spectrumLoss != 0)
+                {
+                  powerDbm += GetSpectrumGainDb (worker, i);
+                }
+              *rxPowerDbm++ = powerDbm;
+            }
+        }
+    }
+
+  // reduction into the layers
+  double noiseMw = std::pow (10.0, (-174.0 + 10 * std::log10 (m_bandwidth) + m_noiseFigure) / 10.0);
+  double rsrpOffsetDb = 10 * std::log10 (m_bandwidth / m_subcarrierSpacing);
+  for (uint32_t p = 0; p < points; p++)
+    {
+      uint32_t best = 0;
+      double bestDbm = worker->m_rxPowerDbm[p];
+      double totalMw = 0.0;
+      for (uint32_t i = 0; i < numTx; i++)
+        {
+          double powerDbm = worker->m_rxPowerDbm[i * points + p];
+          totalMw += std::pow (10.0, powerDbm / 10.0);
+          if (powerDbm > bestDbm)
+            {
+              bestDbm = powerDbm;
+              best = i;
+            }
+        }
+      double bestMw = std::pow (10.0, bestDbm / 10.0);
+      double interferenceMw = std::max (totalMw - bestMw, 0.0);
+      uint32_t index = (y0 + p / nx) * m_xRes + x0 + p % nx;
+      m_layers[RSRP][index] = bestDbm - rsrpOffsetDb;
+      m_layers[SINR][index] = 10 * std::log10 (bestMw / (interferenceMw + noiseMw));
+      m_layers[BEST_SERVER][index] = best;
+    }
+}
+
+double
+CoverageMapHelper::GetSpectrumGainDb (Worker *worker, uint32_t tx)
+{
+#ifdef HAVE_PTHREAD_H
+  CriticalSection cs (*m_spectrumMutex);
+#endif
+  Ptr<SpectrumValue> rxPsd = m_spectrumLoss->CalcRxPowerSpectralDensity (m_spectrumTxPsd,
+                                                                         worker->m_txMobility[tx],
+                                                                         worker->m_rxMobility);
+  return 10 * std::log10 (Integral (*rxPsd) / Integral (*m_spectrumTxPsd));
+}
+
+void
+CoverageMapHelper::WriteOutputFile (void) const
+{
+  NS_LOG_FUNCTION (this << m_outputFile);
+  std::ofstream out (m_outputFile.c_str (), std::ios::binary);
+  NS_ABORT_MSG_IF (!out.is_open (), "Can't open file " << m_outputFile);
+  for (uint32_t l = 0; l < NUM_LAYERS; l++)
+    {
+      // north up: the first line is the one with the max y coordinate
+      for (int32_t iy = m_yRes - 1; iy >= 0; iy--)
+        {
+          out.write (reinterpret_cast<const char *> (&m_layers[l][static_cast<std::size_t> (iy) * m_xRes]), m_xRes * sizeof (float));
+        }
+    }
+  out.close ();
+
+  std::string headerFile = m_outputFile + ".hdr";
+  std::ofstream header (headerFile.c_str ());
+  NS_ABORT_MSG_IF (!header.is_open (), "Can't open file " << headerFile);
+  uint16_t one = 1;
+  bool littleEndian = *reinterpret_cast<const uint8_t *> (&one) == 1;
+  double xStep = (m_xMax - m_xMin) / (m_xRes - 1);
+  double yStep = (m_yMax - m_yMin) / (m_yRes - 1);
+  header << std::setprecision (12)
+         << "ENVI" << std::endl
+         << "description = {ns-3 coverage map, z = " << m_z << "}" << std::endl
+         << "samples = " << m_xRes << std::endl
+         << "lines = " << m_yRes << std::endl
+         << "bands = " << NUM_LAYERS << std::endl
+         << "header offset = 0" << std::endl
+         << "file type = ENVI Standard" << std::endl
+         << "data type = 4" << std::endl
+         << "interleave = bsq" << std::endl
+         << "byte order = " << (littleEndian ? 0 : 1) << std::endl
+         << "map info = {Arbitrary, 1, 1, " << m_xMin - xStep / 2 << ", " << m_yMax + yStep / 2
+         << ", " << xStep << ", " << yStep << ", 0, units=Meters}" << std::endl
+         << "band names = {RSRP (dBm), SINR (dB), best server}" << std::endl;
+  header.close ();
+}
+
+
+} // namespace ns3
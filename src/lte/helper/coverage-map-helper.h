@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COVERAGE_MAP_HELPER_H
+#define COVERAGE_MAP_HELPER_H
+
+#include <ns3/object.h>
+#include <ns3/object-factory.h>
+#include <ns3/attribute.h>
+#include <ns3/vector.h>
+#include <ns3/antenna-model.h>
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
+class SpectrumModel;
+class SpectrumValue;
+class MobilityModel;
+class SystemMutex;
+
+/**
+ * \ingroup lte
+ *
+ * Computes a coverage map of a set of transmitters directly from the
+ * propagation models, without running the simulator.
+ *
+ * Unlike the RadioEnvironmentMapHelper, which deploys listeners on a
+ * spectrum channel and lets the simulator deliver them the signals, this
+ * helper evaluates a PropagationLossModel chain, optionally followed by a
+ * SpectrumPropagationLossModel, and the antenna gains of the transmitters
+ * for every point of a raster grid.  The grid is divided into square tiles
+ * of TileSize points, which are distributed over NumThreads threads.  For
+ * each tile the received powers of all the transmitters are computed
+ * first, transmitter by transmitter, and then reduced point by point into
+ * the layers of the map:
+ *  - RSRP: received power per subcarrier of the best server, in dBm
+ *  - SINR: SINR of the best server, in dB, with all the other transmitters
+ *    interfering at full load
+ *  - BEST_SERVER: index of the best server, as returned by AddTransmitter ()
+ *
+ * Each thread owns a copy of the propagation loss chain, created from the
+ * factories given to AddPropagationLoss (), and of the mobility models of
+ * the transmitters and of the receiver, so the models do not need to be
+ * thread safe as long as they only depend on the positions of the
+ * endpoints.  Models that keep per-link state keyed by the Node of the
+ * endpoints, e.g. the 3GPP channel condition models with probabilistic LOS
+ * or the 3GPP shadowing, cannot be used.  The tiles are statically
+ * assigned to the threads, so the maps of random models are reproducible
+ * for a given number of threads.  Each thread draws from the random
+ * variables of its own copy of the models, though, so a random model gives
+ * different maps for different numbers of threads.  The
+ * SpectrumPropagationLossModel is
+ * shared by all the threads and is evaluated with a lock held.  The
+ * antenna models are shared too, and are expected not to change state
+ * when computing a gain, as the ones of the antenna module.
+ *
+ * Run () writes the map to OutputFile as a raw raster of float32 values,
+ * band (layer) sequential, rows from the max to the min y coordinate, in
+ * the byte order of the host, with an ENVI header in OutputFile.hdr, so
+ * that it can be opened by GDAL based tools.
+ */
+class CoverageMapHelper : public Object
+{
+public:
+  /// Layers of the coverage map
+  enum Layer
+  {
+    RSRP = 0,     ///< RSRP of the best server, in dBm
+    SINR,         ///< SINR of the best server, in dB
+    BEST_SERVER,  ///< index of the best server
+    NUM_LAYERS
+  };
+
+  CoverageMapHelper ();
+  virtual ~CoverageMapHelper ();
+
+  // inherited from Object
+  virtual void DoDispose (void);
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Append a model to the propagation loss chain.  The models are chained
+   * in the order in which they are added.
+   *
+   * \param type the type of the model, a subclass of PropagationLossModel
+   * \param n0 the name of the attribute to set
+   * \param v0 the value of the attribute to set
+   * \param n1 the name of the attribute to set
+   * \param v1 the value of the attribute to set
+   * \param n2 the name of the attribute to set
+   * \param v2 the value of the attribute to set
+   * \param n3 the name of the attribute to set
+   * \param v3 the value of the attribute to set
+   * \param n4 the name of the attribute to set
+   * \param v4 the value of the attribute to set
+   * \param n5 the name of the attribute to set
+   * \param v5 the value of the attribute to set
+   * \param n6 the name of the attribute to set
+   * \param v6 the value of the attribute to set
+   * \param n7 the name of the attribute to set
+   * \param v7 the value of the attribute to set
+   */
+  void AddPropagationLoss (std::string type,
+                           std::string n0 = "", const AttributeValue &v0 = EmptyAttributeValue (),
+                           std::string n1 = "", const AttributeValue &v1 = EmptyAttributeValue (),
+                           std::string n2 = "", const AttributeValue &v2 = EmptyAttributeValue (),
+                           std::string n3 = "", const AttributeValue &v3 = EmptyAttributeValue (),
+                           std::string n4 = "", const AttributeValue &v4 = EmptyAttributeValue (),
+                           std::string n5 = "", const AttributeValue &v5 = EmptyAttributeValue (),
+                           std::string n6 = "", const AttributeValue &v6 = EmptyAttributeValue (),
+                           std::string n7 = "", const AttributeValue &v7 = EmptyAttributeValue ());
+
+  /**
+   * Apply a SpectrumPropagationLossModel after the propagation loss chain.
+   * Its gain is the ratio between the received and the transmitted power
+   * of a flat PSD over the given spectrum model.
+   *
+   * \param model the spectrum propagation loss model
+   * \param spectrumModel the spectrum model of the transmissions
+   */
+  void SetSpectrumPropagationLossModel (Ptr<SpectrumPropagationLossModel> model,
+                                        Ptr<const SpectrumModel> spectrumModel);
+
+  /**
+   * Add a transmitter to the map.
+   *
+   * \param position the position of the transmitter
+   * \param txPowerDbm the total transmission power over the Bandwidth, in dBm
+   * \param antenna the antenna of the transmitter, isotropic if 0
+   * \return the index of the transmitter, as in the BEST_SERVER layer
+   */
+  uint32_t AddTransmitter (Vector position, double txPowerDbm, Ptr<AntennaModel> antenna = 0);
+
+  /**
+   * Compute the map and, if OutputFile is not empty, write it.
+   */
+  void Run (void);
+
+  /**
+   * \param layer the layer
+   * \param ix the index of the point along the x axis
+   * \param iy the index of the point along the y axis
+   * \return the value of the layer at the point, as computed by the last Run ()
+   */
+  float GetValue (Layer layer, uint32_t ix, uint32_t iy) const;
+
+  /**
+   * \param ix the index of the point along the x axis
+   * \param iy the index of the point along the y axis
+   * \return the position of the point
+   */
+  Vector GetPosition (uint32_t ix, uint32_t iy) const;
+
+private:
+  class Worker;
+
+  /// A transmitter of the map
+  struct Transmitter
+  {
+    Vector position;          ///< position
+    double txPowerDbm;        ///< transmission power, in dBm
+    Ptr<AntennaModel> antenna; ///< antenna, or 0 if isotropic
+  };
+
+  /**
+   * Compute the layers of a tile of the map.
+   *
+   * \param worker the state of the thread computing the tile
+   * \param tile the index of the tile
+   */
+  void ComputeTile (Worker *worker, uint32_t tile);
+
+  /**
+   * \param worker the state of the thread computing the gain
+   * \param tx the index of the transmitter
+   * \return the gain of the SpectrumPropagationLossModel from the
+   * transmitter to the current position of the receiver of the worker, in dB
+   */
+  double GetSpectrumGainDb (Worker *worker, uint32_t tx);
+
+  /// Write the map to OutputFile and its ENVI header
+  void WriteOutputFile (void) const;
+
+  double m_xMin;        ///< The `XMin` attribute.
+  double m_xMax;        ///< The `XMax` attribute.
+  uint16_t m_xRes;      ///< The `XRes` attribute.
+  double m_yMin;        ///< The `YMin` attribute.
+  double m_yMax;        ///< The `YMax` attribute.
+  uint16_t m_yRes;      ///< The `YRes` attribute.
+  double m_z;           ///< The `Z` attribute.
+  uint32_t m_numThreads; ///< The `NumThreads` attribute.
+  uint32_t m_tileSize;  ///< The `TileSize` attribute.
+  double m_bandwidth;   ///< The `Bandwidth` attribute.
+  double m_subcarrierSpacing; ///< The `SubcarrierSpacing` attribute.
+  double m_noiseFigure; ///< The `NoiseFigure` attribute.
+  double m_rxAntennaGain; ///< The `RxAntennaGain` attribute.
+  std::string m_outputFile; ///< The `OutputFile` attribute.
+
+  /// Factories of the propagation loss chain
+  std::vector<ObjectFactory> m_propagationLoss;
+  /// The SpectrumPropagationLossModel, if any
+  Ptr<SpectrumPropagationLossModel> m_spectrumLoss;
+  /// Flat PSD used to evaluate m_spectrumLoss
+  Ptr<SpectrumValue> m_spectrumTxPsd;
+  /// Serializes the calls to m_spectrumLoss
+  SystemMutex *m_spectrumMutex;
+
+  /// Transmitters of the map
+  std::vector<Transmitter> m_transmitters;
+  /// Values of the layers, indexed by layer and then by iy * m_xRes + ix
+  std::vector<float> m_layers[NUM_LAYERS];
+
+}; // end of `class CoverageMapHelper`
+
+
+} // end of `namespace ns3`
+
+#endif /* COVERAGE_MAP_HELPER_H */
@@ -166,6 +166,14 @@ TypeId LteHelper::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LteHelper::m_usePdschForCqiGeneration),
                    MakeBooleanChecker ())
+    .AddAttribute ("UseCqiSubsampling",
+                   "If true, the CqiSubsampling attribute of the UE PHYs is enabled: "
+                   "their DL-CQIs are computed again only when they are older than "
+                   "LteUePhy::CqiSubsamplingPeriod or when the SINR changed by more than "
+                   "LteUePhy::CqiSubsamplingThreshold. If false, the attribute is left unchanged.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteHelper::m_useCqiSubsampling),
+                   MakeBooleanChecker ())
     .AddAttribute ("EnbComponentCarrierManager",
                    "The type of Component Carrier Manager to be used for eNBs. "
                    "The allowed values for this attributes are the type names "
@@ -803,6 +811,10 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
       Ptr<LteSpectrumPhy> ulPhy = CreateObject<LteSpectrumPhy> ();
 
       Ptr<LteUePhy> phy = CreateObject<LteUePhy> (dlPhy, ulPhy);
+      if (m_useCqiSubsampling)
+        {
+          phy->SetAttribute ("CqiSubsampling", BooleanValue (true));
+        }
 
       Ptr<LteHarqPhy> harq = Create<LteHarqPhy> ();
       dlPhy->SetHarqPhyModule (harq);
@@ -828,6 +828,12 @@ private:
    * DL-CQI will be calculated from PDCCH as signal and PDCCH as interference.
    */
   bool m_usePdschForCqiGeneration;
+  /**
+   * The `UseCqiSubsampling` attribute. If true, the CqiSubsampling attribute
+   * of the UE PHYs is enabled, so that their DL-CQIs are computed again
+   * only when they are too old or the SINR changed.
+   */
+  bool m_useCqiSubsampling;
 
   /**
    * The `UseCa` attribute. If true, Carrier Aggregation is enabled.
@@ -0,0 +1,228 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/ff-mac-scheduler-core.h>
+#include <ns3/log.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedulerCore");
+
+FfMacSchedulerCore::FfMacSchedulerCore ()
+  : m_tti (0),
+    m_rbgNum (0),
+    m_rbgMask (0),
+    m_rbgSize (0)
+{
+  for (uint8_t n = 0; n < 3; n++)
+    {
+      m_lowestSbCqi[n].resize (n, 1);
+    }
+}
+
+void
+FfMacSchedulerCore::StartTti (Ptr<LteAmc> amc, int rbgSize, int rbgNum, const std::vector<bool>& availableRbgs)
+{
+  NS_LOG_FUNCTION (this << rbgSize << rbgNum);
+  NS_ASSERT_MSG (rbgNum <= 32, "the RBG mask only supports 32 RBGs");
+  m_tti++;
+  if (m_tti == 0)
+    {
+      // the tags wrapped around
+      for (std::vector<RntiState>::iterator it = m_rntis.begin (); it != m_rntis.end (); ++it)
+        {
+          it->ueTti = 0;
+          it->allocatedTti = 0;
+        }
+      m_tti = 1;
+    }
+  m_ues.clear ();
+  m_rbgNum = rbgNum;
+  m_rbgMask = 0;
+  for (int i = 0; i < rbgNum && i < (int) availableRbgs.size (); i++)
+    {
+      if (availableRbgs[i])
+        {
+          m_rbgMask |= (0x1 << i);
+        }
+    }
+
+  if (amc != m_amc || rbgSize != m_rbgSize)
+    {
+      m_amc = amc;
+      m_rbgSize = rbgSize;
+      for (int cqi = 0; cqi < 16; cqi++)
+        {
+          m_mcsOfCqi[cqi] = amc->GetMcsFromCqi (cqi);
+        }
+      for (int mcs = 0; mcs < 29; mcs++)
+        {
+          m_rbgRate[mcs] = ((amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001); // = TB size / TTI
+        }
+    }
+}
+
+uint32_t
+FfMacSchedulerCore::GetRbgMask (void) const
+{
+  return m_rbgMask;
+}
+
+void
+FfMacSchedulerCore::SetRbgMask (uint32_t mask)
+{
+  m_rbgMask = mask;
+}
+
+bool
+FfMacSchedulerCore::IsRbgFree (int rbg) const
+{
+  return ((m_rbgMask >> rbg) & 0x1) == 0;
+}
+
+bool
+FfMacSchedulerCore::IsRbgMapFull (void) const
+{
+  uint32_t all = (m_rbgNum == 32) ? 0xffffffff : ((0x1u << m_rbgNum) - 1);
+  return (m_rbgMask & all) == all;
+}
+
+void
+FfMacSchedulerCore::SetRntiAllocated (uint16_t rnti)
+{
+  GetRntiState (rnti).allocatedTti = m_tti;
+}
+
+bool
+FfMacSchedulerCore::IsRntiAllocated (uint16_t rnti) const
+{
+  return rnti < m_rntis.size () && m_rntis[rnti].allocatedTti == m_tti;
+}
+
+FfMacSchedulerCore::Ue&
+FfMacSchedulerCore::AddUe (uint16_t rnti)
+{
+  NS_ASSERT_MSG (m_ues.empty () || m_ues.back ().rnti < rnti, "UEs not added in the order of their RNTI");
+  RntiState& state = GetRntiState (rnti);
+  state.ueTti = m_tti;
+  state.ueIndex = m_ues.size ();
+  Ue ue;
+  ue.rnti = rnti;
+  ue.nLayers = 1;
+  ue.lcActives = 0;
+  ue.schedulable = false;
+  ue.selected = false;
+  ue.sbCqi = 0;
+  ue.metric = 0.0;
+  ue.rbgMask = 0;
+  m_ues.push_back (ue);
+  return m_ues.back ();
+}
+
+uint32_t
+FfMacSchedulerCore::GetUeNum (void) const
+{
+  return m_ues.size ();
+}
+
+FfMacSchedulerCore::Ue&
+FfMacSchedulerCore::GetUe (uint32_t index)
+{
+  return m_ues[index];
+}
+
+FfMacSchedulerCore::Ue*
+FfMacSchedulerCore::FindUe (uint16_t rnti)
+{
+  if (rnti >= m_rntis.size () || m_rntis[rnti].ueTti != m_tti)
+    {
+      return 0;
+    }
+  return &m_ues[m_rntis[rnti].ueIndex];
+}
+
+void
+FfMacSchedulerCore::CountActiveLcs (const std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>& rlcBufferReq)
+{
+  std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::const_iterator it;
+  Ue* ue = 0;
+  for (it = rlcBufferReq.begin (); it != rlcBufferReq.end (); it++)
+    {
+      if (ue == 0 || ue->rnti != (*it).first.m_rnti)
+        {
+          ue = FindUe ((*it).first.m_rnti);
+          if (ue == 0)
+            {
+              continue;
+            }
+        }
+      if (((*it).second.m_rlcTransmissionQueueSize > 0)
+          || ((*it).second.m_rlcRetransmissionQueueSize > 0)
+          || ((*it).second.m_rlcStatusPduSize > 0))
+        {
+          ue->lcActives++;
+        }
+    }
+}
+
+void
+FfMacSchedulerCore::AllocateRbg (Ue& ue, int rbg)
+{
+  NS_ASSERT_MSG (IsRbgFree (rbg), "RBG " << rbg << " already allocated");
+  ue.rbgMask |= (0x1 << rbg);
+  m_rbgMask |= (0x1 << rbg);
+}
+
+const std::vector<uint8_t>&
+FfMacSchedulerCore::GetSbCqi (const Ue& ue, int rbg) const
+{
+  if (ue.sbCqi == 0)
+    {
+      NS_ASSERT (ue.nLayers < 3);
+      return m_lowestSbCqi[ue.nLayers];
+    }
+  return ue.sbCqi->m_higherLayerSelected.at (rbg).m_sbCqi;
+}
+
+uint8_t
+FfMacSchedulerCore::GetMcsFromCqi (uint8_t cqi) const
+{
+  NS_ASSERT_MSG (cqi < 16, "CQI must be in [0..15] = " << (uint16_t) cqi);
+  return m_mcsOfCqi[cqi];
+}
+
+double
+FfMacSchedulerCore::GetRbgRate (uint8_t mcs) const
+{
+  NS_ASSERT_MSG (mcs < 29, "MCS=" << (uint16_t) mcs);
+  return m_rbgRate[mcs];
+}
+
+FfMacSchedulerCore::RntiState&
+FfMacSchedulerCore::GetRntiState (uint16_t rnti)
+{
+  if (rnti >= m_rntis.size ())
+    {
+      RntiState state;
+      state.ueTti = 0;
+      state.ueIndex = 0;
+      state.allocatedTti = 0;
+      m_rntis.resize (rnti + 1, state);
+    }
+  return m_rntis[rnti];
+}
+
+} // namespace ns3
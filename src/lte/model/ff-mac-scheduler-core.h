@@ -0,0 +1,187 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_CORE_H
+#define FF_MAC_SCHEDULER_CORE_H
+
+#include <ns3/ptr.h>
+#include <ns3/lte-common.h>
+#include <ns3/lte-amc.h>
+#include <ns3/ff-mac-common.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup ff-api
+ *
+ * The DL state of a TTI shared by the FF MAC schedulers allocating RBGs
+ * with the resource allocation type 0.
+ *
+ * The RBGs already allocated in the TTI, either by the FFR algorithm, the
+ * HARQ retransmissions or the scheduler, are kept in a bitmask, and the
+ * RBGs allocated to each UE in another bitmask, which is directly the
+ * m_rbBitmap of its DCI.  The UEs are kept in a dense array, in the order
+ * of their RNTI, with the state of the UE needed by the metric of the
+ * scheduler, which is thus looked up once per TTI instead of once per RBG;
+ * the schedulers keep their own per-UE state in arrays with the same
+ * indices.  The entries indexed by RNTI are tagged with the number of the
+ * TTI, so that they need not be cleared.  The arrays are reused from one
+ * TTI to the next, so that no memory is allocated in steady state.
+ *
+ * The achievable rate of an RBG per MCS is tabulated when the RBG size
+ * changes, since it does not depend on the UE.
+ */
+class FfMacSchedulerCore
+{
+public:
+  /// DL state of a UE in the current TTI
+  struct Ue
+  {
+    uint16_t rnti;               ///< RNTI
+    uint8_t nLayers;             ///< number of layers of the transmission mode
+    uint16_t lcActives;          ///< number of LCs with data to transmit
+    bool schedulable;            ///< whether RBGs can be allocated to the UE
+    bool selected;               ///< whether selected by the time domain scheduler, if any
+    const SbMeasResult_s* sbCqi; ///< last subband CQIs, or 0 if none was received
+    double metric;               ///< per-TTI value of the metric of the scheduler
+    uint32_t rbgMask;            ///< RBGs allocated to the UE in the TTI
+  };
+
+  FfMacSchedulerCore ();
+
+  /**
+   * Start a new TTI, without any UE
+   * \param amc the AMC of the scheduler
+   * \param rbgSize the number of RBs per RBG
+   * \param rbgNum the number of RBGs
+   * \param availableRbgs the RBGs, true if not available for the scheduler
+   */
+  void StartTti (Ptr<LteAmc> amc, int rbgSize, int rbgNum, const std::vector<bool>& availableRbgs);
+
+  /// \return the RBGs allocated in the TTI
+  uint32_t GetRbgMask (void) const;
+  /**
+   * \param mask the RBGs allocated in the TTI
+   */
+  void SetRbgMask (uint32_t mask);
+  /**
+   * \param rbg the RBG
+   * \return true if the RBG is not allocated yet
+   */
+  bool IsRbgFree (int rbg) const;
+  /// \return true if all the RBGs are allocated
+  bool IsRbgMapFull (void) const;
+
+  /**
+   * Mark a UE as served by a HARQ retransmission in the TTI
+   * \param rnti the RNTI of the UE
+   */
+  void SetRntiAllocated (uint16_t rnti);
+  /**
+   * \param rnti the RNTI of the UE
+   * \return true if the UE is served by a HARQ retransmission in the TTI
+   */
+  bool IsRntiAllocated (uint16_t rnti) const;
+
+  /**
+   * Add a UE to the TTI; the UEs must be added in the order of their RNTI.
+   * The UE has a single layer, no active LC and no CQI, and is neither
+   * schedulable nor selected.
+   * \param rnti the RNTI of the UE
+   * \return the state of the UE
+   */
+  Ue& AddUe (uint16_t rnti);
+  /// \return the number of UEs of the TTI
+  uint32_t GetUeNum (void) const;
+  /**
+   * \param index the index of the UE, in the order of addition
+   * \return the state of the UE
+   */
+  Ue& GetUe (uint32_t index);
+  /**
+   * \param rnti the RNTI of the UE
+   * \return the state of the UE, or 0 if it was not added in the TTI
+   */
+  Ue* FindUe (uint16_t rnti);
+
+  /**
+   * Set the number of active LCs of all the UEs, in a single pass over the
+   * RLC buffers
+   * \param rlcBufferReq the RLC buffers of the scheduler
+   */
+  void CountActiveLcs (const std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>& rlcBufferReq);
+
+  /**
+   * Allocate a free RBG to a UE
+   * \param ue the UE
+   * \param rbg the RBG
+   */
+  void AllocateRbg (Ue& ue, int rbg);
+
+  /**
+   * \param ue the UE
+   * \param rbg the RBG
+   * \return the CQI per layer of the RBG, the lowest CQI on each layer if
+   * the UE has no subband CQI
+   */
+  const std::vector<uint8_t>& GetSbCqi (const Ue& ue, int rbg) const;
+
+  /**
+   * \param cqi the CQI
+   * \return the MCS of the CQI, as per LteAmc::GetMcsFromCqi
+   */
+  uint8_t GetMcsFromCqi (uint8_t cqi) const;
+  /**
+   * \param mcs the MCS
+   * \return the rate of a TB of an RBG, in bytes/s
+   */
+  double GetRbgRate (uint8_t mcs) const;
+
+private:
+  /// State indexed by RNTI
+  struct RntiState
+  {
+    uint32_t ueTti;        ///< last TTI in which the UE was added
+    uint32_t ueIndex;      ///< index of the UE in that TTI
+    uint32_t allocatedTti; ///< last TTI in which the UE was served by a HARQ retransmission
+  };
+
+  /**
+   * \param rnti the RNTI
+   * \return the state of the RNTI
+   */
+  RntiState& GetRntiState (uint16_t rnti);
+
+  uint32_t m_tti;                       ///< number of the current TTI, never 0
+  int m_rbgNum;                         ///< number of RBGs
+  uint32_t m_rbgMask;                   ///< RBGs allocated in the TTI
+  std::vector<Ue> m_ues;                ///< UEs of the TTI
+  std::vector<RntiState> m_rntis;       ///< state indexed by RNTI
+  std::vector<uint8_t> m_lowestSbCqi[3]; ///< lowest CQI, per number of layers
+
+  Ptr<LteAmc> m_amc;                    ///< AMC of the tabulated rates
+  int m_rbgSize;                        ///< RBG size of the tabulated rates
+  uint8_t m_mcsOfCqi[16];               ///< MCS of each CQI
+  double m_rbgRate[29];                 ///< rate of an RBG for each MCS, in bytes/s
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_CORE_H */
@@ -381,10 +381,12 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
          {
             uint8_t mcs = 0;
             TbStats_t tbStats;
+            HarqProcessInfoList_t harqInfoList;
+            // the MI of the RBG for each modulation is computed once for all the MCSs
+            LteMibs_t mibs = LteMiErrorModel::GetMibs (sinr, rbgMap);
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
+                tbStats = LteMiErrorModel::GetTbDecodificationStats (mibs, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
                 if (tbStats.tbler > 0.1)
                   {
                     break;
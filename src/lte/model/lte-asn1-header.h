@@ -25,6 +25,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -32,6 +33,12 @@ namespace ns3 {
  * This class has the purpose to encode Information Elements according
  * to ASN.1 syntax, as defined in ITU-T  X-691.
  * IMPORTANT: The encoding is done following the UNALIGNED variant.
+ *
+ * The fields are written and read as whole words of up to 32 bits, most
+ * significant bit first, and the width of the constrained integers is
+ * computed from their range without floating point.  The complete octets
+ * are collected in a plain array and appended to m_serializationResult in
+ * a single step once the serialization is finalized.
  */
 class Asn1Header : public Header
 {
@@ -69,12 +76,41 @@ protected:
   mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
+  mutable std::vector<uint8_t> m_serializationOctets; //!< octets not yet appended to m_serializationResult
 
   /**
    * Function to write in m_serializationResult, after resizing its size
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
+  /**
+   * Append the octets written so far to m_serializationResult
+   */
+  void FlushSerialization (void) const;
+  /**
+   * Compute the number of bits of a constrained whole number
+   * (Clause 11.5.6 ITU-T X.691)
+   * \param range the number of values of the constrained whole number
+   * \returns the number of bits, ceil (log2 (range))
+   */
+  static int GetRequiredBits (int range);
+
+  /**
+   * Serialize the least significant bits of a value, most significant
+   * first, after the pending bits
+   * \param value value to serialize
+   * \param numBits number of bits to serialize, at most 32
+   */
+  void SerializeBits (uint32_t value, int numBits) const;
+  /**
+   * Deserialize bits, most significant first, starting with the pending bits
+   * \param value buffer to store the result, in its least significant bits
+   * \param numBits number of bits to deserialize, at most 32
+   * \param bIterator buffer iterator
+   * \returns the modified buffer iterator
+   */
+  Buffer::Iterator DeserializeBits (uint32_t *value, int numBits,
+                                    Buffer::Iterator bIterator);
 
   // Serialization functions
 
@@ -1055,22 +1055,11 @@ std::list<UlDciLteControlMessage>
 LteEnbPhy::DequeueUlDci (void)
 {
   NS_LOG_FUNCTION (this);
-  if (m_ulDciQueue.at (0).size ()>0)
-    {
-      std::list<UlDciLteControlMessage> ret = m_ulDciQueue.at (0);
-      m_ulDciQueue.erase (m_ulDciQueue.begin ());
-      std::list<UlDciLteControlMessage> l;
-      m_ulDciQueue.push_back (l);
-      return (ret);
-    }
-  else
-    {
-      m_ulDciQueue.erase (m_ulDciQueue.begin ());
-      std::list<UlDciLteControlMessage> l;
-      m_ulDciQueue.push_back (l);
-      std::list<UlDciLteControlMessage> emptylist;
-      return (emptylist);
-    }
+  std::list<UlDciLteControlMessage> ret;
+  ret.swap (m_ulDciQueue.front ());
+  m_ulDciQueue.pop_front ();
+  m_ulDciQueue.push_back (std::list<UlDciLteControlMessage> ());
+  return (ret);
 }
 
 void
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <set>
+#include <deque>
 
 
 
@@ -442,7 +443,7 @@ private:
   std::vector <int> m_dlDataRbMap; ///< DL data RB map
 
   /// For storing info on future receptions.
-  std::vector< std::list<UlDciLteControlMessage> > m_ulDciQueue;
+  std::deque< std::list<UlDciLteControlMessage> > m_ulDciQueue;
 
   LteEnbPhySapProvider* m_enbPhySapProvider; ///< ENB Phy SAP provider
   LteEnbPhySapUser* m_enbPhySapUser; ///< ENB Phy SAP user
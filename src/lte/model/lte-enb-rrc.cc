@@ -911,7 +911,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
     //Copy lte-rlc-am.m_txOnBuffer to X2 forwarding buffer.
     Ptr<LteRlcAm> rlcAm = rlc->GetObject<LteRlcAm>();
     uint32_t txonBufferSize = rlcAm->GetTxBufferSize();
-    std::vector < Ptr<Packet> > txonBuffer = rlcAm->GetTxBuffer();
+    std::deque < Ptr<Packet> > txonBuffer = rlcAm->GetTxBuffer();
     //m_x2forwardingBufferSize =  drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBufferSize();
     //m_x2forwardingBuffer = drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBuffer();
     uint32_t txedBufferSize = rlcAm->GetTxedBufferSize();
@@ -944,7 +944,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
     //{
       LtePdcpHeader pdcpHeader;
       uint32_t pos = 0;
-      for (std::vector< Ptr<Packet> >::iterator it = txonBuffer.begin(); it != txonBuffer.end(); ++it)
+      for (std::deque< Ptr<Packet> >::iterator it = txonBuffer.begin(); it != txonBuffer.end(); ++it)
       {
         pos++;
         if((*it)->GetSize() > 3)
@@ -982,7 +982,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
           segmentedRlcsdu->PeekHeader(pdcpHeader);
           NS_LOG_DEBUG(this << "SegmentedRlcSdu = " << segmentedRlcsdu->GetSize() << " SEQ = " << pdcpHeader.GetSequenceNumber());
           //insert the complete version of the fragmented SDU to the front of txonBuffer.
-          txonBuffer.insert(txonBuffer.begin(),segmentedRlcsdu);
+          txonBuffer.push_front(segmentedRlcsdu);
         }
         m_x2forwardingBuffer.insert(m_x2forwardingBuffer.end(), txonBuffer.begin(), txonBuffer.end());
         m_x2forwardingBufferSize += rlcAm->GetTransmittingRlcSduBufferSize() + txonBufferSize;
@@ -1013,7 +1013,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
       else
       { //TransmittingBuffer is empty. Only copy TxonBuffer.
         NS_LOG_DEBUG(this << " ADDING TXONBUFFER OF RLC AM " << m_rnti << " Size = " << txonBufferSize) ;
-        m_x2forwardingBuffer = txonBuffer;
+        m_x2forwardingBuffer.assign (txonBuffer.begin (), txonBuffer.end ());
         m_x2forwardingBufferSize += txonBufferSize;
       }
     //}
@@ -1137,7 +1137,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
       NS_LOG_UNCOND("Too small, not forwarded");
     }
     m_x2forwardingBufferSize -= (*(m_x2forwardingBuffer.begin()))->GetSize();
-    m_x2forwardingBuffer.erase (m_x2forwardingBuffer.begin());
+    m_x2forwardingBuffer.pop_front ();
     NS_LOG_LOGIC(this << " After forwarding: buffer size = " << m_x2forwardingBufferSize );
   }
 }
@@ -59,6 +59,7 @@
 #include <set>
 #include <ns3/component-carrier-enb.h>
 #include <vector>
+#include <deque>
 
 #define MIN_NO_CC 1
 #define MAX_NO_CC 5 // this is the maximum number of carrier components allowed by 3GPP up to R13
@@ -682,7 +683,7 @@ private:
    */
   EventId m_handoverLeavingTimeout;
 
-  std::vector < Ptr<Packet> > m_x2forwardingBuffer;
+  std::deque < Ptr<Packet> > m_x2forwardingBuffer;
   uint32_t m_x2forwardingBufferSize;
   uint32_t m_maxx2forwardingBufferSize;
 
@@ -56,12 +56,11 @@ LteHarqPhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
   NS_LOG_FUNCTION (this);
 
   // left shift UL HARQ buffers
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
+  std::map <uint16_t, std::deque <HarqProcessInfoList_t> >::iterator it;
   for (it = m_miUlHarqProcessesInfoMap.begin (); it != m_miUlHarqProcessesInfoMap.end (); it++)
     {
-      (*it).second.erase ((*it).second.begin ());
-      HarqProcessInfoList_t h;
-      (*it).second.push_back (h);      
+      (*it).second.pop_front ();
+      (*it).second.push_back (HarqProcessInfoList_t ());
     }
 
 }
@@ -93,10 +92,10 @@ LteHarqPhy::GetAccumulatedMiUl (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
 
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
+  std::map <uint16_t, std::deque <HarqProcessInfoList_t> >::iterator it;
   it = m_miUlHarqProcessesInfoMap.find (rnti);
   NS_ASSERT_MSG (it!=m_miUlHarqProcessesInfoMap.end (), " Does not find MI for RNTI");
-  HarqProcessInfoList_t list = (*it).second.at (0);
+  const HarqProcessInfoList_t &list = (*it).second.at (0);
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -109,14 +108,14 @@ HarqProcessInfoList_t
 LteHarqPhy::GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)harqProcId);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
+  std::map <uint16_t, std::deque <HarqProcessInfoList_t> >::iterator it;
   it = m_miUlHarqProcessesInfoMap.find (rnti);
   if (it==m_miUlHarqProcessesInfoMap.end ())
     {
       // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
+      std::deque <HarqProcessInfoList_t> harqList;
       harqList.resize (8);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
+      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::deque <HarqProcessInfoList_t> > (rnti, harqList));
       return (harqList.at (harqProcId));
     }
   else
@@ -160,19 +159,19 @@ void
 LteHarqPhy::UpdateUlHarqProcessStatus (uint16_t rnti, double mi, uint16_t infoBytes, uint16_t codeBytes)
 {
   NS_LOG_FUNCTION (this << rnti << mi);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
+  std::map <uint16_t, std::deque <HarqProcessInfoList_t> >::iterator it;
   it = m_miUlHarqProcessesInfoMap.find (rnti);
   if (it==m_miUlHarqProcessesInfoMap.end ())
     {
       // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
+      std::deque <HarqProcessInfoList_t> harqList;
       harqList.resize (8);
       HarqProcessInfoElement_t el;
       el.m_mi = mi;
       el.m_infoBits = infoBytes * 8;
       el.m_codeBits = codeBytes * 8;
       harqList.at (7).push_back (el);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
+      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::deque <HarqProcessInfoList_t> > (rnti, harqList));
     }
   else
     {
@@ -183,7 +182,7 @@ LteHarqPhy::UpdateUlHarqProcessStatus (uint16_t rnti, double mi, uint16_t infoBy
         }
 
       //move current status back at the end to maintain full history
-      HarqProcessInfoList_t list = (*it).second.at (0);
+      const HarqProcessInfoList_t &list = (*it).second.at (0);
       for (uint8_t i = 0; i < list.size (); i++)
         {
           (*it).second.at (7).push_back (list.at (i));
@@ -201,14 +200,14 @@ void
 LteHarqPhy::ResetUlHarqProcessStatus (uint16_t rnti, uint8_t id)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)id);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
+  std::map <uint16_t, std::deque <HarqProcessInfoList_t> >::iterator it;
   it = m_miUlHarqProcessesInfoMap.find (rnti);
   if (it==m_miUlHarqProcessesInfoMap.end ())
     {
       // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
+      std::deque <HarqProcessInfoList_t> harqList;
       harqList.resize (8);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
+      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::deque <HarqProcessInfoList_t> > (rnti, harqList));
     }
   else
     {
@@ -29,6 +29,7 @@
 #include <math.h>
 #include <vector>
 #include <map>
+#include <deque>
 #include <ns3/simple-ref-count.h>
 
 
@@ -144,7 +145,7 @@ public:
 private:
 
   std::vector <std::vector <HarqProcessInfoList_t> > m_miDlHarqProcessesInfoMap; ///< MI DL HARQ processes info map
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> > m_miUlHarqProcessesInfoMap; ///< MI UL HARQ processes info map
+  std::map <uint16_t, std::deque <HarqProcessInfoList_t> > m_miUlHarqProcessesInfoMap; ///< MI UL HARQ processes info map
   
 
 };
@@ -39,6 +39,7 @@
 #include <stdint.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/lte-harq-phy.h>
+#include <ns3/lte-mi-kernel.h>
 
 
 
@@ -47,24 +48,6 @@ namespace ns3 {
   
   /// PDCCH PCFICH curve size
   const uint16_t PDCCH_PCFICH_CURVE_SIZE = 46;
-  /// MI map QPSK size 
-  const uint16_t MI_MAP_QPSK_SIZE = 797;
-  /// MI map 16QAM size
-  const uint16_t MI_MAP_16QAM_SIZE = 994;
-  /// MI map 64QAM size
-  const uint16_t MI_MAP_64QAM_SIZE = 752;
-  /// MI QPSK maximum ID
-  const uint16_t MI_QPSK_MAX_ID = 9;
-  /// MI 16QAM maximum ID
-  const uint16_t MI_16QAM_MAX_ID = 16;
-  /// MI 64QAM maximum ID
-  const uint16_t MI_64QAM_MAX_ID = 28;  // 29,30 and 31 are reserved
-  /// MI QPSK BLER maximum ID
-  const uint16_t MI_QPSK_BLER_MAX_ID = 12; // MI_QPSK_MAX_ID + 3 RETX
-  /// MI 16QAM BLER maximum ID
-  const uint16_t MI_16QAM_BLER_MAX_ID = 22;
-  /// MI 64QAM BLER maximum ID
-  const uint16_t MI_64QAM_BLER_MAX_ID = 37;
 
 /// TbStats_t structure
 struct TbStats_t
@@ -109,7 +92,32 @@ public:
    * \param miHistory MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
+
+  /**
+   * \brief find the mmib of the specified RBs for all the modulations in a
+   * single pass over the SINR
+   *
+   * Each value is identical to the one returned by Mib for the MCSs of
+   * that modulation, so that the MCS selection loop of LteAmc can evaluate
+   * all the MCSs without looking at the SINR again.
+   *
+   * \param sinr the perceived sinr values in the whole bandwidth
+   * \param map the active RBs for the TB
+   * \return the mmib for each modulation
+   */
+  static LteMibs_t GetMibs (const SpectrumValue& sinr, const std::vector<int>& map);
+
+  /**
+   * \brief run the error-model algorithm for the specified TB, with the mmib
+   * computed by GetMibs
+   * \param mibs the mmib for each modulation
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \param miHistory MI of past transmissions (in case of retx)
+   * \return the TB error rate and MI
+   */
+  static TbStats_t GetTbDecodificationStats (const LteMibs_t& mibs, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
@@ -119,9 +127,16 @@ public:
   static double GetPcfichPdcchError (const SpectrumValue& sinr);
 
 
-//private:
-
-
+private:
+  /**
+   * \brief run the error-model algorithm for the specified TB
+   * \param tbMi the mmib of the TB
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \param miHistory MI of past transmissions (in case of retx)
+   * \return the TB error rate and MI
+   */
+  static TbStats_t GetTbDecodificationStats (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
 
 };
 
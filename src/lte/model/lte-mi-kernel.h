@@ -0,0 +1,178 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_MI_KERNEL_H
+#define LTE_MI_KERNEL_H
+
+#include <vector>
+#include <stdint.h>
+#include <ns3/spectrum-value.h>
+
+
+namespace ns3 {
+
+  /// MI map QPSK size
+  const uint16_t MI_MAP_QPSK_SIZE = 797;
+  /// MI map 16QAM size
+  const uint16_t MI_MAP_16QAM_SIZE = 994;
+  /// MI map 64QAM size
+  const uint16_t MI_MAP_64QAM_SIZE = 752;
+  /// MI QPSK maximum ID
+  const uint16_t MI_QPSK_MAX_ID = 9;
+  /// MI 16QAM maximum ID
+  const uint16_t MI_16QAM_MAX_ID = 16;
+  /// MI 64QAM maximum ID
+  const uint16_t MI_64QAM_MAX_ID = 28;  // 29,30 and 31 are reserved
+  /// MI QPSK BLER maximum ID
+  const uint16_t MI_QPSK_BLER_MAX_ID = 12; // MI_QPSK_MAX_ID + 3 RETX
+  /// MI 16QAM BLER maximum ID
+  const uint16_t MI_16QAM_BLER_MAX_ID = 22;
+  /// MI 64QAM BLER maximum ID
+  const uint16_t MI_64QAM_BLER_MAX_ID = 37;
+
+/// mean mutual information per bit of a set of RBs for each modulation
+struct LteMibs_t
+{
+  double qpsk;  ///< MI with QPSK (MCS 0 to 9)
+  double qam16; ///< MI with 16-QAM (MCS 10 to 16)
+  double qam64; ///< MI with 64-QAM (MCS 17 to 28)
+};
+
+/**
+ * \ingroup lte
+ *
+ * The tables and the computations of the mutual information based error
+ * model which are shared by LteMiErrorModel and by the mmWave error model:
+ * the maps from the SINR to the mutual information of each modulation, the
+ * BLER curves of the code blocks as a function of their mean mutual
+ * information per bit (MIB), and the segmentation of a TB in code blocks.
+ *
+ * The MIB of a set of RBs is computed on chunks of RBs: the SINRs of a chunk
+ * are first gathered in a contiguous array, then the indexes in the map of
+ * each modulation are computed on the whole chunk, and the values of the
+ * map are finally summed in the order of the RBs.  The sums are thus
+ * identical to the ones of a loop over the RBs, while the index computation
+ * has no branch and can be vectorized by the compiler.  GetMibs () computes
+ * the MIB of all the modulations with a single pass over the SINR, as needed
+ * by the MCS selection loops of the AMC.
+ */
+class LteMiKernel
+{
+public:
+  /// Modulations of the MCSs
+  enum Modulation
+  {
+    QPSK = 0, ///< MCS 0 to 9
+    QAM16,    ///< MCS 10 to 16
+    QAM64     ///< MCS 17 to 28
+  };
+
+  /// Segmentation of a TB in code blocks, according to sec 5.1.2 of TS 36.212
+  struct CodeBlocks
+  {
+    uint32_t B1;     ///< no. of bits of the TB, including the CRCs of the CBs
+    uint32_t C;      ///< no. of codeblocks
+    uint32_t Cplus;  ///< no. of codeblocks with size K+
+    uint32_t Kplus;  ///< size K+ of the larger codeblocks
+    uint32_t Cminus; ///< no. of codeblocks with size K-
+    uint32_t Kminus; ///< size K- of the smaller codeblocks
+  };
+
+  /**
+   * \param mcs the MCS
+   * \return the modulation of the MCS
+   */
+  static Modulation GetModulation (uint8_t mcs);
+
+  /**
+   * \brief map a linear SINR to the mutual information of a modulation
+   * \param sinrLin the linear SINR
+   * \param mod the modulation
+   * \return the mutual information
+   */
+  static double GetMi (double sinrLin, Modulation mod);
+
+  /**
+   * \brief find the mmib (mean mutual information per bit) of the specified RBs
+   * \param sinr the perceived sinrs in the whole bandwidth
+   * \param map the actives RBs for the TB
+   * \param mod the modulation of the TB
+   * \return the mmib
+   */
+  static double Mib (const SpectrumValue& sinr, const std::vector<int>& map, Modulation mod);
+
+  /**
+   * \brief find the mmib of the specified RBs for all the modulations in a
+   * single pass over the SINR
+   *
+   * Each value is identical to the one returned by Mib for that modulation.
+   *
+   * \param sinr the perceived sinrs in the whole bandwidth
+   * \param map the actives RBs for the TB
+   * \return the mmib for each modulation
+   */
+  static LteMibs_t GetMibs (const SpectrumValue& sinr, const std::vector<int>& map);
+
+  /**
+   * \param mibs the mmib for each modulation
+   * \param mcs the MCS of the TB
+   * \return the mmib for the modulation of mcs
+   */
+  static double GetMibForMcs (const LteMibs_t& mibs, uint8_t mcs);
+
+  /**
+   * \brief map the mmib (mean mutual information per bit) to the error rate
+   * of a code block
+   *
+   * For the CB sizes without a curve for the ECR, the curve of the lowest
+   * larger CB size is used, for removing CB size quantization errors.
+   *
+   * \param mib mean mutual information per bit of a code-block
+   * \param ecrId Effective Code Rate ID
+   * \param cbSize the size of the CB
+   * \return the code block error rate
+   */
+  static double MappingMiBler (double mib, uint8_t ecrId, uint32_t cbSize);
+
+  /**
+   * \brief segment a TB in code blocks
+   * \param tbBits the size of the TB, in bits
+   * \return the code blocks of the TB
+   */
+  static CodeBlocks SegmentTb (uint32_t tbBits);
+
+  /**
+   * \param mib the mmib of the TB
+   * \param ecrId Effective Code Rate ID
+   * \param cbs the code blocks of the TB, as returned by SegmentTb
+   * \return the TB error rate, i.e., the probability that any of its
+   * code blocks is in error
+   */
+  static double GetTbBler (double mib, uint8_t ecrId, const CodeBlocks& cbs);
+
+  /**
+   * \brief inverse of the QPSK map, used to get the effective SINR of a
+   * control channel from its MI
+   * \param mi the mutual information
+   * \return the SINR of the QPSK map whose MI is the closest to mi
+   */
+  static double GetQpskEffectiveSinr (double mi);
+};
+
+
+} // namespace ns3
+
+#endif /* LTE_MI_KERNEL_H */
@@ -199,19 +199,14 @@ LtePhy::SetMacPdu (Ptr<Packet> p)
 Ptr<PacketBurst>
 LtePhy::GetPacketBurst (void)
 {
-  if (m_packetBurstQueue.at (0)->GetSize () > 0)
+  Ptr<PacketBurst> ret;
+  if (m_packetBurstQueue.front ()->GetSize () > 0)
     {
-      Ptr<PacketBurst> ret = m_packetBurstQueue.at (0)->Copy ();
-      m_packetBurstQueue.erase (m_packetBurstQueue.begin ());
-      m_packetBurstQueue.push_back (CreateObject <PacketBurst> ());
-      return (ret);
-    }
-  else
-    {
-      m_packetBurstQueue.erase (m_packetBurstQueue.begin ());
-      m_packetBurstQueue.push_back (CreateObject <PacketBurst> ());
-      return (0);
+      ret = m_packetBurstQueue.front ()->Copy ();
     }
+  m_packetBurstQueue.pop_front ();
+  m_packetBurstQueue.push_back (CreateObject <PacketBurst> ());
+  return (ret);
 }
 
 
@@ -227,22 +222,11 @@ std::list<Ptr<LteControlMessage> >
 LtePhy::GetControlMessages (void)
 {
   NS_LOG_FUNCTION (this);
-  if (m_controlMessagesQueue.at (0).size () > 0)
-    {
-      std::list<Ptr<LteControlMessage> > ret = m_controlMessagesQueue.at (0);
-      m_controlMessagesQueue.erase (m_controlMessagesQueue.begin ());
-      std::list<Ptr<LteControlMessage> > newlist;
-      m_controlMessagesQueue.push_back (newlist);
-      return (ret);
-    }
-  else
-    {
-      m_controlMessagesQueue.erase (m_controlMessagesQueue.begin ());
-      std::list<Ptr<LteControlMessage> > newlist;
-      m_controlMessagesQueue.push_back (newlist);
-      std::list<Ptr<LteControlMessage> > emptylist;
-      return (emptylist);
-    }
+  std::list<Ptr<LteControlMessage> > ret;
+  ret.swap (m_controlMessagesQueue.front ());
+  m_controlMessagesQueue.pop_front ();
+  m_controlMessagesQueue.push_back (std::list<Ptr<LteControlMessage> > ());
+  return (ret);
 }
 
 
@@ -38,6 +38,7 @@
 #include <ns3/spectrum-interference.h>
 #include <ns3/generic-phy.h>
 #include <ns3/lte-spectrum-phy.h>
+#include <deque>
 
 namespace ns3 {
 
@@ -290,9 +291,9 @@ protected:
   uint32_t m_ulEarfcn;
 
   /// A queue of packet bursts to be sent.
-  std::vector< Ptr<PacketBurst> > m_packetBurstQueue;
+  std::deque< Ptr<PacketBurst> > m_packetBurstQueue;
   /// A queue of control messages to be sent.
-  std::vector< std::list<Ptr<LteControlMessage> > > m_controlMessagesQueue;
+  std::deque< std::list<Ptr<LteControlMessage> > > m_controlMessagesQueue;
   /**
    * Delay between MAC and channel layer in terms of TTIs. It is the delay that
    * occurs between a scheduling decision in the MAC and the actual start of
@@ -521,7 +521,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
                     }
 
                   NS_LOG_INFO ("Move SN = " << seqNumberValue << " back to txedBuffer");
-                  m_txedBuffer.at (seqNumberValue).m_pdu = m_retxBuffer.at (seqNumberValue).m_pdu->Copy ();
+                  m_txedBuffer.at (seqNumberValue).m_pdu = m_retxBuffer.at (seqNumberValue).m_pdu;
                   m_txedBuffer.at (seqNumberValue).m_retxCount = m_retxBuffer.at (seqNumberValue).m_retxCount;
                   NS_ASSERT_MSG(m_txedBuffer.at (seqNumberValue).m_pdu != 0, "Just inserted an invalid pointer");
                   m_txedBufferSize += m_txedBuffer.at (seqNumberValue).m_pdu->GetSize ();
@@ -715,7 +715,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   }
 
 
-  Ptr<Packet> packet = Create<Packet> ();
+  Ptr<Packet> packet;
   LteRlcAmHeader rlcAmHeader;
   rlcAmHeader.SetDataPdu ();
 
@@ -747,7 +747,8 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
     m_txonBufferSize += tempP->GetSize ();
   }
 
-  Ptr<Packet> firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
+  // The SDU is removed from the buffer, so it is segmented in place
+  Ptr<Packet> firstSegment = *(m_txonBuffer.begin ());
 
   // LL HO
   // tricky: store the incomplete Rlc SDU for forwarding to
@@ -757,12 +758,12 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   // store complete the last complete SDU of the txonBuffer.
   if (!is_fragmented){
     NS_LOG_DEBUG ("Last complete SDU in txonBuffer size = " << firstSegment->GetSize() << " SEQ = " << m_vtS );
-    entireSdu = (*(m_txonBuffer.begin ()))->Copy ();
+    entireSdu = firstSegment->Copy ();
   }
 
   m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
+  m_txonBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -816,7 +817,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               //LL HO Mark the first SDU is txonBuffer is fragmented. This maybe not needed.
               is_fragmented = 1;
 
-              // m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
+              // m_txonBuffer.push_front (firstSegment);
 
               if(m_txonBuffer.empty())
               {
@@ -824,7 +825,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               }
               else
               {
-                m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
+                m_txonBuffer.push_front (firstSegment);
               }
 
               m_txonBufferSize += (*(m_txonBuffer.begin()))->GetSize ();
@@ -939,13 +940,15 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
             m_txonBufferSize += tempP->GetSize ();
           }
 
-          firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
+          firstSegment = *(m_txonBuffer.begin ());
 
           // LL HO
           // New complete SDU is taken from txonBuffer so reset the
-          // status is_fragmented.
+          // status is_fragmented.  The copy of the SDU taken before
+          // segmenting it is shared by m_txedRlcSduBuffer and entireSdu.
           is_fragmented = 0;
-          m_txedRlcSduBuffer.push_back((*(m_txonBuffer.begin()))->Copy());
+          entireSdu = firstSegment->Copy ();
+          m_txedRlcSduBuffer.push_back (entireSdu);
           NS_LOG_DEBUG ("m_txedRlcSduBuffer.size() = " << m_txedRlcSduBuffer.size());
           if (m_txedRlcSduBuffer.size() > 1024){
             NS_LOG_DEBUG ("m_txedRlcSduBuffer.size() = " << m_txedRlcSduBuffer.size() << " clear and resize");
@@ -953,11 +956,8 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
             m_txedRlcSduBuffer.resize(0);
             NS_LOG_DEBUG ("m_txedRlcSduBuffer.size() = " << m_txedRlcSduBuffer.size() << " after clear and resize");
           }
-          // Store the last complete SDU before segmentation in txonBuffer.
-          entireSdu = (*(m_txonBuffer.begin ()))->Copy ();
-
           m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
+          m_txonBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
         }
     }
@@ -991,7 +991,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   // FIRST SEGMENT
   LteRlcSduStatusTag tag;
-  (*it)->RemovePacketTag (tag);
+  (*it)->PeekPacketTag (tag);
   if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
        (tag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
      )
@@ -1002,20 +1002,9 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
     {
       framingInfo |= LteRlcAmHeader::NO_FIRST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
-
-  // Add all SDUs (in DataField) to the Packet
-  while (it < dataField.end ())
-    {
-      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
-
-      packet->AddAtEnd (*it);
-      it++;
-    }
 
   // LAST SEGMENT (Note: There could be only one and be the first one)
-  it--;
-  (*it)->RemovePacketTag (tag);
+  dataField.back ()->PeekPacketTag (tag);
   if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
         (tag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT) )
     {
@@ -1025,7 +1014,19 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
     {
       framingInfo |= LteRlcAmHeader::NO_LAST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
+
+  // Add all SDUs (in DataField) to the Packet.  The SDUs and segments of
+  // the DataField are not referenced elsewhere, so the PDU is built on
+  // the first one, without its packet tags, instead of on a new packet.
+  NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
+  packet = *it;
+  packet->RemoveAllPacketTags ();
+  for (it++; it < dataField.end (); it++)
+    {
+      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
+
+      packet->AddAtEnd (*it);
+    }
 
   // Set the FramingInfo flag after the calculation
   rlcAmHeader.SetFramingInfo (framingInfo);
@@ -1105,14 +1106,13 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   m_macSapProvider->TransmitPdu (params);
 }
 
-std::vector < Ptr<Packet> >
+std::deque < Ptr<Packet> >
 LteRlcAm::GetTxBuffer()
 {
-  std::vector < Ptr<Packet> > toBeReturned;
+  std::deque < Ptr<Packet> > toBeReturned;
   if(!m_enableAqm)
   {
-    toBeReturned.insert(toBeReturned.begin(), m_txonBuffer.begin(), m_txonBuffer.end());
-    m_txonBuffer.clear();
+    toBeReturned.swap(m_txonBuffer);
     m_txonBufferSize = 0;
   }
   else
@@ -1207,7 +1207,7 @@ LteRlcAm::DoNotifyDlHarqDeliveryFailure (uint8_t harqId)
   if (m_txedBuffer.at (seqNumberValue).m_pdu != 0)
   {
     NS_LOG_INFO ("Move SN = " << seqNumberValue << " to retxBuffer");
-    m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu->Copy ();
+    m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu;
     m_retxBuffer.at (seqNumberValue).m_retxCount = m_txedBuffer.at (seqNumberValue).m_retxCount;
     m_retxBufferSize += m_retxBuffer.at (seqNumberValue).m_pdu->GetSize ();
 
@@ -2141,7 +2141,7 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
               if (m_txedBuffer.at (seqNumberValue).m_pdu != 0)
                 {
                   NS_LOG_INFO ("Move SN = " << seqNumberValue << " to retxBuffer");
-                  m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu->Copy ();
+                  m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu;
                   m_retxBuffer.at (seqNumberValue).m_retxCount = m_txedBuffer.at (seqNumberValue).m_retxCount;
                   m_retxBufferSize += m_retxBuffer.at (seqNumberValue).m_pdu->GetSize ();
 
@@ -2841,7 +2841,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
          if ( pduAvailable )
          {
            NS_LOG_INFO ("Move PDU " << sn << " from txedBuffer to retxBuffer");
-           m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu->Copy ();
+           m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu;
            m_retxBuffer.at (sn).m_retxCount = m_txedBuffer.at (sn).m_retxCount;
            m_retxBufferSize += m_retxBuffer.at (sn).m_pdu->GetSize ();
 
@@ -2860,7 +2860,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
          if ( pduAvailable )
          {
            NS_LOG_INFO ("Move PDU " << sn << " from txedBuffer to retxBuffer");
-           m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu->Copy ();
+           m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu;
            m_retxBuffer.at (sn).m_retxCount = m_txedBuffer.at (sn).m_retxCount;
            m_retxBufferSize += m_retxBuffer.at (sn).m_pdu->GetSize ();
 
@@ -2877,7 +2877,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
          if ( pduAvailable )
          {
            NS_LOG_INFO ("Move PDU " << sn << " from txedBuffer to retxBuffer");
-           m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu->Copy ();
+           m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu;
            m_retxBuffer.at (sn).m_retxCount = m_txedBuffer.at (sn).m_retxCount;
            m_retxBufferSize += m_retxBuffer.at (sn).m_pdu->GetSize ();
 
@@ -34,6 +34,7 @@
 #include <ns3/lte-pdcp-header.h>
 
 #include <vector>
+#include <deque>
 #include <map>
 #include <fstream>
 #include <string>
@@ -75,7 +76,7 @@ public:
   virtual void DoSendMcPdcpSdu(EpcX2Sap::UeDataParams params);
 
   // LL HO
-  std::vector < Ptr<Packet> > GetTxBuffer();
+  std::deque < Ptr<Packet> > GetTxBuffer();
   uint32_t GetTxBufferSize();
 
   std::vector < RetxPdu > GetTxedBuffer();
@@ -176,7 +177,7 @@ private:
   void BufferSizeTrace();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    std::deque < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
 
     struct RetxSegPdu
     {
@@ -199,7 +199,7 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
      NS_LOG_DEBUG("LteRlcUmLowLat rnti " << m_rnti << " lcid " << m_lcid << " allocated " << txOpParams.bytes << " bufsize " << m_txBufferSize);
    }
 
-  Ptr<Packet> packet = Create<Packet> ();
+  Ptr<Packet> packet;
   LteRlcHeader rlcHeader;
 
   // Build Data field
@@ -222,10 +222,11 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
   NS_LOG_LOGIC ("First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
+  // The SDU is removed from the buffer, so it is segmented in place
+  Ptr<Packet> firstSegment = *(m_txBuffer.begin ());
   m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
+  m_txBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -273,7 +274,7 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
+              m_txBuffer.push_front (firstSegment);
               m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
@@ -376,9 +377,9 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txBuffer.begin ()))->Copy ();
+          firstSegment = *(m_txBuffer.begin ());
           m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
+          m_txBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
         }
 
@@ -395,7 +396,7 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
 
   // FIRST SEGMENT
   LteRlcSduStatusTag tag;
-  (*it)->RemovePacketTag (tag);
+  (*it)->PeekPacketTag (tag);
   if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
         (tag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT) )
     {
@@ -405,19 +406,9 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
     {
       framingInfo |= LteRlcHeader::NO_FIRST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
-
-  while (it < dataField.end ())
-    {
-      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
-
-      packet->AddAtEnd (*it);
-      it++;
-    }
 
   // LAST SEGMENT (Note: There could be only one and be the first one)
-  it--;
-  (*it)->RemovePacketTag (tag);
+  dataField.back ()->PeekPacketTag (tag);
   if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
         (tag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT) )
     {
@@ -427,7 +418,19 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
     {
       framingInfo |= LteRlcHeader::NO_LAST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
+
+  // The SDUs and segments of the DataField are not referenced elsewhere,
+  // so the PDU is built on the first one, without its packet tags,
+  // instead of on a new packet.
+  NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
+  packet = *it;
+  packet->RemoveAllPacketTags ();
+  for (it++; it < dataField.end (); it++)
+    {
+      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
+
+      packet->AddAtEnd (*it);
+    }
 
   rlcHeader.SetFramingInfo (framingInfo);
 
@@ -469,7 +472,7 @@ LteRlcUmLowLat::DoNotifyHarqDeliveryFailure ()
   NS_LOG_FUNCTION (this);
 }
 
-std::vector < Ptr<Packet> >
+const std::deque < Ptr<Packet> >&
 LteRlcUmLowLat::GetTxBuffer()
 {
   return m_txBuffer;
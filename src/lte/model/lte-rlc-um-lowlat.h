@@ -66,7 +66,7 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters params);
 
-  std::vector < Ptr<Packet> > GetTxBuffer();
+  const std::deque < Ptr<Packet> >& GetTxBuffer();
   uint32_t GetTxBufferSize()
   {
     return m_txBufferSize;
@@ -89,7 +89,7 @@ private:
 private:
   uint32_t m_maxTxBufferSize;
   uint32_t m_txBufferSize;
-  std::vector < Ptr<Packet> > m_txBuffer;       // Transmission buffer
+  std::deque < Ptr<Packet> > m_txBuffer;       // Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; // Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     // Reassembling buffer
 
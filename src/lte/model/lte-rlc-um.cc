@@ -187,10 +187,11 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   NS_LOG_LOGIC ("First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
+  // The SDU is removed from the buffer, so it is segmented in place
+  Ptr<Packet> firstSegment = *(m_txBuffer.begin ());
   m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
+  m_txBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -238,7 +239,7 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
+              m_txBuffer.push_front (firstSegment);
               m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
@@ -341,9 +342,9 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txBuffer.begin ()))->Copy ();
+          firstSegment = *(m_txBuffer.begin ());
           m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
+          m_txBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
         }
 
@@ -435,7 +436,7 @@ LteRlcUm::DoNotifyHarqDeliveryFailure ()
   NS_LOG_FUNCTION (this);
 }
 
-std::vector < Ptr<Packet> >
+const std::deque < Ptr<Packet> >&
 LteRlcUm::GetTxBuffer()
 {
   return m_txBuffer;
@@ -31,6 +31,7 @@
 
 #include <ns3/event-id.h>
 #include <map>
+#include <deque>
 
 namespace ns3 {
 
@@ -72,7 +73,7 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams);
 
-  std::vector < Ptr<Packet> > GetTxBuffer();
+  const std::deque < Ptr<Packet> >& GetTxBuffer();
   uint32_t GetTxBufferSize()
   {
     return m_txBufferSize;
@@ -116,7 +117,7 @@ private:
 private:
   uint32_t m_maxTxBufferSize; ///< maximum transmit buffer status
   uint32_t m_txBufferSize; ///< transmit buffer size
-  std::vector < Ptr<Packet> > m_txBuffer;       ///< Transmission buffer
+  std::deque < Ptr<Packet> > m_txBuffer;       ///< Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
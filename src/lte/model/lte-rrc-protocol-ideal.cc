@@ -28,6 +28,8 @@
 #include <ns3/node-list.h>
 #include <ns3/node.h>
 #include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/trace-source-accessor.h>
 
 #include "lte-rrc-protocol-ideal.h"
 #include "lte-ue-rrc.h"
@@ -41,11 +43,91 @@ NS_LOG_COMPONENT_DEFINE ("LteRrcProtocolIdeal");
 
 static const Time RRC_IDEAL_MSG_DELAY = MicroSeconds (500);
 
+IdealRrcUeToEnbSender::IdealRrcUeToEnbSender (Time delay)
+  : m_delay (delay),
+    m_measurementReportTime (Seconds (-1)),
+    m_measurementReportProvider (0),
+    m_measurementReportRnti (0)
+{
+}
+
+bool
+IdealRrcUeToEnbSender::SendMeasurementReport (LteEnbRrcSapProvider* provider, uint16_t rnti,
+                                              LteRrcSap::MeasurementReport &msg, bool coalesce)
+{
+  if (!coalesce)
+    {
+      Send (&LteEnbRrcSapProvider::RecvMeasurementReport, provider, rnti, msg);
+      return true;
+    }
+
+  // join the open batch if its reports were sent at the same time, to the
+  // same eNB: the batch is delivered when its first report is due, so any
+  // coarser time would deliver the later reports early
+  bool scheduled = false;
+  Time now = Simulator::Now ();
+  if (m_measurementReports == 0
+      || now != m_measurementReportTime
+      || provider != m_measurementReportProvider
+      || rnti != m_measurementReportRnti)
+    {
+      m_measurementReports = Create<IdealRrcMessage<std::list<LteRrcSap::MeasurementReport> > > ();
+      m_measurementReportTime = now;
+      m_measurementReportProvider = provider;
+      m_measurementReportRnti = rnti;
+      Simulator::Schedule (m_delay,
+                           &IdealRrcUeToEnbSender::DeliverMeasurementReports,
+                           provider,
+                           rnti,
+                           m_measurementReports);
+      scheduled = true;
+    }
+  std::list<LteRrcSap::MeasurementReport>& reports = m_measurementReports->Get ();
+  reports.push_back (LteRrcSap::MeasurementReport ());
+  std::swap (reports.back (), msg);
+  return scheduled;
+}
+
+void
+IdealRrcUeToEnbSender::SendNotifySecondaryCellConnected (LteEnbRrcSapProvider* provider, uint16_t rnti,
+                                                         uint16_t mmWaveRnti, uint16_t mmWaveCellId)
+{
+  CloseMeasurementReports ();
+  Simulator::Schedule (m_delay,
+                       &LteEnbRrcSapProvider::RecvRrcSecondaryCellInitialAccessSuccessful,
+                       provider,
+                       rnti,
+                       mmWaveRnti,
+                       mmWaveCellId);
+}
+
+void
+IdealRrcUeToEnbSender::CloseMeasurementReports (void)
+{
+  m_measurementReports = 0;
+}
+
+void
+IdealRrcUeToEnbSender::DeliverMeasurementReports (LteEnbRrcSapProvider* provider, uint16_t rnti,
+                                                  Ptr<IdealRrcMessage<std::list<LteRrcSap::MeasurementReport> > > reports)
+{
+  NS_LOG_FUNCTION (rnti << reports->Get ().size ());
+  for (std::list<LteRrcSap::MeasurementReport>::const_iterator it = reports->Get ().begin ();
+       it != reports->Get ().end (); ++it)
+    {
+      provider->RecvMeasurementReport (rnti, *it);
+    }
+}
+
+
 NS_OBJECT_ENSURE_REGISTERED (LteUeRrcProtocolIdeal);
 
 LteUeRrcProtocolIdeal::LteUeRrcProtocolIdeal ()
   :  m_ueRrcSapProvider (0),
-     m_enbRrcSapProvider (0)
+     m_enbRrcSapProvider (0),
+     m_sender (RRC_IDEAL_MSG_DELAY),
+     m_numMessages (0),
+     m_numEvents (0)
 {
   m_ueRrcSapUser = new MemberLteUeRrcSapUser<LteUeRrcProtocolIdeal> (this);
 }
@@ -60,6 +142,7 @@ LteUeRrcProtocolIdeal::DoDispose ()
   NS_LOG_FUNCTION (this);
   delete m_ueRrcSapUser;
   m_rrc = 0;
+  m_sender.CloseMeasurementReports ();
 }
 
 TypeId
@@ -69,6 +152,20 @@ LteUeRrcProtocolIdeal::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteUeRrcProtocolIdeal> ()
+    .AddAttribute ("CoalesceMeasurementReports",
+                   "If true, the measurement reports sent at the same time "
+                   "are delivered to the eNB by a single event.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteUeRrcProtocolIdeal::m_coalesceMeasurementReports),
+                   MakeBooleanChecker ())
+    .AddTraceSource ("RrcMessages",
+                     "Number of RRC messages sent to the eNB",
+                     MakeTraceSourceAccessor (&LteUeRrcProtocolIdeal::m_numMessages),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("RrcEvents",
+                     "Number of events scheduled to deliver the RRC messages",
+                     MakeTraceSourceAccessor (&LteUeRrcProtocolIdeal::m_numEvents),
+                     "ns3::TracedValueCallback::Uint64")
     ;
   return tid;
 }
@@ -91,6 +188,27 @@ LteUeRrcProtocolIdeal::SetUeRrc (Ptr<LteUeRrc> rrc)
   m_rrc = rrc;
 }
 
+uint64_t
+LteUeRrcProtocolIdeal::GetNumMessages (void) const
+{
+  return m_numMessages;
+}
+
+uint64_t
+LteUeRrcProtocolIdeal::GetNumEvents (void) const
+{
+  return m_numEvents;
+}
+
+template <class T>
+void
+LteUeRrcProtocolIdeal::SendToEnb (void (LteEnbRrcSapProvider::*recv) (uint16_t, T), T &msg)
+{
+  m_numMessages++;
+  m_numEvents++;
+  m_sender.Send (recv, m_enbRrcSapProvider, m_rnti, msg);
+}
+
 void
 LteUeRrcProtocolIdeal::DoSetup (LteUeRrcSapUser::SetupParameters params)
 {
@@ -106,21 +224,13 @@ LteUeRrcProtocolIdeal::DoSendRrcConnectionRequest (LteRrcSap::RrcConnectionReque
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcConnectionRequest,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionRequest, msg);
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendRrcConnectionSetupCompleted (LteRrcSap::RrcConnectionSetupCompleted msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted,
-                       m_enbRrcSapProvider,
-           m_rnti,
-           msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted, msg);
 }
 
 void
@@ -131,52 +241,37 @@ LteUeRrcProtocolIdeal::DoSendRrcConnectionReconfigurationCompleted (LteRrcSap::R
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted, msg);
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentRequest (LteRrcSap::RrcConnectionReestablishmentRequest msg)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest,
-                       m_enbRrcSapProvider,
-           m_rnti,
-                        msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest, msg);
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentComplete (LteRrcSap::RrcConnectionReestablishmentComplete msg)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete,
-                       m_enbRrcSapProvider,
-           m_rnti,
-msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete, msg);
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendMeasurementReport (LteRrcSap::MeasurementReport msg)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvMeasurementReport,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+  m_numMessages++;
+  if (m_sender.SendMeasurementReport (m_enbRrcSapProvider, m_rnti, msg, m_coalesceMeasurementReports))
+    {
+      m_numEvents++;
+    }
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendNotifySecondaryCellConnected (uint16_t mmWaveRnti, uint16_t mmWaveCellId)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcSecondaryCellInitialAccessSuccessful,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        mmWaveRnti,
-                        mmWaveCellId);
+  m_numMessages++;
+  m_numEvents++;
+  m_sender.SendNotifySecondaryCellConnected (m_enbRrcSapProvider, m_rnti, mmWaveRnti, mmWaveCellId);
 }
 
 void
@@ -224,7 +319,9 @@ uint16_t cellId = m_rrc->GetCellId ();
 NS_OBJECT_ENSURE_REGISTERED (LteEnbRrcProtocolIdeal);
 
 LteEnbRrcProtocolIdeal::LteEnbRrcProtocolIdeal ()
-  :  m_enbRrcSapProvider (0)
+  :  m_enbRrcSapProvider (0),
+     m_numMessages (0),
+     m_numEvents (0)
 {
   NS_LOG_FUNCTION (this);
   m_enbRrcSapUser = new MemberLteEnbRrcSapUser<LteEnbRrcProtocolIdeal> (this);
@@ -249,6 +346,14 @@ LteEnbRrcProtocolIdeal::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteEnbRrcProtocolIdeal> ()
+    .AddTraceSource ("RrcMessages",
+                     "Number of RRC messages sent to the UEs",
+                     MakeTraceSourceAccessor (&LteEnbRrcProtocolIdeal::m_numMessages),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("RrcEvents",
+                     "Number of events scheduled to deliver the RRC messages",
+                     MakeTraceSourceAccessor (&LteEnbRrcProtocolIdeal::m_numEvents),
+                     "ns3::TracedValueCallback::Uint64")
     ;
   return tid;
 }
@@ -271,6 +376,32 @@ LteEnbRrcProtocolIdeal::SetCellId (uint16_t cellId)
   m_cellId = cellId;
 }
 
+uint64_t
+LteEnbRrcProtocolIdeal::GetNumMessages (void) const
+{
+  return m_numMessages;
+}
+
+uint64_t
+LteEnbRrcProtocolIdeal::GetNumEvents (void) const
+{
+  return m_numEvents;
+}
+
+template <class T>
+void
+LteEnbRrcProtocolIdeal::SendToUe (void (LteUeRrcSapProvider::*recv) (T), LteUeRrcSapProvider* provider,
+                                  Ptr<IdealRrcMessage<T> > msg)
+{
+  m_numMessages++;
+  m_numEvents++;
+  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
+                       &IdealRrcMessage<T>::DeliverToUe,
+                       recv,
+                       provider,
+                       msg);
+}
+
 LteUeRrcSapProvider*
 LteEnbRrcProtocolIdeal::GetUeRrcSapProvider (uint16_t rnti)
 {
@@ -342,6 +473,8 @@ void
 LteEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::SystemInformation msg)
 {
   NS_LOG_FUNCTION (this << cellId);
+  // the UEs share the message in transit
+  Ptr<IdealRrcMessage<LteRrcSap::SystemInformation> > si = IdealRrcMessage<LteRrcSap::SystemInformation>::Take (msg);
   // walk list of all nodes to get UEs with this cellId
   Ptr<LteUeRrc> ueRrc;
   for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
@@ -358,11 +491,10 @@ LteEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::Sys
               if (ueRrc->GetCellId () == cellId)
                 {
                   NS_LOG_LOGIC ("sending SI to IMSI " << ueDev->GetImsi ());
-                  ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
-                  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                                       &LteUeRrcSapProvider::RecvSystemInformation,
-                                       ueRrc->GetLteUeRrcSapProvider (),
-                                       msg);
+                  ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (si->Get ());
+                  SendToUe (&LteUeRrcSapProvider::RecvSystemInformation,
+                            ueRrc->GetLteUeRrcSapProvider (),
+                            si);
                 }
             }
         }
@@ -372,69 +504,64 @@ LteEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::Sys
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionSetup (uint16_t rnti, LteRrcSap::RrcConnectionSetup msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionSetup,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionSetup,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionSetup>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReconfiguration (uint16_t rnti, LteRrcSap::RrcConnectionReconfiguration msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReconfiguration>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishment (uint16_t rnti, LteRrcSap::RrcConnectionReestablishment msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReestablishment>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishmentReject (uint16_t rnti, LteRrcSap::RrcConnectionReestablishmentReject msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReestablishmentReject>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionRelease (uint16_t rnti, LteRrcSap::RrcConnectionRelease msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionRelease,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionRelease,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionRelease>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReject (uint16_t rnti, LteRrcSap::RrcConnectionReject msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionReject,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReject,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReject>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionSwitch (uint16_t rnti, LteRrcSap::RrcConnectionSwitch msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-           &LteUeRrcSapProvider::RecvRrcConnectionSwitch,
-           GetUeRrcSapProvider (rnti),
-           msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionSwitch,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionSwitch>::Take (msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectToMmWave (uint16_t rnti, uint16_t mmWaveCellId)
 {
+  m_numMessages++;
+  m_numEvents++;
   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
            &LteUeRrcSapProvider::RecvRrcConnectToMmWave,
            GetUeRrcSapProvider (rnti),
@@ -536,7 +663,7 @@ LteEnbRrcProtocolIdeal::DoEncodeHandoverPreparationInformation (LteRrcSap::Hando
   uint32_t msgId = ++g_handoverPreparationInfoMsgIdCounter;
   NS_ASSERT_MSG (g_handoverPreparationInfoMsgMap.find (msgId) == g_handoverPreparationInfoMsgMap.end (), "msgId " << msgId << " already in use");
   NS_LOG_INFO (" encoding msgId = " << msgId);
-  g_handoverPreparationInfoMsgMap.insert (std::pair<uint32_t, LteRrcSap::HandoverPreparationInfo> (msgId, msg));
+  std::swap (g_handoverPreparationInfoMsgMap[msgId], msg);
   IdealHandoverPreparationInfoHeader h;
   h.SetMsgId (msgId);
   Ptr<Packet> p = Create<Packet> ();
@@ -553,7 +680,8 @@ LteEnbRrcProtocolIdeal::DoDecodeHandoverPreparationInformation (Ptr<Packet> p)
   NS_LOG_INFO (" decoding msgId = " << msgId);
   std::map<uint32_t, LteRrcSap::HandoverPreparationInfo>::iterator it = g_handoverPreparationInfoMsgMap.find (msgId);
   NS_ASSERT_MSG (it != g_handoverPreparationInfoMsgMap.end (), "msgId " << msgId << " not found");
-  LteRrcSap::HandoverPreparationInfo msg = it->second;
+  LteRrcSap::HandoverPreparationInfo msg;
+  std::swap (msg, it->second);
   g_handoverPreparationInfoMsgMap.erase (it);
   return msg;
 }
@@ -643,7 +771,7 @@ LteEnbRrcProtocolIdeal::DoEncodeHandoverCommand (LteRrcSap::RrcConnectionReconfi
   uint32_t msgId = ++g_handoverCommandMsgIdCounter;
   NS_ASSERT_MSG (g_handoverCommandMsgMap.find (msgId) == g_handoverCommandMsgMap.end (), "msgId " << msgId << " already in use");
   NS_LOG_INFO (" encoding msgId = " << msgId);
-  g_handoverCommandMsgMap.insert (std::pair<uint32_t, LteRrcSap::RrcConnectionReconfiguration> (msgId, msg));
+  std::swap (g_handoverCommandMsgMap[msgId], msg);
   IdealHandoverCommandHeader h;
   h.SetMsgId (msgId);
   Ptr<Packet> p = Create<Packet> ();
@@ -660,7 +788,8 @@ LteEnbRrcProtocolIdeal::DoDecodeHandoverCommand (Ptr<Packet> p)
   NS_LOG_INFO (" decoding msgId = " << msgId);
   std::map<uint32_t, LteRrcSap::RrcConnectionReconfiguration>::iterator it = g_handoverCommandMsgMap.find (msgId);
   NS_ASSERT_MSG (it != g_handoverCommandMsgMap.end (), "msgId " << msgId << " not found");
-  LteRrcSap::RrcConnectionReconfiguration msg = it->second;
+  LteRrcSap::RrcConnectionReconfiguration msg;
+  std::swap (msg, it->second);
   g_handoverCommandMsgMap.erase (it);
   return msg;
 }
@@ -28,9 +28,15 @@
 
 #include <stdint.h>
 #include <map>
+#include <list>
+#include <utility>
 
 #include <ns3/ptr.h>
 #include <ns3/object.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/traced-value.h>
 #include <ns3/lte-rrc-sap.h>
 
 namespace ns3 {
@@ -40,6 +46,159 @@ class LteUeRrcSapUser;
 class LteEnbRrcSapProvider;
 class LteUeRrc;
 
+/**
+ * \ingroup lte
+ *
+ * RRC message in transit in an ideal RRC protocol.  The message is moved
+ * into the holder once, and the events delivering it share the holder, so
+ * that scheduling a delivery copies a pointer rather than the message and
+ * its lists; the message is copied only once more, when it is passed to
+ * the SAP of the receiver.
+ */
+template <class T>
+class IdealRrcMessage : public SimpleRefCount<IdealRrcMessage<T> >
+{
+public:
+  /**
+   * Take over the content of a message
+   * \param msg the message, left empty
+   * \returns the message in transit
+   */
+  static Ptr<IdealRrcMessage<T> > Take (T &msg)
+  {
+    Ptr<IdealRrcMessage<T> > p = Create<IdealRrcMessage<T> > ();
+    std::swap (p->m_msg, msg);
+    return p;
+  }
+
+  /**
+   * Deliver a message to the eNB RRC
+   * \param recv the method of the eNB RRC SAP receiving the message
+   * \param provider the eNB RRC SAP
+   * \param rnti the RNTI of the sending UE
+   * \param msg the message in transit
+   */
+  static void DeliverToEnb (void (LteEnbRrcSapProvider::*recv) (uint16_t, T),
+                            LteEnbRrcSapProvider* provider, uint16_t rnti,
+                            Ptr<IdealRrcMessage<T> > msg)
+  {
+    (provider->*recv) (rnti, msg->m_msg);
+  }
+
+  /**
+   * Deliver a message to the UE RRC
+   * \param recv the method of the UE RRC SAP receiving the message
+   * \param provider the UE RRC SAP
+   * \param msg the message in transit
+   */
+  static void DeliverToUe (void (LteUeRrcSapProvider::*recv) (T),
+                           LteUeRrcSapProvider* provider,
+                           Ptr<IdealRrcMessage<T> > msg)
+  {
+    (provider->*recv) (msg->m_msg);
+  }
+
+  /// \returns the message
+  const T& Get (void) const
+  {
+    return m_msg;
+  }
+
+  /// \returns the message
+  T& Get (void)
+  {
+    return m_msg;
+  }
+
+private:
+  T m_msg; ///< the message
+};
+
+
+/**
+ * \ingroup lte
+ *
+ * Schedules the delivery of the RRC messages of a UE to the eNB RRC in an
+ * ideal RRC protocol.  The measurement reports may be coalesced: the
+ * reports sent at the same time to the same eNB, with no other message in
+ * between, are then delivered by a single event.  Any other message closes
+ * the batch, so that the eNB receives the messages in the order they were
+ * sent.
+ */
+class IdealRrcUeToEnbSender
+{
+public:
+  /**
+   * \param delay the delay of the delivery of the messages
+   */
+  IdealRrcUeToEnbSender (Time delay);
+
+  /**
+   * Schedule the delivery of a message
+   * \param recv the method of the eNB RRC SAP receiving the message
+   * \param provider the eNB RRC SAP
+   * \param rnti the RNTI of the sending UE
+   * \param msg the message, left empty
+   */
+  template <class T>
+  void Send (void (LteEnbRrcSapProvider::*recv) (uint16_t, T),
+             LteEnbRrcSapProvider* provider, uint16_t rnti, T &msg)
+  {
+    CloseMeasurementReports ();
+    Simulator::Schedule (m_delay,
+                         &IdealRrcMessage<T>::DeliverToEnb,
+                         recv,
+                         provider,
+                         rnti,
+                         IdealRrcMessage<T>::Take (msg));
+  }
+
+  /**
+   * Schedule the delivery of a measurement report
+   * \param provider the eNB RRC SAP
+   * \param rnti the RNTI of the sending UE
+   * \param msg the report, left empty
+   * \param coalesce whether to join the report to the open batch, if any
+   * \returns true if a delivery event was scheduled, false if the report
+   *          joined the batch of a previous one
+   */
+  bool SendMeasurementReport (LteEnbRrcSapProvider* provider, uint16_t rnti,
+                              LteRrcSap::MeasurementReport &msg, bool coalesce);
+
+  /**
+   * Schedule the delivery of the notification that the UE connected to a
+   * secondary cell
+   * \param provider the eNB RRC SAP
+   * \param rnti the RNTI of the sending UE
+   * \param mmWaveRnti the RNTI of the UE in the secondary cell
+   * \param mmWaveCellId the ID of the secondary cell
+   */
+  void SendNotifySecondaryCellConnected (LteEnbRrcSapProvider* provider, uint16_t rnti,
+                                         uint16_t mmWaveRnti, uint16_t mmWaveCellId);
+
+  /**
+   * Close the open batch of measurement reports, if any: the reports sent
+   * afterwards are delivered by a new event
+   */
+  void CloseMeasurementReports (void);
+
+private:
+  /**
+   * Deliver a batch of measurement reports
+   * \param provider the eNB RRC SAP
+   * \param rnti the RNTI of the sending UE
+   * \param reports the reports
+   */
+  static void DeliverMeasurementReports (LteEnbRrcSapProvider* provider, uint16_t rnti,
+                                         Ptr<IdealRrcMessage<std::list<LteRrcSap::MeasurementReport> > > reports);
+
+  Time m_delay; ///< the delay of the delivery of the messages
+  Ptr<IdealRrcMessage<std::list<LteRrcSap::MeasurementReport> > > m_measurementReports; ///< the open batch of reports, if any
+  Time m_measurementReportTime; ///< the time the reports of the open batch were sent at
+  LteEnbRrcSapProvider* m_measurementReportProvider; ///< the eNB RRC SAP of the open batch
+  uint16_t m_measurementReportRnti; ///< the RNTI of the open batch
+};
+
 
 /**
  * \ingroup lte
@@ -87,6 +246,15 @@ public:
    */
   void SetUeRrc (Ptr<LteUeRrc> rrc);
 
+  /**
+   * \returns the number of RRC messages sent to the eNB
+   */
+  uint64_t GetNumMessages (void) const;
+  /**
+   * \returns the number of events scheduled to deliver them
+   */
+  uint64_t GetNumEvents (void) const;
+
 
 private:
 
@@ -138,12 +306,27 @@ private:
   /// Set ENB RRC SAP provider
   void SetEnbRrcSapProvider ();
 
+  /**
+   * Schedule the delivery of a message to the eNB
+   *
+   * \param recv the method of the eNB RRC SAP receiving the message
+   * \param msg the message, left empty
+   */
+  template <class T>
+  void SendToEnb (void (LteEnbRrcSapProvider::*recv) (uint16_t, T), T &msg);
+
   Ptr<LteUeRrc> m_rrc; ///< the RRC
   uint16_t m_rnti; ///< the RNTI
   LteUeRrcSapProvider* m_ueRrcSapProvider; ///< the UE RRC SAP provider
   LteUeRrcSapUser* m_ueRrcSapUser; ///< the RRC SAP user
   LteEnbRrcSapProvider* m_enbRrcSapProvider; ///< the ENB RRC SAP provider
 
+  bool m_coalesceMeasurementReports; ///< whether the reports sent at the same time are delivered by one event
+  IdealRrcUeToEnbSender m_sender; ///< schedules the delivery of the messages
+
+  TracedValue<uint64_t> m_numMessages; ///< the number of RRC messages sent
+  TracedValue<uint64_t> m_numEvents; ///< the number of delivery events scheduled
+
 };
 
 
@@ -206,6 +389,15 @@ public:
    */
   void SetUeRrcSapProvider (uint16_t rnti, LteUeRrcSapProvider* p);
 
+  /**
+   * \returns the number of RRC messages sent to the UEs
+   */
+  uint64_t GetNumMessages (void) const;
+  /**
+   * \returns the number of events scheduled to deliver them
+   */
+  uint64_t GetNumEvents (void) const;
+
 private:
 
   // methods forwarded from LteEnbRrcSapUser
@@ -308,6 +500,17 @@ private:
    */
   LteRrcSap::RrcConnectionReconfiguration DoDecodeHandoverCommand (Ptr<Packet> p);
 
+  /**
+   * Schedule the delivery of a message to a UE
+   *
+   * \param recv the method of the UE RRC SAP receiving the message
+   * \param provider the UE RRC SAP provider
+   * \param msg the message in transit
+   */
+  template <class T>
+  void SendToUe (void (LteUeRrcSapProvider::*recv) (T), LteUeRrcSapProvider* provider,
+                 Ptr<IdealRrcMessage<T> > msg);
+
 
   uint16_t m_rnti; ///< the RNTI
   uint16_t m_cellId; ///< the cell ID
@@ -315,6 +518,9 @@ private:
   LteEnbRrcSapUser* m_enbRrcSapUser; ///< the ENB RRC SAP user
   std::map<uint16_t, LteUeRrcSapProvider*> m_enbRrcSapProviderMap; ///< the LTE UE RRC SAP provider
 
+  TracedValue<uint64_t> m_numMessages; ///< the number of RRC messages sent
+  TracedValue<uint64_t> m_numEvents; ///< the number of delivery events scheduled
+
 };
 
 
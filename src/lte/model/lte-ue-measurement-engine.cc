@@ -0,0 +1,219 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/lte-ue-measurement-engine.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteUeMeasurementEngine");
+
+namespace {
+
+/**
+ * Compare the cell ID of a measurement
+ * \param el the measurement
+ * \param cellId the cell ID
+ * \return true if the measurement is of a lower cell ID
+ */
+bool
+CellIdLess (const LteUeMeasurementEngine::CellMeasurements& el, uint16_t cellId)
+{
+  return el.cellId < cellId;
+}
+
+} // unnamed namespace
+
+
+LteUeMeasurementEngine::LteUeMeasurementEngine ()
+  : m_cqiSubsampling (false),
+    m_cqiPeriod (MilliSeconds (10)),
+    m_cqiThresholdLinear (std::pow (10.0, 0.1)),
+    m_pendingSinr (0.0),
+    m_cqiEvaluations (0),
+    m_cqiReuses (0)
+{
+  m_p10Cqi.valid = false;
+  m_a30Cqi.valid = false;
+}
+
+void
+LteUeMeasurementEngine::AddRsrp (uint16_t cellId, double rsrp)
+{
+  std::vector<CellMeasurements>::iterator it = std::lower_bound (m_cells.begin (), m_cells.end (), cellId, CellIdLess);
+  if (it == m_cells.end () || it->cellId != cellId)
+    {
+      NS_LOG_LOGIC ("new cell " << cellId);
+      CellMeasurements el;
+      el.cellId = cellId;
+      el.measured = false;
+      it = m_cells.insert (it, el);
+    }
+  if (!it->measured)
+    {
+      // first sample of the filtering period
+      it->measured = true;
+      it->rsrpSum = rsrp;
+      it->rsrpNum = 1;
+      it->rsrqSum = 0;
+      it->rsrqNum = 0;
+    }
+  else
+    {
+      it->rsrpSum += rsrp;
+      it->rsrpNum++;
+    }
+}
+
+bool
+LteUeMeasurementEngine::AddRsrq (uint16_t cellId, double rsrq)
+{
+  std::vector<CellMeasurements>::iterator it = std::lower_bound (m_cells.begin (), m_cells.end (), cellId, CellIdLess);
+  if (it == m_cells.end () || it->cellId != cellId || !it->measured)
+    {
+      return false;
+    }
+  it->rsrqSum += rsrq;
+  it->rsrqNum++;
+  return true;
+}
+
+const std::vector<LteUeMeasurementEngine::CellMeasurements>&
+LteUeMeasurementEngine::GetCells (void) const
+{
+  return m_cells;
+}
+
+void
+LteUeMeasurementEngine::ResetFilter (void)
+{
+  for (std::vector<CellMeasurements>::iterator it = m_cells.begin (); it != m_cells.end (); ++it)
+    {
+      it->measured = false;
+    }
+}
+
+double
+LteUeMeasurementEngine::GetRssi (const SpectrumValue& rsReceivedPower, const SpectrumValue& rsInterferencePower)
+{
+  double rssiSum = 0.0;
+  Values::const_iterator itIntN = rsInterferencePower.ConstValuesBegin ();
+  Values::const_iterator itPj;
+  for (itPj = rsReceivedPower.ConstValuesBegin ();
+       itPj != rsReceivedPower.ConstValuesEnd ();
+       itIntN++, itPj++)
+    {
+      // convert PSD [W/Hz] to linear power [W] for the single RE
+      double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
+      double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
+      rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
+    }
+  return rssiSum;
+}
+
+void
+LteUeMeasurementEngine::SetCqiSubsampling (bool enabled, Time period, double thresholdDb)
+{
+  NS_LOG_FUNCTION (this << enabled << period << thresholdDb);
+  m_cqiSubsampling = enabled;
+  m_cqiPeriod = period;
+  m_cqiThresholdLinear = std::pow (10.0, thresholdDb / 10.0);
+  InvalidateCqi ();
+}
+
+bool
+LteUeMeasurementEngine::IsCqiEvaluationDue (CqiListElement_s::CqiType_e type, const SpectrumValue& sinr)
+{
+  if (!m_cqiSubsampling)
+    {
+      m_cqiEvaluations++;
+      return true;
+    }
+  double sum = 0.0;
+  uint32_t rbNum = 0;
+  for (Values::const_iterator it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
+    {
+      sum += (*it);
+      rbNum++;
+    }
+  m_pendingSinr = (rbNum > 0) ? (sum / rbNum) : 0.0;
+
+  const StoredCqi& stored = GetStoredCqi (type);
+  if (stored.valid
+      && Simulator::Now () < stored.time + m_cqiPeriod
+      && m_pendingSinr <= stored.sinr * m_cqiThresholdLinear
+      && m_pendingSinr * m_cqiThresholdLinear >= stored.sinr)
+    {
+      m_cqiReuses++;
+      return false;
+    }
+  m_cqiEvaluations++;
+  return true;
+}
+
+void
+LteUeMeasurementEngine::StoreCqi (const CqiListElement_s& cqi)
+{
+  if (!m_cqiSubsampling)
+    {
+      return;
+    }
+  StoredCqi& stored = GetStoredCqi (cqi.m_cqiType);
+  stored.valid = true;
+  stored.cqi = cqi;
+  stored.sinr = m_pendingSinr;
+  stored.time = Simulator::Now ();
+}
+
+const CqiListElement_s&
+LteUeMeasurementEngine::GetLastCqi (CqiListElement_s::CqiType_e type) const
+{
+  const StoredCqi& stored = (type == CqiListElement_s::P10) ? m_p10Cqi : m_a30Cqi;
+  NS_ASSERT_MSG (stored.valid, "no CQI to reuse");
+  return stored.cqi;
+}
+
+void
+LteUeMeasurementEngine::InvalidateCqi (void)
+{
+  m_p10Cqi.valid = false;
+  m_a30Cqi.valid = false;
+}
+
+uint64_t
+LteUeMeasurementEngine::GetCqiEvaluations (void) const
+{
+  return m_cqiEvaluations;
+}
+
+uint64_t
+LteUeMeasurementEngine::GetCqiReuses (void) const
+{
+  return m_cqiReuses;
+}
+
+LteUeMeasurementEngine::StoredCqi&
+LteUeMeasurementEngine::GetStoredCqi (CqiListElement_s::CqiType_e type)
+{
+  NS_ASSERT_MSG (type == CqiListElement_s::P10 || type == CqiListElement_s::A30,
+                 "only P10 and A30 CQIs are stored");
+  return (type == CqiListElement_s::P10) ? m_p10Cqi : m_a30Cqi;
+}
+
+} // namespace ns3
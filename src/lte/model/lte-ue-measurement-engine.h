@@ -0,0 +1,167 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_UE_MEASUREMENT_ENGINE_H
+#define LTE_UE_MEASUREMENT_ENGINE_H
+
+#include <ns3/nstime.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/ff-mac-common.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * The measurements done by LteUePhy on the cells it can hear, and the
+ * subsampling of its DL-CQI evaluation.
+ *
+ * The layer-1 filtering of the RSRP and RSRQ keeps a running sum per cell
+ * in an array sorted by cell ID.  The entries are kept at the end of each
+ * filtering period, and only their counters are reset, so that no memory
+ * is allocated in steady state.  The cells are reported in the order of
+ * their ID, as done with the former std::map.
+ *
+ * The RSRQ of all the cells whose PSS is received in a subframe share the
+ * same RSSI, which is thus computed once per subframe by GetRssi (),
+ * instead of once per cell.
+ *
+ * When the subsampling is enabled, a DL-CQI of each type is computed
+ * again only if the last one is older than the subsampling period, or if
+ * the wideband SINR changed by more than the subsampling threshold since
+ * then; otherwise the last CQI of that type is reported again.  The DL-CQI
+ * are reported with the same periodicity, so that the schedulers do not
+ * expire them, while the MI computations of the AMC are skipped.
+ */
+class LteUeMeasurementEngine
+{
+public:
+  /// Summary results of measuring a specific cell. Used for layer-1 filtering.
+  struct CellMeasurements
+  {
+    uint16_t cellId;  ///< cell ID
+    bool measured;    ///< Whether the cell was measured in the current filtering period.
+    double rsrpSum;   ///< Sum of RSRP sample values, in dBm.
+    uint8_t rsrpNum;  ///< Number of RSRP samples.
+    double rsrqSum;   ///< Sum of RSRQ sample values, in dB.
+    uint8_t rsrqNum;  ///< Number of RSRQ samples.
+  };
+
+  LteUeMeasurementEngine ();
+
+  /**
+   * Add an RSRP sample of a cell, measured on its PSS
+   * \param cellId the cell ID
+   * \param rsrp the RSRP, in dBm
+   */
+  void AddRsrp (uint16_t cellId, double rsrp);
+
+  /**
+   * Add an RSRQ sample of a cell
+   * \param cellId the cell ID
+   * \param rsrq the RSRQ, in dB
+   * \return false if no RSRP of the cell was measured in the current
+   * filtering period, in which case the sample is discarded
+   */
+  bool AddRsrq (uint16_t cellId, double rsrq);
+
+  /**
+   * \return the cells measured so far, sorted by cell ID; the cells which
+   * were not measured in the current filtering period must be skipped
+   */
+  const std::vector<CellMeasurements>& GetCells (void) const;
+
+  /// Start a new filtering period
+  void ResetFilter (void);
+
+  /**
+   * \param rsReceivedPower the PSD of the RS of the serving cell
+   * \param rsInterferencePower the PSD of the interference plus noise on the RS
+   * \return the RSSI used for the RSRQ, in W
+   */
+  static double GetRssi (const SpectrumValue& rsReceivedPower, const SpectrumValue& rsInterferencePower);
+
+  /**
+   * Configure the subsampling of the DL-CQI
+   * \param enabled whether the subsampling is enabled
+   * \param period the maximum age of a reused CQI
+   * \param thresholdDb the change of the wideband SINR, in dB, above which
+   * a CQI is always computed again
+   */
+  void SetCqiSubsampling (bool enabled, Time period, double thresholdDb);
+
+  /**
+   * \param type the type of the CQI
+   * \param sinr the SINR used for the CQI
+   * \return true if the CQI must be computed, false if the last one
+   * returned by GetLastCqi can be reported again
+   */
+  bool IsCqiEvaluationDue (CqiListElement_s::CqiType_e type, const SpectrumValue& sinr);
+
+  /**
+   * Store a computed CQI, for reusing it.  The wideband SINR passed to the
+   * last call to IsCqiEvaluationDue is associated to the CQI.
+   * \param cqi the CQI
+   */
+  void StoreCqi (const CqiListElement_s& cqi);
+
+  /**
+   * \param type the type of the CQI
+   * \return the last CQI of that type
+   */
+  const CqiListElement_s& GetLastCqi (CqiListElement_s::CqiType_e type) const;
+
+  /// Forget the stored CQIs, e.g., when the RNTI or the bandwidth change
+  void InvalidateCqi (void);
+
+  /// \return the number of CQI computed
+  uint64_t GetCqiEvaluations (void) const;
+  /// \return the number of CQI reused
+  uint64_t GetCqiReuses (void) const;
+
+private:
+  /// Stored CQI of a type
+  struct StoredCqi
+  {
+    bool valid;           ///< whether the CQI can be reused
+    CqiListElement_s cqi; ///< the CQI
+    double sinr;          ///< wideband SINR of the CQI, linear
+    Time time;            ///< time of the computation of the CQI
+  };
+
+  /**
+   * \param type the type of the CQI
+   * \return the stored CQI of that type
+   */
+  StoredCqi& GetStoredCqi (CqiListElement_s::CqiType_e type);
+
+  std::vector<CellMeasurements> m_cells; ///< measured cells, sorted by cell ID
+
+  bool m_cqiSubsampling;       ///< whether the CQI subsampling is enabled
+  Time m_cqiPeriod;            ///< maximum age of a reused CQI
+  double m_cqiThresholdLinear; ///< SINR ratio above which a CQI is computed
+  StoredCqi m_p10Cqi;          ///< last wideband CQI
+  StoredCqi m_a30Cqi;          ///< last subband CQI
+  double m_pendingSinr;        ///< wideband SINR of the CQI being computed
+  uint64_t m_cqiEvaluations;   ///< number of CQI computed
+  uint64_t m_cqiReuses;        ///< number of CQI reused
+};
+
+} // namespace ns3
+
+#endif /* LTE_UE_MEASUREMENT_ENGINE_H */
@@ -288,6 +288,25 @@ LteUePhy::GetTypeId (void)
                    TimeValue (MilliSeconds (200)),
                    MakeTimeAccessor (&LteUePhy::m_ueMeasurementsFilterPeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("CqiSubsampling",
+                   "If true, the DL-CQIs are computed again only when they are "
+                   "older than CqiSubsamplingPeriod or when the wideband SINR "
+                   "changed by more than CqiSubsamplingThreshold; otherwise the "
+                   "last ones are reported again.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteUePhy::m_cqiSubsampling),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CqiSubsamplingPeriod",
+                   "Maximum age of a reported DL-CQI when CqiSubsampling is enabled.",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&LteUePhy::m_cqiSubsamplingPeriod),
+                   MakeTimeChecker ())
+    .AddAttribute ("CqiSubsamplingThreshold",
+                   "Change of the wideband SINR [dB] which triggers the computation "
+                   "of a DL-CQI when CqiSubsampling is enabled.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&LteUePhy::m_cqiSubsamplingThreshold),
+                   MakeDoubleChecker<double> (0.0))
     .AddAttribute ("DownlinkCqiPeriodicity",
                    "Periodicity in milliseconds for reporting the"
                    "wideband and subband downlink CQIs to the eNB",
@@ -334,6 +353,7 @@ LteUePhy::DoInitialize ()
     {
       Simulator::ScheduleNow (&LteUePhy::SubframeIndication, this, 1, 1);
     }
+  m_measurements.SetCqiSubsampling (m_cqiSubsampling, m_cqiSubsamplingPeriod, m_cqiSubsamplingThreshold);
   LtePhy::DoInitialize ();
 }
 
@@ -420,6 +440,12 @@ LteUePhy::GetUlSpectrumPhy () const
   return m_uplinkSpectrumPhy;
 }
 
+const LteUeMeasurementEngine&
+LteUePhy::GetMeasurementEngine () const
+{
+  return m_measurements;
+}
+
 void
 LteUePhy::DoSendMacPdu (Ptr<Packet> p)
 {
@@ -562,25 +588,13 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
       // measure instantaneous RSRQ now
       NS_ASSERT_MSG (m_rsInterferencePowerUpdated, " RS interference power info obsolete");
 
+      // the RSSI is the same for all the cells
+      double rssiSum = LteUeMeasurementEngine::GetRssi (m_rsReceivedPower, m_rsInterferencePower);
+      uint16_t rbNum = m_rsReceivedPower.GetValuesN ();
+
       std::list <PssElement>::iterator itPss = m_pssList.begin ();
       while (itPss != m_pssList.end ())
         {
-          uint16_t rbNum = 0;
-          double rssiSum = 0.0;
-
-          Values::const_iterator itIntN = m_rsInterferencePower.ConstValuesBegin ();
-          Values::const_iterator itPj = m_rsReceivedPower.ConstValuesBegin ();
-          for (itPj = m_rsReceivedPower.ConstValuesBegin ();
-               itPj != m_rsReceivedPower.ConstValuesEnd ();
-               itIntN++, itPj++)
-            {
-              rbNum++;
-              // convert PSD [W/Hz] to linear power [W] for the single RE
-              double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
-              double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
-              rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
-            }
-
           NS_ASSERT (rbNum == (*itPss).nRB);
           double rsrq_dB = 10 * log10 ((*itPss).pssPsdSum / rssiSum);
 
@@ -589,14 +603,7 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
               NS_LOG_INFO (this << " PSS RNTI " << m_rnti << " cellId " << m_cellId
                                 << " has RSRQ " << rsrq_dB << " and RBnum " << rbNum);
               // store measurements
-              std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap;
-              itMeasMap = m_ueMeasurementsMap.find ((*itPss).cellId);
-              if (itMeasMap != m_ueMeasurementsMap.end ())
-                {
-                  (*itMeasMap).second.rsrqSum += rsrq_dB;
-                  (*itMeasMap).second.rsrqNum++;
-                }
-              else
+              if (!m_measurements.AddRsrq ((*itPss).cellId, rsrq_dB))
                 {
                   NS_LOG_WARN ("race condition of bug 2091 occurred");
                 }
@@ -723,7 +730,15 @@ LteUePhy::CreateDlCqiFeedbackMessage (const SpectrumValue& sinr)
   Ptr<DlCqiLteControlMessage> msg = Create<DlCqiLteControlMessage> ();
   CqiListElement_s dlcqi;
   std::vector<int> cqi;
-  if (Simulator::Now () > m_p10CqiLast + m_p10CqiPeriodicity)
+  bool p10Due = Simulator::Now () > m_p10CqiLast + m_p10CqiPeriodicity;
+  if ((p10Due || Simulator::Now () > m_a30CqiLast + m_a30CqiPeriodicity)
+      && !m_measurements.IsCqiEvaluationDue (p10Due ? CqiListElement_s::P10 : CqiListElement_s::A30, sinr))
+    {
+      // report again the last CQI of this type
+      msg->SetDlCqi (m_measurements.GetLastCqi (p10Due ? CqiListElement_s::P10 : CqiListElement_s::A30));
+      return msg;
+    }
+  if (p10Due)
     {
       cqi = m_amc->CreateCqiFeedbacks (newSinr, m_dlBandwidth);
 
@@ -761,6 +776,7 @@ LteUePhy::CreateDlCqiFeedbackMessage (const SpectrumValue& sinr)
       //NS_LOG_DEBUG (this << " Generate P10 CQI feedback " << (uint16_t) cqiSum / activeSubChannels);
       dlcqi.m_wbPmi = 0; // not yet used
       // dl.cqi.m_sbMeasResult others CQI report modes: not yet implemented
+      m_measurements.StoreCqi (dlcqi);
     }
   else if (Simulator::Now () > m_a30CqiLast + m_a30CqiPeriodicity)
     {
@@ -801,6 +817,7 @@ LteUePhy::CreateDlCqiFeedbackMessage (const SpectrumValue& sinr)
       //dlcqi.m_wbCqi.push_back ((uint16_t) cqiSum / nbSubChannels);
       dlcqi.m_wbPmi = 0; // not yet used
       dlcqi.m_sbMeasResult = rbgMeas;
+      m_measurements.StoreCqi (dlcqi);
     }
 
   msg->SetDlCqi (dlcqi);
@@ -816,38 +833,42 @@ LteUePhy::ReportUeMeasurements ()
 
   LteUeCphySapUser::UeMeasurementsParameters ret;
 
-  std::map <uint16_t, UeMeasurementsElement>::iterator it;
-  for (it = m_ueMeasurementsMap.begin (); it != m_ueMeasurementsMap.end (); it++)
+  std::vector<LteUeMeasurementEngine::CellMeasurements>::const_iterator it;
+  for (it = m_measurements.GetCells ().begin (); it != m_measurements.GetCells ().end (); it++)
     {
-      double avg_rsrp = (*it).second.rsrpSum / (double)(*it).second.rsrpNum;
-      double avg_rsrq = (*it).second.rsrqSum / (double)(*it).second.rsrqNum;
+      if (!(*it).measured)
+        {
+          continue;
+        }
+      double avg_rsrp = (*it).rsrpSum / (double)(*it).rsrpNum;
+      double avg_rsrq = (*it).rsrqSum / (double)(*it).rsrqNum;
       /*
        * In CELL_SEARCH state, this may result in avg_rsrq = 0/0 = -nan.
        * UE RRC must take this into account when receiving measurement reports.
        * TODO remove this shortcoming by calculating RSRQ during CELL_SEARCH
        */
-      NS_LOG_DEBUG (this << " CellId " << (*it).first
+      NS_LOG_DEBUG (this << " CellId " << (*it).cellId
                          << " RSRP " << avg_rsrp
-                         << " (nSamples " << (uint16_t)(*it).second.rsrpNum << ")"
+                         << " (nSamples " << (uint16_t)(*it).rsrpNum << ")"
                          << " RSRQ " << avg_rsrq
-                         << " (nSamples " << (uint16_t)(*it).second.rsrqNum << ")"
+                         << " (nSamples " << (uint16_t)(*it).rsrqNum << ")"
                          << " ComponentCarrierID " << (uint16_t)m_componentCarrierId);
 
       LteUeCphySapUser::UeMeasurementsElement newEl;
-      newEl.m_cellId = (*it).first;
+      newEl.m_cellId = (*it).cellId;
       newEl.m_rsrp = avg_rsrp;
       newEl.m_rsrq = avg_rsrq;
       ret.m_ueMeasurementsList.push_back (newEl);
       ret.m_componentCarrierId = m_componentCarrierId;
 
       // report to UE measurements trace
-      m_reportUeMeasurements (m_rnti, (*it).first, avg_rsrp, avg_rsrq, ((*it).first == m_cellId ? 1 : 0), m_componentCarrierId);
+      m_reportUeMeasurements (m_rnti, (*it).cellId, avg_rsrp, avg_rsrq, ((*it).cellId == m_cellId ? 1 : 0), m_componentCarrierId);
     }
 
   // report to RRC
   m_ueCphySapUser->ReportUeMeasurements (ret);
 
-  m_ueMeasurementsMap.clear ();
+  m_measurements.ResetFilter ();
   Simulator::Schedule (m_ueMeasurementsFilterPeriod, &LteUePhy::ReportUeMeasurements, this);
 }
 
@@ -1059,22 +1080,7 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
   // note that m_pssReceptionThreshold does not apply here
 
   // store measurements
-  std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap = m_ueMeasurementsMap.find (cellId);
-  if (itMeasMap == m_ueMeasurementsMap.end ())
-    {
-      // insert new entry
-      UeMeasurementsElement newEl;
-      newEl.rsrpSum = rsrp_dBm;
-      newEl.rsrpNum = 1;
-      newEl.rsrqSum = 0;
-      newEl.rsrqNum = 0;
-      m_ueMeasurementsMap.insert (std::pair <uint16_t, UeMeasurementsElement> (cellId, newEl));
-    }
-  else
-    {
-      (*itMeasMap).second.rsrpSum += rsrp_dBm;
-      (*itMeasMap).second.rsrpNum++;
-    }
+  m_measurements.AddRsrp (cellId, rsrp_dBm);
 
   /*
    * Collect the PSS for later processing in GenerateCtrlCqiReport()
@@ -1229,6 +1235,7 @@ LteUePhy::DoReset ()
   m_p10CqiLast = Simulator::Now ();
   m_a30CqiLast = Simulator::Now ();
   m_paLinear = 1;
+  m_measurements.InvalidateCqi ();
 
   m_packetBurstQueue.clear ();
   m_controlMessagesQueue.clear ();
@@ -1279,6 +1286,7 @@ LteUePhy::DoSynchronizeWithEnb (uint16_t cellId)
   m_cellId = cellId;
   m_downlinkSpectrumPhy->SetCellId (cellId);
   m_uplinkSpectrumPhy->SetCellId (cellId);
+  m_measurements.InvalidateCqi ();
 
   // configure DL for receiving the BCH with the minimum bandwidth
   DoSetDlBandwidth (6);
@@ -1296,6 +1304,7 @@ LteUePhy::DoSetDlBandwidth (uint8_t dlBandwidth)
   if (m_dlBandwidth != dlBandwidth or !m_dlConfigured)
     {
       m_dlBandwidth = dlBandwidth;
+      m_measurements.InvalidateCqi ();
 
       static const int Type0AllocationRbg[4] = {
         10,     // RGB size 1
@@ -1340,6 +1349,7 @@ LteUePhy::DoSetRnti (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
   m_rnti = rnti;
+  m_measurements.InvalidateCqi ();
 
   m_powerControl->SetCellId (m_cellId);
   m_powerControl->SetRnti (m_rnti);
@@ -1350,6 +1360,7 @@ LteUePhy::DoSetTransmissionMode (uint8_t txMode)
 {
   NS_LOG_FUNCTION (this << (uint16_t)txMode);
   m_transmissionMode = txMode;
+  m_measurements.InvalidateCqi ();
   m_downlinkSpectrumPhy->SetTransmissionMode (txMode);
 }
 
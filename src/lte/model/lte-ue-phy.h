@@ -34,6 +34,7 @@
 #include <ns3/lte-amc.h>
 #include <set>
 #include <ns3/lte-ue-power-control.h>
+#include <ns3/lte-ue-measurement-engine.h>
 
 
 namespace ns3 {
@@ -155,6 +156,11 @@ public:
    */
   Ptr<LteSpectrumPhy> GetUlSpectrumPhy () const;
 
+  /**
+   * \return the engine of the RSRP, RSRQ and DL-CQI measurements
+   */
+  const LteUeMeasurementEngine& GetMeasurementEngine () const;
+
   /**
    * \brief Create the PSD for the TX
    * \return the pointer to the PSD
@@ -552,20 +558,28 @@ private:
    */
   double m_pssReceptionThreshold;
 
-  /// Summary results of measuring a specific cell. Used for layer-1 filtering.
-  struct UeMeasurementsElement
-  {
-    double rsrpSum;   ///< Sum of RSRP sample values in linear unit.
-    uint8_t rsrpNum;  ///< Number of RSRP samples.
-    double rsrqSum;   ///< Sum of RSRQ sample values in linear unit.
-    uint8_t rsrqNum;  ///< Number of RSRQ samples.
-  };
-
   /**
-   * Store measurement results during the last layer-1 filtering period.
-   * Indexed by the cell ID where the measurements come from.
+   * Store the measurement results of each cell during the last layer-1
+   * filtering period, and the last DL-CQIs for their subsampling.
+   */
+  LteUeMeasurementEngine m_measurements;
+  /**
+   * The `CqiSubsampling` attribute. If true, the DL-CQIs are computed again
+   * only when they are older than m_cqiSubsamplingPeriod or when the
+   * wideband SINR changed by more than m_cqiSubsamplingThreshold.
+   */
+  bool m_cqiSubsampling;
+  /**
+   * The `CqiSubsamplingPeriod` attribute. Maximum age of a reported DL-CQI
+   * when the subsampling is enabled.
+   */
+  Time m_cqiSubsamplingPeriod;
+  /**
+   * The `CqiSubsamplingThreshold` attribute. Change of the wideband SINR, in
+   * dB, which triggers the computation of a DL-CQI when the subsampling is
+   * enabled.
    */
-  std::map <uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+  double m_cqiSubsamplingThreshold;
   /**
    * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
    * measurements, i.e., the length of layer-1 filtering (default 200 ms).
@@ -1632,7 +1632,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
     //Copy lte-rlc-am.m_txOnBuffer to X2 forwarding buffer.
     Ptr<LteRlcAm> rlcAm = rlc->GetObject<LteRlcAm>();
     uint32_t txonBufferSize = rlcAm->GetTxBufferSize();
-    std::vector < Ptr<Packet> > txonBuffer = rlcAm->GetTxBuffer();
+    std::deque < Ptr<Packet> > txonBuffer = rlcAm->GetTxBuffer();
     //m_rlcBufferToBeForwardedSize =  drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBufferSize();
     //m_rlcBufferToBeForwarded = drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBuffer();
     uint32_t txedBufferSize = rlcAm->GetTxedBufferSize();
@@ -1665,7 +1665,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
     //{
       LtePdcpHeader pdcpHeader;
       uint32_t pos = 0;
-      for (std::vector< Ptr<Packet> >::iterator it = txonBuffer.begin(); it != txonBuffer.end(); ++it)
+      for (std::deque< Ptr<Packet> >::iterator it = txonBuffer.begin(); it != txonBuffer.end(); ++it)
       {
         pos++;
         if((*it)->GetSize() > 3)
@@ -1703,7 +1703,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
           segmentedRlcsdu->PeekHeader(pdcpHeader);
           NS_LOG_DEBUG(this << "UE RRC: SegmentedRlcSdu = " << segmentedRlcsdu->GetSize() << " SEQ = " << pdcpHeader.GetSequenceNumber());
           //insert the complete version of the fragmented SDU to the front of txonBuffer.
-          txonBuffer.insert(txonBuffer.begin(),segmentedRlcsdu);
+          txonBuffer.push_front(segmentedRlcsdu);
         }
         m_rlcBufferToBeForwarded.insert(m_rlcBufferToBeForwarded.end(), txonBuffer.begin(), txonBuffer.end());
         m_rlcBufferToBeForwardedSize += rlcAm->GetTransmittingRlcSduBufferSize() + txonBufferSize;
@@ -1734,7 +1734,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
       else
       { //TransmittingBuffer is empty. Only copy TxonBuffer.
         NS_LOG_DEBUG(this << " UE RRC: ADDING TXONBUFFER OF RLC AM " << m_rnti << " Size = " << txonBufferSize) ;
-        m_rlcBufferToBeForwarded = txonBuffer;
+        m_rlcBufferToBeForwarded.assign (txonBuffer.begin (), txonBuffer.end ());
         m_rlcBufferToBeForwardedSize += txonBufferSize;
       }
     //}
@@ -1812,7 +1812,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
       NS_LOG_UNCOND("UE RRC: Too small, not forwarded");
     }
     m_rlcBufferToBeForwardedSize -= (*(m_rlcBufferToBeForwarded.begin()))->GetSize();
-    m_rlcBufferToBeForwarded.erase (m_rlcBufferToBeForwarded.begin());
+    m_rlcBufferToBeForwarded.pop_front ();
     NS_LOG_LOGIC(this << " UE RRC: After forwarding: buffer size = " << m_rlcBufferToBeForwardedSize );
   }
 }
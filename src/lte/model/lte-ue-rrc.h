@@ -45,6 +45,7 @@
 
 #include <map>
 #include <set>
+#include <deque>
 #include <ns3/lte-rlc.h>
 #include <ns3/lte-pdcp.h>
 #include <ns3/lte-rlc-am.h>
@@ -1253,7 +1254,7 @@ private:
   bool m_ncRaStarted;
 
   // lossless HO
-  std::vector < Ptr<Packet> > m_rlcBufferToBeForwarded;
+  std::deque < Ptr<Packet> > m_rlcBufferToBeForwarded;
   uint32_t m_rlcBufferToBeForwardedSize;
 
 public:
@@ -494,20 +494,8 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
   int rbgSize = GetRbgSize (m_cschedCellConfig.m_dlBandwidth);
   int rbgNum = m_cschedCellConfig.m_dlBandwidth / rbgSize;
-  std::map <uint16_t, std::vector <uint16_t> > allocationMap; // RBs map per RNTI
-  std::vector <bool> rbgMap;  // global RBGs map
-  uint16_t rbgAllocatedNum = 0;
-  std::set <uint16_t> rntiAllocated;
-  rbgMap.resize (m_cschedCellConfig.m_dlBandwidth / rbgSize, false);
-
-  rbgMap = m_ffrSapProvider->GetAvailableDlRbg ();
-  for (std::vector<bool>::iterator it = rbgMap.begin (); it != rbgMap.end (); it++)
-    {
-      if ((*it) == true )
-        {
-          rbgAllocatedNum++;
-        }
-    }
+  // global RBGs map, RNTIs allocated for HARQ retx and RBGs map per RNTI
+  m_dlCore.StartTti (m_amc, rbgSize, rbgNum, m_ffrSapProvider->GetAvailableDlRbg ());
 
   FfMacSchedSapUser::SchedDlConfigIndParameters ret;
 
@@ -669,8 +657,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
   std::vector <struct DlInfoListElement_s> dlInfoListUntxed;
   for (uint16_t i = 0; i < m_dlInfoListBuffered.size (); i++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_dlInfoListBuffered.at (i).m_rnti);
-      if (itRnti != rntiAllocated.end ())
+      if (m_dlCore.IsRntiAllocated (m_dlInfoListBuffered.at (i).m_rnti))
         {
           // RNTI already allocated for retx
           continue;
@@ -746,25 +733,12 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                 }
               mask = (mask << 1);
             }
-          bool free = true;
-          for (uint8_t j = 0; j < dciRbg.size (); j++)
-            {
-              if (rbgMap.at (dciRbg.at (j)) == true)
-                {
-                  free = false;
-                  break;
-                }
-            }
+          bool free = ((m_dlCore.GetRbgMask () & dci.m_rbBitmap) == 0);
           if (free)
             {
               // use the same RBGs for the retx
               // reserve RBGs
-              for (uint8_t j = 0; j < dciRbg.size (); j++)
-                {
-                  rbgMap.at (dciRbg.at (j)) = true;
-                  NS_LOG_INFO ("RBG " << dciRbg.at (j) << " assigned");
-                  rbgAllocatedNum++;
-                }
+              m_dlCore.SetRbgMask (m_dlCore.GetRbgMask () | dci.m_rbBitmap);
 
               NS_LOG_INFO (this << " Send retx in the same RBGs");
             }
@@ -774,12 +748,12 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
               uint8_t j = 0;
               uint8_t rbgId = (dciRbg.at (dciRbg.size () - 1) + 1) % rbgNum;
               uint8_t startRbg = dciRbg.at (dciRbg.size () - 1);
-              std::vector <bool> rbgMapCopy = rbgMap;
+              uint32_t rbgMapCopy = m_dlCore.GetRbgMask ();
               while ((j < dciRbg.size ())&&(startRbg != rbgId))
                 {
-                  if (rbgMapCopy.at (rbgId) == false)
+                  if ((rbgMapCopy & (0x1 << rbgId)) == 0)
                     {
-                      rbgMapCopy.at (rbgId) = true;
+                      rbgMapCopy |= (0x1 << rbgId);
                       dciRbg.at (j) = rbgId;
                       j++;
                     }
@@ -792,10 +766,9 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                   for (uint16_t k = 0; k < dciRbg.size (); k++)
                     {
                       rbgMask = rbgMask + (0x1 << dciRbg.at (k));
-                      rbgAllocatedNum++;
                     }
                   dci.m_rbBitmap = rbgMask;
-                  rbgMap = rbgMapCopy;
+                  m_dlCore.SetRbgMask (rbgMapCopy);
                   NS_LOG_INFO (this << " Move retx in RBGs " << dciRbg.size ());
                 }
               else
@@ -882,7 +855,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             }
           (*itHarqTimer).second.at (harqId) = 0;
           ret.m_buildDataList.push_back (newEl);
-          rntiAllocated.insert (rnti);
+          m_dlCore.SetRntiAllocated (rnti);
         }
       else
         {
@@ -908,7 +881,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
   m_dlInfoListBuffered.clear ();
   m_dlInfoListBuffered = dlInfoListUntxed;
 
-  if (rbgAllocatedNum == rbgNum)
+  if (m_dlCore.IsRbgMapFull ())
     {
       // all the RBGs are already allocated -> exit
       if ((ret.m_buildDataList.size () > 0) || (ret.m_buildRarList.size () > 0))
@@ -920,54 +893,66 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
 
 
+  // collect the UEs and the state used by their metric, once per TTI
+  m_dlUeFlows.clear ();
+  std::map <uint16_t, pfsFlowPerf_t>::iterator it;
+  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+    {
+      m_dlCore.AddUe ((*it).first);
+      m_dlUeFlows.push_back (&(*it).second);
+    }
+  m_dlCore.CountActiveLcs (m_rlcBufferReq);
+  for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
+    {
+      FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+      if ((m_dlCore.IsRntiAllocated (ue.rnti))||(!HarqProcessAvailability (ue.rnti)))
+        {
+          // UE already allocated for HARQ or without HARQ process available -> drop it
+          if (m_dlCore.IsRntiAllocated (ue.rnti))
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)ue.rnti);
+            }
+          if (!HarqProcessAvailability (ue.rnti))
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)ue.rnti);
+            }
+          continue;
+        }
+      std::map <uint16_t,uint8_t>::iterator itTxMode;
+      itTxMode = m_uesTxMode.find (ue.rnti);
+      if (itTxMode == m_uesTxMode.end ())
+        {
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << ue.rnti);
+        }
+      ue.nLayers = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
+      itCqi = m_a30CqiRxed.find (ue.rnti);
+      if (itCqi != m_a30CqiRxed.end ())
+        {
+          ue.sbCqi = &(*itCqi).second;
+        }
+      ue.schedulable = (ue.lcActives > 0);
+    }
+
   for (int i = 0; i < rbgNum; i++)
     {
       NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
-      if (rbgMap.at (i) == false)
+      if (m_dlCore.IsRbgFree (i))
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-          std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
+          FfMacSchedulerCore::Ue* ueMax = 0;
           double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
             {
-              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
+              FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, ue.rnti)) == false)
                 continue;
 
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
+              if (!ue.schedulable)
                 {
-                  // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
+                  // UE without data, allocated for HARQ or without HARQ process available
                   continue;
                 }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
-                {
-                  for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                      sbCqi.push_back (1);  // start with lowest value
-                    }
-                }
-              else
-                {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                }
+              const std::vector <uint8_t>& sbCqi = m_dlCore.GetSbCqi (ue, i);
               uint8_t cqi1 = sbCqi.at (0);
               uint8_t cqi2 = 0;
               if (sbCqi.size () > 1)
@@ -977,59 +962,43 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
               if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                  if (LcActivePerFlow ((*it).first) > 0)
+                  // this UE has data to transmit
+                  double achievableRate = 0.0;
+                  uint8_t mcs = 0;
+                  for (uint8_t k = 0; k < ue.nLayers; k++)
                     {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      uint8_t mcs = 0;
-                      for (uint8_t k = 0; k < nLayer; k++)
+                      if (sbCqi.size () > k)
                         {
-                          if (sbCqi.size () > k)
-                            {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
-                            }
-                          else
-                            {
-                              // no info on this subband -> worst MCS
-                              mcs = 0;
-                            }
-                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
+                          mcs = m_dlCore.GetMcsFromCqi (sbCqi.at (k));
                         }
-
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
-
-                      if (rcqi > rcqiMax)
+                      else
                         {
-                          rcqiMax = rcqi;
-                          itMax = it;
+                          // no info on this subband -> worst MCS
+                          mcs = 0;
                         }
+                      achievableRate += m_dlCore.GetRbgRate (mcs);   // = TB size / TTI
+                    }
+
+                  double rcqi = achievableRate / m_dlUeFlows[u]->lastAveragedThroughput;
+                  NS_LOG_INFO (this << " RNTI " << ue.rnti << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << m_dlUeFlows[u]->lastAveragedThroughput << " RCQI " << rcqi);
+
+                  if (rcqi > rcqiMax)
+                    {
+                      rcqiMax = rcqi;
+                      ueMax = &ue;
                     }
                 }   // end if cqi
-            } // end for m_rlcBufferReq
+            } // end for UEs
 
-          if (itMax == m_flowStatsDl.end ())
+          if (ueMax == 0)
             {
               // no UE available for this RB
               NS_LOG_INFO (this << " any UE found");
             }
           else
             {
-              rbgMap.at (i) = true;
-              std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax).first);
-              if (itMap == allocationMap.end ())
-                {
-                  // insert new element
-                  std::vector <uint16_t> tempMap;
-                  tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
-                }
-              else
-                {
-                  (*itMap).second.push_back (i);
-                }
-              NS_LOG_INFO (this << " UE assigned " << (*itMax).first);
+              m_dlCore.AllocateRbg (*ueMax, i);
+              NS_LOG_INFO (this << " UE assigned " << ueMax->rnti);
             }
         } // end for RBG free
     } // end for RBGs
@@ -1043,103 +1012,100 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
   // generate the transmission opportunities by grouping the RBGs of the same RNTI and
   // creating the correspondent DCIs
-  std::map <uint16_t, std::vector <uint16_t> >::iterator itMap = allocationMap.begin ();
-  while (itMap != allocationMap.end ())
+  for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
     {
+      FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+      if (ue.rbgMask == 0)
+        {
+          continue;
+        }
       // create new BuildDataListElement_s for this LC
       BuildDataListElement_s newEl;
-      newEl.m_rnti = (*itMap).first;
+      newEl.m_rnti = ue.rnti;
       // create the DlDciListElement_s
       DlDciListElement_s newDci;
-      newDci.m_rnti = (*itMap).first;
-      newDci.m_harqProcess = UpdateHarqProcessId ((*itMap).first);
+      newDci.m_rnti = ue.rnti;
+      newDci.m_harqProcess = UpdateHarqProcessId (ue.rnti);
 
-      uint16_t lcActives = LcActivePerFlow ((*itMap).first);
+      uint16_t lcActives = ue.lcActives;
       NS_LOG_INFO (this << "Allocate user " << newEl.m_rnti << " rbg " << lcActives);
       if (lcActives == 0)
         {
           // Set to max value, to avoid divide by 0 below
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
-      uint16_t RgbPerRnti = (*itMap).second.size ();
-      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-      itCqi = m_a30CqiRxed.find ((*itMap).first);
-      std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
-      if (itTxMode == m_uesTxMode.end ())
-        {
-          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
-        }
-      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-      std::vector <uint8_t> worstCqi (2, 15);
-      if (itCqi != m_a30CqiRxed.end ())
+      uint16_t RgbPerRnti = 0;
+      int nLayer = ue.nLayers;
+      uint8_t worstCqi[2] = {15, 15};
+      for (int k = 0; k < rbgNum; k++)
         {
-          for (uint16_t k = 0; k < (*itMap).second.size (); k++)
+          if ((ue.rbgMask & (0x1 << k)) == 0)
+            {
+              continue;
+            }
+          RgbPerRnti++;
+          NS_LOG_INFO (this << " Allocated RBG " << k);
+          if (ue.sbCqi == 0)
+            {
+              continue;
+            }
+          if (ue.sbCqi->m_higherLayerSelected.size () > (uint16_t) k)
             {
-              if ((*itCqi).second.m_higherLayerSelected.size () > (*itMap).second.at (k))
+              const std::vector <uint8_t>& sbCqi = ue.sbCqi->m_higherLayerSelected.at (k).m_sbCqi;
+              NS_LOG_INFO (this << " RBG " << k << " CQI " << (uint16_t)(sbCqi.at (0)) );
+              for (uint8_t j = 0; j < nLayer; j++)
                 {
-                  NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (0)) );
-                  for (uint8_t j = 0; j < nLayer; j++)
+                  if (sbCqi.size () > j)
                     {
-                      if ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.size () > j)
-                        {
-                          if (((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j)) < worstCqi.at (j))
-                            {
-                              worstCqi.at (j) = ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j));
-                            }
-                        }
-                      else
+                      if (sbCqi.at (j) < worstCqi[j])
                         {
-                          // no CQI for this layer of this suband -> worst one
-                          worstCqi.at (j) = 1;
+                          worstCqi[j] = sbCqi.at (j);
                         }
                     }
-                }
-              else
-                {
-                  for (uint8_t j = 0; j < nLayer; j++)
+                  else
                     {
-                      worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
+                      // no CQI for this layer of this suband -> worst one
+                      worstCqi[j] = 1;
                     }
                 }
             }
+          else
+            {
+              for (uint8_t j = 0; j < nLayer; j++)
+                {
+                  worstCqi[j] = 1; // try with lowest MCS in RBG with no info on channel
+                }
+            }
         }
-      else
+      if (ue.sbCqi == 0)
         {
           for (uint8_t j = 0; j < nLayer; j++)
             {
-              worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
+              worstCqi[j] = 1; // try with lowest MCS in RBG with no info on channel
             }
         }
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi.at (j));
+          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi[j]);
         }
       uint32_t bytesTxed = 0;
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          newDci.m_mcs.push_back (m_amc->GetMcsFromCqi (worstCqi.at (j)));
+          newDci.m_mcs.push_back (m_dlCore.GetMcsFromCqi (worstCqi[j]));
           int tbSize = (m_amc->GetDlTbSizeFromMcs (newDci.m_mcs.at (j), RgbPerRnti * rbgSize) / 8); // (size of TB in bytes according to table 7.1.7.2.1-1 of 36.213)
           newDci.m_tbsSize.push_back (tbSize);
-          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " MCS selected" << m_amc->GetMcsFromCqi (worstCqi.at (j)));
+          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " MCS selected" << (uint16_t)newDci.m_mcs.at (j));
           bytesTxed += tbSize;
         }
 
       newDci.m_resAlloc = 0;  // only allocation type 0 at this stage
-      newDci.m_rbBitmap = 0; // TBD (32 bit bitmap see 7.1.6 of 36.213)
-      uint32_t rbgMask = 0;
-      for (uint16_t k = 0; k < (*itMap).second.size (); k++)
-        {
-          rbgMask = rbgMask + (0x1 << (*itMap).second.at (k));
-          NS_LOG_INFO (this << " Allocated RBG " << (*itMap).second.at (k));
-        }
-      newDci.m_rbBitmap = rbgMask; // (32 bit bitmap see 7.1.6 of 36.213)
+      newDci.m_rbBitmap = ue.rbgMask; // (32 bit bitmap see 7.1.6 of 36.213)
 
       // create the rlc PDUs -> equally divide resources among actives LCs
       std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itBufReq;
-      for (itBufReq = m_rlcBufferReq.begin (); itBufReq != m_rlcBufferReq.end (); itBufReq++)
+      for (itBufReq = m_rlcBufferReq.lower_bound (LteFlowId_t (ue.rnti, 0)); itBufReq != m_rlcBufferReq.end (); itBufReq++)
         {
-          if (((*itBufReq).first.m_rnti == (*itMap).first)
+          if (((*itBufReq).first.m_rnti == ue.rnti)
               && (((*itBufReq).second.m_rlcTransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcRetransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcStatusPduSize > 0) ))
@@ -1156,17 +1122,17 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                   if (m_harqOn == true)
                     {
                       // store RLC PDU list for HARQ
-                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find ((*itMap).first);
+                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (ue.rnti);
                       if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
                         {
-                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << (*itMap).first);
+                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << ue.rnti);
                         }
                       (*itRlcPdu).second.at (j).at (newDci.m_harqProcess).push_back (newRlcEl);
                     }
                 }
               newEl.m_rlcPduList.push_back (newRlcPduLe);
             }
-          if ((*itBufReq).first.m_rnti > (*itMap).first)
+          if ((*itBufReq).first.m_rnti > ue.rnti)
             {
               break;
             }
@@ -1177,7 +1143,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
           newDci.m_rv.push_back (0);
         }
 
-      newDci.m_tpc = m_ffrSapProvider->GetTpc ((*itMap).first);
+      newDci.m_tpc = m_ffrSapProvider->GetTpc (ue.rnti);
 
       newEl.m_dci = newDci;
 
@@ -1203,22 +1169,9 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
       ret.m_buildDataList.push_back (newEl);
       // update UE stats
-      std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-      it = m_flowStatsDl.find ((*itMap).first);
-      if (it != m_flowStatsDl.end ())
-        {
-          (*it).second.lastTtiBytesTrasmitted = bytesTxed;
-          NS_LOG_INFO (this << " UE total bytes txed " << (*it).second.lastTtiBytesTrasmitted);
-
-
-        }
-      else
-        {
-          NS_FATAL_ERROR (this << " No Stats for this allocated UE");
-        }
-
-      itMap++;
-    } // end while allocation
+      m_dlUeFlows[u]->lastTtiBytesTrasmitted = bytesTxed;
+      NS_LOG_INFO (this << " UE total bytes txed " << m_dlUeFlows[u]->lastTtiBytesTrasmitted);
+    } // end for allocated UEs
   ret.m_nrOfPdcchOfdmSymbols = 1;   /// \todo check correct value according the DCIs txed
 
 
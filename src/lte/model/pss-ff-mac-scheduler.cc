@@ -522,20 +522,8 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
 
   int rbgSize = GetRbgSize (m_cschedCellConfig.m_dlBandwidth);
   int rbgNum = m_cschedCellConfig.m_dlBandwidth / rbgSize;
-  std::map <uint16_t, std::vector <uint16_t> > allocationMap; // RBs map per RNTI
-  std::vector <bool> rbgMap;  // global RBGs map
-  uint16_t rbgAllocatedNum = 0;
-  std::set <uint16_t> rntiAllocated;
-  rbgMap.resize (m_cschedCellConfig.m_dlBandwidth / rbgSize, false);
-
-  rbgMap = m_ffrSapProvider->GetAvailableDlRbg ();
-  for (std::vector<bool>::iterator it = rbgMap.begin (); it != rbgMap.end (); it++)
-    {
-      if ((*it) == true )
-        {
-          rbgAllocatedNum++;
-        }
-    }
+  // global RBGs map, RNTIs allocated for HARQ retx and RBGs map per RNTI
+  m_dlCore.StartTti (m_amc, rbgSize, rbgNum, m_ffrSapProvider->GetAvailableDlRbg ());
 
   FfMacSchedSapUser::SchedDlConfigIndParameters ret;
 
@@ -696,8 +684,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
   std::vector <struct DlInfoListElement_s> dlInfoListUntxed;
   for (uint16_t i = 0; i < m_dlInfoListBuffered.size (); i++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_dlInfoListBuffered.at (i).m_rnti);
-      if (itRnti != rntiAllocated.end ())
+      if (m_dlCore.IsRntiAllocated (m_dlInfoListBuffered.at (i).m_rnti))
         {
           // RNTI already allocated for retx
           continue;
@@ -773,25 +760,12 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
                 }
               mask = (mask << 1);
             }
-          bool free = true;
-          for (uint8_t j = 0; j < dciRbg.size (); j++)
-            {
-              if (rbgMap.at (dciRbg.at (j)) == true)
-                {
-                  free = false;
-                  break;
-                }
-            }
+          bool free = ((m_dlCore.GetRbgMask () & dci.m_rbBitmap) == 0);
           if (free)
             {
               // use the same RBGs for the retx
               // reserve RBGs
-              for (uint8_t j = 0; j < dciRbg.size (); j++)
-                {
-                  rbgMap.at (dciRbg.at (j)) = true;
-                  NS_LOG_INFO ("RBG " << dciRbg.at (j) << " assigned");
-                  rbgAllocatedNum++;
-                }
+              m_dlCore.SetRbgMask (m_dlCore.GetRbgMask () | dci.m_rbBitmap);
 
               NS_LOG_INFO (this << " Send retx in the same RBGs");
             }
@@ -801,12 +775,12 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
               uint8_t j = 0;
               uint8_t rbgId = (dciRbg.at (dciRbg.size () - 1) + 1) % rbgNum;
               uint8_t startRbg = dciRbg.at (dciRbg.size () - 1);
-              std::vector <bool> rbgMapCopy = rbgMap;
+              uint32_t rbgMapCopy = m_dlCore.GetRbgMask ();
               while ((j < dciRbg.size ())&&(startRbg != rbgId))
                 {
-                  if (rbgMapCopy.at (rbgId) == false)
+                  if ((rbgMapCopy & (0x1 << rbgId)) == 0)
                     {
-                      rbgMapCopy.at (rbgId) = true;
+                      rbgMapCopy |= (0x1 << rbgId);
                       dciRbg.at (j) = rbgId;
                       j++;
                     }
@@ -819,10 +793,9 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
                   for (uint16_t k = 0; k < dciRbg.size (); k++)
                     {
                       rbgMask = rbgMask + (0x1 << dciRbg.at (k));
-                      rbgAllocatedNum++;
                     }
                   dci.m_rbBitmap = rbgMask;
-                  rbgMap = rbgMapCopy;
+                  m_dlCore.SetRbgMask (rbgMapCopy);
                   NS_LOG_INFO (this << " Move retx in RBGs " << dciRbg.size ());
                 }
               else
@@ -909,7 +882,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
             }
           (*itHarqTimer).second.at (harqId) = 0;
           ret.m_buildDataList.push_back (newEl);
-          rntiAllocated.insert (rnti);
+          m_dlCore.SetRntiAllocated (rnti);
         }
       else
         {
@@ -935,7 +908,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
   m_dlInfoListBuffered.clear ();
   m_dlInfoListBuffered = dlInfoListUntxed;
 
-  if (rbgAllocatedNum == rbgNum)
+  if (m_dlCore.IsRbgMapFull ())
     {
       // all the RBGs are already allocated -> exit
       if ((ret.m_buildDataList.size () > 0) || (ret.m_buildRarList.size () > 0))
@@ -946,61 +919,81 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
     }
 
 
+  // collect the UEs and the state used by the TD and FD metrics, once per TTI
+  m_dlUeFlows.clear ();
   std::map <uint16_t, pssFlowPerf_t>::iterator it;
-  std::map <uint16_t, pssFlowPerf_t> tdUeSet; // the result of TD scheduler
+  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+    {
+      m_dlCore.AddUe ((*it).first);
+      m_dlUeFlows.push_back (&(*it).second);
+    }
+  m_dlCore.CountActiveLcs (m_rlcBufferReq);
 
   // schedulability check
-  std::map <uint16_t, pssFlowPerf_t> ueSet;
-  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+  uint32_t ueSetSize = 0;
+  for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
     {
-      if( LcActivePerFlow ((*it).first) > 0 )
+      FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+      if (ue.lcActives == 0)
+        {
+          continue;
+        }
+      ueSetSize++;
+      if ((m_dlCore.IsRntiAllocated (ue.rnti))||(!HarqProcessAvailability (ue.rnti)))
+        {
+          // UE already allocated for HARQ or without HARQ process available -> drop it
+          if (m_dlCore.IsRntiAllocated (ue.rnti))
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)ue.rnti);
+            }
+          if (!HarqProcessAvailability (ue.rnti))
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)ue.rnti);
+            }
+          continue;
+        }
+      std::map <uint16_t,uint8_t>::iterator itTxMode;
+      itTxMode = m_uesTxMode.find (ue.rnti);
+      if (itTxMode == m_uesTxMode.end ())
+        {
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << ue.rnti);
+        }
+      ue.nLayers = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      std::map <uint16_t,SbMeasResult_s>::iterator itSbCqi;
+      itSbCqi = m_a30CqiRxed.find (ue.rnti);
+      if (itSbCqi != m_a30CqiRxed.end ())
         {
-          ueSet.insert(std::pair <uint16_t, pssFlowPerf_t> ((*it).first, (*it).second));
+          ue.sbCqi = &(*itSbCqi).second;
         }
+      ue.schedulable = true;
     }
 
-  if (ueSet.size() != 0)
+  if (ueSetSize != 0)
     { // has data in RLC buffer
 
       // Time Domain scheduler
-      std::vector <std::pair<double, uint16_t> > ueSet1;
-      std::vector <std::pair<double,uint16_t> > ueSet2;
-      for (it = ueSet.begin (); it != ueSet.end (); it++)
+      m_ueSet1.clear ();
+      m_ueSet2.clear ();
+      for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
         {
-          std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-          if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
+          FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+          if (!ue.schedulable)
             {
-              // UE already allocated for HARQ or without HARQ process available -> drop it
-              if (itRnti != rntiAllocated.end ())
-              {
-                NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-              }
-              if (!HarqProcessAvailability ((*it).first))
-              {
-                NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-              }
               continue;
             }
-    
+          pssFlowPerf_t* flow = m_dlUeFlows[u];
+
           double metric = 0.0;
-          if ((*it).second.lastAveragedThroughput < (*it).second.targetThroughput )
+          std::map <uint16_t,uint8_t>::iterator itCqi;
+          itCqi = m_p10CqiRxed.find (ue.rnti);
+          if (flow->lastAveragedThroughput < flow->targetThroughput )
             {
-        	    // calculate TD BET metric
-              metric = 1 / (*it).second.lastAveragedThroughput;
+              // calculate TD BET metric
+              metric = 1 / flow->lastAveragedThroughput;
 
               // check first what are channel conditions for this UE, if CQI!=0
-              std::map <uint16_t,uint8_t>::iterator itCqi;
-              itCqi = m_p10CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-
               uint8_t cqiSum = 0;
-              for (uint8_t j = 0; j < nLayer; j++)
+              for (uint8_t j = 0; j < ue.nLayers; j++)
                 {
                   if (itCqi == m_p10CqiRxed.end ())
                     {
@@ -1013,23 +1006,14 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
                 }
               if (cqiSum != 0)
                 {
-                  ueSet1.push_back(std::pair<double, uint16_t> (metric, (*it).first));
+                  m_ueSet1.push_back (std::pair<double, uint16_t> (metric, ue.rnti));
                 }
             }
           else
             {
               // calculate TD PF metric
-              std::map <uint16_t,uint8_t>::iterator itCqi;
-              itCqi = m_p10CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
               uint8_t wbCqi = 0;
-              if (itCqi == m_p10CqiRxed.end())
+              if (itCqi == m_p10CqiRxed.end ())
                 {
                   wbCqi = 1; // start with lowest value
                 }
@@ -1037,34 +1021,28 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
                 {
                   wbCqi = (*itCqi).second;
                 }
-    
+
               if (wbCqi > 0)
                 {
-                  if (LcActivePerFlow ((*it).first) > 0)
+                  // this UE has data to transmit
+                  double achievableRate = 0.0;
+                  for (uint8_t k = 0; k < ue.nLayers; k++)
                     {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      for (uint8_t k = 0; k < nLayer; k++) 
-                        {
-                          uint8_t mcs = 0; 
-                          mcs = m_amc->GetMcsFromCqi (wbCqi);
-                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001); // = TB size / TTI
-                        }
-    
-                      metric = achievableRate / (*it).second.lastAveragedThroughput;
-                   }
-                  ueSet2.push_back(std::pair<double, uint16_t> (metric, (*it).first));
+                      achievableRate += m_dlCore.GetRbgRate (m_dlCore.GetMcsFromCqi (wbCqi)); // = TB size / TTI
+                    }
+
+                  metric = achievableRate / flow->lastAveragedThroughput;
+                  m_ueSet2.push_back (std::pair<double, uint16_t> (metric, ue.rnti));
                 } // end of wbCqi
             }
         }// end of ueSet
-    
-    
-      if (ueSet1.size () != 0 || ueSet2.size () != 0)
+
+      if (m_ueSet1.size () != 0 || m_ueSet2.size () != 0)
         {
           // sorting UE in ueSet1 and ueSet1 in descending order based on their metric value
-          std::sort (ueSet1.rbegin (), ueSet1.rend ());
-          std::sort (ueSet2.rbegin (), ueSet2.rend ());
- 
+          std::sort (m_ueSet1.rbegin (), m_ueSet1.rend ());
+          std::sort (m_ueSet2.rbegin (), m_ueSet2.rend ());
+
           // select UE set for frequency domain scheduler
           uint32_t nMux;
           if ( m_nMux > 0)
@@ -1072,289 +1050,216 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
           else
             {
               // select half number of UE
-              if (ueSet1.size() + ueSet2.size() <=2 )
+              if (m_ueSet1.size () + m_ueSet2.size () <=2 )
                 nMux = 1;
               else
-                nMux = (int)((ueSet1.size() + ueSet2.size()) / 2) ; // TD scheduler only transfers half selected UE per RTT to TD scheduler
-            }
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it--)
-           {
-             std::vector <std::pair<double, uint16_t> >::iterator itSet;
-             for (itSet = ueSet1.begin (); itSet != ueSet1.end () && nMux != 0; itSet++)
-               {  
-                 std::map <uint16_t, pssFlowPerf_t>::iterator itUe;
-                 itUe = m_flowStatsDl.find((*itSet).second);
-                 tdUeSet.insert(std::pair<uint16_t, pssFlowPerf_t> ( (*itUe).first, (*itUe).second ) );
-                 nMux--;
-               }
-           
-             if (nMux == 0)
-               break;
-        
-             for (itSet = ueSet2.begin (); itSet != ueSet2.end () && nMux != 0; itSet++)
-               {  
-                 std::map <uint16_t, pssFlowPerf_t>::iterator itUe;
-                 itUe = m_flowStatsDl.find((*itSet).second);
-                 tdUeSet.insert(std::pair<uint16_t, pssFlowPerf_t> ( (*itUe).first, (*itUe).second ) );
-                 nMux--;
-               }
-        
-             if (nMux == 0)
-               break;
-        
-           } // end of m_flowStatsDl
-        
-        
+                nMux = (int)((m_ueSet1.size () + m_ueSet2.size ()) / 2) ; // TD scheduler only transfers half selected UE per RTT to TD scheduler
+            }
+          std::vector <std::pair<double, uint16_t> >::iterator itSet;
+          for (itSet = m_ueSet1.begin (); itSet != m_ueSet1.end () && nMux != 0; itSet++)
+            {
+              m_dlCore.FindUe ((*itSet).second)->selected = true;
+              nMux--;
+            }
+          for (itSet = m_ueSet2.begin (); itSet != m_ueSet2.end () && nMux != 0; itSet++)
+            {
+              m_dlCore.FindUe ((*itSet).second)->selected = true;
+              nMux--;
+            }
+
           if ( m_fdSchedulerType.compare("CoItA") == 0)
             {
               // FD scheduler: Carrier over Interference to Average (CoItA)
-              std::map < uint16_t, uint8_t > sbCqiSum;
-              for (it = tdUeSet.begin (); it != tdUeSet.end (); it++)
+              for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
                 {
+                  FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+                  if (!ue.selected)
+                    {
+                      continue;
+                    }
                   uint8_t sum = 0;
                   for (int i = 0; i < rbgNum; i++)
                     {
-                      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-                      itCqi = m_a30CqiRxed.find ((*it).first);
-                      std::map <uint16_t,uint8_t>::iterator itTxMode;
-                      itTxMode = m_uesTxMode.find ((*it).first);
-                      if (itTxMode == m_uesTxMode.end ())
-                        {
-                          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                        }
-                      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-                      std::vector <uint8_t> sbCqis;
-                      if (itCqi == m_a30CqiRxed.end ())
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                              sbCqis.push_back (1);  // start with lowest value
-                            }
-                        }
-                      else
-                        {
-                          sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                        }
-        
+                      const std::vector <uint8_t>& sbCqis = m_dlCore.GetSbCqi (ue, i);
                       uint8_t cqi1 = sbCqis.at (0);
                       uint8_t cqi2 = 0;
                       if (sbCqis.size () > 1)
                         {
                           cqi2 = sbCqis.at (1);
                         }
-            
+
                       uint8_t sbCqi = 0;
                       if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                         {
-                          for (uint8_t k = 0; k < nLayer; k++) 
+                          for (uint8_t k = 0; k < ue.nLayers; k++)
                             {
                               if (sbCqis.size () > k)
-                                {                       
-           	                  sbCqi = sbCqis.at(k);
+                                {
+                                  sbCqi = sbCqis.at (k);
                                 }
                               else
                                 {
-                                  // no info on this subband 
+                                  // no info on this subband
                                   sbCqi = 0;
                                 }
                               sum += sbCqi;
                             }
                         }   // end if cqi
                     }// end of rbgNum
-              
-                  sbCqiSum.insert (std::pair<uint16_t, uint8_t> ((*it).first, sum));
+
+                  // the sum of the subband CQIs
+                  ue.metric = sum;
                 }// end tdUeSet
-        
+
               for (int i = 0; i < rbgNum; i++)
                 {
-                  if (rbgMap.at (i) == true)
+                  if (!m_dlCore.IsRbgFree (i))
                     continue;
 
-                  std::map <uint16_t, pssFlowPerf_t>::iterator itMax = tdUeSet.end ();
+                  FfMacSchedulerCore::Ue* ueMax = 0;
                   double metricMax = 0.0;
-                  for (it = tdUeSet.begin (); it != tdUeSet.end (); it++)
+                  for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
                     {
-                      if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
+                      FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+                      if (!ue.selected)
+                        continue;
+                      if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, ue.rnti)) == false)
                         continue;
 
-                      // calculate PF weight 
-                      double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
+                      // calculate PF weight
+                      double weight = m_dlUeFlows[u]->targetThroughput / m_dlUeFlows[u]->lastAveragedThroughput;
                       if (weight < 1.0)
                         weight = 1.0;
-        
-                      std::map < uint16_t, uint8_t>::iterator itSbCqiSum;
-                      itSbCqiSum = sbCqiSum.find((*it).first);
-        
-                      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-                      itCqi = m_a30CqiRxed.find ((*it).first);
-                      std::map <uint16_t,uint8_t>::iterator itTxMode;
-                      itTxMode = m_uesTxMode.find ((*it).first);
-                      if (itTxMode == m_uesTxMode.end())
-                        {
-                          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                        }
-                      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-                      std::vector <uint8_t> sbCqis;
-                      if (itCqi == m_a30CqiRxed.end ())
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                              sbCqis.push_back (1);  // start with lowest value
-                            }
-                        }
-                      else
-                        {
-                          sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                        }
-        
-                      uint8_t cqi1 = sbCqis.at( 0);
+
+                      const std::vector <uint8_t>& sbCqis = m_dlCore.GetSbCqi (ue, i);
+                      uint8_t cqi1 = sbCqis.at (0);
                       uint8_t cqi2 = 0;
                       if (sbCqis.size () > 1)
                         {
-                          cqi2 = sbCqis.at(1);
+                          cqi2 = sbCqis.at (1);
                         }
-            
+
                       uint8_t sbCqi = 0;
                       double colMetric = 0.0;
                       if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                         {
-                          for (uint8_t k = 0; k < nLayer; k++) 
+                          for (uint8_t k = 0; k < ue.nLayers; k++)
                             {
                               if (sbCqis.size () > k)
-                                {                       
-                                  sbCqi = sbCqis.at(k);
+                                {
+                                  sbCqi = sbCqis.at (k);
                                 }
                               else
                                 {
-                                  // no info on this subband 
+                                  // no info on this subband
                                   sbCqi = 0;
                                 }
-                              colMetric += (double)sbCqi / (double)(*itSbCqiSum).second;
-           	                } 
+                              colMetric += (double)sbCqi / ue.metric;
+                            }
                         }   // end if cqi
-        
+
                       double metric = 0.0;
                       if (colMetric != 0)
                         metric= weight * colMetric;
                       else
                         metric = 1;
-        
+
                       if (metric > metricMax )
                         {
                           metricMax = metric;
-                          itMax = it;
+                          ueMax = &ue;
                         }
                     } // end of tdUeSet
 
-                  if (itMax == tdUeSet.end ())
+                  if (ueMax == 0)
                     {
                       // no UE available for downlink
                     }
                   else
                     {
-                      allocationMap[(*itMax).first].push_back (i);
-                      rbgMap.at (i) = true;
+                      m_dlCore.AllocateRbg (*ueMax, i);
                     }
                 }// end of rbgNum
-        
+
             }// end of CoIta
-        
-        
+
+
           if ( m_fdSchedulerType.compare("PFsch") == 0)
             {
               // FD scheduler: Proportional Fair scheduled (PFsch)
               for (int i = 0; i < rbgNum; i++)
                 {
-                  if (rbgMap.at (i) == true)
+                  if (!m_dlCore.IsRbgFree (i))
                     continue;
 
-                  std::map <uint16_t, pssFlowPerf_t>::iterator itMax = tdUeSet.end ();
+                  FfMacSchedulerCore::Ue* ueMax = 0;
                   double metricMax = 0.0;
-                  for (it = tdUeSet.begin (); it != tdUeSet.end (); it++)
+                  for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
                     {
-                      if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
+                      FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+                      if (!ue.selected)
+                        continue;
+                      if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, ue.rnti)) == false)
                         continue;
-                      // calculate PF weight 
-                      double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
+                      // calculate PF weight
+                      double weight = m_dlUeFlows[u]->targetThroughput / m_dlUeFlows[u]->lastAveragedThroughput;
                       if (weight < 1.0)
                         weight = 1.0;
-        
-                      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-                      itCqi = m_a30CqiRxed.find ((*it).first);
-                      std::map <uint16_t,uint8_t>::iterator itTxMode;
-                      itTxMode = m_uesTxMode.find ((*it).first);
-                      if (itTxMode == m_uesTxMode.end())
-                        {
-                          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                        }
-                      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-                      std::vector <uint8_t> sbCqis;
-                      if (itCqi == m_a30CqiRxed.end ())
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                              sbCqis.push_back (1);  // start with lowest value
-                            }
-                        }
-                      else
-                        {
-                          sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                        }
-        
+
+                      const std::vector <uint8_t>& sbCqis = m_dlCore.GetSbCqi (ue, i);
                       uint8_t cqi1 = sbCqis.at(0);
                       uint8_t cqi2 = 0;
                       if (sbCqis.size () > 1)
                         {
                           cqi2 = sbCqis.at(1);
                         }
-                
+
                       double schMetric = 0.0;
                       if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                         {
                           double achievableRate = 0.0;
-                          for (uint8_t k = 0; k < nLayer; k++) 
+                          for (uint8_t k = 0; k < ue.nLayers; k++)
                             {
                               uint8_t mcs = 0;
                               if (sbCqis.size () > k)
-                                {                       
-                                  mcs = m_amc->GetMcsFromCqi (sbCqis.at (k));
+                                {
+                                  mcs = m_dlCore.GetMcsFromCqi (sbCqis.at (k));
                                 }
                               else
                                 {
                                   // no info on this subband  -> worst MCS
                                   mcs = 0;
                                 }
-                              achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001); // = TB size / TTI
-            	  	    }
-                          schMetric = achievableRate / (*it).second.secondLastAveragedThroughput;
+                              achievableRate += m_dlCore.GetRbgRate (mcs); // = TB size / TTI
+                            }
+                          schMetric = achievableRate / m_dlUeFlows[u]->secondLastAveragedThroughput;
                         }   // end if cqi
-         
+
                       double metric = 0.0;
                       metric= weight * schMetric;
-         
+
                       if (metric > metricMax )
                         {
                           metricMax = metric;
-                          itMax = it;
+                          ueMax = &ue;
                         }
                     } // end of tdUeSet
 
-                  if (itMax == tdUeSet.end ())
+                  if (ueMax == 0)
                     {
-                      // no UE available for downlink 
+                      // no UE available for downlink
                     }
                   else
                     {
-                      allocationMap[(*itMax).first].push_back (i);
-                      rbgMap.at (i) = true;
+                      m_dlCore.AllocateRbg (*ueMax, i);
                     }
-         
+
                 }// end of rbgNum
-        
+
             } // end of PFsch
 
         } // end if ueSet1 || ueSet2
-    
+
     } // end if ueSet
 
 
@@ -1368,103 +1273,100 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
 
   // generate the transmission opportunities by grouping the RBGs of the same RNTI and
   // creating the correspondent DCIs
-  std::map <uint16_t, std::vector <uint16_t> >::iterator itMap = allocationMap.begin ();
-  while (itMap != allocationMap.end ())
+  for (uint32_t u = 0; u < m_dlCore.GetUeNum (); u++)
     {
+      FfMacSchedulerCore::Ue& ue = m_dlCore.GetUe (u);
+      if (ue.rbgMask == 0)
+        {
+          continue;
+        }
       // create new BuildDataListElement_s for this LC
       BuildDataListElement_s newEl;
-      newEl.m_rnti = (*itMap).first;
+      newEl.m_rnti = ue.rnti;
       // create the DlDciListElement_s
       DlDciListElement_s newDci;
-      newDci.m_rnti = (*itMap).first;
-      newDci.m_harqProcess = UpdateHarqProcessId ((*itMap).first);
+      newDci.m_rnti = ue.rnti;
+      newDci.m_harqProcess = UpdateHarqProcessId (ue.rnti);
 
-      uint16_t lcActives = LcActivePerFlow ((*itMap).first);
+      uint16_t lcActives = ue.lcActives;
       NS_LOG_INFO (this << "Allocate user " << newEl.m_rnti << " rbg " << lcActives);
       if (lcActives == 0)
         {
           // Set to max value, to avoid divide by 0 below
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
-      uint16_t RgbPerRnti = (*itMap).second.size ();
-      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-      itCqi = m_a30CqiRxed.find ((*itMap).first);
-      std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
-      if (itTxMode == m_uesTxMode.end ())
+      uint16_t RgbPerRnti = 0;
+      int nLayer = ue.nLayers;
+      uint8_t worstCqi[2] = {15, 15};
+      for (int k = 0; k < rbgNum; k++)
         {
-          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
-        }
-      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-      std::vector <uint8_t> worstCqi (2, 15);
-      if (itCqi != m_a30CqiRxed.end ())
-        {
-          for (uint16_t k = 0; k < (*itMap).second.size (); k++)
+          if ((ue.rbgMask & (0x1 << k)) == 0)
+            {
+              continue;
+            }
+          RgbPerRnti++;
+          NS_LOG_INFO (this << " Allocated RBG " << k);
+          if (ue.sbCqi == 0)
+            {
+              continue;
+            }
+          if (ue.sbCqi->m_higherLayerSelected.size () > (uint16_t) k)
             {
-              if ((*itCqi).second.m_higherLayerSelected.size () > (*itMap).second.at (k))
+              const std::vector <uint8_t>& sbCqi = ue.sbCqi->m_higherLayerSelected.at (k).m_sbCqi;
+              NS_LOG_INFO (this << " RBG " << k << " CQI " << (uint16_t)(sbCqi.at (0)) );
+              for (uint8_t j = 0; j < nLayer; j++)
                 {
-                  NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (0)) );
-                  for (uint8_t j = 0; j < nLayer; j++)
+                  if (sbCqi.size () > j)
                     {
-                      if ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.size () > j)
-                        {
-                          if (((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j)) < worstCqi.at (j))
-                            {
-                              worstCqi.at (j) = ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j));
-                            }
-                        }
-                      else
+                      if (sbCqi.at (j) < worstCqi[j])
                         {
-                          // no CQI for this layer of this suband -> worst one
-                          worstCqi.at (j) = 1;
+                          worstCqi[j] = sbCqi.at (j);
                         }
                     }
-                }
-              else
-                {
-                  for (uint8_t j = 0; j < nLayer; j++)
+                  else
                     {
-                      worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
+                      // no CQI for this layer of this suband -> worst one
+                      worstCqi[j] = 1;
                     }
                 }
             }
+          else
+            {
+              for (uint8_t j = 0; j < nLayer; j++)
+                {
+                  worstCqi[j] = 1; // try with lowest MCS in RBG with no info on channel
+                }
+            }
         }
-      else
+      if (ue.sbCqi == 0)
         {
           for (uint8_t j = 0; j < nLayer; j++)
             {
-              worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
+              worstCqi[j] = 1; // try with lowest MCS in RBG with no info on channel
             }
         }
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi.at (j));
+          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi[j]);
         }
       uint32_t bytesTxed = 0;
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          newDci.m_mcs.push_back (m_amc->GetMcsFromCqi (worstCqi.at (j)));
+          newDci.m_mcs.push_back (m_dlCore.GetMcsFromCqi (worstCqi[j]));
           int tbSize = (m_amc->GetDlTbSizeFromMcs (newDci.m_mcs.at (j), RgbPerRnti * rbgSize) / 8); // (size of TB in bytes according to table 7.1.7.2.1-1 of 36.213)
           newDci.m_tbsSize.push_back (tbSize);
-          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " MCS selected" << m_amc->GetMcsFromCqi (worstCqi.at (j)));
+          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " MCS selected" << (uint16_t)newDci.m_mcs.at (j));
           bytesTxed += tbSize;
         }
 
       newDci.m_resAlloc = 0;  // only allocation type 0 at this stage
-      newDci.m_rbBitmap = 0; // TBD (32 bit bitmap see 7.1.6 of 36.213)
-      uint32_t rbgMask = 0;
-      for (uint16_t k = 0; k < (*itMap).second.size (); k++)
-        {
-          rbgMask = rbgMask + (0x1 << (*itMap).second.at (k));
-          NS_LOG_INFO (this << " Allocated RBG " << (*itMap).second.at (k));
-        }
-      newDci.m_rbBitmap = rbgMask; // (32 bit bitmap see 7.1.6 of 36.213)
+      newDci.m_rbBitmap = ue.rbgMask; // (32 bit bitmap see 7.1.6 of 36.213)
 
       // create the rlc PDUs -> equally divide resources among actives LCs
       std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itBufReq;
-      for (itBufReq = m_rlcBufferReq.begin (); itBufReq != m_rlcBufferReq.end (); itBufReq++)
+      for (itBufReq = m_rlcBufferReq.lower_bound (LteFlowId_t (ue.rnti, 0)); itBufReq != m_rlcBufferReq.end (); itBufReq++)
         {
-          if (((*itBufReq).first.m_rnti == (*itMap).first)
+          if (((*itBufReq).first.m_rnti == ue.rnti)
               && (((*itBufReq).second.m_rlcTransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcRetransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcStatusPduSize > 0) ))
@@ -1481,17 +1383,17 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
                   if (m_harqOn == true)
                     {
                       // store RLC PDU list for HARQ
-                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find ((*itMap).first);
+                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (ue.rnti);
                       if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
                         {
-                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << (*itMap).first);
+                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << ue.rnti);
                         }
                       (*itRlcPdu).second.at (j).at (newDci.m_harqProcess).push_back (newRlcEl);
                     }
                 }
               newEl.m_rlcPduList.push_back (newRlcPduLe);
             }
-          if ((*itBufReq).first.m_rnti > (*itMap).first)
+          if ((*itBufReq).first.m_rnti > ue.rnti)
             {
               break;
             }
@@ -1502,7 +1404,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
           newDci.m_rv.push_back (0);
         }
 
-      newDci.m_tpc = m_ffrSapProvider->GetTpc ((*itMap).first);
+      newDci.m_tpc = m_ffrSapProvider->GetTpc (ue.rnti);
 
       newEl.m_dci = newDci;
 
@@ -1528,22 +1430,9 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
 
       ret.m_buildDataList.push_back (newEl);
       // update UE stats
-      std::map <uint16_t, pssFlowPerf_t>::iterator it;
-      it = m_flowStatsDl.find ((*itMap).first);
-      if (it != m_flowStatsDl.end ())
-        {
-          (*it).second.lastTtiBytesTransmitted = bytesTxed;
-          NS_LOG_INFO (this << " UE total bytes txed " << (*it).second.lastTtiBytesTransmitted);
-
-
-        }
-      else
-        {
-          NS_FATAL_ERROR (this << " No Stats for this allocated UE");
-        }
-
-      itMap++;
-    } // end while allocation
+      m_dlUeFlows[u]->lastTtiBytesTransmitted = bytesTxed;
+      NS_LOG_INFO (this << " UE total bytes txed " << m_dlUeFlows[u]->lastTtiBytesTransmitted);
+    } // end for allocated UEs
   ret.m_nrOfPdcchOfdmSymbols = 1;   /// \todo check correct value according the DCIs txed
 
 
@@ -1551,9 +1440,8 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
   NS_LOG_INFO (this << " Update UEs statistics");
   for (itStats = m_flowStatsDl.begin (); itStats != m_flowStatsDl.end (); itStats++)
     { 
-      std::map <uint16_t, pssFlowPerf_t>::iterator itUeScheduleted = tdUeSet.end();
-      itUeScheduleted = tdUeSet.find((*itStats).first);
-      if (itUeScheduleted != tdUeSet.end())
+      FfMacSchedulerCore::Ue* ueScheduled = m_dlCore.FindUe ((*itStats).first);
+      if (ueScheduled != 0 && ueScheduled->selected)
         {
           (*itStats).second.secondLastAveragedThroughput = ((1.0 - (1 / m_timeWindow)) * (*itStats).second.secondLastAveragedThroughput) + ((1 / m_timeWindow) * (double)((*itStats).second.lastTtiBytesTransmitted / 0.001));
         }
@@ -31,6 +31,7 @@
 #include <ns3/nstime.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
+#include <ns3/ff-mac-scheduler-core.h>
 
 // value for SINR outside the range defined by FF-API, used to indicate that there
 // is no CQI for this element
@@ -425,6 +426,12 @@ private:
   std::vector <uint16_t> m_rachAllocationMap; ///< RACH allocation map
   uint8_t m_ulGrantMcs; ///< MCS for UL grant (default 0)
 
+  FfMacSchedulerCore m_dlCore; ///< DL state of the TTI
+  std::vector <pssFlowPerf_t*> m_dlUeFlows; ///< DL statistics of the UEs of m_dlCore, with the same indices
+
+  std::vector <std::pair<double, uint16_t> > m_ueSet1; ///< UEs below their target throughput, with their TD metric
+  std::vector <std::pair<double, uint16_t> > m_ueSet2; ///< UEs above their target throughput, with their TD metric
+
 };
 
 } // namespace ns3
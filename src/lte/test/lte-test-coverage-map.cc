@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/coverage-map-helper.h"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestCoverageMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the layers computed by the CoverageMapHelper for a single
+ * transmitter match the Friis path loss, and that the best server and the
+ * SINR are right for two transmitters.
+ */
+class LteCoverageMapLayersTestCase : public TestCase
+{
+public:
+  LteCoverageMapLayersTestCase ();
+  virtual ~LteCoverageMapLayersTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteCoverageMapLayersTestCase::LteCoverageMapLayersTestCase ()
+  : TestCase ("Coverage map layers")
+{
+}
+
+LteCoverageMapLayersTestCase::~LteCoverageMapLayersTestCase ()
+{
+}
+
+void
+LteCoverageMapLayersTestCase::DoRun (void)
+{
+  double frequency = 2.1e9;
+  double bandwidth = 18e6;
+  double txPowerDbm = 30.0;
+
+  Ptr<CoverageMapHelper> helper = CreateObject<CoverageMapHelper> ();
+  helper->SetAttribute ("XMin", DoubleValue (-500.0));
+  helper->SetAttribute ("XMax", DoubleValue (500.0));
+  helper->SetAttribute ("YMin", DoubleValue (-100.0));
+  helper->SetAttribute ("YMax", DoubleValue (100.0));
+  helper->SetAttribute ("XRes", UintegerValue (21));
+  helper->SetAttribute ("YRes", UintegerValue (5));
+  helper->SetAttribute ("Z", DoubleValue (1.5));
+  helper->SetAttribute ("Bandwidth", DoubleValue (bandwidth));
+  helper->SetAttribute ("NumThreads", UintegerValue (1));
+  helper->SetAttribute ("OutputFile", StringValue (""));
+  helper->AddPropagationLoss ("ns3::FriisPropagationLossModel", "Frequency", DoubleValue (frequency));
+  helper->AddTransmitter (Vector (-250.0, 0.0, 25.0), txPowerDbm);
+  helper->Run ();
+
+  Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  friis->SetFrequency (frequency);
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (-250.0, 0.0, 25.0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  double noiseDbm = -174.0 + 10 * std::log10 (bandwidth) + 9.0;
+  for (uint32_t iy = 0; iy < 5; iy++)
+    {
+      for (uint32_t ix = 0; ix < 21; ix++)
+        {
+          b->SetPosition (helper->GetPosition (ix, iy));
+          double rxPowerDbm = friis->CalcRxPower (txPowerDbm, a, b);
+          NS_TEST_ASSERT_MSG_EQ_TOL (helper->GetValue (CoverageMapHelper::RSRP, ix, iy),
+                                     rxPowerDbm - 10 * std::log10 (1200.0), 1e-3, "wrong RSRP");
+          NS_TEST_ASSERT_MSG_EQ_TOL (helper->GetValue (CoverageMapHelper::SINR, ix, iy),
+                                     rxPowerDbm - noiseDbm, 1e-3, "wrong SINR without interference");
+          NS_TEST_ASSERT_MSG_EQ (helper->GetValue (CoverageMapHelper::BEST_SERVER, ix, iy), 0, "wrong best server");
+        }
+    }
+
+  // a second transmitter, symmetric to the first one
+  helper->AddTransmitter (Vector (250.0, 0.0, 25.0), txPowerDbm);
+  helper->Run ();
+  for (uint32_t ix = 0; ix < 21; ix++)
+    {
+      uint32_t best = helper->GetValue (CoverageMapHelper::BEST_SERVER, ix, 2);
+      if (ix < 10)
+        {
+          NS_TEST_ASSERT_MSG_EQ (best, 0, "the best server on the left should be 0");
+        }
+      else if (ix > 10)
+        {
+          NS_TEST_ASSERT_MSG_EQ (best, 1, "the best server on the right should be 1");
+        }
+    }
+  // at the same distance from both transmitters the SINR is 0 dB, minus the noise
+  NS_TEST_ASSERT_MSG_EQ_TOL (helper->GetValue (CoverageMapHelper::SINR, 10, 2), 0.0, 0.01,
+                             "wrong SINR with equal interference");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the coverage map does not depend on the number of threads
+ * and on the size of the tiles, and that the output file is written.
+ */
+class LteCoverageMapThreadsTestCase : public TestCase
+{
+public:
+  LteCoverageMapThreadsTestCase ();
+  virtual ~LteCoverageMapThreadsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compute the map of three transmitters
+   *
+   * \param numThreads the number of threads
+   * \param tileSize the size of the tiles
+   * \param outputFile the output file
+   * \return the helper, after the computation of the map
+   */
+  Ptr<CoverageMapHelper> ComputeMap (uint32_t numThreads, uint32_t tileSize, std::string outputFile);
+};
+
+LteCoverageMapThreadsTestCase::LteCoverageMapThreadsTestCase ()
+  : TestCase ("Coverage map with threads")
+{
+}
+
+LteCoverageMapThreadsTestCase::~LteCoverageMapThreadsTestCase ()
+{
+}
+
+Ptr<CoverageMapHelper>
+LteCoverageMapThreadsTestCase::ComputeMap (uint32_t numThreads, uint32_t tileSize, std::string outputFile)
+{
+  Ptr<CoverageMapHelper> helper = CreateObject<CoverageMapHelper> ();
+  helper->SetAttribute ("XMin", DoubleValue (0.0));
+  helper->SetAttribute ("XMax", DoubleValue (1000.0));
+  helper->SetAttribute ("YMin", DoubleValue (0.0));
+  helper->SetAttribute ("YMax", DoubleValue (800.0));
+  helper->SetAttribute ("XRes", UintegerValue (101));
+  helper->SetAttribute ("YRes", UintegerValue (81));
+  helper->SetAttribute ("NumThreads", UintegerValue (numThreads));
+  helper->SetAttribute ("TileSize", UintegerValue (tileSize));
+  helper->SetAttribute ("OutputFile", StringValue (outputFile));
+  helper->AddPropagationLoss ("ns3::LogDistancePropagationLossModel", "Exponent", DoubleValue (3.5));
+  helper->AddPropagationLoss ("ns3::RangePropagationLossModel", "MaxRange", DoubleValue (900.0));
+  helper->AddTransmitter (Vector (100.0, 100.0, 30.0), 43.0);
+  helper->AddTransmitter (Vector (800.0, 200.0, 30.0), 40.0);
+  helper->AddTransmitter (Vector (500.0, 700.0, 30.0), 46.0);
+  helper->Run ();
+  return helper;
+}
+
+void
+LteCoverageMapThreadsTestCase::DoRun (void)
+{
+  std::string outputFile = CreateTempDirFilename ("coverage.bin");
+  Ptr<CoverageMapHelper> reference = ComputeMap (1, 32, outputFile);
+  Ptr<CoverageMapHelper> threaded = ComputeMap (4, 7, "");
+
+  for (uint32_t l = 0; l < CoverageMapHelper::NUM_LAYERS; l++)
+    {
+      CoverageMapHelper::Layer layer = static_cast<CoverageMapHelper::Layer> (l);
+      for (uint32_t iy = 0; iy < 81; iy++)
+        {
+          for (uint32_t ix = 0; ix < 101; ix++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (threaded->GetValue (layer, ix, iy), reference->GetValue (layer, ix, iy),
+                                     "layer " << l << " differs at (" << ix << ", " << iy << ")");
+            }
+        }
+    }
+
+  std::ifstream in (outputFile.c_str (), std::ios::binary);
+  NS_TEST_ASSERT_MSG_EQ (in.is_open (), true, "output file not written");
+  std::vector<float> values (CoverageMapHelper::NUM_LAYERS * 101 * 81);
+  in.read (reinterpret_cast<char *> (&values[0]), values.size () * sizeof (float));
+  NS_TEST_ASSERT_MSG_EQ (in.gcount (), static_cast<std::streamsize> (values.size () * sizeof (float)),
+                         "wrong size of the output file");
+  // the rows are written from the max to the min y coordinate
+  NS_TEST_ASSERT_MSG_EQ (values[0], reference->GetValue (CoverageMapHelper::RSRP, 0, 80), "wrong first value");
+  NS_TEST_ASSERT_MSG_EQ (values[101 * 81 + 100], reference->GetValue (CoverageMapHelper::SINR, 100, 80),
+                         "wrong first row of the SINR layer");
+  NS_TEST_ASSERT_MSG_EQ (values.back (), reference->GetValue (CoverageMapHelper::BEST_SERVER, 100, 0),
+                         "wrong last value");
+
+  std::ifstream header ((outputFile + ".hdr").c_str ());
+  std::string line;
+  std::getline (header, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "ENVI", "wrong header file");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the CoverageMapHelper.
+ */
+class LteCoverageMapTestSuite : public TestSuite
+{
+public:
+  LteCoverageMapTestSuite ();
+};
+
+static LteCoverageMapTestSuite g_lteCoverageMapTestSuite;
+
+LteCoverageMapTestSuite::LteCoverageMapTestSuite ()
+  : TestSuite ("lte-coverage-map", UNIT)
+{
+  AddTestCase (new LteCoverageMapLayersTestCase (), TestCase::QUICK);
+  AddTestCase (new LteCoverageMapThreadsTestCase (), TestCase::QUICK);
+}
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/lte-amc.h"
+#include "ns3/ff-mac-scheduler-core.h"
+
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the RBG allocation of FfMacSchedulerCore: the RBGs not
+ * available are allocated at the start of the TTI, the RBGs of the UEs are
+ * accumulated in their mask, and the state of the TTI is forgotten at the
+ * start of the next one.
+ */
+class FfMacSchedulerCoreRbgTestCase : public TestCase
+{
+public:
+  FfMacSchedulerCoreRbgTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FfMacSchedulerCoreRbgTestCase::FfMacSchedulerCoreRbgTestCase ()
+  : TestCase ("RBG allocation of the FF MAC scheduler core")
+{
+}
+
+void
+FfMacSchedulerCoreRbgTestCase::DoRun (void)
+{
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  FfMacSchedulerCore core;
+  std::vector<bool> availableRbgs (13, false);
+  availableRbgs[0] = true;
+  availableRbgs[12] = true;
+  core.StartTti (amc, 2, 13, availableRbgs);
+  NS_TEST_ASSERT_MSG_EQ (core.GetRbgMask (), 0x1001, "RBGs of the FFR not allocated");
+  NS_TEST_ASSERT_MSG_EQ (core.IsRbgFree (0), false, "RBG 0 free");
+  NS_TEST_ASSERT_MSG_EQ (core.IsRbgFree (1), true, "RBG 1 allocated");
+
+  core.SetRntiAllocated (9);
+  NS_TEST_ASSERT_MSG_EQ (core.IsRntiAllocated (9), true, "RNTI 9 not allocated");
+  NS_TEST_ASSERT_MSG_EQ (core.IsRntiAllocated (4), false, "RNTI 4 allocated");
+  NS_TEST_ASSERT_MSG_EQ (core.IsRntiAllocated (1000), false, "unknown RNTI allocated");
+
+  core.AddUe (4);
+  core.AddUe (7);
+  NS_TEST_ASSERT_MSG_EQ (core.GetUeNum (), 2, "wrong number of UEs");
+  NS_TEST_ASSERT_MSG_EQ (core.FindUe (7)->rnti, 7, "wrong UE found");
+  NS_TEST_ASSERT_MSG_EQ ((core.FindUe (5) == 0), true, "unknown UE found");
+  core.AllocateRbg (core.GetUe (1), 3);
+  core.AllocateRbg (core.GetUe (1), 5);
+  core.AllocateRbg (core.GetUe (0), 4);
+  NS_TEST_ASSERT_MSG_EQ (core.GetUe (1).rbgMask, 0x28, "wrong RBG mask of the UE");
+  NS_TEST_ASSERT_MSG_EQ (core.GetRbgMask (), 0x1039, "wrong RBG mask");
+  NS_TEST_ASSERT_MSG_EQ (core.IsRbgMapFull (), false, "RBG map full");
+  core.SetRbgMask (0x1fff);
+  NS_TEST_ASSERT_MSG_EQ (core.IsRbgMapFull (), true, "RBG map not full");
+
+  // the next TTI starts without any allocation
+  core.StartTti (amc, 2, 13, std::vector<bool> (13, false));
+  NS_TEST_ASSERT_MSG_EQ (core.GetRbgMask (), 0, "RBGs still allocated");
+  NS_TEST_ASSERT_MSG_EQ (core.IsRntiAllocated (9), false, "RNTI 9 still allocated");
+  NS_TEST_ASSERT_MSG_EQ (core.GetUeNum (), 0, "UEs not removed");
+  NS_TEST_ASSERT_MSG_EQ ((core.FindUe (7) == 0), true, "UE of the last TTI found");
+  FfMacSchedulerCore::Ue& ue = core.AddUe (7);
+  NS_TEST_ASSERT_MSG_EQ (ue.rbgMask, 0, "RBG mask of the UE not reset");
+  NS_TEST_ASSERT_MSG_EQ (ue.selected, false, "UE selected");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the per-UE state of FfMacSchedulerCore: the active LCs are
+ * counted per UE, the UEs without subband CQIs get the lowest CQI on each
+ * layer, and the tabulated rates match the AMC.
+ */
+class FfMacSchedulerCoreUeTestCase : public TestCase
+{
+public:
+  FfMacSchedulerCoreUeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FfMacSchedulerCoreUeTestCase::FfMacSchedulerCoreUeTestCase ()
+  : TestCase ("UE state of the FF MAC scheduler core")
+{
+}
+
+void
+FfMacSchedulerCoreUeTestCase::DoRun (void)
+{
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  FfMacSchedulerCore core;
+  core.StartTti (amc, 3, 8, std::vector<bool> (8, false));
+  core.AddUe (1);
+  core.AddUe (2);
+  core.AddUe (5);
+
+  std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> rlcBufferReq;
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters empty;
+  empty.m_rlcTransmissionQueueSize = 0;
+  empty.m_rlcRetransmissionQueueSize = 0;
+  empty.m_rlcStatusPduSize = 0;
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters tx = empty;
+  tx.m_rlcTransmissionQueueSize = 100;
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters status = empty;
+  status.m_rlcStatusPduSize = 10;
+  rlcBufferReq[LteFlowId_t (1, 1)] = status;
+  rlcBufferReq[LteFlowId_t (1, 3)] = tx;
+  rlcBufferReq[LteFlowId_t (1, 4)] = empty;
+  rlcBufferReq[LteFlowId_t (3, 3)] = tx;
+  rlcBufferReq[LteFlowId_t (5, 3)] = tx;
+  core.CountActiveLcs (rlcBufferReq);
+  NS_TEST_ASSERT_MSG_EQ (core.FindUe (1)->lcActives, 2, "wrong number of active LCs of UE 1");
+  NS_TEST_ASSERT_MSG_EQ (core.FindUe (2)->lcActives, 0, "wrong number of active LCs of UE 2");
+  NS_TEST_ASSERT_MSG_EQ (core.FindUe (5)->lcActives, 1, "wrong number of active LCs of UE 5");
+
+  FfMacSchedulerCore::Ue& ue = core.GetUe (0);
+  ue.nLayers = 2;
+  NS_TEST_ASSERT_MSG_EQ (core.GetSbCqi (ue, 4).size (), 2, "wrong number of layers without CQI");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) core.GetSbCqi (ue, 4).at (1), 1, "wrong CQI without CQI");
+  SbMeasResult_s sbCqi;
+  sbCqi.m_higherLayerSelected.resize (8);
+  sbCqi.m_higherLayerSelected.at (4).m_sbCqi.push_back (11);
+  ue.sbCqi = &sbCqi;
+  NS_TEST_ASSERT_MSG_EQ (core.GetSbCqi (ue, 4).size (), 1, "wrong number of layers of the CQI");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) core.GetSbCqi (ue, 4).at (0), 11, "wrong subband CQI");
+
+  for (int cqi = 0; cqi < 16; cqi++)
+    {
+      int mcs = amc->GetMcsFromCqi (cqi);
+      NS_TEST_ASSERT_MSG_EQ ((int) core.GetMcsFromCqi (cqi), mcs, "wrong MCS of CQI " << cqi);
+      NS_TEST_ASSERT_MSG_EQ (core.GetRbgRate (mcs), ((amc->GetDlTbSizeFromMcs (mcs, 3) / 8) / 0.001),
+                             "wrong rate of MCS " << mcs);
+    }
+  // the rates follow the RBG size
+  core.StartTti (amc, 4, 25, std::vector<bool> (25, false));
+  NS_TEST_ASSERT_MSG_EQ (core.GetRbgRate (28), ((amc->GetDlTbSizeFromMcs (28, 4) / 8) / 0.001),
+                         "rate not updated with the RBG size");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of FfMacSchedulerCore.
+ */
+class FfMacSchedulerCoreTestSuite : public TestSuite
+{
+public:
+  FfMacSchedulerCoreTestSuite ();
+};
+
+FfMacSchedulerCoreTestSuite::FfMacSchedulerCoreTestSuite ()
+  : TestSuite ("lte-ff-mac-scheduler-core", UNIT)
+{
+  AddTestCase (new FfMacSchedulerCoreRbgTestCase, TestCase::QUICK);
+  AddTestCase (new FfMacSchedulerCoreUeTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static FfMacSchedulerCoreTestSuite g_ffMacSchedulerCoreTestSuite;
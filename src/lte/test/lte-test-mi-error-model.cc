@@ -0,0 +1,391 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/lte-mi-error-model.h"
+#include "ns3/lte-mi-kernel.h"
+#include "ns3/lte-amc.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMiErrorModel");
+
+/// Number of RBs of the SINR profiles of the golden test
+static const uint32_t GOLDEN_NUM_RBS = 50;
+/// MCSs evaluated by the golden test
+static const uint8_t GOLDEN_MCS[] = {0, 3, 6, 9, 10, 13, 16, 17, 20, 24, 28};
+/// Number of MCSs evaluated by the golden test
+static const uint32_t GOLDEN_NUM_MCS = sizeof (GOLDEN_MCS) / sizeof (GOLDEN_MCS[0]);
+
+/**
+ * \brief Set one of the SINR profiles of the golden test
+ * \param k the index of the profile, from 0 to 3
+ * \param sinr the SINR of the GOLDEN_NUM_RBS RBs
+ * \param map the RBs of the TB
+ */
+static void
+SetGoldenProfile (uint32_t k, SpectrumValue& sinr, std::vector<int>& map)
+{
+  for (uint32_t i = 0; i < GOLDEN_NUM_RBS; i++)
+    {
+      sinr[i] = std::pow (10.0, (-9.0 + ((i * 7 + 3 * k) % 23) * 0.9 + k * 2.5) / 10.0);
+    }
+  map.clear ();
+  for (uint32_t i = 0; i < GOLDEN_NUM_RBS; i++)
+    {
+      if (k == 0 || (k == 1 && i < 6) || (k == 2 && i % 2 == 0) || (k == 3 && i >= 10 && i < 30))
+        {
+          map.push_back (i);
+        }
+    }
+}
+
+/// MI and TBLER of the first transmission of a TB
+struct GoldenTbStats
+{
+  double mi;     ///< MI
+  double tbler;  ///< TBLER
+};
+
+/// TB statistics for each profile and each MCS of GOLDEN_MCS, with a TB of 20 + 300 * k + 37 * mcs bytes
+static const GoldenTbStats g_goldenTbStats[4 * GOLDEN_NUM_MCS] = {
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0.93332683062428956 },
+  { 0.33594066, 0.99999576473112017 },
+  { 0.33594066, 1 },
+  { 0.33594066, 1 },
+  { 0.21390158000000004, 1 },
+  { 0.21390158000000004, 1 },
+  { 0.21390158000000004, 1 },
+  { 0.21390158000000004, 1 },
+
+  { 0.60804916666666664, 0 },
+  { 0.60804916666666664, 0 },
+  { 0.60804916666666664, 0 },
+  { 0.60804916666666664, 0.030564384712214399 },
+  { 0.34399433333333335, 0.99999797997772077 },
+  { 0.34399433333333335, 1 },
+  { 0.34399433333333335, 1 },
+  { 0.22409966666666667, 1 },
+  { 0.22409966666666667, 1 },
+  { 0.22409966666666667, 1 },
+  { 0.22409966666666667, 1 },
+
+  { 0.77987731999999999, 0 },
+  { 0.77987731999999999, 0 },
+  { 0.77987731999999999, 0 },
+  { 0.77987731999999999, 0 },
+  { 0.57300140000000011, 0 },
+  { 0.57300140000000011, 0 },
+  { 0.57300140000000011, 1 },
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 1 },
+
+  { 0.86696350000000011, 0 },
+  { 0.86696350000000011, 0 },
+  { 0.86696350000000011, 0 },
+  { 0.86696350000000011, 0 },
+  { 0.67601175000000002, 0 },
+  { 0.67601175000000002, 0 },
+  { 0.67601175000000002, 0.011248733888131079 },
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1 },
+};
+
+/**
+ * TB statistics of three transmissions of a TB, for each profile, with
+ * MCS GOLDEN_MCS[3 * k + 1], each transmission being added to the HARQ
+ * history with half its MI
+ */
+static const GoldenTbStats g_goldenHarqTbStats[4 * 3] = {
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0 },
+
+  { 0.34399433333333335, 0.99999797997772077 },
+  { 0.34399433333333335, 6.757909622567837e-06 },
+  { 0.34399433333333335, 0.34949381761337067 },
+
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 0.056304482477216977 },
+  { 0.37673751999999999, 0 },
+
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1.6122023749343128e-07 },
+  { 0.46350824999999996, 0 },
+};
+
+/// A point of the BLER curve of a CB
+struct GoldenCbBler
+{
+  uint8_t ecrId;   ///< ECR id
+  uint16_t cbSize; ///< CB size
+  double mib;      ///< MIB
+  double bler;     ///< CB BLER
+};
+
+/// Points of the BLER curves of the CBs, including CB sizes without a curve for the ECR
+static const GoldenCbBler g_goldenCbBler[] = {
+  { 0, 104, 0.0208, 0.32092409438603747 },
+  { 0, 1000, 0.0171, 0.35005010933593556 },
+  { 0, 6144, 0.0161, 0.37284625297891449 },
+  { 5, 104, 0.2012, 0.30007196387040946 },
+  { 5, 1000, 0.1724, 0.30050947226549707 },
+  { 5, 6144, 0.1628, 0.30853753872598799 },
+  { 12, 104, 0.6233, 0.30134085995694404 },
+  { 12, 1000, 0.6233, 0.30134085995694404 },
+  { 12, 6144, 0.5920, 0.30853753872598572 },
+  { 14, 104, 0.1887, 0.30692172427983666 },
+  { 14, 1000, 0.1887, 0.30692172427983666 },
+  { 14, 6144, 0.1792, 0.30603443185578882 },
+  { 20, 104, 0.5679, 0.30111844946824889 },
+  { 20, 1000, 0.5679, 0.30111844946824889 },
+  { 20, 6144, 0.5442, 0.30337928113819845 },
+  { 25, 104, 0.2959, 0.30324694444218236 },
+  { 25, 1000, 0.2959, 0.30324694444218236 },
+  { 25, 6144, 0.2783, 0.30957992140166513 },
+  { 33, 104, 0.7937, 0.30278982236042484 },
+  { 33, 1000, 0.7937, 0.30278982236042484 },
+  { 33, 6144, 0.7883, 0.30415056015288028 },
+};
+
+/// PCFICH-PDCCH error rate for each profile, scaled by 0.05
+static const double g_goldenPcfichPdcchError[4] = {
+  0.61942900000000001,
+  0.27999400000000002,
+  0.064587099999999995,
+  0.0119524,
+};
+
+/// CQI of each RBG of size 3, for each profile
+static const int g_goldenCqi[4][17] = {
+  { 2, 4, 4, 3, 6, 4, 4, 3, 5, 4, 4, 3, 6, 4, 3, 3, 7 },
+  { 4, 4, 7, 6, 4, 4, 7, 6, 4, 7, 7, 5, 4, 4, 7, 4, 4 },
+  { 8, 7, 6, 4, 7, 7, 6, 8, 7, 7, 6, 8, 7, 7, 5, 8, 7 },
+  { 7, 9, 8, 8, 7, 9, 8, 7, 7, 9, 8, 7, 10, 9, 8, 7, 4 }
+};
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that LteMiErrorModel and the MI based LteAmc give exactly the
+ * values that they gave with their own copy of the MI tables, before the
+ * tables and the computations were shared with the mmWave error model in
+ * LteMiKernel.
+ */
+class LteMiErrorModelGoldenTestCase : public TestCase
+{
+public:
+  LteMiErrorModelGoldenTestCase ();
+  virtual ~LteMiErrorModelGoldenTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelGoldenTestCase::LteMiErrorModelGoldenTestCase ()
+  : TestCase ("MI error model golden values")
+{
+}
+
+LteMiErrorModelGoldenTestCase::~LteMiErrorModelGoldenTestCase ()
+{
+}
+
+void
+LteMiErrorModelGoldenTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < GOLDEN_NUM_RBS; i++)
+    {
+      freqs.push_back (2.12e9 + i * 180e3);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  amc->SetAttribute ("AmcModel", EnumValue (LteAmc::MiErrorModel));
+
+  for (uint32_t k = 0; k < 4; k++)
+    {
+      SpectrumValue sinr (sm);
+      std::vector<int> map;
+      SetGoldenProfile (k, sinr, map);
+
+      HarqProcessInfoList_t harqInfoList;
+      for (uint32_t j = 0; j < GOLDEN_NUM_MCS; j++)
+        {
+          uint8_t mcs = GOLDEN_MCS[j];
+          TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, 20 + 300 * k + 37 * mcs, mcs, harqInfoList);
+          const GoldenTbStats& expected = g_goldenTbStats[k * GOLDEN_NUM_MCS + j];
+          NS_TEST_ASSERT_MSG_EQ (stats.mi, expected.mi, "Wrong MI, profile " << k << " MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (stats.tbler, expected.tbler, "Wrong TBLER, profile " << k << " MCS " << (uint16_t) mcs);
+        }
+
+      uint8_t mcs = GOLDEN_MCS[3 * k + 1];
+      uint16_t size = 20 + 300 * k + 37 * mcs;
+      for (uint32_t tx = 0; tx < 3; tx++)
+        {
+          TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, size, mcs, harqInfoList);
+          const GoldenTbStats& expected = g_goldenHarqTbStats[k * 3 + tx];
+          NS_TEST_ASSERT_MSG_EQ (stats.mi, expected.mi, "Wrong MI, profile " << k << " transmission " << tx);
+          NS_TEST_ASSERT_MSG_EQ (stats.tbler, expected.tbler, "Wrong TBLER, profile " << k << " transmission " << tx);
+          HarqProcessInfoElement_t el;
+          el.m_mi = stats.mi * 0.5;
+          el.m_rv = tx;
+          el.m_infoBits = size * 8;
+          el.m_codeBits = size * 8 / 0.6;
+          harqInfoList.push_back (el);
+        }
+
+      SpectrumValue controlSinr = sinr * 0.05;
+      NS_TEST_ASSERT_MSG_EQ (LteMiErrorModel::GetPcfichPdcchError (controlSinr), g_goldenPcfichPdcchError[k],
+                             "Wrong PCFICH-PDCCH error rate, profile " << k);
+
+      std::vector<int> cqi = amc->CreateCqiFeedbacks (sinr, 3);
+      NS_TEST_ASSERT_MSG_EQ (cqi.size (), 51u, "Wrong number of CQIs");
+      for (uint32_t rbg = 0; rbg < 17; rbg++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (cqi[rbg * 3], g_goldenCqi[k][rbg], "Wrong CQI, profile " << k << " RBG " << rbg);
+        }
+    }
+
+  for (uint32_t i = 0; i < sizeof (g_goldenCbBler) / sizeof (g_goldenCbBler[0]); i++)
+    {
+      const GoldenCbBler& p = g_goldenCbBler[i];
+      NS_TEST_ASSERT_MSG_EQ (LteMiErrorModel::MappingMiBler (p.mib, p.ecrId, p.cbSize), p.bler,
+                             "Wrong CB BLER, ECR id " << (uint16_t) p.ecrId << " CB size " << p.cbSize);
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the MIB of all the modulations computed at once by
+ * LteMiKernel::GetMibs, on chunks of RBs, gives exactly the same TB
+ * statistics as the evaluation of each MCS on the SINR.
+ */
+class LteMiKernelMibsTestCase : public TestCase
+{
+public:
+  LteMiKernelMibsTestCase ();
+  virtual ~LteMiKernelMibsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiKernelMibsTestCase::LteMiKernelMibsTestCase ()
+  : TestCase ("MIB of all the modulations")
+{
+}
+
+LteMiKernelMibsTestCase::~LteMiKernelMibsTestCase ()
+{
+}
+
+void
+LteMiKernelMibsTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  // more RBs than the chunks of the kernel
+  uint32_t numRbs = 150;
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < numRbs; i++)
+    {
+      freqs.push_back (3.5e9 + i * 180e3);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+
+  // including SINRs above the MI maps
+  Ptr<UniformRandomVariable> sinrDb = CreateObject<UniformRandomVariable> ();
+  sinrDb->SetAttribute ("Min", DoubleValue (-15.0));
+  sinrDb->SetAttribute ("Max", DoubleValue (40.0));
+
+  HarqProcessInfoList_t harqInfoList;
+  for (uint32_t run = 0; run < 20; run++)
+    {
+      SpectrumValue sinr (sm);
+      for (uint32_t i = 0; i < numRbs; i++)
+        {
+          sinr[i] = std::pow (10.0, sinrDb->GetValue () / 10.0);
+        }
+      std::vector<int> map;
+      for (uint32_t i = run % 3; i < numRbs; i += 1 + run % 4)
+        {
+          map.push_back (i);
+        }
+
+      LteMibs_t mibs = LteMiErrorModel::GetMibs (sinr, map);
+      for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+          uint16_t size = 40 + 331 * run;
+          TbStats_t expected = LteMiErrorModel::GetTbDecodificationStats (sinr, map, size, mcs, harqInfoList);
+          TbStats_t actual = LteMiErrorModel::GetTbDecodificationStats (mibs, size, mcs, harqInfoList);
+          double mi = 0.0;
+          LteMiKernel::Modulation mod = LteMiKernel::GetModulation (mcs);
+          for (uint32_t i = 0; i < map.size (); i++)
+            {
+              mi += LteMiKernel::GetMi (sinr[map[i]], mod);
+            }
+          mi /= map.size ();
+          NS_TEST_ASSERT_MSG_EQ (LteMiKernel::GetMibForMcs (mibs, mcs), mi, "Different MI for MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (actual.mi, expected.mi, "Different MI for MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (actual.tbler, expected.tbler, "Different TBLER for MCS " << (uint16_t) mcs);
+        }
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the MI error model.
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+static LteMiErrorModelTestSuite g_lteMiErrorModelTestSuite;
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  AddTestCase (new LteMiErrorModelGoldenTestCase (), TestCase::QUICK);
+  AddTestCase (new LteMiKernelMibsTestCase (), TestCase::QUICK);
+}
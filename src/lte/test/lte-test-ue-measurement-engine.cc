@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/lte-ue-measurement-engine.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the layer-1 filtering of LteUeMeasurementEngine: the cells are
+ * reported sorted by cell ID, only when measured in the current period, and
+ * the RSRQ samples of the cells without an RSRP are discarded.
+ */
+class LteUeMeasurementEngineFilterTestCase : public TestCase
+{
+public:
+  LteUeMeasurementEngineFilterTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteUeMeasurementEngineFilterTestCase::LteUeMeasurementEngineFilterTestCase ()
+  : TestCase ("layer-1 filtering of the UE measurements")
+{
+}
+
+void
+LteUeMeasurementEngineFilterTestCase::DoRun (void)
+{
+  LteUeMeasurementEngine engine;
+  engine.AddRsrp (7, -80.0);
+  engine.AddRsrp (3, -90.0);
+  engine.AddRsrp (7, -82.0);
+  engine.AddRsrp (5, -100.0);
+  NS_TEST_ASSERT_MSG_EQ (engine.AddRsrq (7, -10.0), true, "RSRQ of a measured cell discarded");
+  NS_TEST_ASSERT_MSG_EQ (engine.AddRsrq (7, -12.0), true, "RSRQ of a measured cell discarded");
+  NS_TEST_ASSERT_MSG_EQ (engine.AddRsrq (4, -12.0), false, "RSRQ of an unknown cell stored");
+
+  const std::vector<LteUeMeasurementEngine::CellMeasurements>& cells = engine.GetCells ();
+  NS_TEST_ASSERT_MSG_EQ (cells.size (), 3, "wrong number of cells");
+  NS_TEST_ASSERT_MSG_EQ (cells[0].cellId, 3, "cells not sorted");
+  NS_TEST_ASSERT_MSG_EQ (cells[1].cellId, 5, "cells not sorted");
+  NS_TEST_ASSERT_MSG_EQ (cells[2].cellId, 7, "cells not sorted");
+  NS_TEST_ASSERT_MSG_EQ (cells[2].rsrpSum, -162.0, "wrong RSRP sum");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) cells[2].rsrpNum, 2, "wrong number of RSRP samples");
+  NS_TEST_ASSERT_MSG_EQ (cells[2].rsrqSum, -22.0, "wrong RSRQ sum");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) cells[2].rsrqNum, 2, "wrong number of RSRQ samples");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) cells[1].rsrqNum, 0, "wrong number of RSRQ samples");
+
+  // a new period keeps the entries, but they are not measured any more
+  engine.ResetFilter ();
+  NS_TEST_ASSERT_MSG_EQ (engine.AddRsrq (7, -10.0), false, "RSRQ of a cell without RSRP stored");
+  engine.AddRsrp (5, -101.0);
+  NS_TEST_ASSERT_MSG_EQ (cells.size (), 3, "entries not kept");
+  NS_TEST_ASSERT_MSG_EQ (cells[0].measured, false, "cell 3 measured");
+  NS_TEST_ASSERT_MSG_EQ (cells[1].measured, true, "cell 5 not measured");
+  NS_TEST_ASSERT_MSG_EQ (cells[2].measured, false, "cell 7 measured");
+  NS_TEST_ASSERT_MSG_EQ (cells[1].rsrpSum, -101.0, "RSRP sum not reset");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) cells[1].rsrpNum, 1, "number of RSRP samples not reset");
+
+  // the RSSI of the RSRQ
+  std::vector<double> freqs;
+  freqs.push_back (2.12e9);
+  freqs.push_back (2.12018e9);
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+  SpectrumValue rs (sm);
+  SpectrumValue interf (sm);
+  rs[0] = 1e-16;
+  rs[1] = 3e-16;
+  interf[0] = 2e-16;
+  interf[1] = 4e-16;
+  double expected = 2 * (1e-16 + 2e-16) * 180000.0 / 12.0 + 2 * (3e-16 + 4e-16) * 180000.0 / 12.0;
+  NS_TEST_ASSERT_MSG_EQ_TOL (LteUeMeasurementEngine::GetRssi (rs, interf), expected, expected * 1e-12, "wrong RSSI");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the subsampling of the DL-CQI by LteUeMeasurementEngine.
+ */
+class LteUeMeasurementEngineCqiTestCase : public TestCase
+{
+public:
+  LteUeMeasurementEngineCqiTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check whether a wideband CQI must be computed, and store a new one if so
+   * \param sinrDb the SINR of all the RBs, in dB
+   * \param due whether the CQI is expected to be computed
+   * \param step the description of the check
+   */
+  void CheckP10 (double sinrDb, bool due, std::string step);
+
+  LteUeMeasurementEngine m_engine; ///< the engine under test
+  Ptr<SpectrumModel> m_sm;         ///< the spectrum model of the SINR
+  uint16_t m_wbCqi;                ///< the wideband CQI of the next stored CQI
+};
+
+LteUeMeasurementEngineCqiTestCase::LteUeMeasurementEngineCqiTestCase ()
+  : TestCase ("subsampling of the DL-CQI"),
+    m_wbCqi (1)
+{
+}
+
+void
+LteUeMeasurementEngineCqiTestCase::CheckP10 (double sinrDb, bool due, std::string step)
+{
+  SpectrumValue sinr (m_sm);
+  sinr = std::pow (10.0, sinrDb / 10.0);
+  bool isDue = m_engine.IsCqiEvaluationDue (CqiListElement_s::P10, sinr);
+  NS_TEST_ASSERT_MSG_EQ (isDue, due, "wrong CQI evaluation decision: " << step);
+  if (isDue)
+    {
+      CqiListElement_s cqi;
+      cqi.m_rnti = 1;
+      cqi.m_cqiType = CqiListElement_s::P10;
+      cqi.m_wbCqi.push_back (m_wbCqi++);
+      m_engine.StoreCqi (cqi);
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_engine.GetLastCqi (CqiListElement_s::P10).m_wbCqi.at (0), m_wbCqi - 1,
+                             "wrong reused CQI: " << step);
+    }
+}
+
+void
+LteUeMeasurementEngineCqiTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      freqs.push_back (2.12e9 + i * 180e3);
+    }
+  m_sm = Create<SpectrumModel> (freqs);
+
+  // disabled by default
+  CheckP10 (10.0, true, "disabled");
+  CheckP10 (10.0, true, "disabled");
+
+  m_engine.SetCqiSubsampling (true, MilliSeconds (10), 1.0);
+  CheckP10 (10.0, true, "no CQI stored");
+  CheckP10 (10.5, false, "small SINR change");
+  CheckP10 (9.1, false, "small SINR change");
+  CheckP10 (11.5, true, "large SINR increase");
+  CheckP10 (10.2, true, "large SINR decrease");
+  // the CQI is computed again when it is 10 ms old
+  Simulator::Schedule (MilliSeconds (9), &LteUeMeasurementEngineCqiTestCase::CheckP10, this,
+                       10.2, false, "young CQI");
+  Simulator::Schedule (MilliSeconds (10), &LteUeMeasurementEngineCqiTestCase::CheckP10, this,
+                       10.2, true, "old CQI");
+  Simulator::Schedule (MilliSeconds (11), &LteUeMeasurementEngine::InvalidateCqi, &m_engine);
+  Simulator::Schedule (MilliSeconds (12), &LteUeMeasurementEngineCqiTestCase::CheckP10, this,
+                       10.2, true, "invalidated CQI");
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_engine.GetCqiEvaluations (), 7, "wrong number of CQI computed");
+  NS_TEST_ASSERT_MSG_EQ (m_engine.GetCqiReuses (), 3, "wrong number of CQI reused");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of LteUeMeasurementEngine.
+ */
+class LteUeMeasurementEngineTestSuite : public TestSuite
+{
+public:
+  LteUeMeasurementEngineTestSuite ();
+};
+
+LteUeMeasurementEngineTestSuite::LteUeMeasurementEngineTestSuite ()
+  : TestSuite ("lte-ue-measurement-engine", UNIT)
+{
+  AddTestCase (new LteUeMeasurementEngineFilterTestCase, TestCase::QUICK);
+  AddTestCase (new LteUeMeasurementEngineCqiTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteUeMeasurementEngineTestSuite g_lteUeMeasurementEngineTestSuite;
@@ -26,7 +26,9 @@
 #include "ns3/test.h"
 #include "ns3/ptr.h"
 #include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
 
+#include "ns3/lte-asn1-header.h"
 #include "ns3/lte-rrc-header.h"
 #include "ns3/lte-rrc-sap.h"
 
@@ -1115,6 +1117,387 @@ MeasurementReportTestCase::DoRun (void)
   packet = 0;
 }
 
+// --------------------------- CLASS Asn1FuzzHeader -----------------------------
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Header serializing a random list of ASN.1 fields with the
+ * functions of Asn1Header, and keeping the bit-by-bit reference encoding
+ * of the same fields.
+ */
+class Asn1FuzzHeader : public Asn1Header
+{
+public:
+  /// Type of a field
+  enum FieldType
+  {
+    BOOLEAN,
+    INTEGER,
+    ENUM,
+    CHOICE,
+    SEQUENCE,
+    BITSTRING,
+    SEQUENCE_OF,
+    NUM_FIELD_TYPES
+  };
+
+  /// Field of the header
+  struct Field
+  {
+    FieldType type; ///< type of the field
+    int size;       ///< number of bits of the bitstrings and sequences
+    int nmin;       ///< min value of the integers
+    int nmax;       ///< max value of the integers
+    bool extension; ///< true if the extension marker is present
+    uint32_t value; ///< value to serialize
+    uint32_t read;  ///< deserialized value
+  };
+
+  /**
+   * Constructor
+   * \param fields the fields
+   */
+  Asn1FuzzHeader (std::vector<Field> fields);
+
+  /**
+   * \returns the fields, with their deserialized values
+   */
+  std::vector<Field> GetFields (void) const;
+  /**
+   * \returns the reference encoding of the fields, one bit per element,
+   * padded to an octet
+   */
+  std::vector<bool> GetReferenceBits (void) const;
+
+  // Inherited from Asn1Header
+  virtual void PreSerialize (void) const;
+  virtual uint32_t Deserialize (Buffer::Iterator bIterator);
+  virtual void Print (std::ostream &os) const;
+
+private:
+  std::vector<Field> m_fields; ///< the fields
+};
+
+Asn1FuzzHeader::Asn1FuzzHeader (std::vector<Field> fields)
+  : m_fields (fields)
+{
+}
+
+std::vector<Asn1FuzzHeader::Field>
+Asn1FuzzHeader::GetFields (void) const
+{
+  return m_fields;
+}
+
+std::vector<bool>
+Asn1FuzzHeader::GetReferenceBits (void) const
+{
+  std::vector<bool> bits;
+  for (std::vector<Field>::const_iterator it = m_fields.begin (); it != m_fields.end (); ++it)
+    {
+      int numBits = it->size;
+      uint32_t value = it->value;
+      if (it->extension)
+        {
+          bits.push_back (false);
+        }
+      if (it->type == INTEGER || it->type == ENUM || it->type == CHOICE || it->type == SEQUENCE_OF)
+        {
+          // ceil (log2 (range)) bits of the offset from the min value
+          uint32_t maxValue = it->nmax - it->nmin;
+          numBits = 0;
+          while ((maxValue >> numBits) > 0)
+            {
+              numBits++;
+            }
+          value = it->value - it->nmin;
+        }
+      for (int i = numBits - 1; i >= 0; i--)
+        {
+          bits.push_back ((value >> i) & 0x1);
+        }
+    }
+  while (bits.size () % 8 != 0)
+    {
+      bits.push_back (false);
+    }
+  return bits;
+}
+
+void
+Asn1FuzzHeader::PreSerialize (void) const
+{
+  m_serializationResult = Buffer ();
+  for (std::vector<Field>::const_iterator it = m_fields.begin (); it != m_fields.end (); ++it)
+    {
+      switch (it->type)
+        {
+        case BOOLEAN:
+          SerializeBoolean (it->value);
+          break;
+        case INTEGER:
+          SerializeInteger (it->value, it->nmin, it->nmax);
+          break;
+        case ENUM:
+          SerializeEnum (it->nmax + 1, it->value);
+          break;
+        case CHOICE:
+          SerializeChoice (it->nmax + 1, it->value, it->extension);
+          break;
+        case SEQUENCE_OF:
+          SerializeSequenceOf (it->value, it->nmax, it->nmin);
+          break;
+        case SEQUENCE:
+          switch (it->size)
+            {
+            case 1:
+              SerializeSequence (std::bitset<1> (it->value), it->extension);
+              break;
+            case 2:
+              SerializeSequence (std::bitset<2> (it->value), it->extension);
+              break;
+            default:
+              SerializeSequence (std::bitset<10> (it->value), it->extension);
+            }
+          break;
+        default:
+          switch (it->size)
+            {
+            case 1:
+              SerializeBitstring (std::bitset<1> (it->value));
+              break;
+            case 2:
+              SerializeBitstring (std::bitset<2> (it->value));
+              break;
+            case 8:
+              SerializeBitstring (std::bitset<8> (it->value));
+              break;
+            case 10:
+              SerializeBitstring (std::bitset<10> (it->value));
+              break;
+            case 16:
+              SerializeBitstring (std::bitset<16> (it->value));
+              break;
+            case 27:
+              SerializeBitstring (std::bitset<27> (it->value));
+              break;
+            case 28:
+              SerializeBitstring (std::bitset<28> (it->value));
+              break;
+            default:
+              SerializeBitstring (std::bitset<32> (it->value));
+            }
+        }
+    }
+  FinalizeSerialization ();
+}
+
+uint32_t
+Asn1FuzzHeader::Deserialize (Buffer::Iterator bIterator)
+{
+  Buffer::Iterator start = bIterator;
+  for (std::vector<Field>::iterator it = m_fields.begin (); it != m_fields.end (); ++it)
+    {
+      int n = it->nmin;
+      bool b;
+      std::bitset<1> bits1;
+      std::bitset<2> bits2;
+      std::bitset<8> bits8;
+      std::bitset<10> bits10;
+      std::bitset<16> bits16;
+      std::bitset<27> bits27;
+      std::bitset<28> bits28;
+      std::bitset<32> bits32;
+      switch (it->type)
+        {
+        case BOOLEAN:
+          bIterator = DeserializeBoolean (&b, bIterator);
+          n = b;
+          break;
+        case INTEGER:
+          bIterator = DeserializeInteger (&n, it->nmin, it->nmax, bIterator);
+          break;
+        case ENUM:
+          bIterator = DeserializeEnum (it->nmax + 1, &n, bIterator);
+          break;
+        case CHOICE:
+          bIterator = DeserializeChoice (it->nmax + 1, it->extension, &n, bIterator);
+          break;
+        case SEQUENCE_OF:
+          bIterator = DeserializeSequenceOf (&n, it->nmax, it->nmin, bIterator);
+          break;
+        case SEQUENCE:
+          switch (it->size)
+            {
+            case 1:
+              bIterator = DeserializeSequence (&bits1, it->extension, bIterator);
+              n = bits1.to_ulong ();
+              break;
+            case 2:
+              bIterator = DeserializeSequence (&bits2, it->extension, bIterator);
+              n = bits2.to_ulong ();
+              break;
+            default:
+              bIterator = DeserializeSequence (&bits10, it->extension, bIterator);
+              n = bits10.to_ulong ();
+            }
+          break;
+        default:
+          switch (it->size)
+            {
+            case 1:
+              bIterator = DeserializeBitstring (&bits1, bIterator);
+              n = bits1.to_ulong ();
+              break;
+            case 2:
+              bIterator = DeserializeBitstring (&bits2, bIterator);
+              n = bits2.to_ulong ();
+              break;
+            case 8:
+              bIterator = DeserializeBitstring (&bits8, bIterator);
+              n = bits8.to_ulong ();
+              break;
+            case 10:
+              bIterator = DeserializeBitstring (&bits10, bIterator);
+              n = bits10.to_ulong ();
+              break;
+            case 16:
+              bIterator = DeserializeBitstring (&bits16, bIterator);
+              n = bits16.to_ulong ();
+              break;
+            case 27:
+              bIterator = DeserializeBitstring (&bits27, bIterator);
+              n = bits27.to_ulong ();
+              break;
+            case 28:
+              bIterator = DeserializeBitstring (&bits28, bIterator);
+              n = bits28.to_ulong ();
+              break;
+            default:
+              bIterator = DeserializeBitstring (&bits32, bIterator);
+              n = bits32.to_ulong ();
+            }
+        }
+      it->read = n;
+    }
+  return bIterator.GetDistanceFrom (start);
+}
+
+void
+Asn1FuzzHeader::Print (std::ostream &os) const
+{
+  os << m_fields.size () << " fields";
+}
+
+// --------------------------- CLASS Asn1FuzzTestCase -----------------------------
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Serialize random lists of ASN.1 fields, check that the encoding
+ * is the bit-by-bit reference encoding of the PER unaligned variant, and
+ * that the fields are deserialized back.
+ */
+class Asn1FuzzTestCase : public TestCase
+{
+public:
+  Asn1FuzzTestCase ();
+  virtual void DoRun (void);
+};
+
+Asn1FuzzTestCase::Asn1FuzzTestCase () : TestCase ("Testing the ASN.1 bit codec with random fields")
+{
+}
+
+void
+Asn1FuzzTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+  const int sizes[] = {1, 2, 10};
+  const int bitstringSizes[] = {1, 2, 8, 10, 16, 27, 28, 32};
+
+  for (int message = 0; message < 500; message++)
+    {
+      std::vector<Asn1FuzzHeader::Field> fields;
+      uint32_t numFields = rng->GetInteger (0, 40);
+      for (uint32_t i = 0; i < numFields; i++)
+        {
+          Asn1FuzzHeader::Field field;
+          field.type = (Asn1FuzzHeader::FieldType) rng->GetInteger (0, Asn1FuzzHeader::NUM_FIELD_TYPES - 1);
+          field.size = 0;
+          field.nmin = 0;
+          field.nmax = 0;
+          field.extension = false;
+          field.read = 0xffffffff;
+          switch (field.type)
+            {
+            case Asn1FuzzHeader::BOOLEAN:
+              field.size = 1;
+              field.value = rng->GetInteger (0, 1);
+              break;
+            case Asn1FuzzHeader::INTEGER:
+            case Asn1FuzzHeader::SEQUENCE_OF:
+              // ranges of 1 to 2^20 values, up to 20 bits
+              field.nmin = rng->GetInteger (0, 2000) - 1000;
+              field.nmax = field.nmin + (rng->GetInteger (0, 1) ? rng->GetInteger (0, 64) : rng->GetInteger (0, (1 << 20) - 1));
+              field.value = field.nmin + rng->GetInteger (0, field.nmax - field.nmin);
+              break;
+            case Asn1FuzzHeader::CHOICE:
+              field.extension = rng->GetInteger (0, 1);
+              // fall through
+            case Asn1FuzzHeader::ENUM:
+              field.nmax = rng->GetInteger (0, 40);
+              field.value = rng->GetInteger (0, field.nmax);
+              break;
+            case Asn1FuzzHeader::SEQUENCE:
+              field.extension = rng->GetInteger (0, 1);
+              field.size = sizes[rng->GetInteger (0, 2)];
+              field.value = rng->GetInteger (0, (1 << field.size) - 1);
+              break;
+            default:
+              field.size = bitstringSizes[rng->GetInteger (0, 7)];
+              field.value = (rng->GetInteger (0, 0xffff) << 16) | rng->GetInteger (0, 0xffff);
+              if (field.size < 32)
+                {
+                  field.value &= (1u << field.size) - 1;
+                }
+              break;
+            }
+          fields.push_back (field);
+        }
+
+      Asn1FuzzHeader source (fields);
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (source);
+
+      std::vector<bool> referenceBits = source.GetReferenceBits ();
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize () * 8, referenceBits.size (), "wrong size of message " << message);
+      uint32_t size = packet->GetSize ();
+      std::vector<uint8_t> octets (size + 1);
+      packet->CopyData (&octets[0], size);
+      for (uint32_t j = 0; j < size; j++)
+        {
+          uint8_t referenceOctet = 0;
+          for (uint32_t k = 0; k < 8; k++)
+            {
+              referenceOctet |= referenceBits[8 * j + k] << (7 - k);
+            }
+          NS_TEST_ASSERT_MSG_EQ ((uint16_t) octets[j], (uint16_t) referenceOctet, "wrong octet " << j << " of message " << message);
+        }
+
+      Asn1FuzzHeader destination (fields);
+      packet->RemoveHeader (destination);
+      std::vector<Asn1FuzzHeader::Field> readFields = destination.GetFields ();
+      for (uint32_t i = 0; i < readFields.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (readFields[i].read, readFields[i].value, "wrong field " << i << " of message " << message);
+        }
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "message " << message << " not completely read");
+    }
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -1142,6 +1525,7 @@ Asn1EncodingSuite::Asn1EncodingSuite ()
   AddTestCase (new RrcConnectionReestablishmentCompleteTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionRejectTestCase (), TestCase::QUICK);
   AddTestCase (new MeasurementReportTestCase (), TestCase::QUICK);
+  AddTestCase (new Asn1FuzzTestCase (), TestCase::QUICK);
 }
 
 Asn1EncodingSuite asn1EncodingSuite;
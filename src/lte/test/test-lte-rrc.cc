@@ -728,6 +728,242 @@ LteRrcConnectionEstablishmentErrorTestCase::JumpBack ()
 }
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the coalescing of the measurement reports by the ideal RRC
+ * protocol: a UE with two measurement configurations reporting at the same
+ * times delivers the same reports to the eNB, at the same time, with and
+ * without coalescing, but with half of the events when they are coalesced.
+ * A report sent after another message at the same time is not coalesced
+ * with the reports sent before that message, so that the eNB receives the
+ * messages in the order they were sent.
+ */
+class LteRrcIdealCoalescingTestCase : public TestCase
+{
+public:
+  LteRrcIdealCoalescingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario
+   * \param coalesce whether the measurement reports are coalesced
+   * \param [out] numMessages the number of RRC messages sent by the UE
+   * \param [out] numEvents the number of events scheduled by the UE
+   */
+  void RunScenario (bool coalesce, uint64_t& numMessages, uint64_t& numEvents);
+
+  /**
+   * Check the order in which the eNB receives two coalesced measurement
+   * reports and the messages sent between them
+   */
+  void CheckOrder (void);
+
+  /**
+   * Receive measurement report callback function
+   * \param context the context string
+   * \param imsi the IMSI
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   * \param report the measurement report
+   */
+  void RecvMeasurementReportCallback (std::string context, uint64_t imsi, uint16_t cellId,
+                                      uint16_t rnti, LteRrcSap::MeasurementReport report);
+
+  /// time and measId of the reports received by the eNB
+  std::vector<std::pair<Time, uint8_t> > m_reports;
+};
+
+
+LteRrcIdealCoalescingTestCase::LteRrcIdealCoalescingTestCase ()
+  : TestCase ("Coalescing of the measurement reports of the ideal RRC")
+{
+}
+
+void
+LteRrcIdealCoalescingTestCase::RunScenario (bool coalesce, uint64_t& numMessages, uint64_t& numEvents)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteUeRrcProtocolIdeal::CoalesceMeasurementReports", BooleanValue (coalesce));
+  Config::SetDefault ("ns3::LteEnbRrc::RsrpFilterCoefficient", UintegerValue (0));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseIdealRrc", BooleanValue (true));
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (1);
+  ueNodes.Create (1);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0)); // eNodeB
+  positionAlloc->Add (Vector (100.0, 0.0, 0.0)); // UE
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  // two configurations always triggered, thus reported at the same times
+  LteRrcSap::ReportConfigEutra config;
+  config.triggerType = LteRrcSap::ReportConfigEutra::EVENT;
+  config.eventId = LteRrcSap::ReportConfigEutra::EVENT_A1;
+  config.threshold1.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRP;
+  config.threshold1.range = 0;
+  config.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRP;
+  config.reportInterval = LteRrcSap::ReportConfigEutra::MS120;
+  Ptr<LteEnbRrc> enbRrc = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetRrc ();
+  enbRrc->AddUeMeasReportConfig (config);
+  config.threshold1.range = 1;
+  enbRrc->AddUeMeasReportConfig (config);
+
+  lteHelper->Attach (ueDevs.Get (0), enbDevs.Get (0));
+  // the measurement configuration is sent with the bearer setup
+  EpsBearer bearer (EpsBearer::GBR_CONV_VOICE);
+  lteHelper->ActivateDataRadioBearer (ueDevs, bearer);
+
+  Config::Connect ("/NodeList/0/DeviceList/0/LteEnbRrc/RecvMeasurementReport",
+                   MakeCallback (&LteRrcIdealCoalescingTestCase::RecvMeasurementReportCallback,
+                                 this));
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+
+  Ptr<LteUeRrcProtocolIdeal> rrcProtocol = ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetRrc ()->GetObject<LteUeRrcProtocolIdeal> ();
+  NS_ASSERT (rrcProtocol != 0);
+  numMessages = rrcProtocol->GetNumMessages ();
+  numEvents = rrcProtocol->GetNumEvents ();
+
+  Simulator::Destroy ();
+}
+
+void
+LteRrcIdealCoalescingTestCase::DoRun (void)
+{
+  uint64_t numMessages;
+  uint64_t numEvents;
+  RunScenario (false, numMessages, numEvents);
+  std::vector<std::pair<Time, uint8_t> > reports;
+  std::swap (reports, m_reports);
+  NS_TEST_ASSERT_MSG_GT (reports.size (), 10, "too few measurement reports");
+  NS_TEST_ASSERT_MSG_EQ (numEvents, numMessages, "messages coalesced by default");
+
+  uint64_t numCoalescedMessages;
+  uint64_t numCoalescedEvents;
+  RunScenario (true, numCoalescedMessages, numCoalescedEvents);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), reports.size (), "wrong number of measurement reports");
+  for (uint32_t i = 0; i < reports.size () && i < m_reports.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_reports[i].first, reports[i].first, "wrong time of report " << i);
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) m_reports[i].second, (uint16_t) reports[i].second, "wrong measId of report " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (numCoalescedMessages, numMessages, "wrong number of messages");
+  NS_TEST_ASSERT_MSG_EQ (numEvents - numCoalescedEvents, reports.size () / 2, "reports not coalesced");
+
+  CheckOrder ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief eNB RRC SAP provider recording the messages it receives
+ */
+class LteRrcIdealRecordingSapProvider : public LteEnbRrcSapProvider
+{
+public:
+  virtual void CompleteSetupUe (uint16_t rnti, CompleteSetupUeParameters params)
+  {
+  }
+  virtual void RecvRrcConnectionRequest (uint16_t rnti, RrcConnectionRequest msg)
+  {
+    m_received.push_back ("RrcConnectionRequest");
+  }
+  virtual void RecvRrcConnectionSetupCompleted (uint16_t rnti, RrcConnectionSetupCompleted msg)
+  {
+    m_received.push_back ("RrcConnectionSetupCompleted");
+  }
+  virtual void RecvRrcConnectionReconfigurationCompleted (uint16_t rnti, RrcConnectionReconfigurationCompleted msg)
+  {
+    m_received.push_back ("RrcConnectionReconfigurationCompleted");
+  }
+  virtual void RecvRrcConnectionReestablishmentRequest (uint16_t rnti, RrcConnectionReestablishmentRequest msg)
+  {
+    m_received.push_back ("RrcConnectionReestablishmentRequest");
+  }
+  virtual void RecvRrcConnectionReestablishmentComplete (uint16_t rnti, RrcConnectionReestablishmentComplete msg)
+  {
+    m_received.push_back ("RrcConnectionReestablishmentComplete");
+  }
+  virtual void RecvMeasurementReport (uint16_t rnti, MeasurementReport msg)
+  {
+    std::ostringstream oss;
+    oss << "MeasurementReport " << (uint16_t) msg.measResults.measId;
+    m_received.push_back (oss.str ());
+  }
+  virtual void RecvRrcSecondaryCellInitialAccessSuccessful (uint16_t rnti, uint16_t mmWaveRnti, uint16_t mmWaveCellId)
+  {
+    m_received.push_back ("RrcSecondaryCellInitialAccessSuccessful");
+  }
+
+  std::vector<std::string> m_received; ///< the messages received, in order
+};
+
+void
+LteRrcIdealCoalescingTestCase::CheckOrder (void)
+{
+  LteRrcIdealRecordingSapProvider provider;
+  IdealRrcUeToEnbSender sender (MicroSeconds (500));
+  LteRrcSap::MeasurementReport report;
+  report.measResults.haveMeasResultNeighCells = false;
+  report.measResults.haveScellsMeas = false;
+  LteRrcSap::RrcConnectionReconfigurationCompleted completed;
+  completed.rrcTransactionIdentifier = 0;
+
+  // all the messages are sent at time 0: MR 1 opens a batch, which MR 2
+  // joins; the reconfiguration completed message closes it, so that MR 3
+  // opens a new batch; the secondary cell notification closes that one too
+  uint32_t numEvents = 0;
+  report.measResults.measId = 1;
+  numEvents += sender.SendMeasurementReport (&provider, 1, report, true);
+  report.measResults.measId = 2;
+  numEvents += sender.SendMeasurementReport (&provider, 1, report, true);
+  sender.Send (&LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted, &provider, 1, completed);
+  report.measResults.measId = 3;
+  numEvents += sender.SendMeasurementReport (&provider, 1, report, true);
+  sender.SendNotifySecondaryCellConnected (&provider, 1, 2, 3);
+  report.measResults.measId = 4;
+  numEvents += sender.SendMeasurementReport (&provider, 1, report, true);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (numEvents, 3, "wrong number of measurement report events");
+  const char* expected[] = { "MeasurementReport 1",
+                             "MeasurementReport 2",
+                             "RrcConnectionReconfigurationCompleted",
+                             "MeasurementReport 3",
+                             "RrcSecondaryCellInitialAccessSuccessful",
+                             "MeasurementReport 4" };
+  NS_TEST_ASSERT_MSG_EQ (provider.m_received.size (), 6, "wrong number of messages received");
+  for (uint32_t i = 0; i < provider.m_received.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (provider.m_received[i], expected[i], "wrong message " << i);
+    }
+}
+
+void
+LteRrcIdealCoalescingTestCase::RecvMeasurementReportCallback (std::string context, uint64_t imsi, uint16_t cellId,
+                                                              uint16_t rnti, LteRrcSap::MeasurementReport report)
+{
+  m_reports.push_back (std::make_pair (Simulator::Now (), report.measResults.measId));
+}
+
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -788,6 +1024,8 @@ LteRrcTestSuite::LteRrcTestSuite ()
       AddTestCase (new LteRrcConnectionEstablishmentTestCase (  3,     0,     20,           0,           1, false, useIdealRrc, false), TestCase::EXTENSIVE);
     }
 
+  AddTestCase (new LteRrcIdealCoalescingTestCase, TestCase::QUICK);
+
   // Test cases with transmission error
   AddTestCase (new LteRrcConnectionEstablishmentErrorTestCase (
                    Seconds (0.020214),
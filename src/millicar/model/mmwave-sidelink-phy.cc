@@ -69,7 +69,7 @@ MmWaveSidelinkPhy::MmWaveSidelinkPhy (Ptr<MmWaveSidelinkSpectrumPhy> spectrumPhy
   m_phySapProvider = new MacSidelinkMemberPhySapProvider (this);
 
   // create the noise PSD
-  Ptr<SpectrumValue> noisePsd = mmwave::MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+  Ptr<const SpectrumValue> noisePsd = mmwave::MmWaveSpectrumValueHelper::GetNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
   m_sidelinkSpectrumPhy->SetNoisePowerSpectralDensity (noisePsd);
 
   // schedule the first slot
@@ -138,7 +138,7 @@ MmWaveSidelinkPhy::SetNoiseFigure (double nf)
   m_noiseFigure = nf;
 
   // update the noise PSD
-  Ptr<SpectrumValue> noisePsd = mmwave::MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+  Ptr<const SpectrumValue> noisePsd = mmwave::MmWaveSpectrumValueHelper::GetNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
   m_sidelinkSpectrumPhy->SetNoisePowerSpectralDensity (noisePsd);
 }
 
@@ -281,7 +281,7 @@ MmWaveSidelinkPhy::SetSubChannelsForTransmission ()
     }
 
     // create the tx PSD
-    Ptr<SpectrumValue> txPsd = mmwave::MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, m_txPower, subChannelsForTx);
+    Ptr<const SpectrumValue> txPsd = mmwave::MmWaveSpectrumValueHelper::GetTxPowerSpectralDensity (m_phyMacConfig, m_txPower, subChannelsForTx);
 
     // set the tx PSD in the spectrum phy
     m_sidelinkSpectrumPhy->SetTxPowerSpectralDensity (txPsd);
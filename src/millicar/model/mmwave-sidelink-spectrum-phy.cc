@@ -197,7 +197,7 @@ MmWaveSidelinkSpectrumPhy::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue
 }
 
 void
-MmWaveSidelinkSpectrumPhy::SetTxPowerSpectralDensity (Ptr<SpectrumValue> TxPsd)
+MmWaveSidelinkSpectrumPhy::SetTxPowerSpectralDensity (Ptr<const SpectrumValue> TxPsd)
 {
   m_txPsd = TxPsd;
 }
@@ -383,8 +383,8 @@ MmWaveSidelinkSpectrumPhy::EndRxData ()
          i != m_rxTransportBlock.end (); ++i)
      {
        // Here we need to initialize an empty harqInfoList since it is mandatory input
-       // for the method. Since the vector is empty, no harq procedures are triggeres (as we want)
-       std::vector <mmwave::MmWaveHarqProcessInfoElement_t> harqInfoList;
+       // for the method. Since the list is empty, no harq procedures are triggeres (as we want)
+       mmwave::MmWaveHarqProcessInfoList_t harqInfoList;
 
        NS_LOG_DEBUG ("average sinr " << 10*log10 (sinrAvg) << " MCS " <<  (uint16_t)(*i).mcs);
        mmwave::MmWaveTbStats_t tbStats = mmwave::MmWaveMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, (*i).rbBitmap, (*i).size, (*i).mcs, harqInfoList);
@@ -480,7 +480,8 @@ MmWaveSidelinkSpectrumPhy::StartTxDataFrames (Ptr<PacketBurst> pb,
         Ptr<MmWaveSidelinkSpectrumSignalParameters> txParams = Create<MmWaveSidelinkSpectrumSignalParameters> ();
         txParams->duration = duration;
         txParams->txPhy = this->GetObject<SpectrumPhy> ();
-        txParams->psd = m_txPsd;
+        // the tx PSD is shared and never written: the channel only reads it and copies it for each receiver
+        txParams->psd = ConstCast<SpectrumValue> (m_txPsd);
         txParams->packetBurst = pb;
         //txParams->ctrlMsgList = ctrlMsgList;
         txParams->txAntenna = m_antenna;
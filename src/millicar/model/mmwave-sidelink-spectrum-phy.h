@@ -170,7 +170,7 @@ public:
   void SetAntenna (Ptr<AntennaModel> a);
 
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
-  void SetTxPowerSpectralDensity (Ptr<SpectrumValue> TxPsd);
+  void SetTxPowerSpectralDensity (Ptr<const SpectrumValue> TxPsd);
 
   void StartRx (Ptr<SpectrumSignalParameters> params);
 
@@ -271,7 +271,7 @@ private:
   Ptr<NetDevice> m_device; ///< the device
   Ptr<SpectrumChannel> m_channel; ///< the channel
   Ptr<const SpectrumModel> m_rxSpectrumModel; ///< the spectrum model
-  Ptr<SpectrumValue> m_txPsd; ///< the transmit PSD
+  Ptr<const SpectrumValue> m_txPsd; ///< the transmit PSD
   //Ptr<PacketBurst> m_txPacketBurst;
 
   std::list<TbInfo_t> m_rxTransportBlock; ///< the received with associated structure
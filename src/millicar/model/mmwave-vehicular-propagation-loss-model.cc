@@ -90,6 +90,12 @@ MmWaveVehicularPropagationLossModel::GetTypeId (void)
                    DoubleValue (0.0),
                    MakeDoubleAccessor (&MmWaveVehicularPropagationLossModel::m_percType3Vehicles),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("OrderIndependentDraws",
+                   "If true, the random values of the n-th evaluation of a link only depend on the link, "
+                   "on n and on the stream numbers, and not on the order in which the links are evaluated",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveVehicularPropagationLossModel::m_orderIndependentDraws),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -192,9 +198,20 @@ MmWaveVehicularPropagationLossModel::GetLoss (Ptr<MobilityModel> deviceA, Ptr<Mo
 
   channelConditionMap_t::const_iterator it;
   it = m_channelConditionMap.find (std::make_pair (deviceA, deviceB));
+  uint32_t draws = (it == m_channelConditionMap.end ()) ? 0 : (*it).second.m_draws;
+  if (m_orderIndependentDraws)
+    {
+      // draw the values of this evaluation from the counter of the link
+      uint64_t linkKey = GetLinkKey (deviceA, deviceB);
+      m_uniformVar->SetCounterKey (linkKey, draws);
+      m_norVar->SetCounterKey (linkKey, draws);
+      m_logNorVar->SetCounterKey (linkKey, draws);
+    }
+
   if (it == m_channelConditionMap.end ())
     {
       channelCondition condition;
+      condition.m_draws = 0;
 
       if (m_channelConditions.compare ("l") == 0 )
         {
@@ -323,6 +340,12 @@ MmWaveVehicularPropagationLossModel::GetLoss (Ptr<MobilityModel> deviceA, Ptr<Mo
         
     }
 
+  if (m_orderIndependentDraws)
+    {
+      m_channelConditionMap[std::make_pair (deviceA, deviceB)].m_draws = draws + 1;
+      m_channelConditionMap[std::make_pair (deviceB, deviceA)].m_draws = draws + 1;
+    }
+
   double lossDb = 0;
   double freqGHz = m_frequency / 1e9;
 
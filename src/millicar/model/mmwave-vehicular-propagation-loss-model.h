@@ -52,6 +52,7 @@ struct channelCondition
   char m_channelCondition;
   double m_shadowing;
   Vector m_position;
+  uint32_t m_draws; // number of evaluations of the link, if OrderIndependentDraws is true
 };
 
 // map store the path loss scenario(LOS,NLOS,OUTAGE) of each propagation channel
@@ -131,6 +132,7 @@ class MmWaveVehicularPropagationLossModel : public PropagationLossModel
     bool m_shadowingEnabled = true;
     double m_percType3Vehicles = 30;
     bool m_snowEnabled = false;
+    bool m_orderIndependentDraws = false;
 };
 
 } // namespace millicar
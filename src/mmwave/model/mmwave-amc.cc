@@ -277,10 +277,11 @@ MmWaveAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
             {
               uint8_t mcs = 0;
               MmWaveTbStats_t tbStats;
+              MmWaveHarqProcessInfoList_t harqInfoList;
+              MmWaveMibs_t mibs = MmWaveMiErrorModel::GetMibs (sinr, rbgMap);
               while (mcs <= 28)
                 {
-                  MmWaveHarqProcessInfoList_t harqInfoList;
-                  tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, GetTbSizeFromMcs (mcs, rbgSize / 18) / 8, mcs, harqInfoList);
+                  tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (mibs, GetTbSizeFromMcs (mcs, rbgSize / 18) / 8, mcs, harqInfoList);
                   if (tbStats.tbler > 0.1)
                     {
                       break;
@@ -375,10 +376,11 @@ MmWaveAmc::CreateCqiFeedbacksTdma (const SpectrumValue& sinr, uint8_t numSym)
           MmWaveTbStats_t tbStats;
           std::vector <int> chunkMap;
           chunkMap.push_back (chunkId++);
+          MmWaveHarqProcessInfoList_t harqInfoList;
+          MmWaveMibs_t mibs = MmWaveMiErrorModel::GetMibs (sinr, chunkMap);
           while (mcs <= 28)
             {
-              MmWaveHarqProcessInfoList_t harqInfoList;
-              tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, GetTbSizeFromMcsSymbols (mcs, numSym) / 8, mcs, harqInfoList);
+              tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (mibs, GetTbSizeFromMcsSymbols (mcs, numSym) / 8, mcs, harqInfoList);
               if (tbStats.tbler > 0.1)
                 {
                   break;
@@ -485,10 +487,14 @@ MmWaveAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, u
 
       mcs = 0;
       MmWaveTbStats_t tbStats;
+      MmWaveHarqProcessInfoList_t harqInfoList;
+      // the MI of each modulation is computed once; the BLER is not monotone
+      // in the MCS across modulation changes, so the MCSs are still scanned
+      // in order, each step costing only the BLER curve lookup
+      MmWaveMibs_t mibs = MmWaveMiErrorModel::GetMibs (sinr, chunkMap);
       while (mcs <= 28)
         {
-          MmWaveHarqProcessInfoList_t harqInfoList;
-          tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, tbSize, mcs, harqInfoList);
+          tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (mibs, tbSize, mcs, harqInfoList);
           if (tbStats.tbler > 0.1)
             {
               break;
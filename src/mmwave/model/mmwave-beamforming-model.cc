@@ -77,6 +77,8 @@ MmWaveBeamformingModel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_device = 0;
   m_antenna = 0;
+  m_cacheChannelMap.clear ();
+  m_cacheBfVectors.clear ();
 }
 
 Ptr<NetDevice>
@@ -107,6 +109,130 @@ MmWaveBeamformingModel::SetAntenna (Ptr<ThreeGppAntennaArrayModel> antenna)
   m_antenna = antenna;
 }
 
+void
+MmWaveBeamformingModel::SetBeamformingVectorsFromChannel (Ptr<MatrixBasedChannelModel> channel, bool useCache,
+                                                          Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
+{
+  NS_LOG_FUNCTION (this << channel << useCache << otherDevice << otherAntenna);
+
+  Ptr<MobilityModel> thisMob = m_device->GetNode ()->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (thisMob, "This device " << m_device << " does not have a mobility model");
+  Ptr<MobilityModel> otherMob = otherDevice->GetNode ()->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (otherMob, "The otherDevice " << otherDevice << " does not have a mobility model");
+
+  // this will trigger a new computation (if needed)
+  auto channelMatrix = channel->GetChannel (thisMob, otherMob, m_antenna, otherAntenna);
+
+  BeamformingVectors bfVectors;
+
+  bool toCache {false};
+
+  if (useCache)
+    {
+      auto entry {m_cacheChannelMap.find (otherDevice)};
+      if (entry != m_cacheChannelMap.end () && entry->second == channelMatrix) // hit: the channel was already cached
+        {
+          NS_LOG_DEBUG ("channel cached " << channelMatrix);
+          bfVectors = m_cacheBfVectors.find (otherDevice)->second;
+        }
+      else
+        {
+          NS_LOG_DEBUG ("new channel " << channelMatrix);
+          toCache = true;
+        }
+    }
+
+  if (!useCache || toCache)
+    {
+      if (channelMatrix->m_channel[0][0].size () == 0)
+        {
+          NS_LOG_LOGIC ("Channel has no MPCs");
+
+          ThreeGppAntennaArrayModel::ComplexVector thisBf;
+          thisBf.resize (m_antenna->GetNumberOfElements ());
+          ThreeGppAntennaArrayModel::ComplexVector otherBf;
+          otherBf.resize (otherAntenna->GetNumberOfElements ());
+
+          bfVectors = std::make_pair (thisBf, otherBf);
+        }
+      else
+        {
+          uint32_t thisDeviceId = m_device->GetNode ()->GetId ();
+          uint32_t otherDeviceId = otherDevice->GetNode ()->GetId ();
+          bool reverse = channelMatrix->IsReverse (thisDeviceId, otherDeviceId);
+
+          // the vectors computed on the previous channel of this link, in the
+          // (s, u) order of the new channel matrix
+          const BeamformingVectors *cachedBfVectors = 0;
+          BeamformingVectors reversedCachedBfVectors;
+          auto cachedBf = m_cacheBfVectors.find (otherDevice);
+          if (toCache && cachedBf != m_cacheBfVectors.end ())
+            {
+              if (reverse)
+                {
+                  reversedCachedBfVectors = std::make_pair (cachedBf->second.second, cachedBf->second.first);
+                  cachedBfVectors = &reversedCachedBfVectors;
+                }
+              else
+                {
+                  cachedBfVectors = &cachedBf->second;
+                }
+            }
+
+          if (reverse)
+            {
+              // this device is the u side of the channel matrix
+              bfVectors = ComputeBeamformingVectorsForLink (channelMatrix, otherAntenna, m_antenna, cachedBfVectors);
+              bfVectors = std::make_pair (std::get<1> (bfVectors), std::get<0> (bfVectors));
+            }
+          else
+            {
+              bfVectors = ComputeBeamformingVectorsForLink (channelMatrix, m_antenna, otherAntenna, cachedBfVectors);
+            }
+        }
+    }
+
+  // configure the antenna to use the new beamforming vector
+  m_antenna->SetBeamformingVector (std::get<0> (bfVectors));
+  NS_LOG_LOGIC ("antenna " << m_antenna
+                           << " set BF vector"
+                           << " numAntennaElem " << m_antenna->GetNumberOfElements ()
+                           << " this device ID=" << m_device->GetNode ()->GetId ()
+                           << " otherDevice ID=" << otherDevice->GetNode ()->GetId ());
+  otherAntenna->SetBeamformingVector (std::get<1> (bfVectors));
+  NS_LOG_LOGIC ("antenna " << otherAntenna
+                           << " set BF vector"
+                           << " numAntennaElem " << otherAntenna->GetNumberOfElements ()
+                           << " this device ID=" << otherDevice->GetNode ()->GetId ()
+                           << " otherDevice ID=" << m_device->GetNode ()->GetId ());
+
+  if (toCache)
+    {
+      auto entry {m_cacheChannelMap.find (otherDevice)};
+      if (entry != m_cacheChannelMap.end ())
+        {
+          entry->second = channelMatrix;
+          // this means there is also an entry for the bf vector
+          m_cacheBfVectors.find (otherDevice)->second = bfVectors;
+        }
+      else
+        {
+          m_cacheChannelMap.insert (std::make_pair (otherDevice, channelMatrix));
+          m_cacheBfVectors.insert (std::make_pair (otherDevice, bfVectors));
+        }
+    }
+}
+
+MmWaveBeamformingModel::BeamformingVectors
+MmWaveBeamformingModel::ComputeBeamformingVectorsForLink (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                          Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                          Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                          const BeamformingVectors *cachedBfVectors)
+{
+  NS_FATAL_ERROR ("This beamforming model does not compute the beamforming vectors from the channel matrix");
+  return BeamformingVectors ();
+}
+
 /*----------------------------------------------------------------------------*/
 
 NS_OBJECT_ENSURE_REGISTERED (MmWaveDftBeamforming);
@@ -205,6 +331,12 @@ MmWaveSvdBeamforming::GetTypeId ()
                    DoubleValue (1e-8),
                    MakeDoubleAccessor (&MmWaveSvdBeamforming::m_tolerance),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("WarmStart",
+                   "Start the numerical approximation of the SVD decomposition from the "
+                   "BF vectors previously computed for the same device, if any. Requires UseCache",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MmWaveSvdBeamforming::m_warmStart),
+                   MakeBooleanChecker ())
     .AddAttribute ("UseCache",
                    "Use the cache for the BF vectors. Do not set it to false unless you have very good reasons",
                    BooleanValue (true),
@@ -215,7 +347,8 @@ MmWaveSvdBeamforming::GetTypeId ()
 }
 
 MmWaveSvdBeamforming::MmWaveSvdBeamforming ()
-  : m_useCache {false}
+  : m_useCache {false},
+    m_warmStart {false}
 {
   NS_LOG_FUNCTION (this);
 }
@@ -236,173 +369,118 @@ void
 MmWaveSvdBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
 {
   NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+  SetBeamformingVectorsFromChannel (m_channel, m_useCache, otherDevice, otherAntenna);
+}
 
-  Ptr<MobilityModel> thisMob = m_device->GetNode ()->GetObject<MobilityModel> ();
-  NS_ASSERT_MSG (thisMob, "This device " << m_device << " does not have a mobility model");
-  Ptr<MobilityModel> otherMob = otherDevice->GetNode ()->GetObject<MobilityModel> ();
-  NS_ASSERT_MSG (otherMob, "The otherDevice " << otherDevice << " does not have a mobility model");
-
-  // this will trigger a new computation (if needed)
-  auto channelMatrix = m_channel->GetChannel (thisMob, otherMob, m_antenna, otherAntenna);
-
-  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> bfVectors;
-
-  bool toCache {false};
-
-  if (m_useCache)
-    {
-      auto entry {m_cacheChannelMap.find (otherDevice)};
-      if (entry != m_cacheChannelMap.end () && entry->second == channelMatrix) // hit: the channel was already cached
-        {
-          NS_LOG_DEBUG ("channel cached " << channelMatrix);
-          bfVectors = m_cacheBfVectors.find (otherDevice)->second;
-        }
-      else
-        {
-          NS_LOG_DEBUG ("new channel " << channelMatrix);
-          toCache = true;
-        }
-    }
-
-  if (!m_useCache || toCache)
+MmWaveBeamformingModel::BeamformingVectors
+MmWaveSvdBeamforming::ComputeBeamformingVectorsForLink (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                        Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                        Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                        const BeamformingVectors *cachedBfVectors)
+{
+  NS_LOG_FUNCTION (this << channelMatrix << sAntenna << uAntenna << cachedBfVectors);
+
+  // the power iterations start from the beams previously computed
+  // for this link, if any, which are usually close to the new ones
+  const ThreeGppAntennaArrayModel::ComplexVector *bInit = 0;
+  const ThreeGppAntennaArrayModel::ComplexVector *aInit = 0;
+  ThreeGppAntennaArrayModel::ComplexVector aInitConj;
+  if (m_warmStart && cachedBfVectors)
     {
-      if (channelMatrix->m_channel[0][0].size () == 0)
-        {
-          NS_LOG_LOGIC ("Channel has no MPCs");
-
-          uint64_t thisAntennaNumElements = m_antenna->GetNumberOfElements ();
-          uint64_t otherAntennaNumElements = otherAntenna->GetNumberOfElements ();
-          ThreeGppAntennaArrayModel::ComplexVector thisBf;
-          thisBf.resize (thisAntennaNumElements);
-          ThreeGppAntennaArrayModel::ComplexVector otherBf;
-          otherBf.resize (otherAntennaNumElements);
-
-          bfVectors = std::make_pair (thisBf, otherBf);
-        }
-      else
+      bInit = &cachedBfVectors->first;
+      const ThreeGppAntennaArrayModel::ComplexVector &aBf = cachedBfVectors->second;
+      // the receiver side beam is the conjugate of the eigenvector
+      aInitConj.resize (aBf.size ());
+      for (size_t i = 0; i < aBf.size (); ++i)
         {
-          bfVectors = ComputeBeamformingVectors (channelMatrix);
-
-          uint32_t thisDeviceId = m_device->GetNode ()->GetId ();
-          uint32_t otherDeviceId = otherDevice->GetNode ()->GetId ();
-          if (channelMatrix->IsReverse (thisDeviceId, otherDeviceId))
-            {
-              // reverse BF vectors
-              bfVectors = std::make_pair (std::get<1> (bfVectors), std::get<0> (bfVectors));
-            }
+          aInitConj[i] = std::conj (aBf[i]);
         }
+      aInit = &aInitConj;
     }
 
-  // configure the antenna to use the new beamforming vector
-  m_antenna->SetBeamformingVector (std::get<0> (bfVectors));
-  NS_LOG_LOGIC ("antenna " << m_antenna
-                           << " set BF vector"
-                           << " numAntennaElem " << m_antenna->GetNumberOfElements ()
-                           << " this device ID=" << m_device->GetNode ()->GetId ()
-                           << " otherDevice ID=" << otherDevice->GetNode ()->GetId ());
-  otherAntenna->SetBeamformingVector (std::get<1> (bfVectors));
-  NS_LOG_LOGIC ("antenna " << otherAntenna
-                           << " set BF vector"
-                           << " numAntennaElem " << otherAntenna->GetNumberOfElements ()
-                           << " this device ID=" << otherDevice->GetNode ()->GetId ()
-                           << " otherDevice ID=" << m_device->GetNode ()->GetId ());
-
-  if (toCache)
-    {
-      auto entry {m_cacheChannelMap.find (otherDevice)};
-      if (entry != m_cacheChannelMap.end ())
-        {
-          entry->second = channelMatrix;
-          // this means there is also an entry for the bf vector
-          m_cacheBfVectors.find (otherDevice)->second = bfVectors;
-        }
-      else
-        {
-          m_cacheChannelMap.insert (std::make_pair (otherDevice, channelMatrix));
-          m_cacheBfVectors.insert (std::make_pair (otherDevice, bfVectors));
-        }
-    }
+  return ComputeBeamformingVectors (channelMatrix, bInit, aInit);
 }
 
 std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector>
-MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params) const
+MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                 const ThreeGppAntennaArrayModel::ComplexVector *bInit,
+                                                 const ThreeGppAntennaArrayModel::ComplexVector *aInit) const
 {
   //generate transmitter side spatial correlation matrix
   uint16_t aSize = params->m_channel.size ();
   uint16_t bSize = params->m_channel[0].size ();
   uint16_t clusterSize = params->m_channel[0][0].size ();
 
-  // compute narrowband channel by summing over the cluster index
-  MatrixBasedChannelModel::Complex2DVector narrowbandChannel;
-  narrowbandChannel.resize (aSize);
-
-  for (uint16_t aIndex = 0; aIndex < aSize; aIndex++)
-    {
-      narrowbandChannel[aIndex].resize (bSize);
-    }
-
+  // compute narrowband channel by summing over the cluster index, stored
+  // row-major in a flat matrix
+  m_narrowbandChannel.resize (aSize * bSize);
   for (uint16_t aIndex = 0; aIndex < aSize; aIndex++)
     {
       for (uint16_t bIndex = 0; bIndex < bSize; bIndex++)
         {
+          const ThreeGppAntennaArrayModel::ComplexVector &clusters = params->m_channel[aIndex][bIndex];
           std::complex<double> cSum (0, 0);
           for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
             {
-              cSum += params->m_channel[aIndex][bIndex][cIndex];
+              cSum += clusters[cIndex];
             }
-          narrowbandChannel[aIndex][bIndex] = cSum;
+          m_narrowbandChannel[aIndex * bSize + bIndex] = cSum;
         }
     }
 
   //compute the transmitter side spatial correlation matrix bQ = H*H, where H is the sum of H_n over n clusters.
-  MatrixBasedChannelModel::Complex2DVector bQ;
-  bQ.resize (bSize);
-
-  for (uint16_t bIndex = 0; bIndex < bSize; bIndex++)
-    {
-      bQ[bIndex].resize (bSize);
-    }
-
+  //The matrix is hermitian, only the upper triangle is computed.
+  m_correlation.resize (bSize * bSize);
   for (uint16_t b1Index = 0; b1Index < bSize; b1Index++)
     {
-      for (uint16_t b2Index = 0; b2Index < bSize; b2Index++)
+      for (uint16_t b2Index = b1Index; b2Index < bSize; b2Index++)
         {
           std::complex<double> aSum (0,0);
           for (uint16_t aIndex = 0; aIndex < aSize; aIndex++)
             {
-              aSum += std::conj (narrowbandChannel[aIndex][b1Index]) * narrowbandChannel[aIndex][b2Index];
+              const std::complex<double> *h = &m_narrowbandChannel[aIndex * bSize];
+              aSum += std::conj (h[b1Index]) * h[b2Index];
+            }
+          m_correlation[b1Index * bSize + b2Index] = aSum;
+          if (b2Index != b1Index)
+            {
+              m_correlation[b2Index * bSize + b1Index] = std::conj (aSum);
             }
-          bQ[b1Index][b2Index] += aSum;
         }
     }
 
   //calculate beamforming vector from spatial correlation matrix
-  ThreeGppAntennaArrayModel::ComplexVector bW = GetFirstEigenvector (bQ);
+  ThreeGppAntennaArrayModel::ComplexVector bW;
+  InitEigenvector (m_correlation, bSize, bInit, bW);
+  uint32_t bIter = GetFirstEigenvector (m_correlation, bW, m_maxIterations, m_tolerance, m_iterate);
 
   //compute the receiver side spatial correlation matrix aQ = HH*, where H is the sum of H_n over n clusters.
-  MatrixBasedChannelModel::Complex2DVector aQ;
-  aQ.resize (aSize);
-
-  for (uint16_t aIndex = 0; aIndex < aSize; aIndex++)
-    {
-      aQ[aIndex].resize (aSize);
-    }
-
+  m_correlation.resize (aSize * aSize);
   for (uint16_t a1Index = 0; a1Index < aSize; a1Index++)
     {
-      for (uint16_t a2Index = 0; a2Index < aSize; a2Index++)
+      const std::complex<double> *h1 = &m_narrowbandChannel[a1Index * bSize];
+      for (uint16_t a2Index = a1Index; a2Index < aSize; a2Index++)
         {
+          const std::complex<double> *h2 = &m_narrowbandChannel[a2Index * bSize];
           std::complex<double> bSum (0,0);
           for (uint16_t bIndex = 0; bIndex < bSize; bIndex++)
             {
-              bSum += narrowbandChannel[a1Index][bIndex] * std::conj (narrowbandChannel[a2Index][bIndex]);
+              bSum += h1[bIndex] * std::conj (h2[bIndex]);
+            }
+          m_correlation[a1Index * aSize + a2Index] = bSum;
+          if (a2Index != a1Index)
+            {
+              m_correlation[a2Index * aSize + a1Index] = std::conj (bSum);
             }
-          aQ[a1Index][a2Index] += bSum;
         }
     }
 
   //calculate beamforming vector from spatial correlation matrix.
-  ThreeGppAntennaArrayModel::ComplexVector aW = GetFirstEigenvector (aQ);
+  ThreeGppAntennaArrayModel::ComplexVector aW;
+  InitEigenvector (m_correlation, aSize, aInit, aW);
+  uint32_t aIter = GetFirstEigenvector (m_correlation, aW, m_maxIterations, m_tolerance, m_iterate);
+  NS_LOG_DEBUG ("eigenvectors computed in " << bIter << " and " << aIter << " iterations"
+                << (bInit != 0 ? " (warm start)" : ""));
 
   for (size_t i = 0; i < aW.size (); ++i)
     {
@@ -412,54 +490,281 @@ MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelMod
   return std::make_pair (bW, aW);
 }
 
-ThreeGppAntennaArrayModel::ComplexVector
-MmWaveSvdBeamforming::GetFirstEigenvector (MatrixBasedChannelModel::Complex2DVector A) const
+void
+MmWaveSvdBeamforming::InitEigenvector (const ThreeGppAntennaArrayModel::ComplexVector &A, uint16_t size,
+                                       const ThreeGppAntennaArrayModel::ComplexVector *init,
+                                       ThreeGppAntennaArrayModel::ComplexVector &v)
 {
-  ThreeGppAntennaArrayModel::ComplexVector antennaWeights;
-  uint16_t arraySize = A.size ();
-  for (uint16_t eIndex = 0; eIndex < arraySize; eIndex++)
+  if (init != 0 && init->size () == size)
     {
-      antennaWeights.push_back (A[0][eIndex]);
+      double norm = 0;
+      for (uint16_t i = 0; i < size; i++)
+        {
+          norm += std::norm ((*init)[i]);
+        }
+      // a link without MPCs caches all-zero vectors, which cannot be used
+      if (norm > 0)
+        {
+          v = *init;
+          return;
+        }
     }
+  // cold start from the first row of A
+  v.assign (A.begin (), A.begin () + size);
+}
 
+uint32_t
+MmWaveSvdBeamforming::GetFirstEigenvector (const ThreeGppAntennaArrayModel::ComplexVector &A,
+                                           ThreeGppAntennaArrayModel::ComplexVector &v,
+                                           uint32_t maxIterations, double tolerance,
+                                           ThreeGppAntennaArrayModel::ComplexVector &scratch)
+{
+  uint16_t arraySize = v.size ();
+  NS_ASSERT (A.size () >= static_cast<size_t> (arraySize) * arraySize);
+  scratch.resize (arraySize);
 
   uint32_t iter = 0;
   double diff = 1;
-  while (iter < m_maxIterations && diff > m_tolerance)
+  while (iter < maxIterations && diff > tolerance)
     {
-      ThreeGppAntennaArrayModel::ComplexVector antennaWeightsNew;
-
+      // power iteration: scratch = A * v
       for (uint16_t row = 0; row < arraySize; row++)
         {
+          const std::complex<double> *a = &A[row * arraySize];
           std::complex<double> sum (0,0);
           for (uint16_t col = 0; col < arraySize; col++)
             {
-              sum += A[row][col] * antennaWeights[col];
+              sum += a[col] * v[col];
             }
-
-          antennaWeightsNew.push_back (sum);
+          scratch[row] = sum;
         }
-      //normalize antennaWeights;
+      //normalize scratch
       double weighbSum = 0;
       for (uint16_t i = 0; i < arraySize; i++)
         {
-          weighbSum += norm (antennaWeightsNew[i]);
+          weighbSum += norm (scratch[i]);
         }
       for (uint16_t i = 0; i < arraySize; i++)
         {
-          antennaWeightsNew[i] = antennaWeightsNew[i] / sqrt (weighbSum);
+          scratch[i] = scratch[i] / sqrt (weighbSum);
         }
       diff = 0;
       for (uint16_t i = 0; i < arraySize; i++)
         {
-          diff += std::norm (antennaWeightsNew[i] - antennaWeights[i]);
+          diff += std::norm (scratch[i] - v[i]);
         }
       iter++;
-      antennaWeights = antennaWeightsNew;
+      v.swap (scratch);
     }
   NS_LOG_DEBUG ("antennaWeigths stopped after " << iter << " iterations with diff=" << diff << std::endl);
 
-  return antennaWeights;
+  return iter;
+}
+
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveCodebookBeamforming);
+
+TypeId
+MmWaveCodebookBeamforming::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveCodebookBeamforming")
+    .SetParent<MmWaveBeamformingModel> ()
+    .AddConstructor<MmWaveCodebookBeamforming> ()
+    .AddAttribute ("ChannelModel",
+                   "Pointer to the MatrixBasedChannelModel object used in the simulation scenario",
+                   PointerValue (),
+                   MakePointerAccessor (&MmWaveCodebookBeamforming::m_channel),
+                   MakePointerChecker<MatrixBasedChannelModel> ())
+    .AddAttribute ("HorizontalOversampling",
+                   "Oversampling factor of the DFT codebooks in the horizontal dimension",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&MmWaveCodebookBeamforming::m_horizontalOversampling),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("VerticalOversampling",
+                   "Oversampling factor of the DFT codebooks in the vertical dimension",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&MmWaveCodebookBeamforming::m_verticalOversampling),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("UseCache",
+                   "Use the cache for the BF vectors. Do not set it to false unless you have very good reasons",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MmWaveCodebookBeamforming::m_useCache),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+MmWaveCodebookBeamforming::MmWaveCodebookBeamforming ()
+  : m_horizontalOversampling {1},
+    m_verticalOversampling {1},
+    m_useCache {false}
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveCodebookBeamforming::~MmWaveCodebookBeamforming ()
+{
+}
+
+void
+MmWaveCodebookBeamforming::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_channel = 0;
+  m_codebooks.clear ();
+  MmWaveBeamformingModel::DoDispose ();
+}
+
+const ThreeGppAntennaArrayModel::ComplexVector &
+MmWaveCodebookBeamforming::GetCodebook (Ptr<const ThreeGppAntennaArrayModel> antenna)
+{
+  NS_LOG_FUNCTION (this << antenna);
+
+  UintegerValue uintValue;
+  antenna->GetAttribute ("NumRows", uintValue);
+  uint32_t numRows = uintValue.Get ();
+  antenna->GetAttribute ("NumColumns", uintValue);
+  uint32_t numColumns = uintValue.Get ();
+
+  auto key = std::make_pair (numRows, numColumns);
+  auto it = m_codebooks.find (key);
+  if (it != m_codebooks.end ())
+    {
+      return it->second;
+    }
+
+  uint32_t numElements = numRows * numColumns;
+  uint32_t numH = numColumns * m_horizontalOversampling;
+  uint32_t numV = numRows * m_verticalOversampling;
+  uint32_t numCodewords = numH * numV;
+  NS_LOG_DEBUG ("codebook for a " << numRows << "x" << numColumns << " array with " << numCodewords << " codewords");
+
+  double power = 1 / sqrt (numElements);
+  ThreeGppAntennaArrayModel::ComplexVector codebook (numElements * numCodewords);
+  for (uint32_t eIndex = 0; eIndex < numElements; eIndex++)
+    {
+      // same element ordering as ThreeGppAntennaArrayModel::GetElementLocation
+      uint32_t column = eIndex % numColumns;
+      uint32_t row = eIndex / numColumns;
+      for (uint32_t l = 0; l < numV; l++)
+        {
+          for (uint32_t k = 0; k < numH; k++)
+            {
+              double phase = 2 * M_PI * (static_cast<double> (column * k) / numH
+                                         + static_cast<double> (row * l) / numV);
+              codebook[eIndex * numCodewords + l * numH + k] = std::polar (power, phase);
+            }
+        }
+    }
+  return m_codebooks.insert (std::make_pair (key, codebook)).first->second;
+}
+
+void
+MmWaveCodebookBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
+{
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+  SetBeamformingVectorsFromChannel (m_channel, m_useCache, otherDevice, otherAntenna);
+}
+
+MmWaveBeamformingModel::BeamformingVectors
+MmWaveCodebookBeamforming::ComputeBeamformingVectorsForLink (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                             Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                             Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                             const BeamformingVectors *cachedBfVectors)
+{
+  NS_LOG_FUNCTION (this << channelMatrix << sAntenna << uAntenna << cachedBfVectors);
+  return ComputeBeamformingVectors (channelMatrix, GetCodebook (sAntenna), GetCodebook (uAntenna));
+}
+
+std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector>
+MmWaveCodebookBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                      const ThreeGppAntennaArrayModel::ComplexVector &sCodebook,
+                                                      const ThreeGppAntennaArrayModel::ComplexVector &uCodebook) const
+{
+  uint16_t uSize = params->m_channel.size ();
+  uint16_t sSize = params->m_channel[0].size ();
+  uint16_t clusterSize = params->m_channel[0][0].size ();
+  uint32_t sCodewords = sCodebook.size () / sSize;
+  uint32_t uCodewords = uCodebook.size () / uSize;
+  NS_ASSERT_MSG (sCodewords * sSize == sCodebook.size () && uCodewords * uSize == uCodebook.size (),
+                 "The codebooks do not match the size of the channel matrix");
+
+  // As in ThreeGppSpectrumPropagationLossModel::CalcLongTerm, the response of
+  // cluster c to the pair of codewords (i, j) is u_i^T H_c s_j, and the gain of
+  // the pair is the sum of the powers of its cluster responses.
+  // First compute all the H_c S products, stacked in a (clusters * uSize) x
+  // sCodewords matrix
+  m_channelTimesCodebook.assign (clusterSize * uSize * sCodewords, 0);
+  for (uint16_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      for (uint16_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          const ThreeGppAntennaArrayModel::ComplexVector &clusters = params->m_channel[uIndex][sIndex];
+          const std::complex<double> *sRow = &sCodebook[sIndex * sCodewords];
+          for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
+            {
+              std::complex<double> h = clusters[cIndex];
+              std::complex<double> *row = &m_channelTimesCodebook[(cIndex * uSize + uIndex) * sCodewords];
+              for (uint32_t j = 0; j < sCodewords; j++)
+                {
+                  row[j] += h * sRow[j];
+                }
+            }
+        }
+    }
+
+  // then U^T (H_c S) for each cluster, accumulating the power of each pair
+  m_beamPairGain.assign (uCodewords * sCodewords, 0.0);
+  for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
+    {
+      m_beamPairResponse.assign (uCodewords * sCodewords, 0);
+      for (uint16_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          const std::complex<double> *hsRow = &m_channelTimesCodebook[(cIndex * uSize + uIndex) * sCodewords];
+          const std::complex<double> *uRow = &uCodebook[uIndex * uCodewords];
+          for (uint32_t i = 0; i < uCodewords; i++)
+            {
+              std::complex<double> u = uRow[i];
+              std::complex<double> *response = &m_beamPairResponse[i * sCodewords];
+              for (uint32_t j = 0; j < sCodewords; j++)
+                {
+                  response[j] += u * hsRow[j];
+                }
+            }
+        }
+      for (uint32_t k = 0; k < uCodewords * sCodewords; k++)
+        {
+          m_beamPairGain[k] += std::norm (m_beamPairResponse[k]);
+        }
+    }
+
+  uint32_t best = 0;
+  for (uint32_t k = 1; k < uCodewords * sCodewords; k++)
+    {
+      if (m_beamPairGain[k] > m_beamPairGain[best])
+        {
+          best = k;
+        }
+    }
+  uint32_t uBest = best / sCodewords;
+  uint32_t sBest = best % sCodewords;
+  NS_LOG_DEBUG ("best beam pair s " << sBest << " u " << uBest << " out of "
+                << sCodewords << "x" << uCodewords << " with gain " << m_beamPairGain[best]);
+
+  ThreeGppAntennaArrayModel::ComplexVector sW (sSize);
+  for (uint16_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+      sW[sIndex] = sCodebook[sIndex * sCodewords + sBest];
+    }
+  ThreeGppAntennaArrayModel::ComplexVector uW (uSize);
+  for (uint16_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      uW[uIndex] = uCodebook[uIndex * uCodewords + uBest];
+    }
+  return std::make_pair (sW, uW);
 }
 
 } // namespace mmwave
@@ -91,8 +91,43 @@ public:
 protected:
   virtual void DoDispose (void) override;
 
+  /// the beamforming vectors of the two antennas of a link
+  typedef std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> BeamformingVectors;
+
+  /**
+   * Computes the beamforming vectors of this device and of the target device
+   * from the channel matrix between them, and configures the two antennas.
+   * The beamforming vectors are recomputed with ComputeBeamformingVectorsForLink
+   * only when the channel matrix has changed, if useCache is true.
+   * \param channel the channel model providing the channel matrix
+   * \param useCache whether to cache the beamforming vectors of each target device
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   */
+  void SetBeamformingVectorsFromChannel (Ptr<MatrixBasedChannelModel> channel, bool useCache,
+                                         Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna);
+
+  /**
+   * Computes the beamforming vectors of the two antennas of a link, used by
+   * SetBeamformingVectorsFromChannel
+   * \param channelMatrix the channel matrix, with at least one cluster
+   * \param sAntenna the antenna of the transmitter side (s) of channelMatrix
+   * \param uAntenna the antenna of the receiver side (u) of channelMatrix
+   * \param cachedBfVectors the beamforming vectors of the s and u antennas
+   *        computed on the previous channel matrix of the link, or 0
+   * \return a pair with the beamforming vectors of the s and u antennas
+   */
+  virtual BeamformingVectors ComputeBeamformingVectorsForLink (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                               Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                               Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                               const BeamformingVectors *cachedBfVectors);
+
   Ptr<NetDevice> m_device; //!< pointer to the NetDevice
   Ptr<ThreeGppAntennaArrayModel> m_antenna; //!< The antenna of the device on which the beamforming is applied
+
+private:
+  std::map<Ptr<NetDevice>, Ptr<const MatrixBasedChannelModel::ChannelMatrix> > m_cacheChannelMap; //!< map that stores the channel previously computed
+  std::map<Ptr<NetDevice>, BeamformingVectors> m_cacheBfVectors; //!< map that stores the previous bf vectors
 };
 
 
@@ -163,35 +198,148 @@ public:
    */
   void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
 
+  /**
+   * Compute the eigenvector related to the highest eigenvalue with the power
+   * iteration method, starting from the given vector.
+   * No memory is allocated once v and scratch have the right size.
+   * \param A spatial correlation matrix (complex, hermitian), flattened
+   *        row-major, of size v.size () x v.size ()
+   * \param v the initial vector, replaced by the eigenvector
+   * \param maxIterations maximum number of iterations
+   * \param tolerance if the squared norm of the difference of two consecutive
+   *        vectors is below this threshold, stop computation before
+   *        maxIterations iterations
+   * \param scratch working buffer
+   * \return the number of iterations
+   */
+  static uint32_t GetFirstEigenvector (const ThreeGppAntennaArrayModel::ComplexVector &A,
+                                       ThreeGppAntennaArrayModel::ComplexVector &v,
+                                       uint32_t maxIterations, double tolerance,
+                                       ThreeGppAntennaArrayModel::ComplexVector &scratch);
+
 private:
   void DoDispose (void) override;
+  BeamformingVectors ComputeBeamformingVectorsForLink (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                       Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                       Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                       const BeamformingVectors *cachedBfVectors) override;
   /**
    * Compute the beamforming vectors using SVD
    * \param params the channel matrix
+   * \param bInit the initial vector for the eigenvector of the transmitter
+   *        side correlation matrix, or 0
+   * \param aInit the initial vector for the eigenvector of the receiver
+   *        side correlation matrix, or 0
    * \return a pair with the beamforming vectors
    */
-  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params) const;
+  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                                                                                        const ThreeGppAntennaArrayModel::ComplexVector *bInit,
+                                                                                                                        const ThreeGppAntennaArrayModel::ComplexVector *aInit) const;
 
   /**
-   * Compute eigenvector related to highest eigenvalue
-   * \param A spatial correlation matrix (complex, hermitian)
-   * \param nIter maximum number of iterations
-   * \param threshold if norm of two consecutive vectors is below this threshold, stop computation before nIter iterations
-   * \return eigenvector
+   * Set the initial vector of the power iterations: init if it is a valid
+   * vector of the right size, the first row of A otherwise
+   * \param A spatial correlation matrix, flattened row-major
+   * \param size the number of rows of A
+   * \param init the warm start vector, or 0
+   * \param v the initial vector
    */
-  ThreeGppAntennaArrayModel::ComplexVector GetFirstEigenvector (MatrixBasedChannelModel::Complex2DVector A) const;
-
+  static void InitEigenvector (const ThreeGppAntennaArrayModel::ComplexVector &A, uint16_t size,
+                               const ThreeGppAntennaArrayModel::ComplexVector *init,
+                               ThreeGppAntennaArrayModel::ComplexVector &v);
 
   Ptr<MatrixBasedChannelModel> m_channel; //!< pointer to the MatrixChannel, to retrieve the matrix on which the SVD should be computed
 
-  std::map<Ptr<NetDevice>, Ptr<const MatrixBasedChannelModel::ChannelMatrix> > m_cacheChannelMap; //!< map that stores the channel previously computed
-  std::map<Ptr<NetDevice>, std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> > m_cacheBfVectors; //!< map that stores the previous bf vectors
   uint32_t m_maxIterations; //!< Maximum number of iterations to numerically approximate the SVD decomposition
   double m_tolerance; //!< Tolerance to numerically approximate the SVD decomposition
   bool m_useCache; //!< Cache the channel matrix whenever possible. NOTE: the SVD decomposition can be extremely computationally expensive, caching is suggested.
+  bool m_warmStart; //!< Start the power iterations from the cached BF vectors of the same device
+  mutable ThreeGppAntennaArrayModel::ComplexVector m_narrowbandChannel; //!< narrowband channel matrix, reused across calls
+  mutable ThreeGppAntennaArrayModel::ComplexVector m_correlation; //!< spatial correlation matrix, reused across calls
+  mutable ThreeGppAntennaArrayModel::ComplexVector m_iterate; //!< working buffer of the power iterations
 };
 
 
+/**
+ * This class extends the MmWaveBeamformingModel interface.
+ * It implements a beam sweep over oversampled 2D DFT codebooks, such as the
+ * 3GPP Type I codebooks: each antenna array can only use one of a finite
+ * set of beams, and the pair of beams of the two devices is the one with
+ * the highest gain on the current channel.
+ *
+ * The codeword (k, l) of an array with M rows and N columns, and with O1
+ * and O2 as horizontal and vertical oversampling factors, has weight
+ * exp (j 2 pi (n k / (N O1) + m l / (M O2))) / sqrt (M N) for the element
+ * in row m and column n.  The codebook of each array size is computed once
+ * and stored as an elements x codewords matrix, so that the gain of all
+ * the beam pairs is obtained with matrix products between the cluster
+ * channels and the two codebooks.
+ */
+class MmWaveCodebookBeamforming : public MmWaveBeamformingModel
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveCodebookBeamforming ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveCodebookBeamforming () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Computes the beamforming vector to communicate with the target device
+   * and sets the antenna.
+   * The beamforming vectors are the codewords of the two antennas with the
+   * highest beamforming gain.
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   */
+  void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
+
+  /**
+   * Returns the codebook of an antenna array
+   * \param antenna the antenna
+   * \return the codebook, as a flattened row-major matrix with one row
+   *         per antenna element and one column per codeword
+   */
+  const ThreeGppAntennaArrayModel::ComplexVector & GetCodebook (Ptr<const ThreeGppAntennaArrayModel> antenna);
+
+private:
+  void DoDispose (void) override;
+  BeamformingVectors ComputeBeamformingVectorsForLink (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                       Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                       Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                       const BeamformingVectors *cachedBfVectors) override;
+  /**
+   * Find the pair of codewords with the highest gain
+   * \param params the channel matrix
+   * \param sCodebook the codebook of the transmitter side (s) antenna
+   * \param uCodebook the codebook of the receiver side (u) antenna
+   * \return a pair with the beamforming vectors of the s and u antennas
+   */
+  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                                                                                        const ThreeGppAntennaArrayModel::ComplexVector &sCodebook,
+                                                                                                                        const ThreeGppAntennaArrayModel::ComplexVector &uCodebook) const;
+
+  Ptr<MatrixBasedChannelModel> m_channel; //!< pointer to the MatrixChannel, to retrieve the matrix on which the beams are evaluated
+
+  std::map<std::pair<uint32_t, uint32_t>, ThreeGppAntennaArrayModel::ComplexVector> m_codebooks; //!< codebooks for each (rows, columns) array size
+  uint32_t m_horizontalOversampling; //!< Oversampling factor of the codebooks in the horizontal dimension
+  uint32_t m_verticalOversampling; //!< Oversampling factor of the codebooks in the vertical dimension
+  bool m_useCache; //!< Cache the beamforming vectors whenever possible
+  mutable ThreeGppAntennaArrayModel::ComplexVector m_channelTimesCodebook; //!< the cluster channels times the s codebook, reused across calls
+  mutable ThreeGppAntennaArrayModel::ComplexVector m_beamPairResponse; //!< response of all the beam pairs for a cluster, reused across calls
+  mutable std::vector<double> m_beamPairGain; //!< gain of all the beam pairs, reused across calls
+};
+
 } // namespace mmwave
 } // namespace ns3
 
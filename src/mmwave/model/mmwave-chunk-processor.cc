@@ -59,7 +59,11 @@ void
 mmWaveChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
+  if (m_sumValues != 0)
+    {
+      // reuse the buffer of the previous reception
+      (*m_sumValues) = 0.0;
+    }
   m_totDuration = MicroSeconds (0);
 }
 
@@ -68,11 +72,17 @@ void
 mmWaveChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModel () != sinr.GetSpectrumModel ())
     {
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
+  // accumulate in place, without a temporary SpectrumValue
+  double seconds = duration.GetSeconds ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
+  for (Values::iterator it = m_sumValues->ValuesBegin (); it != m_sumValues->ValuesEnd (); ++it, ++sinrIt)
+    {
+      *it += *sinrIt * seconds;
+    }
   m_totDuration += duration;
 }
 
@@ -82,10 +92,12 @@ mmWaveChunkProcessor::End ()
   NS_LOG_FUNCTION (this);
   if (m_totDuration.GetSeconds () > 0)
     {
+      // the average is computed in place, the sum is reset by Start ()
+      (*m_sumValues) /= m_totDuration.GetSeconds ();
       std::vector<mmWaveChunkProcessorCallback>::iterator it;
       for (it = m_mmWaveChunkProcessorCallbacks.begin (); it != m_mmWaveChunkProcessorCallbacks.end (); it++)
         {
-          (*it)((*m_sumValues) / m_totDuration.GetSeconds ());
+          (*it)(*m_sumValues);
         }
     }
   else
@@ -167,7 +167,7 @@ void
 MmWaveEnbPhy::DoInitialize (void)
 {
   NS_LOG_FUNCTION (this);
-  Ptr<SpectrumValue> noisePsd = MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+  Ptr<const SpectrumValue> noisePsd = MmWaveSpectrumValueHelper::GetNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
   m_downlinkSpectrumPhy->SetNoisePowerSpectralDensity (noisePsd);
 
   for (unsigned i = 0; i < m_phyMacConfig->GetL1L2Latency (); i++)
@@ -542,11 +542,11 @@ MmWaveEnbPhy::CalcChannelQualityForUe (std::vector <double> sinr, Ptr<MmWaveSpec
 
 }
 
-Ptr<SpectrumValue>
+Ptr<const SpectrumValue>
 MmWaveEnbPhy::CreateTxPowerSpectralDensity ()
 {
-  Ptr<SpectrumValue> psd =
-    MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, m_txPower, m_listOfSubchannels );
+  Ptr<const SpectrumValue> psd =
+    MmWaveSpectrumValueHelper::GetTxPowerSpectralDensity (m_phyMacConfig, m_txPower, m_listOfSubchannels );
   return psd;
 }
 
@@ -560,7 +560,8 @@ void
 MmWaveEnbPhy::SetSubChannels (std::vector<int> mask )
 {
   m_listOfSubchannels = mask;
-  Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensity ();
+  m_ueTxPsdCache.clear ();
+  Ptr<const SpectrumValue> txPsd = CreateTxPowerSpectralDensity ();
   NS_ASSERT (txPsd);
   m_downlinkSpectrumPhy->SetTxPowerSpectralDensity (txPsd);
 }
@@ -577,6 +578,20 @@ MmWaveEnbPhy::GetUlSpectrumPhy () const
   return m_uplinkSpectrumPhy;
 }
 
+Ptr<const SpectrumValue>
+MmWaveEnbPhy::GetUeTxPowerSpectralDensity (double ueTxPower)
+{
+  std::map<double, Ptr<const SpectrumValue> >::iterator it = m_ueTxPsdCache.find (ueTxPower);
+  if (it == m_ueTxPsdCache.end ())
+    {
+      // it is the eNB that dictates the conf, m_listOfSubchannels contains all the subch
+      Ptr<const SpectrumValue> txPsd =
+        MmWaveSpectrumValueHelper::GetTxPowerSpectralDensity (m_phyMacConfig, ueTxPower, m_listOfSubchannels);
+      it = m_ueTxPsdCache.insert (std::make_pair (ueTxPower, txPsd)).first;
+    }
+  return it->second;
+}
+
 void
 MmWaveEnbPhy::UpdateUeSinrEstimate ()
 {
@@ -586,9 +601,18 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
   m_rxPsdMap.clear ();
 
 
-  Ptr<SpectrumValue> noisePsd = MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+  Ptr<const SpectrumValue> noisePsd = MmWaveSpectrumValueHelper::GetNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
   Ptr<SpectrumValue> totalReceivedPsd = Create <SpectrumValue> (SpectrumValue (noisePsd->GetSpectrumModel ()));
 
+  // get this node mobility
+  Ptr<MobilityModel> enbMob = m_netDevice->GetNode ()->GetObject<MobilityModel> ();
+  NS_LOG_LOGIC ("eNB mobility " << enbMob->GetPosition ());
+
+  // The UEs are processed one at a time, in IMSI order: the beamforming
+  // configuration below changes the state of the shared antenna arrays, and
+  // the channel and beamforming models draw from their random streams and
+  // update their caches when a link is evaluated, so the links cannot be
+  // evaluated concurrently without changing the results.
   for (std::map<uint64_t, Ptr<NetDevice> >::iterator ue = m_ueAttachedImsiMap.begin (); ue != m_ueAttachedImsiMap.end (); ++ue)
     {
       // distinguish between MC and MmWaveNetDevice
@@ -619,14 +643,11 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
       NS_LOG_LOGIC ("Linear UE Tx power = " << powerTxW);
       NS_LOG_LOGIC ("System bandwidth = " << m_phyMacConfig->GetBandwidth ());
       NS_LOG_LOGIC ("txPowerDensity = " << txPowerDensity);
-      // create tx psd
-      Ptr<SpectrumValue> txPsd =                                                        // it is the eNB that dictates the conf, m_listOfSubchannels contains all the subch
-        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, ueTxPower, m_listOfSubchannels);
+      // get tx psd
+      Ptr<const SpectrumValue> txPsd = GetUeTxPowerSpectralDensity (ueTxPower);
       NS_LOG_LOGIC ("TxPsd " << *txPsd);
 
-      // get this node and remote node mobility
-      Ptr<MobilityModel> enbMob = m_netDevice->GetNode ()->GetObject<MobilityModel> ();
-      NS_LOG_LOGIC ("eNB mobility " << enbMob->GetPosition ());
+      // get remote node mobility
       Ptr<MobilityModel> ueMob = ue->second->GetNode ()->GetObject<MobilityModel> ();
       NS_LOG_DEBUG ("UE mobility " << ueMob->GetPosition ());
 
@@ -697,8 +718,7 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
 
   for (std::map<uint64_t, Ptr<SpectrumValue> >::iterator ue = m_rxPsdMap.begin (); ue != m_rxPsdMap.end (); ++ue)
     {
-      SpectrumValue interference = *totalReceivedPsd - *(ue->second);
-      NS_LOG_LOGIC ("interference " << interference);
+      NS_LOG_LOGIC ("interference " << *totalReceivedPsd - *(ue->second));
       SpectrumValue sinr = *(ue->second) / (*noisePsd);           // + interference);
       // we consider the SNR only!
       NS_LOG_LOGIC ("sinr " << sinr);
@@ -1074,23 +1094,8 @@ MmWaveEnbPhy::StartTti (void)
                                             currTti.m_dci.m_mcs, m_channelChunks, currTti.m_dci.m_harqProcess, currTti.m_dci.m_rv, false,
                                             currTti.m_dci.m_symStart, currTti.m_dci.m_numSym);
 
-      for (uint8_t i = 0; i < m_deviceMap.size (); i++)
-        {
-          Ptr<mmwave::MmWaveUeNetDevice> ueDev = DynamicCast<mmwave::MmWaveUeNetDevice> (m_deviceMap.at (i));
-          Ptr<McUeNetDevice> mcUeDev = DynamicCast<McUeNetDevice> (m_deviceMap.at (i));
-          uint64_t ueRnti = (ueDev != 0) ? (ueDev->GetPhy ()->GetRnti ()) : (mcUeDev->GetMmWavePhy ()->GetRnti ());
-          Ptr<NetDevice> associatedEnb = (ueDev != 0) ? (ueDev->GetTargetEnb ()) : (mcUeDev->GetMmWaveTargetEnb ());
-
-          NS_LOG_DEBUG ("Scheduled rnti: " << currTti.m_rnti << " ue rnti: " << ueRnti
-                                           << " target eNB " << associatedEnb << " this eNB " << m_netDevice);
-
-          if (currTti.m_rnti == ueRnti && m_netDevice == associatedEnb)
-            {
-              // point the beam towards the user
-              m_downlinkSpectrumPhy->ConfigureBeamforming (m_deviceMap.at (i));
-              break;
-            }
-        }
+      // point the beam towards the user
+      ConfigureBeamformingForRnti (currTti.m_rnti);
 
       NS_LOG_DEBUG ("ENB " << m_cellId << " RXing UL DATA frame " << m_frameNum << " subframe " << (unsigned)m_sfNum << " slot "
                            << (uint16_t)m_slotNum << " symbols " << (unsigned)currTti.m_dci.m_symStart << "-" << (unsigned)(currTti.m_dci.m_symStart + currTti.m_dci.m_numSym - 1)
@@ -1168,40 +1173,66 @@ MmWaveEnbPhy::SendDataChannels (Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo&
     }
   else
     {     // update beamforming vectors (currently supports 1 user only)
-      //std::map<uint16_t, std::vector<unsigned> >::iterator ueRbIt = slotInfo.m_ueRbMap.begin();
-      //uint16_t rnti = ueRbIt->first;
-      for (uint8_t i = 0; i < m_deviceMap.size (); i++)
-        {
-          uint64_t ueRnti = 0;
-          Ptr<mmwave::MmWaveUeNetDevice> ueDev = m_deviceMap.at (i)->GetObject<mmwave::MmWaveUeNetDevice> ();
-          Ptr<NetDevice> associatedEnb = 0;
-          if (ueDev != 0)
-            {
-              ueRnti = ueDev->GetPhy ()->GetRnti ();
-              associatedEnb = ueDev->GetTargetEnb ();
-            }
-          else
-            {
-              Ptr<McUeNetDevice> ueMcDev = m_deviceMap.at (i)->GetObject<McUeNetDevice> ();
-              ueRnti = ueMcDev->GetMmWavePhy ()->GetRnti ();
-              associatedEnb = ueMcDev->GetMmWaveTargetEnb ();
-            }
+      ConfigureBeamformingForRnti (slotInfo.m_dci.m_rnti);
+    }
+
+
+  std::list<Ptr<MmWaveControlMessage> > ctrlMsgs;
+  m_downlinkSpectrumPhy->StartTxDataFrames (pb, ctrlMsgs, slotPrd, slotInfo.m_ttiIdx);
+}
 
-          NS_LOG_DEBUG ("Scheduled rnti: " << slotInfo.m_dci.m_rnti << " ue rnti: " << ueRnti
-                                           << " target eNB " << associatedEnb << " this eNB " << m_netDevice);
-          if (slotInfo.m_dci.m_rnti == ueRnti && m_netDevice == associatedEnb)
+bool
+MmWaveEnbPhy::IsServedUe (Ptr<NetDevice> ueDevice, uint16_t rnti) const
+{
+  uint16_t ueRnti = 0;
+  Ptr<NetDevice> associatedEnb = 0;
+  Ptr<mmwave::MmWaveUeNetDevice> ueDev = DynamicCast<mmwave::MmWaveUeNetDevice> (ueDevice);
+  if (ueDev != 0)
+    {
+      ueRnti = ueDev->GetPhy ()->GetRnti ();
+      associatedEnb = ueDev->GetTargetEnb ();
+    }
+  else
+    {
+      Ptr<McUeNetDevice> ueMcDev = DynamicCast<McUeNetDevice> (ueDevice);
+      ueRnti = ueMcDev->GetMmWavePhy ()->GetRnti ();
+      associatedEnb = ueMcDev->GetMmWaveTargetEnb ();
+    }
+
+  NS_LOG_DEBUG ("Scheduled rnti: " << rnti << " ue rnti: " << ueRnti
+                                   << " target eNB " << associatedEnb << " this eNB " << m_netDevice);
+  return rnti == ueRnti && m_netDevice == associatedEnb;
+}
+
+void
+MmWaveEnbPhy::ConfigureBeamformingForRnti (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  Ptr<NetDevice> ueDevice = 0;
+  std::map <uint16_t, Ptr<NetDevice> >::iterator cached = m_rntiDeviceCache.find (rnti);
+  if (cached != m_rntiDeviceCache.end () && IsServedUe (cached->second, rnti))
+    {
+      ueDevice = cached->second;
+    }
+  else
+    {
+      for (std::vector< Ptr<NetDevice> >::const_iterator it = m_deviceMap.begin (); it != m_deviceMap.end (); ++it)
+        {
+          if (IsServedUe (*it, rnti))
             {
-              NS_LOG_DEBUG ("Change Beamforming Vector");
-              m_downlinkSpectrumPhy->ConfigureBeamforming (m_deviceMap.at (i));
+              ueDevice = *it;
+              m_rntiDeviceCache[rnti] = ueDevice;
               break;
             }
-
         }
     }
 
-
-  std::list<Ptr<MmWaveControlMessage> > ctrlMsgs;
-  m_downlinkSpectrumPhy->StartTxDataFrames (pb, ctrlMsgs, slotPrd, slotInfo.m_ttiIdx);
+  if (ueDevice != 0)
+    {
+      NS_LOG_DEBUG ("Change Beamforming Vector");
+      m_downlinkSpectrumPhy->ConfigureBeamforming (ueDevice);
+    }
 }
 
 void
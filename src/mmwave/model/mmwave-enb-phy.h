@@ -80,7 +80,7 @@ public:
 
   void CalcChannelQualityForUe (std::vector <double> sinr, Ptr<MmWaveSpectrumPhy> ue);
 
-  virtual Ptr<SpectrumValue> CreateTxPowerSpectralDensity () override;
+  virtual Ptr<const SpectrumValue> CreateTxPowerSpectralDensity () override;
 
   void SetSubChannels (std::vector<int> mask );
 
@@ -156,6 +156,16 @@ public:
 
   void UpdateUeSinrEstimate ();
 
+  /**
+   * Return the PSD transmitted by a UE with the given power on the
+   * subchannels of this eNB, used for the periodic SINR estimate.
+   * The PSDs are cached per power level and invalidated by SetSubChannels.
+   *
+   * \param ueTxPower the UE tx power (dBm)
+   * \return the UE tx PSD
+   */
+  Ptr<const SpectrumValue> GetUeTxPowerSpectralDensity (double ueTxPower);
+
   double AddGaussianNoise (double sample);
 
   std::pair <uint64_t,uint64_t> ApplyFilter (std::vector<double>);
@@ -169,6 +179,26 @@ public:
 
 
 private:
+  /**
+   * Point the beam of the eNB towards the UE scheduled with the given RNTI,
+   * if the UE is served by this eNB.  The UE device of each RNTI is cached,
+   * and the cached device is used only if its RNTI and target eNB still
+   * match, so that m_deviceMap is scanned only when the association changes.
+   *
+   * \param rnti the RNTI of the scheduled UE
+   */
+  void ConfigureBeamformingForRnti (uint16_t rnti);
+
+  /**
+   * Check whether a UE device currently has the given RNTI and this eNB as
+   * target eNB.
+   *
+   * \param ueDevice the MmWaveUeNetDevice or McUeNetDevice
+   * \param rnti the RNTI
+   * \return true if the UE is served by this eNB with the given RNTI
+   */
+  bool IsServedUe (Ptr<NetDevice> ueDevice, uint16_t rnti) const;
+
   bool AddUePhy (uint16_t rnti);
   // LteEnbCphySapProvider forwarded methods
   void DoSetBandwidth (uint8_t ulBandwidth, uint8_t dlBandwidth);
@@ -215,6 +245,8 @@ private:
   std::map <uint64_t, Ptr<NetDevice> > m_ueAttachedImsiMap;
   std::map <uint64_t, double > m_sinrMap;
   std::map <uint64_t, Ptr<SpectrumValue> > m_rxPsdMap;
+  std::map <double, Ptr<const SpectrumValue> > m_ueTxPsdCache;        // UE tx PSD for each tx power (dBm), see GetUeTxPowerSpectralDensity
+  std::map <uint16_t, Ptr<NetDevice> > m_rntiDeviceCache;        // UE device of each scheduled RNTI, see ConfigureBeamformingForRnti
   std::map <pairDevices_t, std::vector<double> > m_sinrVector;        // array containing all SINR values for a specific pair (UE-eNB)
   std::map <pairDevices_t, std::vector<double> > m_sinrVectorToFilter;        // array containing the  SINR values that must be filtered
   std::map <pairDevices_t, std::vector<double> > m_sinrVectorNoisy;        // array containing the  noisy SINR values that must be filteredF
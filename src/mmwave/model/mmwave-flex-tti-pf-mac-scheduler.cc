@@ -1024,6 +1024,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
   // ********************* END OF HARQ SECTION, START OF NEW DATA SCHEDULING ********************* //
 
   // compute achievable rates in current subframe
+  m_ueStatHeap.clear ();
   for (std::map<uint16_t, UeSchedInfo>::iterator ueIt = m_ueSchedInfoMap.begin (); ueIt != m_ueSchedInfoMap.end (); ueIt++)
     {
       UeSchedInfo* ueInfo = &ueIt->second;
@@ -1124,82 +1125,72 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
 //		std::cout << frameNum << " " << sfNum << " " << itUeAllocMap->second->m_rlcPduInfo.size () << std::endl;
 //	}
 
-  // allocate each slot to UE with highest PF metric, then update PF metrics
-  while (symAvail > 0)
+  // allocate each symbol to the UE with highest PF metric, then update its PF metric.
+  // Only the metric of the UE that gets the symbol changes, so the UEs are kept in a
+  // heap and each allocation costs O(log n) instead of a sort of all the UEs
+  std::make_heap (m_ueStatHeap.begin (), m_ueStatHeap.end (),
+                  MmWaveFlexTtiPfMacScheduler::CompareUeWeightsPf);
+  while (symAvail > 0 && !m_ueStatHeap.empty ())
     {
-      std::sort (m_ueStatHeap.begin (), m_ueStatHeap.end (),
-                 MmWaveFlexTtiPfMacScheduler::CompareUeWeightsPf);
+      std::pop_heap (m_ueStatHeap.begin (), m_ueStatHeap.end (),
+                     MmWaveFlexTtiPfMacScheduler::CompareUeWeightsPf);
+      UeSchedInfo* ueInfo = m_ueStatHeap.back ();
+      m_ueStatHeap.pop_back ();
+
+      if (ueInfo->m_totBufDl == 0)
+        {
+          ueInfo->m_dlAllocDone = true;
+        }
+      if (ueInfo->m_totBufUl == 0)
+        {
+          ueInfo->m_ulAllocDone = true;
+        }
+
       // evenly distribute symbols between DL and UL flows of same UE
-      bool ueAlloc = false;
-      std::vector<UeSchedInfo*>::iterator ueHeapIt = m_ueStatHeap.begin ();
-//		for (itUeAllocMap = ueAllocMap.begin (); itUeAllocMap != ueAllocMap.end(); itUeAllocMap++)
-//		{
-//			UeSchedInfo* ueInfo = itUeAllocMap->second;
-//			double pfMetric = std::max(ueInfo->m_currTputDl,ueInfo->m_currTputUl) / std::max(1E-9,(ueInfo->m_avgTputDl + ueInfo->m_avgTputDl));
-//			std::cout << ueInfo->m_rnti << "=" << pfMetric << " ";
-//		}
-//		std::cout << std::endl;
-
-      while (!ueAlloc && ueHeapIt != m_ueStatHeap.end ())
+      if ((ueInfo->m_allocUlLast || ueInfo->m_dlAllocDone) && !ueInfo->m_ulAllocDone)
         {
-          UeSchedInfo* ueInfo = *ueHeapIt;
 
-          if (ueInfo->m_totBufDl == 0)
-            {
-              ueInfo->m_dlAllocDone = true;
-            }
-          if (ueInfo->m_totBufUl == 0)
+          ueInfo->m_ulSymbols++;
+          symAvail--;
+          ueInfo->m_ulTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols) / 8;
+          if (ueInfo->m_ulTbSize >= ueInfo->m_totBufUl)
             {
               ueInfo->m_ulAllocDone = true;
+              ueInfo->m_lastAvgTputUl = ueInfo->m_avgTputUl;
             }
+          ueInfo->m_allocUlLast = true;
 
-          if ((ueInfo->m_allocUlLast || ueInfo->m_dlAllocDone) && !ueInfo->m_ulAllocDone)
-            {
-
-              ueInfo->m_ulSymbols++;
-              symAvail--;
-              ueInfo->m_ulTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols) / 8;
-              if (ueInfo->m_ulTbSize >= ueInfo->m_totBufUl)
-                {
-                  ueInfo->m_ulAllocDone = true;
-                  ueInfo->m_lastAvgTputUl = ueInfo->m_avgTputUl;
-                }
-              ueInfo->m_allocUlLast = true;
-
-              uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols);
-              ueInfo->m_currTputUl = std::min (ueInfo->m_totBufUl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
-              ueInfo->m_avgTputUl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputUl) +
-                ((1.0 / m_timeWindow) * ((double)ueInfo->m_ulTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
-              ueAlloc = true;
+          uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols);
+          ueInfo->m_currTputUl = std::min (ueInfo->m_totBufUl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
+          ueInfo->m_avgTputUl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputUl) +
+            ((1.0 / m_timeWindow) * ((double)ueInfo->m_ulTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
+        }
+      else if (!ueInfo->m_dlAllocDone)
+        {
 
-            }
-          else if (!ueInfo->m_dlAllocDone)
+          ueInfo->m_dlSymbols++;
+          symAvail--;
+          ueInfo->m_dlTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols) / 8;
+          if (ueInfo->m_dlTbSize >= ueInfo->m_totBufDl)
             {
-
-              ueInfo->m_dlSymbols++;
-              symAvail--;
-              ueInfo->m_dlTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols) / 8;
-              if (ueInfo->m_dlTbSize >= ueInfo->m_totBufDl)
-                {
-                  ueInfo->m_dlAllocDone = true;
-                  ueInfo->m_lastAvgTputDl = ueInfo->m_avgTputDl;
-                }
-              ueInfo->m_allocUlLast = false;
-
-              uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols);
-              ueInfo->m_currTputDl = std::min (ueInfo->m_totBufDl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
-              ueInfo->m_avgTputDl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputDl) +
-                ((1.0 / m_timeWindow) * ((double)ueInfo->m_dlTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
-              ueAlloc = true;
+              ueInfo->m_dlAllocDone = true;
+              ueInfo->m_lastAvgTputDl = ueInfo->m_avgTputDl;
             }
+          ueInfo->m_allocUlLast = false;
 
-          ueHeapIt++;
+          uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols);
+          ueInfo->m_currTputDl = std::min (ueInfo->m_totBufDl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
+          ueInfo->m_avgTputDl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputDl) +
+            ((1.0 / m_timeWindow) * ((double)ueInfo->m_dlTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
         }
-
-      if (!ueAlloc)
+      else
         {
-          break;
+          continue;               // both DL and UL allocations are done, drop the UE from the heap
         }
+
+      m_ueStatHeap.push_back (ueInfo);
+      std::push_heap (m_ueStatHeap.begin (), m_ueStatHeap.end (),
+                      MmWaveFlexTtiPfMacScheduler::CompareUeWeightsPf);
     }
 
   // no further allocations
@@ -205,11 +205,20 @@ private:
 
   };
 
+  static double GetPfMetric (const UeSchedInfo* ue)
+  {
+    return std::max (ue->m_currTputDl,ue->m_currTputUl) / std::max (1E-9,(ue->m_avgTputDl + ue->m_avgTputDl));
+  }
+
+  /**
+   * Heap order of m_ueStatHeap: the top of the heap is the UE with the
+   * highest PF metric and, among UEs with the same metric, the lowest RNTI.
+   */
   static bool CompareUeWeightsPf (UeSchedInfo* lue, UeSchedInfo* rue)
   {
-    double lPfMetric = std::max (lue->m_currTputDl,lue->m_currTputUl) / std::max (1E-9,(lue->m_avgTputDl + lue->m_avgTputDl));
-    double rPfMetric = std::max (rue->m_currTputDl,rue->m_currTputUl) / std::max (1E-9,(rue->m_avgTputDl + rue->m_avgTputDl));
-    return (lPfMetric > rPfMetric);
+    double lPfMetric = GetPfMetric (lue);
+    double rPfMetric = GetPfMetric (rue);
+    return (lPfMetric < rPfMetric) || (lPfMetric == rPfMetric && lue->m_rnti > rue->m_rnti);
   }
 
 
@@ -431,7 +440,7 @@ private:
   double m_timeWindow;
 
   std::vector <FlowStats*> m_flowHeap;
-  std::vector <UeSchedInfo*> m_ueStatHeap;
+  std::vector <UeSchedInfo*> m_ueStatHeap;     // UEs with data in the current slot, see CompareUeWeightsPf
 };
 
 }
@@ -43,6 +43,8 @@ namespace mmwave {
 //NS_OBJECT_ENSURE_REGISTERED (MmWaveHarqPhy)
 //  ;
 
+const uint8_t MmWaveHarqProcessInfoList_t::MAX_TX;
+
 
 MmWaveHarqPhy::MmWaveHarqPhy (uint32_t harqNum)
 {
@@ -72,7 +74,7 @@ MmWaveHarqPhy::GetAccumulatedMiDl (uint16_t rnti, uint8_t harqId)
   std::map <uint16_t, std::vector <MmWaveHarqProcessInfoList_t> >::iterator it;
   it = m_miDlHarqProcessesInfoMap.find (rnti);
   NS_ASSERT_MSG (it != m_miDlHarqProcessesInfoMap.end (), " Does not find MI for RNTI");
-  MmWaveHarqProcessInfoList_t list = (*it).second.at (harqId);
+  const MmWaveHarqProcessInfoList_t& list = (*it).second.at (harqId);
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -81,7 +83,7 @@ MmWaveHarqPhy::GetAccumulatedMiDl (uint16_t rnti, uint8_t harqId)
   return (mi);
 }
 
-MmWaveHarqProcessInfoList_t
+const MmWaveHarqProcessInfoList_t&
 MmWaveHarqPhy::GetHarqProcessInfoDl (uint16_t rnti, uint8_t harqProcId)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)harqProcId);
@@ -92,8 +94,8 @@ MmWaveHarqPhy::GetHarqProcessInfoDl (uint16_t rnti, uint8_t harqProcId)
       // new entry
       std::vector <MmWaveHarqProcessInfoList_t> harqList;
       harqList.resize (m_harqNum);
-      m_miDlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <MmWaveHarqProcessInfoList_t> > (rnti, harqList));
-      return (harqList.at (harqProcId));
+      it = m_miDlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <MmWaveHarqProcessInfoList_t> > (rnti, harqList)).first;
+      return ((*it).second.at (harqProcId));
     }
   else
     {
@@ -110,7 +112,7 @@ MmWaveHarqPhy::GetAccumulatedMiUl (uint16_t rnti, uint8_t harqId)
   std::map <uint16_t, std::vector <MmWaveHarqProcessInfoList_t> >::iterator it;
   it = m_miUlHarqProcessesInfoMap.find (rnti);
   NS_ASSERT_MSG (it != m_miUlHarqProcessesInfoMap.end (), " Does not find MI for RNTI");
-  MmWaveHarqProcessInfoList_t list = (*it).second.at (harqId);
+  const MmWaveHarqProcessInfoList_t& list = (*it).second.at (harqId);
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -119,7 +121,7 @@ MmWaveHarqPhy::GetAccumulatedMiUl (uint16_t rnti, uint8_t harqId)
   return (mi);
 }
 
-MmWaveHarqProcessInfoList_t
+const MmWaveHarqProcessInfoList_t&
 MmWaveHarqPhy::GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)harqProcId);
@@ -130,8 +132,8 @@ MmWaveHarqPhy::GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId)
       // new entry
       std::vector <MmWaveHarqProcessInfoList_t> harqList;
       harqList.resize (m_harqNum);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <MmWaveHarqProcessInfoList_t> > (rnti, harqList));
-      return (harqList.at (harqProcId));
+      it = m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <MmWaveHarqProcessInfoList_t> > (rnti, harqList)).first;
+      return ((*it).second.at (harqProcId));
     }
   else
     {
@@ -162,7 +164,7 @@ MmWaveHarqPhy::UpdateDlHarqProcessStatus (uint16_t rnti, uint8_t harqId, double
     }
   else
     {
-      if ((*it).second.at (harqId).size () == 3)   // MAX HARQ RETX
+      if ((*it).second.at (harqId).size () == MmWaveHarqProcessInfoList_t::MAX_TX)   // MAX HARQ RETX
         {
           // HARQ should be disabled -> discard info
           return;
@@ -227,7 +229,7 @@ MmWaveHarqPhy::UpdateUlHarqProcessStatus (uint16_t rnti, uint8_t harqId, double
     }
   else
     {
-      if ((*it).second.at (harqId).size () == 3) // MAX HARQ RETX
+      if ((*it).second.at (harqId).size () == MmWaveHarqProcessInfoList_t::MAX_TX) // MAX HARQ RETX
         {
           // HARQ should be disabled -> discard info
           return;
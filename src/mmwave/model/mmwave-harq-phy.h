@@ -58,7 +58,109 @@ struct MmWaveHarqProcessInfoElement_t
   uint32_t m_codeBits;
 };
 
-typedef std::vector <MmWaveHarqProcessInfoElement_t> MmWaveHarqProcessInfoList_t;
+/**
+ * \ingroup MmWave
+ * \brief The HARQ history of a TB, i.e., the info of its previous
+ * transmissions, at most MAX_TX of them.
+ *
+ * The elements are stored in place, so that a history can be kept for each
+ * HARQ process and read or copied without heap allocations.  The sums over
+ * the history needed by the MI error model to compute the effective MI and
+ * code rate are updated when an element is added, so that their cost does
+ * not depend on the length of the history.  The interface is the subset of
+ * std::vector used by the HARQ and error models.
+ */
+class MmWaveHarqProcessInfoList_t
+{
+public:
+  static const uint8_t MAX_TX = 3; //!< maximum number of transmissions of a TB (MAX HARQ RETX)
+
+  MmWaveHarqProcessInfoList_t ()
+    : m_size (0),
+      m_codeBitsSum (0),
+      m_miSum (0.0)
+  {
+  }
+
+  /**
+   * \return the number of transmissions in the history
+   */
+  uint8_t size () const
+  {
+    return m_size;
+  }
+
+  /**
+   * \return true if there are no transmissions in the history
+   */
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \param i the index of the transmission
+   * \return the info of the i-th transmission
+   */
+  const MmWaveHarqProcessInfoElement_t& at (uint8_t i) const
+  {
+    NS_ASSERT_MSG (i < m_size, "HARQ history index " << (uint16_t) i << " out of range");
+    return m_elements[i];
+  }
+
+  /**
+   * \return the info of the last transmission
+   */
+  const MmWaveHarqProcessInfoElement_t& back () const
+  {
+    return at (m_size - 1);
+  }
+
+  /**
+   * \brief Add a transmission to the history
+   * \param el the info of the transmission
+   */
+  void push_back (const MmWaveHarqProcessInfoElement_t& el)
+  {
+    NS_ASSERT_MSG (m_size < MAX_TX, "HARQ history full");
+    m_elements[m_size++] = el;
+    m_codeBitsSum += el.m_codeBits;
+    m_miSum += (el.m_mi * el.m_codeBits);
+  }
+
+  /**
+   * \brief Remove all the transmissions from the history
+   */
+  void clear ()
+  {
+    m_size = 0;
+    m_codeBitsSum = 0;
+    m_miSum = 0.0;
+  }
+
+  /**
+   * \return the sum of the code bits of the transmissions in the history
+   */
+  uint32_t GetCodeBitsSum () const
+  {
+    return m_codeBitsSum;
+  }
+
+  /**
+   * \return the sum of the MI of the transmissions in the history, each
+   * weighted by its code bits
+   */
+  double GetMiSum () const
+  {
+    return m_miSum;
+  }
+
+private:
+  MmWaveHarqProcessInfoElement_t m_elements[MAX_TX]; //!< the transmissions in the history
+  uint8_t m_size; //!< the number of transmissions in the history
+  uint32_t m_codeBitsSum; //!< the sum of the code bits of the transmissions
+  double m_miSum; //!< the sum of the MI of the transmissions, weighted by their code bits
+};
 
 /**
  * \ingroup MmWave
@@ -90,7 +192,7 @@ public:
   * \param layer layer no. (for MIMO spatail multiplexing)
   * \return the vector of the info related to HARQ proc Id
   */
-  MmWaveHarqProcessInfoList_t GetHarqProcessInfoDl (uint16_t rnti, uint8_t harqProcId);
+  const MmWaveHarqProcessInfoList_t& GetHarqProcessInfoDl (uint16_t rnti, uint8_t harqProcId);
 
   /**
   * \brief Return the cumulated MI of the HARQ procId in case of retranmissions
@@ -106,7 +208,7 @@ public:
   * \param harqProcId the HARQ proc id
   * \return the vector of the info related to HARQ proc Id
   */
-  MmWaveHarqProcessInfoList_t GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId);
+  const MmWaveHarqProcessInfoList_t& GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId);
 
   /**
   * \brief Update the Info associated to the decodification of an HARQ process
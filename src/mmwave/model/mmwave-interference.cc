@@ -85,7 +85,15 @@ mmWaveInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
   if (m_receiving == false)
     {
       NS_LOG_LOGIC ("first signal");
-      m_rxSignal = rxPsd->Copy ();
+      if (m_rxSignal == 0 || m_rxSignal->GetSpectrumModel () != rxPsd->GetSpectrumModel ())
+        {
+          m_rxSignal = rxPsd->Copy ();
+        }
+      else
+        {
+          // reuse the buffer of the previous reception
+          *m_rxSignal = *rxPsd;
+        }
       m_lastChangeTime = Now ();
       m_receiving = true;
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
@@ -189,8 +197,20 @@ mmWaveInterference::ConditionallyEvaluateChunk ()
   if (m_receiving && (Now () > m_lastChangeTime))
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-      SpectrumValue sinr = (*m_rxSignal) / interf;
+      // sinr = signal / (allSignals - signal + noise), computed in a single
+      // pass into a buffer reused across chunks
+      if (m_sinr.GetSpectrumModel () != m_rxSignal->GetSpectrumModel ())
+        {
+          m_sinr = SpectrumValue (m_rxSignal->GetSpectrumModel ());
+        }
+      Values::const_iterator rxIt = m_rxSignal->ConstValuesBegin ();
+      Values::const_iterator allIt = m_allSignals->ConstValuesBegin ();
+      Values::const_iterator noiseIt = m_noise->ConstValuesBegin ();
+      for (Values::iterator sinrIt = m_sinr.ValuesBegin (); sinrIt != m_sinr.ValuesEnd (); ++sinrIt, ++rxIt, ++allIt, ++noiseIt)
+        {
+          *sinrIt = *rxIt / (*allIt - *rxIt + *noiseIt);
+        }
+      const SpectrumValue &sinr = m_sinr;
       Time duration = Now () - m_lastChangeTime;
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
         {
@@ -69,6 +69,7 @@ private:
   Ptr<SpectrumValue> m_rxSignal;
   Ptr<SpectrumValue> m_allSignals;
   Ptr<const SpectrumValue> m_noise;
+  SpectrumValue m_sinr;
 
   Time m_lastChangeTime;
 
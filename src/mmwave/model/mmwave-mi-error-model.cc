@@ -55,150 +55,62 @@ MmWaveMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map,
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
 
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-
-  for (uint32_t i = 0; i < map.size (); i++)
-    {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MMWAVE_MI_QPSK_MAX_ID) // QPSK
-        {
-
-          if (sinrLin > MI_map_qpsk_axis[MMWAVE_MI_MAP_QPSK_SIZE - 1])
-            {
-              MI = 1;
-            }
-          else
-            {
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk =
-                (MMWAVE_MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MMWAVE_MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
-        {
-          if (mcs > MMWAVE_MI_QPSK_MAX_ID && mcs <= MMWAVE_MI_16QAM_MAX_ID )    // 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MMWAVE_MI_MAP_16QAM_SIZE - 1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam =
-                    (MMWAVE_MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MMWAVE_MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MMWAVE_MI_MAP_64QAM_SIZE - 1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam =
-                    (MMWAVE_MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MMWAVE_MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-      MIsum += MI;
-    }
-  MI = MIsum / map.size ();
+  double MI = LteMiKernel::Mib (sinr, map, LteMiKernel::GetModulation (mcs));
   NS_LOG_LOGIC (" MI = " << MI);
   return MI;
 }
 
+MmWaveMibs_t
+MmWaveMiErrorModel::GetMibs (const SpectrumValue& sinr, const std::vector<int>& map)
+{
+  NS_LOG_FUNCTION (sinr << &map);
+
+  MmWaveMibs_t mibs = LteMiKernel::GetMibs (sinr, map);
+  NS_LOG_LOGIC (" MI QPSK = " << mibs.qpsk << ", 16-QAM = " << mibs.qam16 << ", 64-QAM = " << mibs.qam64);
+  return mibs;
+}
+
+double
+MmWaveMiErrorModel::GetMibForMcs (const MmWaveMibs_t& mibs, uint8_t mcs)
+{
+  return LteMiKernel::GetMibForMcs (mibs, mcs);
+}
 
 double
 MmWaveMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint32_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
+  return LteMiKernel::MappingMiBler (mib, ecrId, cbSize);
+}
 
-  NS_ASSERT_MSG (ecrId <= MMWAVE_MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
-  int cbIndex = 1;
-  while ((cbIndex < 9)&&(cbMiSizeTable[cbIndex] <= cbSize))
-    {
-      cbIndex++;
-    }
-  cbIndex--;
-  NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
+MmWaveTbStats_t
+MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, const MmWaveHarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b < 0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i < 9)&&(b < 0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c < 0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i < 9)&&(c < 0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
-  // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5 * ( 1 - erf ((mib - b) / (sqrt (2) * c)) );
-  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
-  return bler;
+  return GetTbDecodificationStats (Mib (sinr, map, mcs), size, mcs, miHistory);
 }
 
 MmWaveTbStats_t
-MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, MmWaveHarqProcessInfoList_t miHistory)
+MmWaveMiErrorModel::GetTbDecodificationStats (const MmWaveMibs_t& mibs, uint32_t size, uint8_t mcs, const MmWaveHarqProcessInfoList_t& miHistory)
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
+  NS_LOG_FUNCTION ((uint32_t) size << (uint32_t) mcs);
+
+  return GetTbDecodificationStats (GetMibForMcs (mibs, mcs), size, mcs, miHistory);
+}
 
-  double tbMi = Mib (sinr, map, mcs);
+MmWaveTbStats_t
+MmWaveMiErrorModel::GetTbDecodificationStats (double tbMi, uint32_t size, uint8_t mcs, const MmWaveHarqProcessInfoList_t& miHistory)
+{
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
   if (miHistory.size () > 0)
     {
-      // evaluate R_eff and MI_eff
-      uint32_t codeBitsSum = 0;
-      double miSum = 0.0;
-      for (uint16_t i = 0; i < miHistory.size (); i++)
-        {
-          NS_LOG_DEBUG (" Sum MI " << miHistory.at (i).m_mi << " Ci " << miHistory.at (i).m_codeBits);
-          codeBitsSum += miHistory.at (i).m_codeBits;
-          miSum += (miHistory.at (i).m_mi * miHistory.at (i).m_codeBits);
-        }
+      // evaluate R_eff and MI_eff, the sums over the previous transmissions are kept by miHistory
+      uint32_t codeBitsSum = miHistory.GetCodeBitsSum ();
+      double miSum = miHistory.GetMiSum ();
+      NS_LOG_DEBUG (" Sum MI " << miSum << " Ci " << codeBitsSum);
       codeBitsSum += (((double)size * 8.0) / McsEcrTable [mcs]);
       miSum += (tbMi * (((double)size * 8.0) / McsEcrTable [mcs]));
       Reff = miHistory.at (0).m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
@@ -210,99 +122,8 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
     }
   NS_LOG_DEBUG (" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size ());
   // estimate CB size (according to sec 5.1.2 of TS 36.212)
-  uint16_t Z = 6144; // max size of a codeblock (including CRC)
-  uint32_t B = size * 8;
-//   B = 1234;
-  uint32_t L = 0;
-  uint32_t C = 0; // no. of codeblocks
-  uint32_t Cplus = 0; // no. of codeblocks with size K+
-  uint32_t Kplus = 0; // no. of codeblocks with size K+
-  uint32_t Cminus = 0; // no. of codeblocks with size K+
-  uint32_t Kminus = 0; // no. of codeblocks with size K+
-  uint32_t B1 = 0;
-  uint32_t deltaK = 0;
-  if (B <= Z)
-    {
-      // only one codeblock
-      L = 0;
-      C = 1;
-      B1 = B;
-    }
-  else
-    {
-      L = 24;
-      C = ceil ((double)B / ((double)(Z - L)));
-      B1 = B + C * L;
-    }
-  // first segmentation: K+ = minimum K in table such that C * K >= B1
-//   uint i = 0;
-//   while (B1 > cbSizeTable[i] * C)
-//     {
-// //       NS_LOG_INFO (" K+ " << cbSizeTable[i] << " means " << cbSizeTable[i] * C);
-//       i++;
-//     }
-//   uint32_t KplusId = i;
-//   Kplus = cbSizeTable[i];
-
-  // implement a modified binary search
-  int min = 0;
-  int max = 187;
-  int mid = 0;
-  do
-    {
-      mid = (min + max) / 2;
-      if (B1 > cbSizeTable[mid] * C)
-        {
-          if (B1 < cbSizeTable[mid + 1] * C)
-            {
-              break;
-            }
-          else
-            {
-              min = mid + 1;
-            }
-        }
-      else
-        {
-          if (B1 > cbSizeTable[mid - 1] * C)
-            {
-              break;
-            }
-          else
-            {
-              max = mid - 1;
-            }
-        }
-    }
-  while ((cbSizeTable[mid] * C != B1) && (min < max));
-  // adjust binary search to the largest integer value of K containing B1
-  if (B1 > cbSizeTable[mid] * C)
-    {
-      mid++;
-    }
-
-  uint32_t KplusId = mid;
-  Kplus = cbSizeTable[mid];
-
-
-  if (C == 1)
-    {
-      Cplus = 1;
-      Cminus = 0;
-      Kminus = 0;
-    }
-  else
-    {
-      // second segmentation size: K- = maximum K in table such that K < K+
-      // -fstrict-overflow sensitive, see bug 1868
-      Kminus = cbSizeTable[ KplusId > 1 ? KplusId - 1 : 0];
-      deltaK = Kplus - Kminus;
-      Cminus = floor ((((double) C * Kplus) - (double)B1) / (double)deltaK);
-      Cplus = C - Cminus;
-    }
-  NS_LOG_INFO ("--------------------LteMiErrorModel: TB size of " << B << " needs of " << B1 << " bits reparted in " << C << " CBs as " << Cplus << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
+  LteMiKernel::CodeBlocks cbs = LteMiKernel::SegmentTb (size * 8);
 
-  double errorRate = 1.0;
   uint8_t ecrId = 0;
   if (miHistory.size () == 0)
     {
@@ -347,18 +168,7 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
       NS_LOG_DEBUG ("HARQ ECR " << (uint16_t)ecrId);
     }
 
-  if (C != 1)
-    {
-      double cbler = MappingMiBler (MI, ecrId, Kplus);
-      errorRate *= pow (1.0 - cbler, Cplus);
-      cbler = MappingMiBler (MI, ecrId, Kminus);
-      errorRate *= pow (1.0 - cbler, Cminus);
-      errorRate = 1.0 - errorRate;
-    }
-  else
-    {
-      errorRate = MappingMiBler (MI, ecrId, Kplus);
-    }
+  double errorRate = LteMiKernel::GetTbBler (MI, ecrId, cbs);
 
   NS_LOG_LOGIC (" Error rate " << errorRate);
   MmWaveTbStats_t ret;
@@ -277,22 +277,11 @@ MmWavePhy::GetControlMessages (void)
       return (emptylist);
     }
 
-  if (m_controlMessageQueue.at (0).size () > 0)
-    {
-      std::list<Ptr<MmWaveControlMessage> > ret = m_controlMessageQueue.front ();
-      m_controlMessageQueue.erase (m_controlMessageQueue.begin ());
-      std::list<Ptr<MmWaveControlMessage> > newlist;
-      m_controlMessageQueue.push_back (newlist);
-      return (ret);
-    }
-  else
-    {
-      m_controlMessageQueue.erase (m_controlMessageQueue.begin ());
-      std::list<Ptr<MmWaveControlMessage> > newlist;
-      m_controlMessageQueue.push_back (newlist);
-      std::list<Ptr<MmWaveControlMessage> > emptylist;
-      return (emptylist);
-    }
+  std::list<Ptr<MmWaveControlMessage> > ret;
+  ret.swap (m_controlMessageQueue.front ());
+  m_controlMessageQueue.pop_front ();
+  m_controlMessageQueue.push_back (std::list<Ptr<MmWaveControlMessage> > ());
+  return (ret);
 }
 
 void
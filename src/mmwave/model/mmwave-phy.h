@@ -53,6 +53,7 @@
 #include "mmwave-phy-sap.h"
 #include <string>
 #include <map>
+#include <deque>
 
 namespace ns3 {
 
@@ -80,9 +81,10 @@ public:
 
   /**
    * \brief Compute the TX Power Spectral Density
-   * \return a pointer to a newly allocated SpectrumValue representing the TX Power Spectral Density in W/Hz for each Resource Block
+   * \return a pointer to a SpectrumValue representing the TX Power Spectral Density in W/Hz for each Resource Block,
+   *         shared through MmWaveSpectrumValueHelper::GetTxPowerSpectralDensity and thus not to be modified
    */
-  virtual Ptr<SpectrumValue> CreateTxPowerSpectralDensity () = 0;
+  virtual Ptr<const SpectrumValue> CreateTxPowerSpectralDensity () = 0;
 
   virtual void DoDispose () override;
 
@@ -170,7 +172,7 @@ protected:
   Ptr<MmWavePhyMacCommon> m_phyMacConfig;
 
   std::map<uint64_t, Ptr<PacketBurst> > m_packetBurstMap;
-  std::vector< std::list<Ptr<MmWaveControlMessage> > > m_controlMessageQueue;
+  std::deque< std::list<Ptr<MmWaveControlMessage> > > m_controlMessageQueue;
 
   std::vector <SlotAllocInfo> m_slotAllocInfo;  //!< Maps slot number to its allocation info
 
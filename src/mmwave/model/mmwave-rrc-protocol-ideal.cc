@@ -41,6 +41,8 @@
 #include <ns3/node-list.h>
 #include <ns3/node.h>
 #include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/trace-source-accessor.h>
 
 #include "ns3/lte-ue-rrc.h"
 #include "ns3/lte-enb-rrc.h"
@@ -62,7 +64,10 @@ NS_OBJECT_ENSURE_REGISTERED (MmWaveUeRrcProtocolIdeal);
 
 MmWaveUeRrcProtocolIdeal::MmWaveUeRrcProtocolIdeal ()
   :  m_ueRrcSapProvider (0),
-    m_enbRrcSapProvider (0)
+    m_enbRrcSapProvider (0),
+    m_sender (RRC_IDEAL_MSG_DELAY),
+    m_numMessages (0),
+    m_numEvents (0)
 {
   m_ueRrcSapUser = new MemberLteUeRrcSapUser<MmWaveUeRrcProtocolIdeal> (this);
 }
@@ -77,6 +82,7 @@ MmWaveUeRrcProtocolIdeal::DoDispose ()
   NS_LOG_FUNCTION (this);
   delete m_ueRrcSapUser;
   m_rrc = 0;
+  m_sender.CloseMeasurementReports ();
 }
 
 TypeId
@@ -85,6 +91,20 @@ MmWaveUeRrcProtocolIdeal::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::MmWaveUeRrcProtocolIdeal")
     .SetParent<Object> ()
     .AddConstructor<MmWaveUeRrcProtocolIdeal> ()
+    .AddAttribute ("CoalesceMeasurementReports",
+                   "If true, the measurement reports sent at the same time "
+                   "are delivered to the eNB by a single event.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveUeRrcProtocolIdeal::m_coalesceMeasurementReports),
+                   MakeBooleanChecker ())
+    .AddTraceSource ("RrcMessages",
+                     "Number of RRC messages sent to the eNB",
+                     MakeTraceSourceAccessor (&MmWaveUeRrcProtocolIdeal::m_numMessages),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("RrcEvents",
+                     "Number of events scheduled to deliver the RRC messages",
+                     MakeTraceSourceAccessor (&MmWaveUeRrcProtocolIdeal::m_numEvents),
+                     "ns3::TracedValueCallback::Uint64")
   ;
   return tid;
 }
@@ -107,6 +127,27 @@ MmWaveUeRrcProtocolIdeal::SetUeRrc (Ptr<LteUeRrc> rrc)
   m_rrc = rrc;
 }
 
+uint64_t
+MmWaveUeRrcProtocolIdeal::GetNumMessages (void) const
+{
+  return m_numMessages;
+}
+
+uint64_t
+MmWaveUeRrcProtocolIdeal::GetNumEvents (void) const
+{
+  return m_numEvents;
+}
+
+template <class T>
+void
+MmWaveUeRrcProtocolIdeal::SendToEnb (void (LteEnbRrcSapProvider::*recv) (uint16_t, T), T &msg)
+{
+  m_numMessages++;
+  m_numEvents++;
+  m_sender.Send (recv, m_enbRrcSapProvider, m_rnti, msg);
+}
+
 void
 MmWaveUeRrcProtocolIdeal::DoSetup (LteUeRrcSapUser::SetupParameters params)
 {
@@ -122,21 +163,13 @@ MmWaveUeRrcProtocolIdeal::DoSendRrcConnectionRequest (LteRrcSap::RrcConnectionRe
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcConnectionRequest,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionRequest, msg);
 }
 
 void
 MmWaveUeRrcProtocolIdeal::DoSendRrcConnectionSetupCompleted (LteRrcSap::RrcConnectionSetupCompleted msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted, msg);
 }
 
 void
@@ -147,52 +180,37 @@ MmWaveUeRrcProtocolIdeal::DoSendRrcConnectionReconfigurationCompleted (LteRrcSap
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted, msg);
 }
 
 void
 MmWaveUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentRequest (LteRrcSap::RrcConnectionReestablishmentRequest msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest, msg);
 }
 
 void
 MmWaveUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentComplete (LteRrcSap::RrcConnectionReestablishmentComplete msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  SendToEnb (&LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete, msg);
 }
 
 void
 MmWaveUeRrcProtocolIdeal::DoSendMeasurementReport (LteRrcSap::MeasurementReport msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvMeasurementReport,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       msg);
+  m_numMessages++;
+  if (m_sender.SendMeasurementReport (m_enbRrcSapProvider, m_rnti, msg, m_coalesceMeasurementReports))
+    {
+      m_numEvents++;
+    }
 }
 
 void
 MmWaveUeRrcProtocolIdeal::DoSendNotifySecondaryCellConnected (uint16_t mmWaveRnti,uint16_t mmWaveCellId)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteEnbRrcSapProvider::RecvRrcSecondaryCellInitialAccessSuccessful,
-                       m_enbRrcSapProvider,
-                       m_rnti,
-                       mmWaveRnti,
-                       mmWaveCellId);
+  m_numMessages++;
+  m_numEvents++;
+  m_sender.SendNotifySecondaryCellConnected (m_enbRrcSapProvider, m_rnti, mmWaveRnti, mmWaveCellId);
 }
 
 void
@@ -239,7 +257,9 @@ MmWaveUeRrcProtocolIdeal::SetEnbRrcSapProvider ()
 NS_OBJECT_ENSURE_REGISTERED (MmWaveEnbRrcProtocolIdeal);
 
 MmWaveEnbRrcProtocolIdeal::MmWaveEnbRrcProtocolIdeal ()
-  :  m_enbRrcSapProvider (0)
+  :  m_enbRrcSapProvider (0),
+    m_numMessages (0),
+    m_numEvents (0)
 {
   NS_LOG_FUNCTION (this);
   m_enbRrcSapUser = new MemberLteEnbRrcSapUser<MmWaveEnbRrcProtocolIdeal> (this);
@@ -263,6 +283,14 @@ MmWaveEnbRrcProtocolIdeal::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::MmWaveEnbRrcProtocolIdeal")
     .SetParent<Object> ()
     .AddConstructor<MmWaveEnbRrcProtocolIdeal> ()
+    .AddTraceSource ("RrcMessages",
+                     "Number of RRC messages sent to the UEs",
+                     MakeTraceSourceAccessor (&MmWaveEnbRrcProtocolIdeal::m_numMessages),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("RrcEvents",
+                     "Number of events scheduled to deliver the RRC messages",
+                     MakeTraceSourceAccessor (&MmWaveEnbRrcProtocolIdeal::m_numEvents),
+                     "ns3::TracedValueCallback::Uint64")
   ;
   return tid;
 }
@@ -285,6 +313,32 @@ MmWaveEnbRrcProtocolIdeal::SetCellId (uint16_t cellId)
   m_cellId = cellId;
 }
 
+uint64_t
+MmWaveEnbRrcProtocolIdeal::GetNumMessages (void) const
+{
+  return m_numMessages;
+}
+
+uint64_t
+MmWaveEnbRrcProtocolIdeal::GetNumEvents (void) const
+{
+  return m_numEvents;
+}
+
+template <class T>
+void
+MmWaveEnbRrcProtocolIdeal::SendToUe (void (LteUeRrcSapProvider::*recv) (T), LteUeRrcSapProvider* provider,
+                                     Ptr<IdealRrcMessage<T> > msg)
+{
+  m_numMessages++;
+  m_numEvents++;
+  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
+                       &IdealRrcMessage<T>::DeliverToUe,
+                       recv,
+                       provider,
+                       msg);
+}
+
 LteUeRrcSapProvider*
 MmWaveEnbRrcProtocolIdeal::GetUeRrcSapProvider (uint16_t rnti)
 {
@@ -322,6 +376,8 @@ void
 MmWaveEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::SystemInformation msg)
 {
   NS_LOG_FUNCTION (this << cellId);
+  // the UEs share the message in transit
+  Ptr<IdealRrcMessage<LteRrcSap::SystemInformation> > si = IdealRrcMessage<LteRrcSap::SystemInformation>::Take (msg);
   // walk list of all nodes to get UEs with this cellId
   Ptr<LteUeRrc> ueRrc;
   for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
@@ -338,11 +394,10 @@ MmWaveEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::
               if (ueRrc->GetCellId () == cellId)
                 {
                   NS_LOG_LOGIC ("sending SI to IMSI " << mmWaveUeDev->GetImsi ());
-                  ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
-                  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                                       &LteUeRrcSapProvider::RecvSystemInformation,
-                                       ueRrc->GetLteUeRrcSapProvider (),
-                                       msg);
+                  ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (si->Get ());
+                  SendToUe (&LteUeRrcSapProvider::RecvSystemInformation,
+                            ueRrc->GetLteUeRrcSapProvider (),
+                            si);
                 }
             }
           else
@@ -360,11 +415,10 @@ MmWaveEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::
                       if (ueRrc->GetCellId () == m_cellId)
                         {
                           NS_LOG_LOGIC ("sending SI to IMSI " << mcUeDev->GetImsi ());
-                          ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
-                          Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                                               &LteUeRrcSapProvider::RecvSystemInformation,
-                                               ueRrc->GetLteUeRrcSapProvider (),
-                                               msg);
+                          ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (si->Get ());
+                          SendToUe (&LteUeRrcSapProvider::RecvSystemInformation,
+                                    ueRrc->GetLteUeRrcSapProvider (),
+                                    si);
                         }
                     }
                   else // it may have just a double stack up to MAC layer
@@ -377,11 +431,10 @@ MmWaveEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::
                           if (ueRrc->GetCellId () == m_cellId)
                             {
                               NS_LOG_LOGIC ("sending SI to IMSI " << mcUeDev->GetImsi ());
-                              ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
-                              Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                                                   &LteUeRrcSapProvider::RecvSystemInformation,
-                                                   ueRrc->GetLteUeRrcSapProvider (),
-                                                   msg);
+                              ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (si->Get ());
+                              SendToUe (&LteUeRrcSapProvider::RecvSystemInformation,
+                                        ueRrc->GetLteUeRrcSapProvider (),
+                                        si);
                             }
                         }
                     }
@@ -394,55 +447,49 @@ MmWaveEnbRrcProtocolIdeal::DoSendSystemInformation (uint16_t cellId, LteRrcSap::
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionSetup (uint16_t rnti, LteRrcSap::RrcConnectionSetup msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteUeRrcSapProvider::RecvRrcConnectionSetup,
-                       GetUeRrcSapProvider (rnti),
-                       msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionSetup,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionSetup>::Take (msg));
 }
 
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionReconfiguration (uint16_t rnti, LteRrcSap::RrcConnectionReconfiguration msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
-                       GetUeRrcSapProvider (rnti),
-                       msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReconfiguration>::Take (msg));
 }
 
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishment (uint16_t rnti, LteRrcSap::RrcConnectionReestablishment msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
-                       GetUeRrcSapProvider (rnti),
-                       msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReestablishment>::Take (msg));
 }
 
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishmentReject (uint16_t rnti, LteRrcSap::RrcConnectionReestablishmentReject msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
-                       GetUeRrcSapProvider (rnti),
-                       msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReestablishmentReject>::Take (msg));
 }
 
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionRelease (uint16_t rnti, LteRrcSap::RrcConnectionRelease msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteUeRrcSapProvider::RecvRrcConnectionRelease,
-                       GetUeRrcSapProvider (rnti),
-                       msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionRelease,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionRelease>::Take (msg));
 }
 
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionReject (uint16_t rnti, LteRrcSap::RrcConnectionReject msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
-                       &LteUeRrcSapProvider::RecvRrcConnectionReject,
-                       GetUeRrcSapProvider (rnti),
-                       msg);
+  SendToUe (&LteUeRrcSapProvider::RecvRrcConnectionReject,
+            GetUeRrcSapProvider (rnti),
+            IdealRrcMessage<LteRrcSap::RrcConnectionReject>::Take (msg));
 }
 
 
@@ -455,6 +502,8 @@ MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectionSwitch (uint16_t rnti, LteRrcSap::
 void
 MmWaveEnbRrcProtocolIdeal::DoSendRrcConnectToMmWave (uint16_t rnti, uint16_t mmWaveCellId)
 {
+  m_numMessages++;
+  m_numEvents++;
   Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
                        &LteUeRrcSapProvider::RecvRrcConnectToMmWave,
                        GetUeRrcSapProvider (rnti),
@@ -555,7 +604,7 @@ MmWaveEnbRrcProtocolIdeal::DoEncodeHandoverPreparationInformation (LteRrcSap::Ha
   uint32_t msgId = ++g_handoverPreparationInfoMsgIdCounter;
   NS_ASSERT_MSG (g_handoverPreparationInfoMsgMap.find (msgId) == g_handoverPreparationInfoMsgMap.end (), "msgId " << msgId << " already in use");
   NS_LOG_INFO (" encoding msgId = " << msgId);
-  g_handoverPreparationInfoMsgMap.insert (std::pair<uint32_t, LteRrcSap::HandoverPreparationInfo> (msgId, msg));
+  std::swap (g_handoverPreparationInfoMsgMap[msgId], msg);
   MmWaveIdealHandoverPreparationInfoHeader h;
   h.SetMsgId (msgId);
   Ptr<Packet> p = Create<Packet> ();
@@ -572,7 +621,8 @@ MmWaveEnbRrcProtocolIdeal::DoDecodeHandoverPreparationInformation (Ptr<Packet> p
   NS_LOG_INFO (" decoding msgId = " << msgId);
   std::map<uint32_t, LteRrcSap::HandoverPreparationInfo>::iterator it = g_handoverPreparationInfoMsgMap.find (msgId);
   NS_ASSERT_MSG (it != g_handoverPreparationInfoMsgMap.end (), "msgId " << msgId << " not found");
-  LteRrcSap::HandoverPreparationInfo msg = it->second;
+  LteRrcSap::HandoverPreparationInfo msg;
+  std::swap (msg, it->second);
   g_handoverPreparationInfoMsgMap.erase (it);
   return msg;
 }
@@ -661,7 +711,7 @@ MmWaveEnbRrcProtocolIdeal::DoEncodeHandoverCommand (LteRrcSap::RrcConnectionReco
   uint32_t msgId = ++g_handoverCommandMsgIdCounter;
   NS_ASSERT_MSG (g_handoverCommandMsgMap.find (msgId) == g_handoverCommandMsgMap.end (), "msgId " << msgId << " already in use");
   NS_LOG_INFO (" encoding msgId = " << msgId);
-  g_handoverCommandMsgMap.insert (std::pair<uint32_t, LteRrcSap::RrcConnectionReconfiguration> (msgId, msg));
+  std::swap (g_handoverCommandMsgMap[msgId], msg);
   MmWaveIdealHandoverCommandHeader h;
   h.SetMsgId (msgId);
   Ptr<Packet> p = Create<Packet> ();
@@ -678,7 +728,8 @@ MmWaveEnbRrcProtocolIdeal::DoDecodeHandoverCommand (Ptr<Packet> p)
   NS_LOG_INFO (" decoding msgId = " << msgId);
   std::map<uint32_t, LteRrcSap::RrcConnectionReconfiguration>::iterator it = g_handoverCommandMsgMap.find (msgId);
   NS_ASSERT_MSG (it != g_handoverCommandMsgMap.end (), "msgId " << msgId << " not found");
-  LteRrcSap::RrcConnectionReconfiguration msg = it->second;
+  LteRrcSap::RrcConnectionReconfiguration msg;
+  std::swap (msg, it->second);
   g_handoverCommandMsgMap.erase (it);
   return msg;
 }
@@ -36,10 +36,13 @@
 
 #include <stdint.h>
 #include <map>
+#include <list>
 
 #include <ns3/ptr.h>
 #include <ns3/object.h>
+#include <ns3/traced-value.h>
 #include <ns3/lte-rrc-sap.h>
+#include <ns3/lte-rrc-protocol-ideal.h>
 
 namespace ns3 {
 
@@ -73,6 +76,9 @@ public:
 
   void SetUeRrc (Ptr<LteUeRrc> rrc);
 
+  uint64_t GetNumMessages (void) const;
+  uint64_t GetNumEvents (void) const;
+
 
 private:
   // methods forwarded from LteUeRrcSapUser
@@ -87,12 +93,21 @@ private:
 
   void SetEnbRrcSapProvider ();
 
+  template <class T>
+  void SendToEnb (void (LteEnbRrcSapProvider::*recv) (uint16_t, T), T &msg);
+
   Ptr<LteUeRrc> m_rrc;
   uint16_t m_rnti;
   LteUeRrcSapProvider* m_ueRrcSapProvider;
   LteUeRrcSapUser* m_ueRrcSapUser;
   LteEnbRrcSapProvider* m_enbRrcSapProvider;
 
+  bool m_coalesceMeasurementReports;
+  IdealRrcUeToEnbSender m_sender;
+
+  TracedValue<uint64_t> m_numMessages;
+  TracedValue<uint64_t> m_numEvents;
+
 };
 
 
@@ -122,6 +137,9 @@ public:
   LteUeRrcSapProvider* GetUeRrcSapProvider (uint16_t rnti);
   void SetUeRrcSapProvider (uint16_t rnti, LteUeRrcSapProvider* p);
 
+  uint64_t GetNumMessages (void) const;
+  uint64_t GetNumEvents (void) const;
+
 private:
   // methods forwarded from LteEnbRrcSapUser
   void DoSetupUe (uint16_t rnti, LteEnbRrcSapUser::SetupUeParameters params);
@@ -141,6 +159,10 @@ private:
   Ptr<Packet> DoEncodeHandoverCommand (LteRrcSap::RrcConnectionReconfiguration msg);
   LteRrcSap::RrcConnectionReconfiguration DoDecodeHandoverCommand (Ptr<Packet> p);
 
+  template <class T>
+  void SendToUe (void (LteUeRrcSapProvider::*recv) (T), LteUeRrcSapProvider* provider,
+                 Ptr<IdealRrcMessage<T> > msg);
+
 
   uint16_t m_rnti;
   uint16_t m_cellId;
@@ -148,6 +170,9 @@ private:
   LteEnbRrcSapUser* m_enbRrcSapUser;
   std::map<uint16_t, LteUeRrcSapProvider*> m_enbRrcSapProviderMap;
 
+  TracedValue<uint64_t> m_numMessages;
+  TracedValue<uint64_t> m_numEvents;
+
 };
 
 
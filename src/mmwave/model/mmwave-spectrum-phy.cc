@@ -258,7 +258,7 @@ MmWaveSpectrumPhy::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noiseP
 }
 
 void
-MmWaveSpectrumPhy::SetTxPowerSpectralDensity (Ptr<SpectrumValue> TxPsd)
+MmWaveSpectrumPhy::SetTxPowerSpectralDensity (Ptr<const SpectrumValue> TxPsd)
 {
   m_txPsd = TxPsd;
 }
@@ -567,26 +567,27 @@ MmWaveSpectrumPhy::EndRxData ()
     {
       if ((m_dataErrorModelEnabled) && (m_rxPacketBurstList.size () > 0))
         {
-          MmWaveHarqProcessInfoList_t harqInfoList;
+          static const MmWaveHarqProcessInfoList_t noHarqInfo;
+          const MmWaveHarqProcessInfoList_t *harqInfoList = &noHarqInfo;
           uint8_t rv = 0;
           if (itTb->second.ndi == 0)
             {
               // TB retxed: retrieve HARQ history
               if (itTb->second.downlink)
                 {
-                  harqInfoList = m_harqPhyModule->GetHarqProcessInfoDl (itTb->first, itTb->second.harqProcessId);
+                  harqInfoList = &m_harqPhyModule->GetHarqProcessInfoDl (itTb->first, itTb->second.harqProcessId);
                 }
               else
                 {
-                  harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl (itTb->first, itTb->second.harqProcessId);
+                  harqInfoList = &m_harqPhyModule->GetHarqProcessInfoUl (itTb->first, itTb->second.harqProcessId);
                 }
-              if (harqInfoList.size () > 0)
+              if (harqInfoList->size () > 0)
                 {
-                  rv = harqInfoList.back ().m_rv;
+                  rv = harqInfoList->back ().m_rv;
                 }
             }
 
-          MmWaveTbStats_t tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, itTb->second.rbBitmap, itTb->second.size, itTb->second.mcs, harqInfoList);
+          MmWaveTbStats_t tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, itTb->second.rbBitmap, itTb->second.size, itTb->second.mcs, *harqInfoList);
           itTb->second.tbler = tbStats.tbler;
           itTb->second.mi = tbStats.miTotal;
           itTb->second.corrupt = m_random->GetValue () > tbStats.tbler ? false : true;
@@ -801,7 +802,8 @@ MmWaveSpectrumPhy::StartTxDataFrames (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveC
           Ptr<MmwaveSpectrumSignalParametersDataFrame> txParams = Create<MmwaveSpectrumSignalParametersDataFrame> ();
           txParams->duration = duration;
           txParams->txPhy = this->GetObject<SpectrumPhy> ();
-          txParams->psd = m_txPsd;
+          // the tx PSD is shared and never written: the channel only reads it and copies it for each receiver
+          txParams->psd = ConstCast<SpectrumValue> (m_txPsd);
           txParams->packetBurst = pb;
           txParams->cellId = m_cellId;
           txParams->ctrlMsgList = ctrlMsgList;
@@ -848,7 +850,8 @@ MmWaveSpectrumPhy::StartTxDlControlFrames (std::list<Ptr<MmWaveControlMessage> >
           Ptr<MmWaveSpectrumSignalParametersDlCtrlFrame> txParams = Create<MmWaveSpectrumSignalParametersDlCtrlFrame> ();
           txParams->duration = duration;
           txParams->txPhy = GetObject<SpectrumPhy> ();
-          txParams->psd = m_txPsd;
+          // the tx PSD is shared and never written: the channel only reads it and copies it for each receiver
+          txParams->psd = ConstCast<SpectrumValue> (m_txPsd);
           txParams->cellId = m_cellId;
           txParams->pss = true;
           txParams->ctrlMsgList = ctrlMsgList;
@@ -152,7 +152,7 @@ public:
   void ConfigureBeamforming (Ptr<NetDevice> device);
 
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
-  void SetTxPowerSpectralDensity (Ptr<SpectrumValue> TxPsd);
+  void SetTxPowerSpectralDensity (Ptr<const SpectrumValue> TxPsd);
   void StartRx (Ptr<SpectrumSignalParameters> params) override;
   void StartRxData (Ptr<MmwaveSpectrumSignalParametersDataFrame> params);
   void StartRxCtrl (Ptr<MmWaveSpectrumSignalParametersDlCtrlFrame> params);
@@ -217,7 +217,7 @@ private:
   Ptr<NetDevice> m_device;
   Ptr<SpectrumChannel> m_channel;
   Ptr<const SpectrumModel> m_rxSpectrumModel;
-  Ptr<SpectrumValue> m_txPsd;
+  Ptr<const SpectrumValue> m_txPsd;
   //Ptr<PacketBurst> m_txPacketBurst;
   std::list<Ptr<PacketBurst> > m_rxPacketBurstList;
   std::list<Ptr<MmWaveControlMessage> > m_rxControlMessageList;
@@ -36,6 +36,7 @@
 #include <ns3/fatal-error.h>
 #include <ns3/string.h>
 #include <ns3/abort.h>
+#include <ns3/hash.h>
 
 #include "mmwave-spectrum-value-helper.h"
 
@@ -51,6 +52,11 @@ NS_LOG_COMPONENT_DEFINE ("MmWaveSpectrumValueHelper");
 namespace mmwave {
 
 std::map<uint8_t,Ptr<SpectrumModel> > MmWaveSpectrumValueHelper::m_model;
+std::map<MmWaveSpectrumValueHelper::TxPsdKey, MmWaveSpectrumValueHelper::TxPsdEntry> MmWaveSpectrumValueHelper::m_txPsdCache;
+std::map<MmWaveSpectrumValueHelper::NoisePsdKey, Ptr<const SpectrumValue> > MmWaveSpectrumValueHelper::m_noisePsdCache;
+
+/// Maximum number of PSDs in each cache, which is flushed when full
+static const size_t MAX_CACHED_PSDS = 1024;
 
 Ptr<SpectrumModel>
 MmWaveSpectrumValueHelper::GetSpectrumModel (Ptr<MmWavePhyMacCommon> ptrConfig)
@@ -91,9 +97,28 @@ MmWaveSpectrumValueHelper::GetSpectrumModel (Ptr<MmWavePhyMacCommon> ptrConfig)
 }
 
 Ptr<SpectrumValue>
-MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig, double powerTx, std::vector <int> activeRbs)
+MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig, double powerTx, const std::vector <int> &activeRbs)
+{
+  return GetTxPowerSpectralDensity (ptrConfig, powerTx, activeRbs)->Copy ();
+}
+
+Ptr<const SpectrumValue>
+MmWaveSpectrumValueHelper::GetTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig, double powerTx, const std::vector <int> &activeRbs)
 {
   Ptr<SpectrumModel> model = GetSpectrumModel (ptrConfig);
+  uint64_t rbsHash = Hash64 (reinterpret_cast<const char *> (activeRbs.data ()), activeRbs.size () * sizeof (int));
+  TxPsdKey key (model->GetUid (), ptrConfig->GetBandwidth (), powerTx, rbsHash);
+  std::map<TxPsdKey, TxPsdEntry>::iterator cached = m_txPsdCache.find (key);
+  if (cached != m_txPsdCache.end () && cached->second.activeRbs == activeRbs)
+    {
+      NS_ASSERT_MSG (Sum (*cached->second.psd) == cached->second.sum, "The shared tx PSD has been modified");
+      return cached->second.psd;
+    }
+  if (m_txPsdCache.size () >= MAX_CACHED_PSDS)
+    {
+      m_txPsdCache.clear ();
+    }
+
   Ptr<SpectrumValue> txPsd = Create <SpectrumValue> (model);
 
   double powerTxW = std::pow (10., (powerTx - 30) / 10);
@@ -101,15 +126,18 @@ MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon>
   double txPowerDensity = 0;
   txPowerDensity = (powerTxW / (ptrConfig->GetBandwidth ()));
 
-  for (std::vector <int>::iterator it = activeRbs.begin (); it != activeRbs.end (); it++)
+  for (std::vector <int>::const_iterator it = activeRbs.begin (); it != activeRbs.end (); it++)
     {
       int rbId = (*it);
       (*txPsd)[rbId] = txPowerDensity;
     }
 
-
+  // a colliding entry, if any, is replaced
+  TxPsdEntry &entry = m_txPsdCache[key];
+  entry.activeRbs = activeRbs;
+  entry.psd = txPsd;
+  entry.sum = Sum (*txPsd);
   return txPsd;
-
 }
 
 Ptr<SpectrumValue>
@@ -123,9 +151,26 @@ MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon>
 
 Ptr<SpectrumValue>
 MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig, double noiseFigure)
+{
+  return GetNoisePowerSpectralDensity (ptrConfig, noiseFigure)->Copy ();
+}
+
+Ptr<const SpectrumValue>
+MmWaveSpectrumValueHelper::GetNoisePowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig, double noiseFigure)
 {
   Ptr<SpectrumModel> model = GetSpectrumModel (ptrConfig);
-  Ptr<SpectrumValue> noisePsd = CreateNoisePowerSpectralDensity (noiseFigure, model);
+  NoisePsdKey key (model->GetUid (), noiseFigure);
+  std::map<NoisePsdKey, Ptr<const SpectrumValue> >::iterator cached = m_noisePsdCache.find (key);
+  if (cached != m_noisePsdCache.end ())
+    {
+      return cached->second;
+    }
+  if (m_noisePsdCache.size () >= MAX_CACHED_PSDS)
+    {
+      m_noisePsdCache.clear ();
+    }
+  Ptr<const SpectrumValue> noisePsd = CreateNoisePowerSpectralDensity (noiseFigure, model);
+  m_noisePsdCache.insert (std::make_pair (key, noisePsd));
   return noisePsd;
 }
 
@@ -36,6 +36,8 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/mmwave-phy-mac-common.h>
 #include <vector>
+#include <map>
+#include <tuple>
 
 
 namespace ns3 {
@@ -55,7 +57,7 @@ public:
 
   static Ptr<SpectrumValue> CreateTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig,
                                                           double powerTx,
-                                                          std::vector <int> activeRbs);
+                                                          const std::vector <int> &activeRbs);
 
 
   static Ptr<SpectrumValue> CreateTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig,
@@ -68,9 +70,57 @@ public:
 
   static Ptr<SpectrumValue> CreateNoisePowerSpectralDensity (double noiseFigure, Ptr<SpectrumModel> spectrumModel);
 
+  /**
+   * \brief Get the tx PSD with the power spread over the active RBs
+   *
+   * The PSDs are computed once for each combination of spectrum model,
+   * bandwidth, power and active RBs, and shared among all the callers, which
+   * must not modify them.  CreateTxPowerSpectralDensity returns a copy.
+   * The spectrum phys cast the shared PSD to a mutable one only to put it
+   * in the SpectrumSignalParameters of a transmission, which the channel
+   * reads and copies for each receiver.  Debug builds assert on each cache
+   * hit that the PSD has not been written.
+   * The cache is looked up with a hash of the active RBs, so a lookup
+   * neither copies nor allocates.
+   *
+   * \param ptrConfig the PHY/MAC configuration
+   * \param powerTx the tx power in dBm
+   * \param activeRbs the active RBs
+   * \return the shared tx PSD
+   */
+  static Ptr<const SpectrumValue> GetTxPowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig,
+                                                             double powerTx,
+                                                             const std::vector <int> &activeRbs);
+
+  /**
+   * \brief Get the noise PSD
+   *
+   * As for GetTxPowerSpectralDensity, the PSDs are computed once for each
+   * spectrum model and noise figure and shared among all the callers.
+   *
+   * \param ptrConfig the PHY/MAC configuration
+   * \param noiseFigure the noise figure in dB
+   * \return the shared noise PSD
+   */
+  static Ptr<const SpectrumValue> GetNoisePowerSpectralDensity (Ptr<MmWavePhyMacCommon> ptrConfig, double noiseFigure);
+
 private:
+  /// key of the tx PSD cache: spectrum model, bandwidth, power and hash of the active RBs
+  typedef std::tuple<SpectrumModelUid_t, double, double, uint64_t> TxPsdKey;
+  /// a cached tx PSD
+  struct TxPsdEntry
+  {
+    std::vector<int> activeRbs; //!< the active RBs, which tell colliding hashes apart
+    Ptr<const SpectrumValue> psd; //!< the tx PSD
+    double sum; //!< the sum of the PSD values, to assert that the shared PSD is never written
+  };
+  /// key of the noise PSD cache: spectrum model and noise figure
+  typedef std::pair<SpectrumModelUid_t, double> NoisePsdKey;
+
   //static Ptr<SpectrumModel> m_model;
   static std::map<uint8_t, Ptr<SpectrumModel> > m_model;
+  static std::map<TxPsdKey, TxPsdEntry> m_txPsdCache; //!< the tx PSDs computed so far
+  static std::map<NoisePsdKey, Ptr<const SpectrumValue> > m_noisePsdCache; //!< the noise PSDs computed so far
 };
 
 } // namespace mmwave
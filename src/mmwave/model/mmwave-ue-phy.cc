@@ -221,11 +221,11 @@ MmWaveUePhy::GetNoiseFigure () const
   return m_noiseFigure;
 }
 
-Ptr<SpectrumValue>
+Ptr<const SpectrumValue>
 MmWaveUePhy::CreateTxPowerSpectralDensity ()
 {
-  Ptr<SpectrumValue> psd =
-    MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, m_txPower, m_subChannelsForTx );
+  Ptr<const SpectrumValue> psd =
+    MmWaveSpectrumValueHelper::GetTxPowerSpectralDensity (m_phyMacConfig, m_txPower, m_subChannelsForTx );
   return psd;
 }
 
@@ -283,10 +283,10 @@ MmWaveUePhy::GetSubChannelsForReception (void)
 }
 
 void
-MmWaveUePhy::SetSubChannelsForTransmission (std::vector <int> mask)
+MmWaveUePhy::SetSubChannelsForTransmission (const std::vector <int> &mask)
 {
   m_subChannelsForTx = mask;
-  Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensity ();
+  Ptr<const SpectrumValue> txPsd = CreateTxPowerSpectralDensity ();
   NS_ASSERT (txPsd);
   m_downlinkSpectrumPhy->SetTxPowerSpectralDensity (txPsd);
 }
@@ -339,8 +339,8 @@ MmWaveUePhy::RegisterToEnb (uint16_t cellId, Ptr<MmWavePhyMacCommon> config)
   }
 
   m_downlinkSpectrumPhy->ResetSpectrumModel ();
-  Ptr<SpectrumValue> noisePsd =
-    MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+  Ptr<const SpectrumValue> noisePsd =
+    MmWaveSpectrumValueHelper::GetNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
   m_downlinkSpectrumPhy->SetNoisePowerSpectralDensity (noisePsd);
   m_downlinkSpectrumPhy->GetSpectrumChannel ()->AddRx (m_downlinkSpectrumPhy);
   m_downlinkSpectrumPhy->SetCellId (m_cellId);
@@ -82,14 +82,14 @@ public:
 
   bool SendPacket (Ptr<Packet> packet);
 
-  Ptr<SpectrumValue> CreateTxPowerSpectralDensity () override;
+  Ptr<const SpectrumValue> CreateTxPowerSpectralDensity () override;
 
   void DoSetSubChannels ();
 
   void SetSubChannelsForReception (std::vector <int> mask);
   std::vector <int> GetSubChannelsForReception (void);
 
-  void SetSubChannelsForTransmission (std::vector <int> mask);
+  void SetSubChannelsForTransmission (const std::vector <int> &mask);
   std::vector <int> GetSubChannelsForTransmission (void);
 
   void DoSendControlMessage (Ptr<MmWaveControlMessage> msg);
@@ -318,6 +318,144 @@ MmWaveSvdBeamformingTestCase::DoRun (void)
     }
 }
 
+/**
+* This test case checks if the MmWaveCodebookBeamforming selects the best
+* pair of codewords
+*/
+class MmWaveCodebookBeamformingTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveCodebookBeamformingTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveCodebookBeamformingTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveCodebookBeamformingTestCase::MmWaveCodebookBeamformingTestCase ()
+  : TestCase ("Checks if the MmWaveCodebookBeamforming class works as expected")
+{
+}
+
+MmWaveCodebookBeamformingTestCase::~MmWaveCodebookBeamformingTestCase ()
+{
+}
+
+void
+MmWaveCodebookBeamformingTestCase::DoRun (void)
+{
+  // Create the tx and rx nodes, devices and antennas
+  Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel> ();
+  txMob->SetPosition (Vector (0, 0, 0));
+  Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel> ();
+  rxMob->SetPosition (Vector (1, 0, 0));
+
+  Ptr<Node> txNode = CreateObject<Node> ();
+  txNode->AggregateObject (txMob);
+  Ptr<NetDevice> txDevice = CreateObject<SimpleNetDevice> ();
+  txDevice->SetNode (txNode);
+  txNode->AddDevice (txDevice);
+  Ptr<ThreeGppAntennaArrayModel> txAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumRows", UintegerValue (4),
+                                                                                                    "NumColumns", UintegerValue (8),
+                                                                                                    "IsotropicElements", BooleanValue (true));
+
+  Ptr<Node> rxNode = CreateObject<Node> ();
+  rxNode->AggregateObject (rxMob);
+  Ptr<NetDevice> rxDevice = CreateObject<SimpleNetDevice> ();
+  rxDevice->SetNode (rxNode);
+  rxNode->AddDevice (rxDevice);
+  Ptr<ThreeGppAntennaArrayModel> rxAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumRows", UintegerValue (2),
+                                                                                                    "NumColumns", UintegerValue (2),
+                                                                                                    "IsotropicElements", BooleanValue (true));
+
+  // Create a channel model with two clusters
+  Ptr<SimpleMatrixBasedChannelModel> channelModel = CreateObject<SimpleMatrixBasedChannelModel> ();
+  channelModel->SetAodAzimuth ({10, -40});
+  channelModel->SetAodElevation ({80, 100});
+  channelModel->SetAoaAzimuth ({170, 120});
+  channelModel->SetAoaElevation ({95, 70});
+  channelModel->SetPhaseShift ({0, 1});
+  channelModel->SetPathLoss ({0, -3});
+  channelModel->SetDelay ({0, 1e-8});
+
+  Ptr<MmWaveCodebookBeamforming> bfModule = CreateObjectWithAttributes<MmWaveCodebookBeamforming> ("Device", PointerValue (txDevice),
+                                                                                                   "Antenna", PointerValue (txAntenna),
+                                                                                                   "ChannelModel", PointerValue (channelModel),
+                                                                                                   "HorizontalOversampling", UintegerValue (2),
+                                                                                                   "VerticalOversampling", UintegerValue (2));
+  bfModule->SetBeamformingVectorForDevice (rxDevice, rxAntenna);
+  ThreeGppAntennaArrayModel::ComplexVector txBfVector = txAntenna->GetBeamformingVector ();
+  ThreeGppAntennaArrayModel::ComplexVector rxBfVector = rxAntenna->GetBeamformingVector ();
+
+  // Check the size and the normalization of the codebooks
+  const ThreeGppAntennaArrayModel::ComplexVector &txCodebook = bfModule->GetCodebook (txAntenna);
+  const ThreeGppAntennaArrayModel::ComplexVector &rxCodebook = bfModule->GetCodebook (rxAntenna);
+  uint32_t txElements = txAntenna->GetNumberOfElements ();
+  uint32_t rxElements = rxAntenna->GetNumberOfElements ();
+  uint32_t txCodewords = txCodebook.size () / txElements;
+  uint32_t rxCodewords = rxCodebook.size () / rxElements;
+  NS_TEST_ASSERT_MSG_EQ (txCodewords, 4 * 8 * 4, "Unexpected number of codewords");
+  NS_TEST_ASSERT_MSG_EQ (rxCodewords, 2 * 2 * 4, "Unexpected number of codewords");
+
+  // Find the best pair by brute force, computing the gain as in
+  // ThreeGppSpectrumPropagationLossModel::CalcLongTerm
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
+  double bestGain = 0;
+  uint32_t bestTx = 0;
+  uint32_t bestRx = 0;
+  for (uint32_t i = 0; i < txCodewords; i++)
+    {
+      for (uint32_t j = 0; j < rxCodewords; j++)
+        {
+          double gain = 0;
+          for (uint32_t c = 0; c < channel->m_channel[0][0].size (); c++)
+            {
+              std::complex<double> txSum (0, 0);
+              for (uint32_t s = 0; s < txElements; s++)
+                {
+                  std::complex<double> rxSum (0, 0);
+                  for (uint32_t u = 0; u < rxElements; u++)
+                    {
+                      rxSum += rxCodebook[u * rxCodewords + j] * channel->m_channel[u][s][c];
+                    }
+                  txSum += txCodebook[s * txCodewords + i] * rxSum;
+                }
+              gain += std::norm (txSum);
+            }
+          if (gain > bestGain)
+            {
+              bestGain = gain;
+              bestTx = i;
+              bestRx = j;
+            }
+        }
+    }
+
+  double tol = 1e-10;
+  for (uint32_t s = 0; s < txElements; s++)
+    {
+      NS_TEST_ASSERT_MSG_LT (std::abs (txBfVector[s] - txCodebook[s * txCodewords + bestTx]), tol,
+                             "TX beamforming vector is not the best codeword");
+      NS_TEST_ASSERT_MSG_EQ_TOL (std::abs (txBfVector[s]), 1 / std::sqrt (txElements), tol,
+                                 "Codewords should have unit norm");
+    }
+  for (uint32_t u = 0; u < rxElements; u++)
+    {
+      NS_TEST_ASSERT_MSG_LT (std::abs (rxBfVector[u] - rxCodebook[u * rxCodewords + bestRx]), tol,
+                             "RX beamforming vector is not the best codeword");
+    }
+}
+
 /**
 * This suite tests if the beamforming module works properly
 */
@@ -333,6 +471,7 @@ MmWaveBeamformingTest::MmWaveBeamformingTest ()
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new MmWaveDftBeamformingTestCase, TestCase::QUICK);
   AddTestCase (new MmWaveSvdBeamformingTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveCodebookBeamformingTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,398 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-mi-error-model.h"
+#include "ns3/mmwave-harq-phy.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/spectrum-model.h"
+#include <cmath>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveMiErrorModelTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks that the MI computed for all the modulations at once
+* by MmWaveMiErrorModel::GetMibs gives exactly the same TB statistics as the
+* evaluation of each MCS on the SINR
+*/
+class MmWaveMibsTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveMibsTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveMibsTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveMibsTestCase::MmWaveMibsTestCase ()
+  : TestCase ("Checks that MmWaveMiErrorModel::GetMibs matches the per-MCS evaluation")
+{
+}
+
+MmWaveMibsTestCase::~MmWaveMibsTestCase ()
+{
+}
+
+void
+MmWaveMibsTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  uint32_t numRbs = 72;
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < numRbs; i++)
+    {
+      freqs.push_back (28e9 + i * 14e6);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+
+  Ptr<UniformRandomVariable> sinrDb = CreateObject<UniformRandomVariable> ();
+  sinrDb->SetAttribute ("Min", DoubleValue (-15.0));
+  sinrDb->SetAttribute ("Max", DoubleValue (35.0));
+
+  MmWaveHarqProcessInfoList_t harqInfoList;
+  for (uint32_t run = 0; run < 20; run++)
+    {
+      SpectrumValue sinr (sm);
+      for (uint32_t i = 0; i < numRbs; i++)
+        {
+          sinr[i] = std::pow (10.0, sinrDb->GetValue () / 10.0);
+        }
+      std::vector<int> map;
+      for (uint32_t i = run % 3; i < numRbs; i += 1 + run % 4)
+        {
+          map.push_back (i);
+        }
+
+      MmWaveMibs_t mibs = MmWaveMiErrorModel::GetMibs (sinr, map);
+      for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+          uint32_t size = 100 + 997 * run;
+          MmWaveTbStats_t expected = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, map, size, mcs, harqInfoList);
+          MmWaveTbStats_t actual = MmWaveMiErrorModel::GetTbDecodificationStats (mibs, size, mcs, harqInfoList);
+          NS_TEST_ASSERT_MSG_EQ (MmWaveMiErrorModel::GetMibForMcs (mibs, mcs), MmWaveMiErrorModel::Mib (sinr, map, mcs),
+                                 "Different MI for MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (actual.tbler, expected.tbler, "Different TBLER for MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (actual.mi, expected.mi, "Different MI for MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (actual.miTotal, expected.miTotal, "Different total MI for MCS " << (uint16_t) mcs);
+        }
+    }
+}
+
+/**
+* This test case checks the HARQ history kept by MmWaveHarqPhy and the
+* effective MI that MmWaveMiErrorModel computes for a retransmission
+*/
+class MmWaveHarqHistoryTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveHarqHistoryTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveHarqHistoryTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveHarqHistoryTestCase::MmWaveHarqHistoryTestCase ()
+  : TestCase ("Checks the HARQ history and the effective MI of the retransmissions")
+{
+}
+
+MmWaveHarqHistoryTestCase::~MmWaveHarqHistoryTestCase ()
+{
+}
+
+void
+MmWaveHarqHistoryTestCase::DoRun (void)
+{
+  uint16_t rnti = 7;
+  uint8_t harqId = 2;
+  double mis[] = {0.31, 0.47, 0.52, 0.9};
+  uint32_t infoBytes = 1500;
+  uint32_t codeBytes[] = {2900, 3100, 2700, 3000};
+
+  Ptr<MmWaveHarqPhy> harq = Create<MmWaveHarqPhy> (8);
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoDl (rnti, harqId).empty (), true, "The history of a new process is not empty");
+
+  for (uint8_t tx = 0; tx < 4; tx++)
+    {
+      harq->UpdateDlHarqProcessStatus (rnti, harqId, mis[tx], infoBytes, codeBytes[tx]);
+      const MmWaveHarqProcessInfoList_t& history = harq->GetHarqProcessInfoDl (rnti, harqId);
+      uint8_t expectedSize = std::min<uint8_t> (tx + 1, MmWaveHarqProcessInfoList_t::MAX_TX);
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) history.size (), (uint16_t) expectedSize, "Wrong HARQ history length");
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) history.back ().m_rv, (uint16_t) (expectedSize - 1), "Wrong redundancy version");
+
+      // the running sums and the effective MI must match the ones computed on the history
+      uint32_t codeBitsSum = 0;
+      double miSum = 0.0;
+      for (uint8_t i = 0; i < history.size (); i++)
+        {
+          codeBitsSum += history.at (i).m_codeBits;
+          miSum += (history.at (i).m_mi * history.at (i).m_codeBits);
+        }
+      NS_TEST_ASSERT_MSG_EQ (history.GetCodeBitsSum (), codeBitsSum, "Wrong sum of the code bits");
+      NS_TEST_ASSERT_MSG_EQ (history.GetMiSum (), miSum, "Wrong sum of the MI");
+
+      uint32_t size = infoBytes;
+      uint8_t mcs = 10;
+      double tbMi = 0.4;
+      MmWaveMibs_t mibs;
+      mibs.qpsk = tbMi;
+      mibs.qam16 = tbMi;
+      mibs.qam64 = tbMi;
+      MmWaveTbStats_t stats = MmWaveMiErrorModel::GetTbDecodificationStats (mibs, size, mcs, history);
+      double newCodeBits = size * 8.0 / McsEcrTable[mcs];
+      codeBitsSum += newCodeBits;
+      miSum += tbMi * newCodeBits;
+      NS_TEST_ASSERT_MSG_EQ (stats.miTotal, miSum / codeBitsSum, "Wrong effective MI");
+    }
+
+  harq->ResetDlHarqProcessStatus (rnti, harqId);
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoDl (rnti, harqId).empty (), true, "The history was not reset");
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoDl (rnti, harqId).GetCodeBitsSum (), 0u, "The sums were not reset");
+}
+
+/// Number of RBs of the SINR profiles of the golden test
+static const uint32_t GOLDEN_NUM_RBS = 50;
+/// MCSs evaluated by the golden test
+static const uint8_t GOLDEN_MCS[] = {0, 3, 6, 9, 10, 13, 16, 17, 20, 24, 28};
+/// Number of MCSs evaluated by the golden test
+static const uint32_t GOLDEN_NUM_MCS = sizeof (GOLDEN_MCS) / sizeof (GOLDEN_MCS[0]);
+
+/**
+* \brief Set one of the SINR profiles of the golden test
+* \param k the index of the profile, from 0 to 3
+* \param sinr the SINR of the GOLDEN_NUM_RBS RBs
+* \param map the RBs of the TB
+*/
+static void
+SetGoldenProfile (uint32_t k, SpectrumValue& sinr, std::vector<int>& map)
+{
+  for (uint32_t i = 0; i < GOLDEN_NUM_RBS; i++)
+    {
+      sinr[i] = std::pow (10.0, (-9.0 + ((i * 7 + 3 * k) % 23) * 0.9 + k * 2.5) / 10.0);
+    }
+  map.clear ();
+  for (uint32_t i = 0; i < GOLDEN_NUM_RBS; i++)
+    {
+      if (k == 0 || (k == 1 && i < 6) || (k == 2 && i % 2 == 0) || (k == 3 && i >= 10 && i < 30))
+        {
+          map.push_back (i);
+        }
+    }
+}
+
+/// TB statistics for each profile and each MCS of GOLDEN_MCS, with a TB of 20 + 1500 * k + 97 * mcs bytes
+static const double g_goldenTbStats[4 * GOLDEN_NUM_MCS][2] = {
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0 },
+  { 0.5708366399999999, 0.99555468848539785 },
+  { 0.33594066, 0.99999999999991229 },
+  { 0.33594066, 1 },
+  { 0.33594066, 1 },
+  { 0.21390158000000004, 1 },
+  { 0.21390158000000004, 1 },
+  { 0.21390158000000004, 1 },
+  { 0.21390158000000004, 1 },
+
+  { 0.60804916666666664, 0 },
+  { 0.60804916666666664, 0 },
+  { 0.60804916666666664, 0 },
+  { 0.60804916666666664, 0.11676578722137743 },
+  { 0.34399433333333335, 1 },
+  { 0.34399433333333335, 1 },
+  { 0.34399433333333335, 1 },
+  { 0.22409966666666667, 1 },
+  { 0.22409966666666667, 1 },
+  { 0.22409966666666667, 1 },
+  { 0.22409966666666667, 1 },
+
+  { 0.77987731999999999, 0 },
+  { 0.77987731999999999, 0 },
+  { 0.77987731999999999, 0 },
+  { 0.77987731999999999, 0 },
+  { 0.57300140000000011, 0 },
+  { 0.57300140000000011, 0 },
+  { 0.57300140000000011, 1 },
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 1 },
+  { 0.37673751999999999, 1 },
+
+  { 0.86696350000000011, 0 },
+  { 0.86696350000000011, 0 },
+  { 0.86696350000000011, 0 },
+  { 0.86696350000000011, 0 },
+  { 0.67601175000000002, 0 },
+  { 0.67601175000000002, 0 },
+  { 0.67601175000000002, 0.036954932713142097 },
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1 },
+  { 0.46350824999999996, 1 },
+};
+
+/**
+* TB statistics (MI, TBLER and total MI) of three transmissions of a TB, for
+* each profile, with MCS GOLDEN_MCS[3 * k + 1], each transmission being added
+* to the HARQ history with half its MI
+*/
+static const double g_goldenHarqTbStats[4 * 3][3] = {
+  { 0.5708366399999999, 0, 0.5708366399999999 },
+  { 0.5708366399999999, 0, 0.51377683887323933 },
+  { 0.5708366399999999, 0, 0.47572014543934388 },
+
+  { 0.34399433333333335, 1, 0.34399433333333335 },
+  { 0.34399433333333335, 2.7031364475460506e-05, 0.28666194444444448 },
+  { 0.34399433333333335, 0.82093705879177092, 0.25799575000000002 },
+
+  { 0.37673751999999999, 1, 0.37673751999999999 },
+  { 0.37673751999999999, 0.18368825497678376, 0.29809861249324948 },
+  { 0.37673751999999999, 0, 0.26578096954666613 },
+
+  { 0.46350824999999996, 1, 0.46350824999999996 },
+  { 0.46350824999999996, 5.3889188034172975e-07, 0.32323751526843836 },
+  { 0.46350824999999996, 0.95299839978292811, 0.2887436783165 },
+};
+
+/**
+* This test case checks that MmWaveMiErrorModel gives exactly the values
+* that it gave with its own copy of the MI tables, before the tables and the
+* computations were shared with the LTE error model in LteMiKernel
+*/
+class MmWaveMiGoldenTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveMiGoldenTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveMiGoldenTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveMiGoldenTestCase::MmWaveMiGoldenTestCase ()
+  : TestCase ("Checks the MI error model against golden values")
+{
+}
+
+MmWaveMiGoldenTestCase::~MmWaveMiGoldenTestCase ()
+{
+}
+
+void
+MmWaveMiGoldenTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < GOLDEN_NUM_RBS; i++)
+    {
+      freqs.push_back (28e9 + i * 14e6);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+
+  for (uint32_t k = 0; k < 4; k++)
+    {
+      SpectrumValue sinr (sm);
+      std::vector<int> map;
+      SetGoldenProfile (k, sinr, map);
+
+      MmWaveHarqProcessInfoList_t harqInfoList;
+      for (uint32_t j = 0; j < GOLDEN_NUM_MCS; j++)
+        {
+          uint8_t mcs = GOLDEN_MCS[j];
+          MmWaveTbStats_t stats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, map, 20 + 1500 * k + 97 * mcs, mcs, harqInfoList);
+          const double *expected = g_goldenTbStats[k * GOLDEN_NUM_MCS + j];
+          NS_TEST_ASSERT_MSG_EQ (stats.mi, expected[0], "Wrong MI, profile " << k << " MCS " << (uint16_t) mcs);
+          NS_TEST_ASSERT_MSG_EQ (stats.tbler, expected[1], "Wrong TBLER, profile " << k << " MCS " << (uint16_t) mcs);
+        }
+
+      uint8_t mcs = GOLDEN_MCS[3 * k + 1];
+      uint32_t size = 20 + 1500 * k + 97 * mcs;
+      for (uint32_t tx = 0; tx < 3; tx++)
+        {
+          MmWaveTbStats_t stats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, map, size, mcs, harqInfoList);
+          const double *expected = g_goldenHarqTbStats[k * 3 + tx];
+          NS_TEST_ASSERT_MSG_EQ (stats.mi, expected[0], "Wrong MI, profile " << k << " transmission " << tx);
+          NS_TEST_ASSERT_MSG_EQ (stats.tbler, expected[1], "Wrong TBLER, profile " << k << " transmission " << tx);
+          NS_TEST_ASSERT_MSG_EQ (stats.miTotal, expected[2], "Wrong total MI, profile " << k << " transmission " << tx);
+          MmWaveHarqProcessInfoElement_t el;
+          el.m_mi = stats.mi * 0.5;
+          el.m_rv = tx;
+          el.m_infoBits = size * 8;
+          el.m_codeBits = size * 8 / 0.6;
+          harqInfoList.push_back (el);
+        }
+    }
+}
+
+/**
+* This suite tests the MmWaveMiErrorModel
+*/
+class MmWaveMiErrorModelTest : public TestSuite
+{
+public:
+  MmWaveMiErrorModelTest ();
+};
+
+MmWaveMiErrorModelTest::MmWaveMiErrorModelTest ()
+  : TestSuite ("mmwave-mi-error-model-test", UNIT)
+{
+  AddTestCase (new MmWaveMibsTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveHarqHistoryTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveMiGoldenTestCase, TestCase::QUICK);
+}
+
+static MmWaveMiErrorModelTest mmwaveMiErrorModelTestSuite;
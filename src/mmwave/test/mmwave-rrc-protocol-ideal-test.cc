@@ -0,0 +1,192 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-helper.h"
+#include "ns3/mmwave-rrc-protocol-ideal.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveRrcProtocolIdealTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks that the ideal RRC protocol of a mmWave UE only
+* coalesces the measurement reports sent at the same time: mmWave slots are
+* shorter than 1 ms, and each report must still reach the eNB exactly
+* RRC_IDEAL_MSG_DELAY after it was sent.
+*/
+class MmWaveRrcIdealCoalescingTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveRrcIdealCoalescingTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveRrcIdealCoalescingTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Send a measurement report through the ideal RRC protocol of the UE
+  * \param measId the measId of the report
+  */
+  void SendMeasurementReport (uint8_t measId);
+
+  /**
+  * Receive measurement report callback function
+  * \param context the context string
+  * \param imsi the IMSI
+  * \param cellId the cell ID
+  * \param rnti the RNTI
+  * \param report the measurement report
+  */
+  void RecvMeasurementReportCallback (std::string context, uint64_t imsi, uint16_t cellId,
+                                      uint16_t rnti, LteRrcSap::MeasurementReport report);
+
+  Ptr<MmWaveUeRrcProtocolIdeal> m_rrcProtocol; ///< the ideal RRC protocol of the UE
+  std::map<uint8_t, Time> m_sent; ///< the time each report was sent at, by measId
+  std::vector<std::pair<Time, uint8_t> > m_received; ///< time and measId of the reports received by the eNB
+};
+
+MmWaveRrcIdealCoalescingTestCase::MmWaveRrcIdealCoalescingTestCase ()
+  : TestCase ("Checks that the mmWave ideal RRC only coalesces the measurement reports sent at the same time")
+{
+}
+
+MmWaveRrcIdealCoalescingTestCase::~MmWaveRrcIdealCoalescingTestCase ()
+{
+}
+
+void
+MmWaveRrcIdealCoalescingTestCase::SendMeasurementReport (uint8_t measId)
+{
+  LteRrcSap::MeasurementReport report;
+  report.measResults.measId = measId;
+  report.measResults.rsrpResult = 50;
+  report.measResults.rsrqResult = 20;
+  report.measResults.haveMeasResultNeighCells = false;
+  report.measResults.haveScellsMeas = false;
+  m_sent[measId] = Simulator::Now ();
+  m_rrcProtocol->GetLteUeRrcSapUser ()->SendMeasurementReport (report);
+}
+
+void
+MmWaveRrcIdealCoalescingTestCase::RecvMeasurementReportCallback (std::string context, uint64_t imsi, uint16_t cellId,
+                                                                 uint16_t rnti, LteRrcSap::MeasurementReport report)
+{
+  m_received.push_back (std::make_pair (Simulator::Now (), report.measResults.measId));
+}
+
+void
+MmWaveRrcIdealCoalescingTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::MmWaveHelper::UseIdealRrc", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWaveUeRrcProtocolIdeal::CoalesceMeasurementReports", BooleanValue (true));
+
+  Ptr<MmWaveHelper> helper = CreateObject<MmWaveHelper> ();
+
+  NodeContainer bsNodes;
+  bsNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (1);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 25.0));
+  positionAlloc->Add (Vector (0.0, 20.0, 1.6));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (bsNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer bsNetDevs = helper->InstallEnbDevice (bsNodes);
+  NetDeviceContainer ueNetDevs = helper->InstallUeDevice (ueNodes);
+  helper->AttachToClosestEnb (ueNetDevs, bsNetDevs);
+
+  Ptr<MmWaveUeNetDevice> ueDev = DynamicCast<MmWaveUeNetDevice> (ueNetDevs.Get (0));
+  m_rrcProtocol = ueDev->GetRrc ()->GetObject<MmWaveUeRrcProtocolIdeal> ();
+  NS_TEST_ASSERT_MSG_NE (m_rrcProtocol, 0, "the UE does not use the ideal RRC protocol");
+
+  Ptr<MmWaveEnbNetDevice> bsDev = DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (0));
+  bsDev->GetRrc ()->TraceConnect ("RecvMeasurementReport", "",
+                                  MakeCallback (&MmWaveRrcIdealCoalescingTestCase::RecvMeasurementReportCallback, this));
+
+  // reports 1 and 2 are sent at the same time, report 3 one mmWave slot
+  // later in the same millisecond, reports 4 and 5 at the same time one more
+  // slot later
+  Time start = MilliSeconds (300);
+  Time slot = MicroSeconds (125);
+  Simulator::Schedule (start, &MmWaveRrcIdealCoalescingTestCase::SendMeasurementReport, this, 1);
+  Simulator::Schedule (start, &MmWaveRrcIdealCoalescingTestCase::SendMeasurementReport, this, 2);
+  Simulator::Schedule (start + slot, &MmWaveRrcIdealCoalescingTestCase::SendMeasurementReport, this, 3);
+  Simulator::Schedule (start + 2 * slot, &MmWaveRrcIdealCoalescingTestCase::SendMeasurementReport, this, 4);
+  Simulator::Schedule (start + 2 * slot, &MmWaveRrcIdealCoalescingTestCase::SendMeasurementReport, this, 5);
+
+  Simulator::Stop (start - NanoSeconds (1));
+  Simulator::Run ();
+  uint64_t numMessages = m_rrcProtocol->GetNumMessages ();
+  uint64_t numEvents = m_rrcProtocol->GetNumEvents ();
+
+  Simulator::Stop (MilliSeconds (10));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), 5, "wrong number of measurement reports");
+  for (uint32_t i = 0; i < m_received.size (); i++)
+    {
+      uint8_t measId = m_received[i].second;
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) measId, i + 1, "wrong order of the measurement reports");
+      NS_TEST_ASSERT_MSG_EQ (m_received[i].first - m_sent[measId], MicroSeconds (500),
+                             "wrong delivery delay of report " << (uint16_t) measId);
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_rrcProtocol->GetNumMessages () - numMessages, 5, "wrong number of messages");
+  NS_TEST_ASSERT_MSG_EQ (m_rrcProtocol->GetNumEvents () - numEvents, 3, "wrong number of delivery events");
+
+  m_rrcProtocol = 0;
+  Simulator::Destroy ();
+  Config::Reset ();
+}
+
+/**
+* This suite tests the ideal RRC protocol of the mmWave devices
+*/
+class MmWaveRrcProtocolIdealTest : public TestSuite
+{
+public:
+  MmWaveRrcProtocolIdealTest ();
+};
+
+MmWaveRrcProtocolIdealTest::MmWaveRrcProtocolIdealTest ()
+  : TestSuite ("mmwave-rrc-protocol-ideal", UNIT)
+{
+  AddTestCase (new MmWaveRrcIdealCoalescingTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveRrcProtocolIdealTest mmwaveRrcProtocolIdealTestSuite;
@@ -75,7 +75,6 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
 Buffer::FreeList *Buffer::g_freeList = 0;
 struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
@@ -84,34 +83,51 @@ Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
   NS_LOG_FUNCTION (this);
   if (IS_INITIALIZED (g_freeList))
     {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
+      for (uint32_t c = 0; c < BUFFER_FREE_LIST_CLASSES; c++)
         {
-          Buffer::Deallocate (*i);
+          for (Buffer::FreeList::iterator i = g_freeList[c].begin ();
+               i != g_freeList[c].end (); i++)
+            {
+              Buffer::Deallocate (*i);
+            }
         }
-      delete g_freeList;
+      delete [] g_freeList;
       g_freeList = DESTROYED;
     }
 }
 
+uint32_t
+Buffer::GetSizeClass (uint32_t size)
+{
+  uint32_t sizeClass = 0;
+  while (sizeClass < BUFFER_FREE_LIST_CLASSES &&
+         (1U << (BUFFER_FREE_LIST_MIN_SHIFT + sizeClass)) < size)
+    {
+      sizeClass++;
+    }
+  return sizeClass;
+}
+
 void
 Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
   NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
-  g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
+  /* feed into the free list of its size class. Only storages created
+   * with the exact size of a class are pooled. */
+  uint32_t sizeClass = GetSizeClass (data->m_size);
+  if (IS_DESTROYED (g_freeList) ||
+      sizeClass == BUFFER_FREE_LIST_CLASSES ||
+      data->m_size != (1U << (BUFFER_FREE_LIST_MIN_SHIFT + sizeClass)) ||
+      g_freeList[sizeClass].size () >= BUFFER_FREE_LIST_MAX_PER_CLASS)
     {
       Buffer::Deallocate (data);
     }
   else
     {
       NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
+      g_freeList[sizeClass].push_back (data);
     }
 }
 
@@ -119,26 +135,25 @@ Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
-  /* try to find a buffer correctly sized. */
   if (IS_UNINITIALIZED (g_freeList))
     {
-      g_freeList = new Buffer::FreeList ();
+      g_freeList = new Buffer::FreeList [BUFFER_FREE_LIST_CLASSES];
     }
-  else if (IS_INITIALIZED (g_freeList))
+  uint32_t sizeClass = GetSizeClass (dataSize);
+  if (sizeClass == BUFFER_FREE_LIST_CLASSES)
     {
-      while (!g_freeList->empty ()) 
-        {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
-        }
+      /* too large to be pooled */
+      return Buffer::Allocate (dataSize);
+    }
+  /* try to reuse a buffer of the same size class. */
+  if (IS_INITIALIZED (g_freeList) && !g_freeList[sizeClass].empty ())
+    {
+      struct Buffer::Data *data = g_freeList[sizeClass].back ();
+      g_freeList[sizeClass].pop_back ();
+      data->m_count = 1;
+      return data;
     }
-  struct Buffer::Data *data = Buffer::Allocate (dataSize);
+  struct Buffer::Data *data = Buffer::Allocate (1U << (BUFFER_FREE_LIST_MIN_SHIFT + sizeClass));
   NS_ASSERT (data->m_count == 1);
   return data;
 }
@@ -26,6 +26,12 @@
 #include "ns3/assert.h"
 
 #define BUFFER_FREE_LIST 1
+/// log2 of the smallest pooled buffer data size
+#define BUFFER_FREE_LIST_MIN_SHIFT 6
+/// number of power-of-two size classes of pooled buffer data (64 B to 64 KiB)
+#define BUFFER_FREE_LIST_CLASSES 11
+/// maximum number of unused buffer data kept per size class
+#define BUFFER_FREE_LIST_MAX_PER_CLASS 1000
 
 namespace ns3 {
 
@@ -791,6 +797,18 @@ private:
   uint32_t m_end;
 
 #ifdef BUFFER_FREE_LIST
+  /**
+   * \brief Get the free list size class of a buffer data storage
+   *
+   * Size class i holds storages of exactly
+   * 2^(BUFFER_FREE_LIST_MIN_SHIFT + i) bytes.
+   *
+   * \param size the storage size
+   * \returns the smallest size class which can hold size bytes, or
+   *          BUFFER_FREE_LIST_CLASSES if size is too large to be pooled
+   */
+  static uint32_t GetSizeClass (uint32_t size);
+
   /// Container for buffer data
   typedef std::vector<struct Buffer::Data*> FreeList;
   /// Local static destructor structure
@@ -798,8 +816,7 @@ private:
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
+  static FreeList *g_freeList; //!< Buffer data containers, one per size class
   static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
@@ -37,6 +37,7 @@ bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+bool PacketMetadata::m_freeListDestroyed = false;
 
 PacketMetadata::DataFreeList::~DataFreeList ()
 {
@@ -46,6 +47,7 @@ PacketMetadata::DataFreeList::~DataFreeList ()
       PacketMetadata::Deallocate (*i);
     }
   PacketMetadata::m_enable = false;
+  PacketMetadata::m_freeListDestroyed = true;
 }
 
 void 
@@ -596,7 +598,7 @@ void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
+  if (m_freeListDestroyed)
     {
       PacketMetadata::Deallocate (data);
       return;
@@ -662,6 +662,7 @@ public:
   static void Deallocate (struct PacketMetadata::Data *data);
 
   static DataFreeList m_freeList; //!< the metadata data storage
+  static bool m_freeListDestroyed; //!< true once m_freeList has been destroyed
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
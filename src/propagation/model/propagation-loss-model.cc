@@ -28,6 +28,10 @@
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/hash.h"
+#include <algorithm>
 #include <cmath>
 
 namespace ns3 {
@@ -94,6 +98,30 @@ PropagationLossModel::AssignStreams (int64_t stream)
   return (currentStream - stream);
 }
 
+uint64_t
+PropagationLossModel::GetLinkKey (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
+{
+  Ptr<Node> nodeA = a->GetObject<Node> ();
+  Ptr<Node> nodeB = b->GetObject<Node> ();
+  if (nodeA != 0 && nodeB != 0)
+    {
+      uint64_t first = std::min (nodeA->GetId (), nodeB->GetId ());
+      uint64_t second = std::max (nodeA->GetId (), nodeB->GetId ());
+      return (first << 32) | second;
+    }
+
+  // without nodes, hash the positions, ordered so that the key is symmetric
+  Vector posA = a->GetPosition ();
+  Vector posB = b->GetPosition ();
+  double positions[6] = {posA.x, posA.y, posA.z, posB.x, posB.y, posB.z};
+  if (posB.x < posA.x || (posB.x == posA.x && (posB.y < posA.y || (posB.y == posA.y && posB.z < posA.z))))
+    {
+      std::swap_ranges (positions, positions + 3, positions + 3);
+    }
+  // set the highest bit, which is never set in the keys made of the node ids
+  return Hash64 (reinterpret_cast<const char *> (positions), sizeof (positions)) | (1ULL << 63);
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationLossModel);
@@ -687,7 +715,15 @@ NakagamiPropagationLossModel::GetTypeId (void)
                    "Access to the underlying GammaRandomVariable",
                    StringValue ("ns3::GammaRandomVariable"),
                    MakePointerAccessor (&NakagamiPropagationLossModel::m_gammaRandomVariable),
-                   MakePointerChecker<GammaRandomVariable> ());
+                   MakePointerChecker<GammaRandomVariable> ())
+    .AddAttribute ("OrderIndependentDraws",
+                   "If true, the fading of a link at a given time only depends on the link, "
+                   "on the time and on the stream numbers, and not on the order in which "
+                   "the links are evaluated. Evaluating a link twice at the same time, "
+                   "in either direction, gives the same fading.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NakagamiPropagationLossModel::m_orderIndependentDraws),
+                   MakeBooleanChecker ())
   ;
   return tid;
 
@@ -731,6 +767,14 @@ NakagamiPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   // speed. (Gamma is equal to Erlang for any positive integer m.)
   unsigned int int_m = static_cast<unsigned int>(std::floor (m));
 
+  if (m_orderIndependentDraws)
+    {
+      uint64_t counter[2] = {GetLinkKey (a, b), static_cast<uint64_t> (Simulator::Now ().GetTimeStep ())};
+      uint64_t key = Hash64 (reinterpret_cast<const char *> (counter), sizeof (counter));
+      m_erlangRandomVariable->SetCounterKey (key);
+      m_gammaRandomVariable->SetCounterKey (key);
+    }
+
   if (int_m == m)
     {
       resultPowerW = m_erlangRandomVariable->GetValue (int_m, powerW / m);
@@ -106,6 +106,20 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+protected:
+  /**
+   * Compute a key identifying the link between two mobility models,
+   * e.g. to draw its random values with RandomVariableStream::SetCounterKey ().
+   * The key is the same for (a, b) and (b, a).  If both models are
+   * aggregated to a node it is made of the ids of the nodes, otherwise
+   * it is a hash of their positions.
+   *
+   * \param a the mobility model of one end of the link
+   * \param b the mobility model of the other end of the link
+   * \return the key of the link
+   */
+  static uint64_t GetLinkKey (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
+
 private:
   /**
    * \brief Copy constructor
@@ -651,6 +665,12 @@ private:
  *
  * For m = 1 the Nakagami-m distribution equals the Rayleigh distribution. Thus
  * this model also implements Rayleigh distribution based fast fading.
+ *
+ * By default the fading values are drawn in sequence from the random
+ * variables, so they depend on the order in which the links are evaluated.
+ * If the OrderIndependentDraws attribute is true, the values of a link are
+ * drawn with RandomVariableStream::SetCounterKey (), keyed by the link and
+ * the current time, and do not depend on the other links.
  */
 class NakagamiPropagationLossModel : public PropagationLossModel
 {
@@ -694,6 +714,7 @@ private:
 
   Ptr<ErlangRandomVariable>  m_erlangRandomVariable; //!< Erlang random variable
   Ptr<GammaRandomVariable> m_gammaRandomVariable;    //!< Gamma random variable
+  bool m_orderIndependentDraws; //!< Draw the fading of each link and time from its own counter key
 };
 
 /**
@@ -53,6 +53,13 @@ ThreeGppPropagationLossModel::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&ThreeGppPropagationLossModel::m_shadowingEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("OrderIndependentDraws",
+                   "If true, the n-th shadowing realization of a link only depends on the "
+                   "link, on n and on the stream number, and not on the order in which "
+                   "the links are evaluated.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ThreeGppPropagationLossModel::m_orderIndependentDraws),
+                   MakeBooleanChecker ())
     .AddAttribute ("ChannelConditionModel", "Pointer to the channel condition model.",
                    PointerValue (),
                    MakePointerAccessor (&ThreeGppPropagationLossModel::SetChannelConditionModel,
@@ -189,9 +196,16 @@ ThreeGppPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityMo
 
       // add a new entry in the map and update the iterator
       ShadowingMapItem newItem;
+      newItem.m_draws = 0;
       it = m_shadowingMap.insert (it, std::make_pair (key, newItem));
     }
 
+  if (m_orderIndependentDraws)
+    {
+      // draw the realization from the counter of the link
+      m_normRandomVariable->SetCounterKey (GetLinkKey (a, b), it->second.m_draws++);
+    }
+
   if (notFound || newCondition)
     {
       // generate a new independent realization
@@ -213,6 +213,7 @@ protected:
   double m_frequency; //!< operating frequency in Hz
   bool m_shadowingEnabled; //!< enable/disable shadowing
   Ptr<NormalRandomVariable> m_normRandomVariable; //!< normal random variable
+  bool m_orderIndependentDraws; //!< draw the shadowing of each link from its own counter key
 
   /** Define a struct for the m_shadowingMap entries */
   struct ShadowingMapItem
@@ -220,6 +221,7 @@ protected:
     double m_shadowing; //!< the shadowing loss in dB
     ChannelCondition::LosConditionValue m_condition; //!< the LOS/NLOS condition
     Vector m_distance; //!< the vector AB
+    uint32_t m_draws; //!< the number of shadowing realizations drawn for the link
   };
 
   mutable std::unordered_map<uint32_t, ShadowingMapItem> m_shadowingMap; //!< map to store the shadowing values
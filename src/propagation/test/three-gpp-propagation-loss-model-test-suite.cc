@@ -884,6 +884,95 @@ ThreeGppShadowingTestCase::DoRun (void)
     }
 }
 
+/**
+ * Test case for the OrderIndependentDraws attribute of the
+ * ThreeGppPropagationLossModel. It checks that the shadowing of the links
+ * does not change when they are evaluated in a different order.
+ */
+class ThreeGppShadowingOrderTestCase : public TestCase
+{
+public:
+  ThreeGppShadowingOrderTestCase ();
+  virtual ~ThreeGppShadowingOrderTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compute the loss of the links between the first node and the other
+   * nodes, twice, moving the other nodes in between
+   * \param mobility the mobility models of the nodes
+   * \param reverse if true, evaluate the links in the reverse order
+   * \return the losses, in the order of the links
+   */
+  std::vector<double> ComputeLosses (std::vector<Ptr<MobilityModel> > mobility, bool reverse);
+};
+
+ThreeGppShadowingOrderTestCase::ThreeGppShadowingOrderTestCase ()
+  : TestCase ("Test to check if the shadow fading of a link does not depend on the order of the links")
+{
+}
+
+ThreeGppShadowingOrderTestCase::~ThreeGppShadowingOrderTestCase ()
+{
+}
+
+std::vector<double>
+ThreeGppShadowingOrderTestCase::ComputeLosses (std::vector<Ptr<MobilityModel> > mobility, bool reverse)
+{
+  uint32_t numLinks = mobility.size () - 1;
+  for (uint32_t i = 0; i <= numLinks; i++)
+    {
+      mobility[i]->SetPosition (Vector (10.0 * i, 50.0 + 20.0 * i, i == 0 ? 25.0 : 1.6));
+    }
+
+  Ptr<ThreeGppPropagationLossModel> lossModel = CreateObject<ThreeGppUmaPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (3.5e9));
+  lossModel->SetAttribute ("OrderIndependentDraws", BooleanValue (true));
+  lossModel->SetChannelConditionModel (CreateObject<AlwaysLosChannelConditionModel> ());
+  lossModel->AssignStreams (42);
+
+  std::vector<double> losses (2 * numLinks);
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      for (uint32_t j = 0; j < numLinks; j++)
+        {
+          uint32_t link = reverse ? numLinks - 1 - j : j;
+          losses[round * numLinks + link] = lossModel->CalcRxPower (0, mobility[0], mobility[link + 1]);
+        }
+      for (uint32_t i = 1; i <= numLinks; i++)
+        {
+          mobility[i]->SetPosition (mobility[i]->GetPosition () + Vector (30.0, 0.0, 0.0));
+        }
+    }
+  return losses;
+}
+
+void
+ThreeGppShadowingOrderTestCase::DoRun (void)
+{
+  // a BS and three UTs, with one link between the BS and each UT
+  NodeContainer nodes;
+  nodes.Create (4);
+  std::vector<Ptr<MobilityModel> > mobility;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<MobilityModel> m = CreateObject<ConstantPositionMobilityModel> ();
+      nodes.Get (i)->AggregateObject (m);
+      mobility.push_back (m);
+    }
+
+  std::vector<double> forward = ComputeLosses (mobility, false);
+  std::vector<double> reverse = ComputeLosses (mobility, true);
+  for (uint32_t i = 0; i < forward.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (reverse[i], forward[i], 1e-9, "The loss " << i << " depends on the order of the links");
+    }
+  NS_TEST_ASSERT_MSG_NE (forward[0], forward[3], "The shadowing has not been updated");
+
+  Simulator::Destroy ();
+}
+
 class ThreeGppPropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -898,6 +987,7 @@ ThreeGppPropagationLossModelsTestSuite::ThreeGppPropagationLossModelsTestSuite (
   AddTestCase (new ThreeGppUmiPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new ThreeGppIndoorOfficePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new ThreeGppShadowingTestCase, TestCase::QUICK);
+  AddTestCase (new ThreeGppShadowingOrderTestCase, TestCase::QUICK);
 }
 
 static ThreeGppPropagationLossModelsTestSuite propagationLossModelsTestSuite;
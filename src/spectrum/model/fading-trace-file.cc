@@ -0,0 +1,356 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/fading-trace-file.h>
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+#include <ns3/abort.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FadingTraceFile");
+
+namespace {
+
+/// Header of a binary fading trace
+struct BinaryHeader
+{
+  char magic[8];       ///< "NS3FADTR"
+  uint32_t version;    ///< version of the format
+  uint32_t byteOrder;  ///< BYTE_ORDER_MARK in the byte order of the writer
+  uint32_t sampleType; ///< FadingTraceFile::SampleType of the samples
+  uint32_t rbNum;      ///< number of RBs
+  uint32_t samplesNum; ///< number of samples per RB
+  uint32_t padding;    ///< aligns the samples to 8 bytes
+};
+
+/// Magic string of the binary traces
+const char MAGIC[8] = {'N', 'S', '3', 'F', 'A', 'D', 'T', 'R'};
+/// Version of the binary format
+const uint32_t VERSION = 1;
+/// Byte order mark of the binary traces
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * \return the open traces, indexed by file name and dimensions
+ */
+std::map<std::string, FadingTraceFile *> &
+GetRegistry (void)
+{
+  static std::map<std::string, FadingTraceFile *> registry;
+  return registry;
+}
+
+} // unnamed namespace
+
+
+FadingTraceFile::FadingTraceFile (std::string key)
+  : m_key (key),
+    m_type (TEXT),
+    m_rbNum (0),
+    m_samplesNum (0),
+    m_float32 (0),
+    m_float16 (0),
+    m_mapping (0),
+    m_mappingSize (0)
+{
+  NS_LOG_FUNCTION (this << key);
+}
+
+FadingTraceFile::~FadingTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  GetRegistry ().erase (m_key);
+  if (m_mapping != 0)
+    {
+      munmap (m_mapping, m_mappingSize);
+    }
+}
+
+Ptr<const FadingTraceFile>
+FadingTraceFile::Open (std::string fileName, uint32_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (fileName << rbNum << samplesNum);
+  std::ostringstream key;
+  key << fileName << ":" << rbNum << ":" << samplesNum;
+  std::map<std::string, FadingTraceFile *>::iterator it = GetRegistry ().find (key.str ());
+  if (it != GetRegistry ().end ())
+    {
+      NS_LOG_LOGIC ("Fading trace " << fileName << " already open");
+      return Ptr<const FadingTraceFile> (it->second);
+    }
+
+  Ptr<FadingTraceFile> trace = Ptr<FadingTraceFile> (new FadingTraceFile (key.str ()), false);
+  trace->m_rbNum = rbNum;
+  trace->m_samplesNum = samplesNum;
+
+  char magic[sizeof (MAGIC)] = {0};
+  std::ifstream ifTraceFile (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  if (!ifTraceFile.good ())
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " not found");
+    }
+  ifTraceFile.read (magic, sizeof (magic));
+  ifTraceFile.close ();
+  if (std::memcmp (magic, MAGIC, sizeof (MAGIC)) == 0)
+    {
+      trace->Map (fileName);
+    }
+  else
+    {
+      trace->LoadText (fileName);
+    }
+  GetRegistry ()[key.str ()] = PeekPointer (trace);
+  return trace;
+}
+
+void
+FadingTraceFile::LoadText (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ifstream ifTraceFile (fileName.c_str (), std::ifstream::in);
+  m_type = TEXT;
+  m_text.resize (static_cast<uint64_t> (m_rbNum) * m_samplesNum);
+  for (uint64_t i = 0; i < m_text.size (); i++)
+    {
+      ifTraceFile >> m_text[i];
+    }
+}
+
+void
+FadingTraceFile::Map (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  int fd = open (fileName.c_str (), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat (fd, &st) != 0)
+    {
+      NS_FATAL_ERROR ("Cannot open the fading trace file " << fileName);
+    }
+  m_mappingSize = st.st_size;
+  if (m_mappingSize < sizeof (BinaryHeader))
+    {
+      NS_FATAL_ERROR ("Truncated fading trace file " << fileName);
+    }
+  // a shared read-only mapping, so that the pages are shared by all the
+  // processes which map the trace
+  m_mapping = mmap (0, m_mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (m_mapping == MAP_FAILED)
+    {
+      m_mapping = 0;
+      NS_FATAL_ERROR ("Cannot map the fading trace file " << fileName);
+    }
+
+  const BinaryHeader *header = static_cast<const BinaryHeader *> (m_mapping);
+  if (header->byteOrder != BYTE_ORDER_MARK || header->version != VERSION)
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " has an unsupported version or byte order");
+    }
+  if (header->rbNum < m_rbNum || header->samplesNum != m_samplesNum)
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " has " << header->rbNum << " RBs and "
+                      << header->samplesNum << " samples, instead of " << m_rbNum << " RBs and "
+                      << m_samplesNum << " samples");
+    }
+  uint64_t samples = static_cast<uint64_t> (header->rbNum) * header->samplesNum;
+  const char *data = static_cast<const char *> (m_mapping) + sizeof (BinaryHeader);
+  uint64_t sampleSize = 0;
+  switch (header->sampleType)
+    {
+    case FLOAT32:
+      m_float32 = reinterpret_cast<const float *> (data);
+      sampleSize = sizeof (float);
+      break;
+    case FLOAT16:
+      m_float16 = reinterpret_cast<const uint16_t *> (data);
+      sampleSize = sizeof (uint16_t);
+      break;
+    default:
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " has an unknown sample type " << header->sampleType);
+    }
+  if (m_mappingSize < sizeof (BinaryHeader) + samples * sampleSize)
+    {
+      NS_FATAL_ERROR ("Truncated fading trace file " << fileName);
+    }
+  m_type = static_cast<SampleType> (header->sampleType);
+  NS_LOG_INFO ("Mapped fading trace " << fileName << " of " << header->rbNum << " RBs and "
+               << header->samplesNum << " samples, sample type " << m_type);
+}
+
+void
+FadingTraceFile::ConvertTextTrace (std::string textFileName, std::string binaryFileName,
+                                   uint32_t rbNum, uint32_t samplesNum, SampleType type)
+{
+  NS_LOG_FUNCTION (textFileName << binaryFileName << rbNum << samplesNum << type);
+  NS_ABORT_MSG_UNLESS (type == FLOAT32 || type == FLOAT16, "Invalid sample type of a binary fading trace");
+  std::ifstream in (textFileName.c_str (), std::ifstream::in);
+  if (!in.good ())
+    {
+      NS_FATAL_ERROR ("Fading trace file " << textFileName << " not found");
+    }
+  std::ofstream out (binaryFileName.c_str (), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  if (!out.good ())
+    {
+      NS_FATAL_ERROR ("Cannot write the fading trace file " << binaryFileName);
+    }
+
+  BinaryHeader header;
+  std::memcpy (header.magic, MAGIC, sizeof (MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.sampleType = type;
+  header.rbNum = rbNum;
+  header.samplesNum = samplesNum;
+  header.padding = 0;
+  out.write (reinterpret_cast<const char *> (&header), sizeof (header));
+
+  // the samples are converted one RB at a time, to keep the memory
+  // footprint small for long traces
+  std::vector<float> float32 (samplesNum);
+  std::vector<uint16_t> float16 (samplesNum);
+  for (uint32_t rb = 0; rb < rbNum; rb++)
+    {
+      for (uint32_t i = 0; i < samplesNum; i++)
+        {
+          double sample;
+          if (!(in >> sample))
+            {
+              NS_FATAL_ERROR ("Fading trace file " << textFileName << " has less than "
+                              << rbNum << " x " << samplesNum << " samples");
+            }
+          float32[i] = static_cast<float> (sample);
+          float16[i] = FloatToHalf (float32[i]);
+        }
+      if (type == FLOAT32)
+        {
+          out.write (reinterpret_cast<const char *> (&float32[0]), samplesNum * sizeof (float));
+        }
+      else
+        {
+          out.write (reinterpret_cast<const char *> (&float16[0]), samplesNum * sizeof (uint16_t));
+        }
+    }
+  if (!out.good ())
+    {
+      NS_FATAL_ERROR ("Cannot write the fading trace file " << binaryFileName);
+    }
+}
+
+uint32_t
+FadingTraceFile::GetRbNum (void) const
+{
+  return m_rbNum;
+}
+
+uint32_t
+FadingTraceFile::GetSamplesNum (void) const
+{
+  return m_samplesNum;
+}
+
+FadingTraceFile::SampleType
+FadingTraceFile::GetSampleType (void) const
+{
+  return m_type;
+}
+
+float
+FadingTraceFile::HalfToFloat (uint16_t h)
+{
+  uint32_t sign = static_cast<uint32_t> (h & 0x8000) << 16;
+  uint32_t exponent = (h >> 10) & 0x1f;
+  uint32_t mantissa = h & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0)
+    {
+      // zero or subnormal, mantissa * 2^-24
+      float f = std::ldexp (static_cast<float> (mantissa), -24);
+      return sign ? -f : f;
+    }
+  else if (exponent == 0x1f)
+    {
+      // infinity or NaN
+      bits = sign | 0x7f800000 | (mantissa << 13);
+    }
+  else
+    {
+      bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+  float f;
+  std::memcpy (&f, &bits, sizeof (f));
+  return f;
+}
+
+uint16_t
+FadingTraceFile::FloatToHalf (float f)
+{
+  uint32_t bits;
+  std::memcpy (&bits, &f, sizeof (bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  int32_t exponent = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+  if (exponent == 0xff)
+    {
+      // infinity or NaN
+      return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+    }
+  exponent = exponent - 127 + 15;
+  if (exponent >= 0x1f)
+    {
+      // overflow
+      return sign | 0x7c00;
+    }
+  if (exponent <= 0)
+    {
+      // subnormal or zero
+      if (exponent < -10)
+        {
+          return sign;
+        }
+      mantissa |= 0x800000;
+      uint32_t shift = 14 - exponent;
+      uint32_t half = mantissa >> shift;
+      uint32_t remainder = mantissa & ((1u << shift) - 1);
+      uint32_t midpoint = 1u << (shift - 1);
+      if (remainder > midpoint || (remainder == midpoint && (half & 1)))
+        {
+          half++;
+        }
+      return sign | half;
+    }
+  uint32_t half = (exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  // a carry into the exponent gives the right result, up to infinity
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+      half++;
+    }
+  return sign | half;
+}
+
+} // namespace ns3
@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FADING_TRACE_FILE_H
+#define FADING_TRACE_FILE_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/assert.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief The samples of a fading trace, shared by all the
+ * TraceFadingLossModel instances that use the same file.
+ *
+ * A trace is made of SamplesNum samples, in dB, for each of RbNum RBs.  Two
+ * file formats are supported, and told apart by the first bytes of the file:
+ *  - the ASCII format generated by fading_trace_generator.m, with a row of
+ *    samples for each RB, which is parsed into doubles;
+ *  - a binary format, made of a 32 bytes header followed by the samples,
+ *    RB by RB, stored as float32 or float16 values in the byte order of the
+ *    host.  The header contains the magic string "NS3FADTR", the version
+ *    (1), a byte order mark (0x01020304), the type of the samples (see
+ *    SampleType), the number of RBs and the number of samples per RB, each
+ *    as a uint32_t, and 4 bytes of padding.
+ *
+ * Binary traces are memory-mapped read-only and shared, so they are not
+ * parsed, the pages of the samples are loaded only when used, and they are
+ * shared through the page cache by all the processes using the trace, e.g.
+ * the runs of a parameter sweep.  Within a process, the traces are shared
+ * by all the users that open the same file with the same dimensions, in
+ * both formats.  ConvertTextTrace () converts an ASCII trace to the binary
+ * format, and is available from the command line as the
+ * convert-fading-trace program of the utils directory.
+ *
+ * The float16 format halves the size of the float32 one; its 11 bit
+ * significand keeps the error of the samples below 0.008 dB for the
+ * fading values between -32 and 32 dB, and below 0.0003 dB for the ones
+ * between -1 and 1 dB.
+ */
+class FadingTraceFile : public SimpleRefCount<FadingTraceFile>
+{
+public:
+  /// Types of the samples of a trace
+  enum SampleType
+  {
+    TEXT = 0,    ///< ASCII trace, parsed into doubles
+    FLOAT32 = 1, ///< binary trace of IEEE 754 binary32 samples
+    FLOAT16 = 2  ///< binary trace of IEEE 754 binary16 samples
+  };
+
+  ~FadingTraceFile ();
+
+  /**
+   * Open a trace, or get the instance already opened in this process.
+   * The program is aborted if the file cannot be read, or if the
+   * dimensions of a binary trace do not match.
+   *
+   * \param fileName the name of the trace file, in either format
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   * \return the trace
+   */
+  static Ptr<const FadingTraceFile> Open (std::string fileName, uint32_t rbNum, uint32_t samplesNum);
+
+  /**
+   * Convert an ASCII trace to the binary format.  The program is aborted
+   * if the ASCII trace has less than rbNum * samplesNum samples, or if the
+   * binary trace cannot be written.
+   *
+   * \param textFileName the name of the ASCII trace
+   * \param binaryFileName the name of the binary trace to write
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   * \param type the type of the samples of the binary trace, FLOAT32 or FLOAT16
+   */
+  static void ConvertTextTrace (std::string textFileName, std::string binaryFileName,
+                                uint32_t rbNum, uint32_t samplesNum, SampleType type);
+
+  /**
+   * \param rb the index of the RB
+   * \param index the index of the sample
+   * \return the sample, in dB
+   */
+  inline double GetSample (uint32_t rb, uint32_t index) const
+  {
+    NS_ASSERT_MSG (rb < m_rbNum && index < m_samplesNum, "fading trace sample out of range");
+    uint64_t i = static_cast<uint64_t> (rb) * m_samplesNum + index;
+    switch (m_type)
+      {
+      case FLOAT32:
+        return m_float32[i];
+      case FLOAT16:
+        return HalfToFloat (m_float16[i]);
+      default:
+        return m_text[i];
+      }
+  }
+
+  /// \return the number of RBs of the trace
+  uint32_t GetRbNum (void) const;
+  /// \return the number of samples per RB of the trace
+  uint32_t GetSamplesNum (void) const;
+  /// \return the type of the samples of the trace
+  SampleType GetSampleType (void) const;
+
+  /**
+   * \param h an IEEE 754 binary16 value
+   * \return the value as a float
+   */
+  static float HalfToFloat (uint16_t h);
+  /**
+   * \param f a float
+   * \return the nearest IEEE 754 binary16 value, ties to even
+   */
+  static uint16_t FloatToHalf (float f);
+
+private:
+  /**
+   * Constructor
+   * \param key the key of the trace in the registry of the open traces
+   */
+  FadingTraceFile (std::string key);
+
+  /**
+   * Parse an ASCII trace
+   * \param fileName the name of the trace file
+   */
+  void LoadText (std::string fileName);
+  /**
+   * Map a binary trace
+   * \param fileName the name of the trace file
+   */
+  void Map (std::string fileName);
+
+  std::string m_key;          ///< key in the registry of the open traces
+  SampleType m_type;          ///< type of the samples
+  uint32_t m_rbNum;           ///< number of RBs
+  uint32_t m_samplesNum;      ///< number of samples per RB
+  std::vector<double> m_text; ///< samples of an ASCII trace
+  const float *m_float32;     ///< samples of a FLOAT32 binary trace
+  const uint16_t *m_float16;  ///< samples of a FLOAT16 binary trace
+  void *m_mapping;            ///< mapping of a binary trace, or 0
+  uint64_t m_mappingSize;     ///< size of m_mapping
+};
+
+} // namespace ns3
+
+#endif /* FADING_TRACE_FILE_H */
@@ -29,6 +29,7 @@
 #include <map>
 #include "ns3/random-variable-stream.h"
 #include <ns3/nstime.h>
+#include <ns3/fading-trace-file.h>
 
 namespace ns3 {
 
@@ -40,6 +41,11 @@ class MobilityModel;
  * \ingroup spectrum
  *
  * \brief fading loss model based on precalculated fading traces
+ *
+ * The trace can be in the ASCII format generated by
+ * fading_trace_generator.m, or in the binary format of FadingTraceFile,
+ * which is memory-mapped instead of being parsed, and is shared by all the
+ * instances and all the processes using the same file.
  */
 class TraceFadingLossModel : public SpectrumPropagationLossModel
 {
@@ -112,20 +118,9 @@ private:
   
   mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap; ///< start variable map
   
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
-  /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
-   */
-  typedef std::vector<FadingTraceSample> FadingTrace;
-
-
-  
   std::string m_traceFile; ///< the trace file name
   
-  FadingTrace m_fadingTrace; ///< fading trace
+  Ptr<const FadingTraceFile> m_fadingTrace; ///< fading trace, shared with the other instances using the file
 
   
   Time m_traceLength; ///< the trace time
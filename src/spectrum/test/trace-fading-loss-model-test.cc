@@ -0,0 +1,290 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/nstime.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/fading-trace-file.h>
+#include <ns3/trace-fading-loss-model.h>
+#include <cmath>
+#include <fstream>
+
+using namespace ns3;
+
+/// number of RBs of the test traces
+static const uint32_t TEST_RB_NUM = 4;
+/// number of samples per RB of the test traces
+static const uint32_t TEST_SAMPLES_NUM = 100;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Write an ASCII fading trace with TEST_RB_NUM x TEST_SAMPLES_NUM samples
+ *
+ * \param fileName the name of the trace
+ * \param exact whether the samples must be exactly representable as float16
+ * \return the samples, RB by RB
+ */
+static std::vector<double>
+WriteTextTrace (std::string fileName, bool exact)
+{
+  std::vector<double> samples;
+  std::ofstream out (fileName.c_str ());
+  for (uint32_t rb = 0; rb < TEST_RB_NUM; rb++)
+    {
+      for (uint32_t i = 0; i < TEST_SAMPLES_NUM; i++)
+        {
+          double sample;
+          if (exact)
+            {
+              sample = -20.0 + ((rb * 37 + i * 11) % 160) * 0.25;
+            }
+          else
+            {
+              sample = 15.0 * std::sin (0.1 * i + rb) - 3.3;
+            }
+          samples.push_back (sample);
+          out.precision (17);
+          out << sample << (i + 1 < TEST_SAMPLES_NUM ? " " : "\n");
+        }
+    }
+  return samples;
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test the float16 conversions of FadingTraceFile on known values
+ */
+class FadingTraceHalfTestCase : public TestCase
+{
+public:
+  FadingTraceHalfTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FadingTraceHalfTestCase::FadingTraceHalfTestCase ()
+  : TestCase ("float16 conversions of the fading traces")
+{
+}
+
+void
+FadingTraceHalfTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (1.0f), 0x3c00, "1.0");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (-2.0f), 0xc000, "-2.0");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (65504.0f), 0x7bff, "largest float16");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (1e6f), 0x7c00, "overflow to infinity");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (0.1f), 0x2e66, "0.1");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (2049.0f), 0x6800, "tie rounded to even (2048)");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (2051.0f), 0x6802, "tie rounded to even (2052)");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (std::ldexp (1.0f, -24)), 0x0001, "smallest subnormal");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::FloatToHalf (std::ldexp (1.0f, -26)), 0x0000, "underflow to zero");
+
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::HalfToFloat (0x3c00), 1.0f, "1.0");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::HalfToFloat (0xc000), -2.0f, "-2.0");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::HalfToFloat (0x7bff), 65504.0f, "largest float16");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::HalfToFloat (0x0001), std::ldexp (1.0f, -24), "smallest subnormal");
+  NS_TEST_ASSERT_MSG_EQ (std::isinf (FadingTraceFile::HalfToFloat (0x7c00)), true, "infinity");
+
+  // round trip of all the finite float16 values
+  for (uint32_t h = 0; h < 0x10000; h++)
+    {
+      if ((h & 0x7c00) != 0x7c00)
+        {
+          uint16_t back = FadingTraceFile::FloatToHalf (FadingTraceFile::HalfToFloat (h));
+          if (h != 0x8000)
+            {
+              NS_TEST_ASSERT_MSG_EQ (back, h, "float16 round trip");
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test the conversion of an ASCII trace to the binary formats, the samples
+ * read from the mapped traces, and the sharing of the open traces
+ */
+class FadingTraceFileTestCase : public TestCase
+{
+public:
+  FadingTraceFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FadingTraceFileTestCase::FadingTraceFileTestCase ()
+  : TestCase ("binary fading traces")
+{
+}
+
+void
+FadingTraceFileTestCase::DoRun (void)
+{
+  std::string text = CreateTempDirFilename ("trace.fad");
+  std::string float32 = CreateTempDirFilename ("trace-float32.bin");
+  std::string float16 = CreateTempDirFilename ("trace-float16.bin");
+  std::vector<double> samples = WriteTextTrace (text, false);
+  FadingTraceFile::ConvertTextTrace (text, float32, TEST_RB_NUM, TEST_SAMPLES_NUM, FadingTraceFile::FLOAT32);
+  FadingTraceFile::ConvertTextTrace (text, float16, TEST_RB_NUM, TEST_SAMPLES_NUM, FadingTraceFile::FLOAT16);
+
+  Ptr<const FadingTraceFile> textTrace = FadingTraceFile::Open (text, TEST_RB_NUM, TEST_SAMPLES_NUM);
+  Ptr<const FadingTraceFile> float32Trace = FadingTraceFile::Open (float32, TEST_RB_NUM, TEST_SAMPLES_NUM);
+  Ptr<const FadingTraceFile> float16Trace = FadingTraceFile::Open (float16, TEST_RB_NUM, TEST_SAMPLES_NUM);
+  NS_TEST_ASSERT_MSG_EQ (textTrace->GetSampleType (), FadingTraceFile::TEXT, "wrong type of the ASCII trace");
+  NS_TEST_ASSERT_MSG_EQ (float32Trace->GetSampleType (), FadingTraceFile::FLOAT32, "wrong type of the float32 trace");
+  NS_TEST_ASSERT_MSG_EQ (float16Trace->GetSampleType (), FadingTraceFile::FLOAT16, "wrong type of the float16 trace");
+
+  for (uint32_t rb = 0; rb < TEST_RB_NUM; rb++)
+    {
+      for (uint32_t i = 0; i < TEST_SAMPLES_NUM; i++)
+        {
+          double sample = samples[rb * TEST_SAMPLES_NUM + i];
+          float f = static_cast<float> (sample);
+          NS_TEST_ASSERT_MSG_EQ (textTrace->GetSample (rb, i), sample, "wrong ASCII sample");
+          NS_TEST_ASSERT_MSG_EQ (float32Trace->GetSample (rb, i), f, "wrong float32 sample");
+          NS_TEST_ASSERT_MSG_EQ (float16Trace->GetSample (rb, i),
+                                 FadingTraceFile::HalfToFloat (FadingTraceFile::FloatToHalf (f)),
+                                 "wrong float16 sample");
+          NS_TEST_ASSERT_MSG_EQ_TOL (float16Trace->GetSample (rb, i), sample, 0.008, "float16 sample too far");
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::Open (float32, TEST_RB_NUM, TEST_SAMPLES_NUM), float32Trace,
+                         "the open trace is not shared");
+  NS_TEST_ASSERT_MSG_EQ (FadingTraceFile::Open (text, TEST_RB_NUM, TEST_SAMPLES_NUM), textTrace,
+                         "the open trace is not shared");
+  // a trace with less RBs is a different instance
+  Ptr<const FadingTraceFile> fewerRbs = FadingTraceFile::Open (float32, TEST_RB_NUM - 1, TEST_SAMPLES_NUM);
+  NS_TEST_ASSERT_MSG_NE (fewerRbs, float32Trace, "traces with different dimensions are shared");
+  NS_TEST_ASSERT_MSG_EQ (fewerRbs->GetSample (1, 7), float32Trace->GetSample (1, 7), "wrong sample with less RBs");
+
+  // the trace is closed when released by all the users
+  float16Trace = 0;
+  float16Trace = FadingTraceFile::Open (float16, TEST_RB_NUM, TEST_SAMPLES_NUM);
+  NS_TEST_ASSERT_MSG_EQ (float16Trace->GetSampleType (), FadingTraceFile::FLOAT16, "wrong type of the reopened trace");
+  NS_TEST_ASSERT_MSG_EQ (float16Trace->GetSample (2, 3), FadingTraceFile::HalfToFloat (FadingTraceFile::FloatToHalf (samples[2 * TEST_SAMPLES_NUM + 3])),
+                         "wrong sample of the reopened trace");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test that TraceFadingLossModel gives the same received PSDs with an
+ * ASCII trace and with its float16 conversion, when the samples are
+ * exactly representable as float16
+ */
+class TraceFadingLossModelFormatTestCase : public TestCase
+{
+public:
+  TraceFadingLossModelFormatTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param fileName the name of the trace
+   * \return a fading model using the trace
+   */
+  Ptr<TraceFadingLossModel> CreateModel (std::string fileName);
+};
+
+TraceFadingLossModelFormatTestCase::TraceFadingLossModelFormatTestCase ()
+  : TestCase ("TraceFadingLossModel with ASCII and binary traces")
+{
+}
+
+Ptr<TraceFadingLossModel>
+TraceFadingLossModelFormatTestCase::CreateModel (std::string fileName)
+{
+  Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel> ();
+  model->SetAttribute ("TraceFilename", StringValue (fileName));
+  model->SetAttribute ("TraceLength", TimeValue (MilliSeconds (TEST_SAMPLES_NUM)));
+  model->SetAttribute ("SamplesNum", UintegerValue (TEST_SAMPLES_NUM));
+  model->SetAttribute ("WindowSize", TimeValue (MilliSeconds (10)));
+  model->SetAttribute ("RbNum", UintegerValue (TEST_RB_NUM));
+  model->AssignStreams (1);
+  model->Initialize ();
+  return model;
+}
+
+void
+TraceFadingLossModelFormatTestCase::DoRun (void)
+{
+  std::string text = CreateTempDirFilename ("exact.fad");
+  std::string float16 = CreateTempDirFilename ("exact-float16.bin");
+  WriteTextTrace (text, true);
+  FadingTraceFile::ConvertTextTrace (text, float16, TEST_RB_NUM, TEST_SAMPLES_NUM, FadingTraceFile::FLOAT16);
+
+  Ptr<TraceFadingLossModel> textModel = CreateModel (text);
+  Ptr<TraceFadingLossModel> binaryModel = CreateModel (float16);
+
+  std::vector<double> freqs;
+  for (uint32_t rb = 0; rb < TEST_RB_NUM; rb++)
+    {
+      freqs.push_back (2.0e9 + rb * 180e3);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (sm);
+  for (uint32_t rb = 0; rb < TEST_RB_NUM; rb++)
+    {
+      (*txPsd)[rb] = 1e-10 * (rb + 1);
+    }
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+
+  Ptr<SpectrumValue> textRxPsd = textModel->CalcRxPowerSpectralDensity (txPsd, a, b);
+  Ptr<SpectrumValue> binaryRxPsd = binaryModel->CalcRxPowerSpectralDensity (txPsd, a, b);
+  for (uint32_t rb = 0; rb < TEST_RB_NUM; rb++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*binaryRxPsd)[rb], (*textRxPsd)[rb], "different rx PSD in RB " << rb);
+      NS_TEST_ASSERT_MSG_NE ((*textRxPsd)[rb], (*txPsd)[rb], "no fading in RB " << rb);
+    }
+
+  textModel->Dispose ();
+  binaryModel->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test suite of the fading traces of TraceFadingLossModel
+ */
+class TraceFadingLossModelTestSuite : public TestSuite
+{
+public:
+  TraceFadingLossModelTestSuite ();
+};
+
+TraceFadingLossModelTestSuite::TraceFadingLossModelTestSuite ()
+  : TestSuite ("trace-fading-loss-model", UNIT)
+{
+  AddTestCase (new FadingTraceHalfTestCase, TestCase::QUICK);
+  AddTestCase (new FadingTraceFileTestCase, TestCase::QUICK);
+  AddTestCase (new TraceFadingLossModelFormatTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceFadingLossModelTestSuite g_traceFadingLossModelTestSuite;
@@ -22,8 +22,10 @@ main (int argc, char *argv[])
 {
   /*** 0. Logging Options ***/
   bool verbose = true;
+  bool useSubscriptions = true;
 
   CommandLine cmd;
+  cmd.AddValue ("useSubscriptions", "Read vehicle positions from TraCI subscriptions", useSubscriptions);
   cmd.Parse (argc, argv);
   if (verbose)
     {
@@ -70,7 +72,7 @@ main (int argc, char *argv[])
   positionAlloc->SetY (320.0);
   positionAlloc->SetRho (25.0);
   mobility.SetPositionAllocator (positionAlloc);
-  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetMobilityModel ("ns3::TraciMobilityModel"); // interpolates the SUMO positions and reports the vehicle velocity
   mobility.Install (nodePool);
 
   /*** 7. Setup Traci and start SUMO ***/
@@ -87,6 +89,7 @@ main (int argc, char *argv[])
   sumoClient->SetAttribute ("SumoAdditionalCmdOptions", StringValue ("--verbose true"));
   sumoClient->SetAttribute ("SumoWaitForSocket", TimeValue (Seconds (1.0)));
   sumoClient->SetAttribute("SumoGUI", BooleanValue(true));
+  sumoClient->SetAttribute ("UseSubscriptions", BooleanValue (useSubscriptions)); // step latency is logged by TraciClient
 
   /*** 8. Create and Setup Applications for the RSU node and set position ***/
   RsuSpeedControlHelper rsuSpeedControlHelper (9); // Port #9
@@ -133,7 +136,7 @@ main (int argc, char *argv[])
         vehicleSpeedControl->StopApplicationNow();
 
       // set position outside communication range
-      Ptr<ConstantPositionMobilityModel> mob = exNode->GetObject<ConstantPositionMobilityModel>();
+      Ptr<MobilityModel> mob = exNode->GetObject<MobilityModel>();
       mob->SetPosition(Vector(-100.0+(rand()%25),320.0+(rand()%25),250.0));// rand() for visualization purposes
 
       // NOTE: further actions could be required for a save shut down!
@@ -21,6 +21,7 @@
  */
 
 #include <exception>
+#include <chrono>
 #include <algorithm>
 #include <unistd.h>
 #include <iostream>
@@ -105,6 +106,15 @@ namespace ns3
                   DoubleValue (1.5),
                   MakeDoubleAccessor (&TraciClient::m_altitude),
                   MakeDoubleChecker<double> ())
+    .AddAttribute ("UseSubscriptions",
+                  "Subscribe once to the position, speed and angle of every vehicle and read them from the simulation step response, instead of one request per vehicle and step.",
+                  BooleanValue (false),
+                  MakeBooleanAccessor (&TraciClient::m_useSubscriptions),
+                  MakeBooleanChecker ())
+    .AddTraceSource ("StepLatency",
+                  "Wall-clock time spent synchronising with SUMO in a simulation step, with the number of tracked vehicles.",
+                  MakeTraceSourceAccessor (&TraciClient::m_stepLatencyTrace),
+                  "ns3::TraciClient::StepLatencyTracedCallback")
   ;
     return tid;
   }
@@ -121,6 +131,7 @@ namespace ns3
     m_sumoLogFile = false;
     m_sumoStepLog = false;
     m_sumoWaitForSocket = ns3::Seconds(1.0);
+    m_useSubscriptions = false;
   }
 
   TraciClient::~TraciClient(void)
@@ -263,7 +274,7 @@ namespace ns3
     SynchroniseVehicleNodeMap();
 
     // get current positions from sumo and uptdate positions
-    UpdatePositions();
+    UpdatePositions(Seconds(0));
 
     // schedule event to command sumo the next simulation step
     Simulator::Schedule(m_synchInterval, &TraciClient::SumoSimulationStep, this);
@@ -274,6 +285,8 @@ namespace ns3
   {
     NS_LOG_FUNCTION(this);
 
+    auto stepStart = std::chrono::steady_clock::now();
+
     try
       {
         // get current simulation time
@@ -285,8 +298,12 @@ namespace ns3
         // include a ns3 node for every new sumo vehicle and exclude arrived vehicles
         SynchroniseVehicleNodeMap();
 
-        // ask sumo for new vehicle positions and update node positions
-        UpdatePositions();
+        // ask sumo for new vehicle positions and update node positions; sumo is one synch interval ahead
+        UpdatePositions(m_synchInterval);
+
+        std::chrono::duration<double> latency = std::chrono::steady_clock::now() - stepStart;
+        NS_LOG_INFO("SUMO step with " << m_vehicleNodeMap.size() << " vehicles took " << latency.count() * 1e3 << " ms");
+        m_stepLatencyTrace(m_vehicleNodeMap.size(), latency.count());
 
         // schedule next event to simulate next time step in sumo
         Simulator::Schedule(m_synchInterval, &TraciClient::SumoSimulationStep, this);
@@ -298,25 +315,70 @@ namespace ns3
   }
 
   void
-  TraciClient::UpdatePositions()
+  TraciClient::UpdatePositions(Time delay)
   {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << delay);
 
     try
       {
-        // iterate over all sumo vehicles in map
-        for (std::map<std::string, Ptr<Node> >::iterator it = m_vehicleNodeMap.begin(); it != m_vehicleNodeMap.end(); ++it)
+        if (m_useSubscriptions)
           {
-            // get current sumo vehicle from map
-            std::string veh(it->first);
+            // the simulation step response already holds the subscribed variables of all vehicles;
+            // both maps are sorted by vehicle id, so walk them side by side
+            libsumo::SubscriptionResults& results = this->TraCIAPI::vehicle.getModifiableSubscriptionResults();
+            libsumo::SubscriptionResults::iterator res = results.begin();
+            for (std::map<std::string, VehicleMobility>::iterator it = m_vehicleMobilityMap.begin(); it != m_vehicleMobilityMap.end(); ++it)
+              {
+                while (res != results.end() && res->first < it->first)
+                  {
+                    ++res;
+                  }
 
-            // get vehicle position from sumo
-            libsumo::TraCIPosition pos(this->TraCIAPI::vehicle.getPosition(veh));
+                libsumo::TraCIResults::iterator pos, speed, angle;
+                if (res != results.end() && res->first == it->first
+                    && (pos = res->second.find(libsumo::VAR_POSITION)) != res->second.end()
+                    && (speed = res->second.find(libsumo::VAR_SPEED)) != res->second.end()
+                    && (angle = res->second.find(libsumo::VAR_ANGLE)) != res->second.end())
+                  {
+                    SetVehicleState(it->second,
+                                    *static_cast<const libsumo::TraCIPosition*>(pos->second.get()),
+                                    static_cast<const libsumo::TraCIDouble*>(speed->second.get())->value,
+                                    static_cast<const libsumo::TraCIDouble*>(angle->second.get())->value,
+                                    delay);
+                  }
+                else
+                  {
+                    // no subscription result for this vehicle, ask for its state
+                    NS_LOG_WARN("No subscription result for vehicle " << it->first);
+                    SetVehicleState(it->second,
+                                    this->TraCIAPI::vehicle.getPosition(it->first),
+                                    this->TraCIAPI::vehicle.getSpeed(it->first),
+                                    this->TraCIAPI::vehicle.getAngle(it->first),
+                                    delay);
+                  }
+              }
+          }
+        else
+          {
+            // iterate over all sumo vehicles in map
+            for (std::map<std::string, VehicleMobility>::iterator it = m_vehicleMobilityMap.begin(); it != m_vehicleMobilityMap.end(); ++it)
+              {
+                // get vehicle position from sumo
+                libsumo::TraCIPosition pos(this->TraCIAPI::vehicle.getPosition(it->first));
 
-            // get corresponding ns3 node from map
-            Ptr<MobilityModel> mob = m_vehicleNodeMap.at(veh)->GetObject<MobilityModel>();
-            // set ns3 node position with user defined altitude
-            mob->SetPosition(Vector(pos.x, pos.y, m_altitude));
+                // speed and angle are only needed (and requested) for a TraciMobilityModel
+                if (it->second.traciMobility)
+                  {
+                    SetVehicleState(it->second, pos,
+                                    this->TraCIAPI::vehicle.getSpeed(it->first),
+                                    this->TraCIAPI::vehicle.getAngle(it->first),
+                                    delay);
+                  }
+                else
+                  {
+                    SetVehicleState(it->second, pos, 0.0, 0.0, delay);
+                  }
+              }
           }
       }
     catch (std::exception& e)
@@ -325,6 +387,36 @@ namespace ns3
       }
   }
 
+  void
+  TraciClient::SetVehicleState(VehicleMobility& mob, const libsumo::TraCIPosition& pos, double speed, double angle, Time delay)
+  {
+    // set ns3 node position with user defined altitude
+    if (mob.traciMobility)
+      {
+        // a vehicle added in this step is still at the position its node was created with,
+        // so it must not be moved from there to the road over the synch interval
+        mob.traciMobility->SetSumoState(Vector(pos.x, pos.y, m_altitude), speed, angle, mob.placed ? delay : Seconds(0));
+      }
+    else
+      {
+        mob.mobility->SetPosition(Vector(pos.x, pos.y, m_altitude));
+      }
+    mob.placed = true;
+  }
+
+  void
+  TraciClient::SubscribeVehicle(const std::string& veh)
+  {
+    NS_LOG_FUNCTION(this << veh);
+
+    // subscribe for the whole lifetime of the vehicle; sumo drops the subscription when the vehicle arrives
+    std::vector<int> vars;
+    vars.push_back(libsumo::VAR_POSITION);
+    vars.push_back(libsumo::VAR_SPEED);
+    vars.push_back(libsumo::VAR_ANGLE);
+    this->TraCIAPI::vehicle.subscribe(veh, vars, libsumo::INVALID_DOUBLE_VALUE, libsumo::INVALID_DOUBLE_VALUE);
+  }
+
   void
   TraciClient::GetSumoVehicles(std::vector<std::string>& sumoVehicles)
   {
@@ -421,6 +513,7 @@ namespace ns3
 
                 // unregister in map
                 m_vehicleNodeMap.erase(veh);
+                m_vehicleMobilityMap.erase(veh);
               }
             else // if it is not in the map, create a new ns3 node for it
               {
@@ -429,6 +522,16 @@ namespace ns3
 
                 // register in the map (link vehicle to node!)
                 m_vehicleNodeMap.insert(std::pair<std::string, Ptr<Node>>(veh, inNode));
+                VehicleMobility mob;
+                mob.mobility = inNode->GetObject<MobilityModel>();
+                mob.traciMobility = DynamicCast<TraciMobilityModel>(mob.mobility);
+                mob.placed = false;
+                m_vehicleMobilityMap.insert(std::pair<std::string, VehicleMobility>(veh, mob));
+
+                if (m_useSubscriptions)
+                  {
+                    SubscribeVehicle(veh);
+                  }
                  //std::cout<<"\n A new node is created with ID "<<veh<<std::endl;
               }
           }
@@ -37,6 +37,7 @@
 
 #include "sumo-TraCIAPI.h"
 #include "sumo-TraCIDefs.h"
+#include "traci-mobility-model.h"
 
 namespace ns3 {
 
@@ -59,6 +60,10 @@ public:
   std::string GetVehicleId(Ptr<Node> node);
 
   uint32_t GetVehicleMapSize(); // size of vehicle map
+
+  // signature of the StepLatency trace source: number of tracked vehicles and
+  // wall-clock time in seconds spent in one synchronisation step
+  typedef void (* StepLatencyTracedCallback)(uint32_t vehicles, double latency);
   
     // map every sumo vehicle to a ns3 node
   std::map< std::string, Ptr<Node> > m_vehicleNodeMap;
@@ -67,8 +72,24 @@ private:
   // perform sumo simulation for a certain time step
   void SumoSimulationStep(void);
 
-  // get current positions from sumo vehicles and update corresponding ns3 nodes positions
-  void UpdatePositions(void);
+  // mobility of the ns3 node of a tracked vehicle; traciMobility is null if the node has no TraciMobilityModel;
+  // placed is false until the first sumo state of the vehicle has been applied
+  struct VehicleMobility
+  {
+    Ptr<MobilityModel> mobility;
+    Ptr<TraciMobilityModel> traciMobility;
+    bool placed;
+  };
+
+  // get current positions from sumo vehicles and update corresponding ns3 nodes positions;
+  // the sumo state is the one of the vehicles after delay
+  void UpdatePositions(Time delay);
+
+  // apply the sumo state of a vehicle to its ns3 node; the first state of a vehicle is applied at once
+  void SetVehicleState(VehicleMobility& mob, const libsumo::TraCIPosition& pos, double speed, double angle, Time delay);
+
+  // subscribe to position, speed and angle of a newly tracked vehicle
+  void SubscribeVehicle(const std::string& veh);
 
   // get new (departed) and removed (arrived) vehicles from sumo
   void GetSumoVehicles(std::vector<std::string>& sumoVehicles);
@@ -82,6 +103,9 @@ private:
   // map every sumo vehicle to a ns3 node
   //std::map< std::string, Ptr<Node> > m_vehicleNodeMap;
 
+  // mobility model of the ns3 node of every tracked sumo vehicle, sorted by vehicle id as the subscription results
+  std::map< std::string, VehicleMobility > m_vehicleMobilityMap;
+
   // a vehicle is untracked if it is simulated in sumo but not linked to a ns3 node because of an penetration rate < 1.0
   std::vector<std::string> m_untrackedVehicles;
 
@@ -110,6 +134,10 @@ private:
   double m_altitude;
   int m_sumoSeed;
   ns3::Time m_sumoWaitForSocket;
+  bool m_useSubscriptions;
+
+  // wall-clock latency of every synchronisation step
+  TracedCallback<uint32_t, double> m_stepLatencyTrace;
 
 };
 
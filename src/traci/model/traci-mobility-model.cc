@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "traci-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TraciMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TraciMobilityModel);
+
+TypeId
+TraciMobilityModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TraciMobilityModel")
+    .SetParent<MobilityModel> ()
+    .SetGroupName ("TraciClient")
+    .AddConstructor<TraciMobilityModel> ();
+  return tid;
+}
+
+TraciMobilityModel::TraciMobilityModel ()
+{
+}
+
+TraciMobilityModel::~TraciMobilityModel ()
+{
+}
+
+void
+TraciMobilityModel::SetSumoState (const Vector &position, double speed, double angle, Time delay)
+{
+  NS_LOG_FUNCTION (this << position << speed << angle << delay);
+  NS_ASSERT (!delay.IsStrictlyNegative ());
+
+  Time now = Simulator::Now ();
+  m_start = delay.IsZero () ? position : DoGetPosition ();
+  double heading = angle * M_PI / 180.0;
+  m_velocity = Vector (speed * std::sin (heading), speed * std::cos (heading), 0.0);
+  m_startTime = now;
+  m_end = position;
+  m_endTime = now + delay;
+  if (delay.IsZero ())
+    {
+      m_segmentVelocity = m_velocity;
+    }
+  else
+    {
+      double t = delay.GetSeconds ();
+      m_segmentVelocity = Vector ((m_end.x - m_start.x) / t,
+                                  (m_end.y - m_start.y) / t,
+                                  (m_end.z - m_start.z) / t);
+    }
+  NotifyCourseChange ();
+}
+
+Vector
+TraciMobilityModel::DoGetPosition (void) const
+{
+  Time now = Simulator::Now ();
+  if (now < m_endTime)
+    {
+      double t = (now - m_startTime).GetSeconds ();
+      return Vector (m_start.x + m_segmentVelocity.x * t,
+                     m_start.y + m_segmentVelocity.y * t,
+                     m_start.z + m_segmentVelocity.z * t);
+    }
+  double t = (now - m_endTime).GetSeconds ();
+  return Vector (m_end.x + m_velocity.x * t,
+                 m_end.y + m_velocity.y * t,
+                 m_end.z + m_velocity.z * t);
+}
+
+void
+TraciMobilityModel::DoSetPosition (const Vector &position)
+{
+  NS_LOG_FUNCTION (this << position);
+  m_start = position;
+  m_end = position;
+  m_startTime = Simulator::Now ();
+  m_endTime = m_startTime;
+  m_segmentVelocity = Vector (0.0, 0.0, 0.0);
+  m_velocity = Vector (0.0, 0.0, 0.0);
+  NotifyCourseChange ();
+}
+
+Vector
+TraciMobilityModel::DoGetVelocity (void) const
+{
+  return Simulator::Now () < m_endTime ? m_segmentVelocity : m_velocity;
+}
+
+} // namespace ns3
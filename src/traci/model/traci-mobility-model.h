@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TRACI_MOBILITY_MODEL_H
+#define TRACI_MOBILITY_MODEL_H
+
+#include "ns3/nstime.h"
+#include "ns3/mobility-model.h"
+
+namespace ns3 {
+
+/**
+ * \brief Mobility model driven by the SUMO state of a vehicle.
+ *
+ * TraciClient steps SUMO one SynchInterval ahead of ns-3, so the position,
+ * speed and angle it reads for a vehicle are the ones the vehicle will have
+ * at the end of the current interval.  Instead of jumping to that position,
+ * this model moves the node on a constant velocity segment from its current
+ * position to the reported one, reaching it when SUMO does, and afterwards
+ * keeps moving with the reported speed and heading until the next update.
+ *
+ * GetVelocity () therefore returns the actual velocity of the vehicle, as
+ * needed by the Doppler computations of the channel models, and the position
+ * changes continuously however coarse the SynchInterval is.  The position is
+ * evaluated lazily, no event is scheduled.
+ *
+ * SetPosition () places the node at the given position and stops it.
+ */
+class TraciMobilityModel : public MobilityModel
+{
+public:
+  /**
+   * Register this type with the TypeId system.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  TraciMobilityModel ();
+  virtual ~TraciMobilityModel ();
+
+  /**
+   * Set the state that SUMO reports for the vehicle at time Now () + delay.
+   * If delay is zero, the node is moved to the position immediately.
+   *
+   * \param position the position of the vehicle (m)
+   * \param speed the speed of the vehicle (m/s)
+   * \param angle the heading of the vehicle, in degrees clockwise from the
+   *        positive y axis (north), as in SUMO
+   * \param delay the time after which the vehicle is at position
+   */
+  void SetSumoState (const Vector &position, double speed, double angle, Time delay);
+
+private:
+  virtual Vector DoGetPosition (void) const;
+  virtual void DoSetPosition (const Vector &position);
+  virtual Vector DoGetVelocity (void) const;
+
+  Vector m_start;         //!< position at the beginning of the segment
+  Time m_startTime;       //!< beginning of the segment
+  Vector m_segmentVelocity; //!< velocity along the segment
+  Vector m_end;           //!< position reported by SUMO, end of the segment
+  Time m_endTime;         //!< end of the segment
+  Vector m_velocity;      //!< velocity reported by SUMO, used after m_endTime
+};
+
+} // namespace ns3
+
+#endif /* TRACI_MOBILITY_MODEL_H */
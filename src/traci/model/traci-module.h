@@ -13,4 +13,5 @@
 #include "sumo-TraCIConstants.h"
 #include "sumo-TraCIDefs.h"
 #include "traci-client.h"
+#include "traci-mobility-model.h"
 #endif
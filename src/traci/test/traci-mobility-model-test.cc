@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/vector.h"
+#include "ns3/traci-mobility-model.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup tests
+ *
+ * \brief Check the position and the velocity of a TraciMobilityModel fed
+ * with SUMO states, without SUMO: the node moves on a constant velocity
+ * segment towards a delayed state, extrapolates with the SUMO speed and
+ * heading afterwards, and jumps to a state given with no delay.
+ */
+class TraciMobilityModelTestCase : public TestCase
+{
+public:
+  TraciMobilityModelTestCase ();
+  virtual ~TraciMobilityModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the position and the velocity of the model
+   * \param position the expected position
+   * \param velocity the expected velocity
+   */
+  void CheckState (Vector position, Vector velocity);
+
+  Ptr<TraciMobilityModel> m_mob; ///< the mobility model under test
+};
+
+TraciMobilityModelTestCase::TraciMobilityModelTestCase ()
+  : TestCase ("Check the interpolation and the extrapolation of the TraciMobilityModel")
+{
+}
+
+TraciMobilityModelTestCase::~TraciMobilityModelTestCase ()
+{
+}
+
+void
+TraciMobilityModelTestCase::CheckState (Vector position, Vector velocity)
+{
+  Vector pos = m_mob->GetPosition ();
+  Vector vel = m_mob->GetVelocity ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (pos.x, position.x, 1e-9, "Wrong x position at " << Simulator::Now ().GetSeconds () << " s");
+  NS_TEST_EXPECT_MSG_EQ_TOL (pos.y, position.y, 1e-9, "Wrong y position at " << Simulator::Now ().GetSeconds () << " s");
+  NS_TEST_EXPECT_MSG_EQ_TOL (pos.z, position.z, 1e-9, "Wrong z position at " << Simulator::Now ().GetSeconds () << " s");
+  NS_TEST_EXPECT_MSG_EQ_TOL (vel.x, velocity.x, 1e-9, "Wrong x velocity at " << Simulator::Now ().GetSeconds () << " s");
+  NS_TEST_EXPECT_MSG_EQ_TOL (vel.y, velocity.y, 1e-9, "Wrong y velocity at " << Simulator::Now ().GetSeconds () << " s");
+  NS_TEST_EXPECT_MSG_EQ_TOL (vel.z, velocity.z, 1e-9, "Wrong z velocity at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+TraciMobilityModelTestCase::DoRun (void)
+{
+  m_mob = CreateObject<TraciMobilityModel> ();
+  m_mob->SetPosition (Vector (0.0, 0.0, 1.5));
+  Simulator::Schedule (Seconds (0.5), &TraciMobilityModelTestCase::CheckState, this,
+                       Vector (0.0, 0.0, 1.5), Vector (0.0, 0.0, 0.0));
+
+  // at 1 s SUMO reports the state of the vehicle at 2 s: heading east at 10 m/s
+  Simulator::Schedule (Seconds (1.0), &TraciMobilityModel::SetSumoState, m_mob,
+                       Vector (10.0, 20.0, 1.5), 10.0, 90.0, Seconds (1.0));
+  // half way along the segment towards the reported position
+  Simulator::Schedule (Seconds (1.5), &TraciMobilityModelTestCase::CheckState, this,
+                       Vector (5.0, 10.0, 1.5), Vector (10.0, 20.0, 0.0));
+  // past the reported state, the node keeps the SUMO speed and heading
+  Simulator::Schedule (Seconds (2.5), &TraciMobilityModelTestCase::CheckState, this,
+                       Vector (15.0, 20.0, 1.5), Vector (10.0, 0.0, 0.0));
+
+  // a state with no delay is applied at once: heading north at 5 m/s
+  Simulator::Schedule (Seconds (3.0), &TraciMobilityModel::SetSumoState, m_mob,
+                       Vector (100.0, 100.0, 1.5), 5.0, 0.0, Seconds (0));
+  Simulator::Schedule (Seconds (3.0), &TraciMobilityModelTestCase::CheckState, this,
+                       Vector (100.0, 100.0, 1.5), Vector (0.0, 5.0, 0.0));
+  Simulator::Schedule (Seconds (3.5), &TraciMobilityModelTestCase::CheckState, this,
+                       Vector (100.0, 102.5, 1.5), Vector (0.0, 5.0, 0.0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_mob = 0;
+}
+
+/**
+ * \ingroup tests
+ *
+ * \brief TraciClient test suite
+ */
+class TraciTestSuite : public TestSuite
+{
+public:
+  TraciTestSuite ();
+};
+
+TraciTestSuite::TraciTestSuite ()
+  : TestSuite ("traci", UNIT)
+{
+  AddTestCase (new TraciMobilityModelTestCase, TestCase::QUICK);
+}
+
+static TraciTestSuite g_traciTestSuite; ///< the test suite
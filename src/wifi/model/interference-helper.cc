@@ -28,6 +28,7 @@
 #include "wifi-utils.h"
 #include "wifi-ppdu.h"
 #include "wifi-psdu.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -130,6 +131,100 @@ InterferenceHelper::NiChange::GetEvent (void) const
   return m_event;
 }
 
+/****************************************************************
+ *       Time-ordered list of NiChange events.
+ ****************************************************************/
+
+InterferenceHelper::NiChanges::NiChanges ()
+  : m_head (0)
+{
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::begin (void)
+{
+  return m_changes.begin () + m_head;
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChanges::begin (void) const
+{
+  return m_changes.begin () + m_head;
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChanges::end (void)
+{
+  return m_changes.end ();
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChanges::end (void) const
+{
+  return m_changes.end ();
+}
+
+void
+InterferenceHelper::NiChanges::clear (void)
+{
+  m_changes.clear ();
+  m_head = 0;
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChanges::lower_bound (Time moment) const
+{
+  return std::lower_bound (begin (), end (), moment,
+                           [] (const value_type &change, const Time &t) { return change.first < t; });
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChanges::upper_bound (Time moment) const
+{
+  return std::upper_bound (begin (), end (), moment,
+                           [] (const Time &t, const value_type &change) { return t < change.first; });
+}
+
+std::size_t
+InterferenceHelper::NiChanges::insert (Time moment, NiChange change)
+{
+  std::size_t index = upper_bound (moment) - m_changes.begin ();
+  m_changes.insert (m_changes.begin () + index, std::make_pair (moment, change));
+  return index - m_head;
+}
+
+void
+InterferenceHelper::NiChanges::push_back (Time moment, NiChange change)
+{
+  NS_ASSERT (m_changes.size () == m_head || m_changes.back ().first <= moment);
+  m_changes.push_back (std::make_pair (moment, change));
+}
+
+void
+InterferenceHelper::NiChanges::EraseFront (const_iterator last)
+{
+  std::size_t newHead = last - m_changes.begin ();
+  NS_ASSERT (newHead > m_head);
+  newHead--;
+  if (newHead == m_head)
+    {
+      return;
+    }
+  // move the first NiChange just before last and release the events of the
+  // skipped NiChanges, which are compacted away later on
+  m_changes[newHead] = m_changes[m_head];
+  for (std::size_t i = m_head; i < newHead; i++)
+    {
+      m_changes[i].second = NiChange (0, 0);
+    }
+  m_head = newHead;
+  if (m_head > m_changes.size () / 2)
+    {
+      m_changes.erase (m_changes.begin (), m_changes.begin () + m_head);
+      m_head = 0;
+    }
+}
+
 
 /****************************************************************
  *       The actual InterferenceHelper
@@ -226,12 +321,11 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
     {
       m_firstPower = previousPowerStart;
       // Always leave the first zero power noise event in the list
-      m_niChanges.erase (++(m_niChanges.begin ()),
-                         GetNextPosition (event->GetStartTime ()));
+      m_niChanges.EraseFront (GetNextPosition (event->GetStartTime ()));
     }
-  auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
-  auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  std::size_t first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
+  std::size_t last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
+  for (auto i = m_niChanges.begin () + first; i != m_niChanges.begin () + last; ++i)
     {
       i->second.AddPower (event->GetRxPowerW ());
     }
@@ -263,20 +357,37 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, WifiT
 double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
 {
+  // A single pass over the NiChanges of the event accumulates the noise and
+  // interference power at the current time and copies the changes seen by
+  // the event, which are already sorted by time.
+  Time now = Simulator::Now ();
   double noiseInterferenceW = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->first < Simulator::Now (); ++it)
+  auto it = m_niChanges.lower_bound (event->GetStartTime ());
+  for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it)
+    {
+      if (it->first < now)
+        {
+          noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
+        }
+    }
+  ni->push_back (event->GetStartTime (), NiChange (0, event));
+  if (it != m_niChanges.end () && it->first < now)
     {
       noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
     }
-  it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it);
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
   while (++it != m_niChanges.end () && it->second.GetEvent () != event)
     {
-      ni->insert (*it);
+      if (it->first < now)
+        {
+          noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
+        }
+      ni->push_back (it->first, it->second);
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
+  for (; it != m_niChanges.end () && it->first < now; ++it)
+    {
+      noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
+    }
+  ni->push_back (event->GetEndTime (), NiChange (0, event));
   NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
   return noiseInterferenceW;
 }
@@ -833,10 +944,10 @@ InterferenceHelper::GetPreviousPosition (Time moment) const
   return it;
 }
 
-InterferenceHelper::NiChanges::iterator
+std::size_t
 InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change)
 {
-  return m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
+  return m_niChanges.insert (moment, change);
 }
 
 void
@@ -24,6 +24,7 @@
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -266,8 +267,6 @@ protected:
    */
   double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const;
 
-
-private:
   /**
    * Noise and Interference (thus Ni) event.
    */
@@ -307,10 +306,87 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * Time-ordered list of NiChange events.
+   *
+   * The changes are kept sorted by time in a contiguous vector, so that
+   * the PER computations are linear scans over contiguous memory.  Changes
+   * with the same time are kept in insertion order, as in a multimap.  The
+   * list only ever shrinks at its front (see EraseFront): the erased slots
+   * are skipped by moving the head index and are compacted once they make up
+   * half of the vector, so that the erasure is amortized O(1) per change.
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  class NiChanges
+  {
+public:
+    /// a NiChange and the time at which it happens
+    typedef std::pair<Time, NiChange> value_type;
+    /// iterator over the NiChanges
+    typedef std::vector<value_type>::iterator iterator;
+    /// const iterator over the NiChanges
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    NiChanges ();
 
+    /**
+     * \returns an iterator to the first NiChange
+     */
+    iterator begin (void);
+    /**
+     * \returns a const iterator to the first NiChange
+     */
+    const_iterator begin (void) const;
+    /**
+     * \returns an iterator past the last NiChange
+     */
+    iterator end (void);
+    /**
+     * \returns a const iterator past the last NiChange
+     */
+    const_iterator end (void) const;
+    /**
+     * Remove all the NiChanges.
+     */
+    void clear (void);
+    /**
+     * \param moment the time to look for
+     * \returns a const iterator to the first NiChange not earlier than moment
+     */
+    const_iterator lower_bound (Time moment) const;
+    /**
+     * \param moment the time to look for
+     * \returns a const iterator to the first NiChange later than moment
+     */
+    const_iterator upper_bound (Time moment) const;
+    /**
+     * Insert a NiChange after all the NiChanges not later than moment.
+     *
+     * \param moment the time of the NiChange
+     * \param change the NiChange
+     * \returns the index of the new NiChange, relative to begin ()
+     */
+    std::size_t insert (Time moment, NiChange change);
+    /**
+     * Append a NiChange, which must not be earlier than the last one.
+     *
+     * \param moment the time of the NiChange
+     * \param change the NiChange
+     */
+    void push_back (Time moment, NiChange change);
+    /**
+     * Erase the NiChanges in [begin () + 1, last), i.e. everything before last
+     * except the first NiChange, which is moved just before last.
+     *
+     * \param last the first NiChange to keep
+     */
+    void EraseFront (const_iterator last);
+
+private:
+    std::vector<value_type> m_changes; ///< the NiChanges, sorted by time
+    std::size_t m_head; ///< index of the first NiChange in m_changes
+  };
+
+
+private:
   /**
    * Append the given Event.
    *
@@ -385,13 +461,6 @@ private:
    * \returns an iterator to the list of NiChanges
    */
   NiChanges::const_iterator GetNextPosition (Time moment) const;
-  /**
-   * Returns an iterator to the first NiChange that is later than moment
-   *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
-   */
-  //NiChanges::iterator GetNextPosition (Time moment);
   /**
    * Returns an iterator to the last NiChange that is before than moment
    *
@@ -402,13 +471,13 @@ private:
 
   /**
    * Add NiChange to the list at the appropriate position and
-   * return the iterator of the new event.
+   * return the index of the new event.
    *
    * \param moment time to check from
    * \param change the NiChange to add
-   * \returns the iterator of the new event
+   * \returns the index of the new event, relative to the first NiChange
    */
-  NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change);
+  std::size_t AddNiChangeEvent (Time moment, NiChange change);
 };
 
 } //namespace ns3
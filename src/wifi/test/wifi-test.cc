@@ -48,6 +48,7 @@
 #include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/waypoint-mobility-model.h"
+#include "ns3/interference-helper.h"
 
 using namespace ns3;
 
@@ -2926,6 +2927,109 @@ IdealRateManagerMimoTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * InterferenceHelper giving the test access to its NiChanges list.
+ */
+class NiChangesInterferenceHelper : public InterferenceHelper
+{
+public:
+  typedef InterferenceHelper::NiChange NiChange; ///< the NiChange class
+  typedef InterferenceHelper::NiChanges NiChanges; ///< the NiChanges class
+};
+
+/**
+ * Make sure that the time-ordered list of NiChanges kept by the
+ * InterferenceHelper keeps equal-time changes in insertion order, returns
+ * indices relative to begin () once the front has been erased and keeps the
+ * first (zero-power) NiChange when it compacts its storage.
+ */
+class InterferenceHelperNiChangesTest : public TestCase
+{
+public:
+  InterferenceHelperNiChangesTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Check the time and the power of the NiChange at the given index.
+   * \param ni the NiChanges
+   * \param index the index of the NiChange, relative to begin ()
+   * \param moment the expected time
+   * \param power the expected power
+   */
+  void CheckChange (const NiChangesInterferenceHelper::NiChanges &ni, std::size_t index, Time moment, double power);
+};
+
+InterferenceHelperNiChangesTest::InterferenceHelperNiChangesTest ()
+  : TestCase ("Test the NiChanges list of the InterferenceHelper")
+{
+}
+
+void
+InterferenceHelperNiChangesTest::CheckChange (const NiChangesInterferenceHelper::NiChanges &ni, std::size_t index, Time moment, double power)
+{
+  NS_TEST_ASSERT_MSG_LT (index, static_cast<std::size_t> (ni.end () - ni.begin ()), "NiChange " << index << " out of range");
+  NiChangesInterferenceHelper::NiChanges::const_iterator it = ni.begin () + index;
+  NS_TEST_EXPECT_MSG_EQ (it->first, moment, "Unexpected time of NiChange " << index);
+  NS_TEST_EXPECT_MSG_EQ (it->second.GetPower (), power, "Unexpected power of NiChange " << index);
+}
+
+void
+InterferenceHelperNiChangesTest::DoRun (void)
+{
+  typedef NiChangesInterferenceHelper::NiChange NiChange;
+  NiChangesInterferenceHelper::NiChanges ni;
+
+  // the first NiChange carries no power, as in InterferenceHelper::EraseEvents
+  ni.push_back (Seconds (0), NiChange (0, 0));
+  for (uint32_t i = 1; i <= 8; i++)
+    {
+      ni.push_back (Seconds (i), NiChange (i, 0));
+    }
+
+  // equal-time NiChanges are kept in insertion order
+  NS_TEST_EXPECT_MSG_EQ (ni.insert (Seconds (4), NiChange (40, 0)), 5, "Unexpected index of the first NiChange at 4 s");
+  NS_TEST_EXPECT_MSG_EQ (ni.insert (Seconds (4), NiChange (41, 0)), 6, "Unexpected index of the second NiChange at 4 s");
+  CheckChange (ni, 4, Seconds (4), 4);
+  CheckChange (ni, 5, Seconds (4), 40);
+  CheckChange (ni, 6, Seconds (4), 41);
+  CheckChange (ni, 7, Seconds (5), 5);
+
+  // erase [1 s, 3 s): the first NiChange is moved just before 3 s, and the
+  // returned indices stay relative to begin ()
+  ni.EraseFront (ni.lower_bound (Seconds (3)));
+  NS_TEST_EXPECT_MSG_EQ (ni.end () - ni.begin (), 9, "Unexpected number of NiChanges after the first erasure");
+  CheckChange (ni, 0, Seconds (0), 0);
+  CheckChange (ni, 1, Seconds (3), 3);
+  NS_TEST_EXPECT_MSG_EQ (ni.insert (Seconds (4), NiChange (42, 0)), 5, "Unexpected index of the third NiChange at 4 s");
+  CheckChange (ni, 2, Seconds (4), 4);
+  CheckChange (ni, 3, Seconds (4), 40);
+  CheckChange (ni, 4, Seconds (4), 41);
+  CheckChange (ni, 5, Seconds (4), 42);
+  CheckChange (ni, 6, Seconds (5), 5);
+  NS_TEST_EXPECT_MSG_EQ (ni.upper_bound (Seconds (4)) - ni.begin (), 6, "Unexpected upper bound of 4 s");
+  NS_TEST_EXPECT_MSG_EQ (ni.lower_bound (Seconds (4)) - ni.begin (), 2, "Unexpected lower bound of 4 s");
+
+  // erase [3 s, 7 s): more than half of the storage is now skipped, which
+  // compacts it and must keep the first NiChange at begin ()
+  ni.EraseFront (ni.lower_bound (Seconds (7)));
+  NS_TEST_EXPECT_MSG_EQ (ni.end () - ni.begin (), 3, "Unexpected number of NiChanges after the compaction");
+  CheckChange (ni, 0, Seconds (0), 0);
+  CheckChange (ni, 1, Seconds (7), 7);
+  CheckChange (ni, 2, Seconds (8), 8);
+  NS_TEST_EXPECT_MSG_EQ (ni.insert (Seconds (7), NiChange (70, 0)), 2, "Unexpected index of the NiChange inserted after the compaction");
+  CheckChange (ni, 1, Seconds (7), 7);
+  CheckChange (ni, 2, Seconds (7), 70);
+  CheckChange (ni, 3, Seconds (8), 8);
+
+  // a NiChange earlier than all the others but the first one
+  NS_TEST_EXPECT_MSG_EQ (ni.insert (Seconds (6), NiChange (60, 0)), 1, "Unexpected index of the NiChange at 6 s");
+  CheckChange (ni, 0, Seconds (0), 0);
+  CheckChange (ni, 1, Seconds (6), 60);
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2944,6 +3048,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new WifiTest, TestCase::QUICK);
   AddTestCase (new QosUtilsIsOldPacketTest, TestCase::QUICK);
   AddTestCase (new InterferenceHelperSequenceTest, TestCase::QUICK); //Bug 991
+  AddTestCase (new InterferenceHelperNiChangesTest, TestCase::QUICK);
   AddTestCase (new DcfImmediateAccessBroadcastTestCase, TestCase::QUICK);
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
   AddTestCase (new QosFragmentationTestCase, TestCase::QUICK);
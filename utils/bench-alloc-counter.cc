@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "bench-alloc-counter.h"
+#include <cstdlib>
+#include <new>
+
+/// Number of heap allocations done by the program
+static uint64_t g_allocations = 0;
+
+uint64_t
+GetAllocationCount (void)
+{
+  return g_allocations;
+}
+
+void *
+operator new (std::size_t size)
+{
+  g_allocations++;
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the DL scheduling of the FF MAC schedulers alone,
+// without PHY, MAC nor RLC: the scheduler SAPs are driven directly, with
+// full-buffer UEs reporting subband CQIs every 10 TTIs.  For each scheduler
+// and number of UEs it reports the time spent per DL TTI, the number of DCIs
+// per TTI, and a checksum of the DCIs, which only depends on the decisions
+// of the scheduler.
+// Sample usage:  ./waf --run 'bench-ff-mac-scheduler --nUe=50,500 --nTti=2000'
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+/// Scheduler SAP user collecting the DCIs
+class BenchSchedSapUser : public FfMacSchedSapUser
+{
+public:
+  BenchSchedSapUser ()
+    : m_dcis (0),
+      m_checksum (14695981039346656037ULL)
+  {
+  }
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+  {
+    for (std::vector<BuildDataListElement_s>::const_iterator it = params.m_buildDataList.begin ();
+         it != params.m_buildDataList.end (); ++it)
+      {
+        m_dcis++;
+        Hash (it->m_dci.m_rnti);
+        Hash (it->m_dci.m_rbBitmap);
+        for (uint32_t j = 0; j < it->m_dci.m_tbsSize.size (); j++)
+          {
+            Hash (it->m_dci.m_mcs.at (j));
+            Hash (it->m_dci.m_tbsSize.at (j));
+          }
+      }
+  }
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+  {
+  }
+
+  uint64_t m_dcis;     ///< number of DL DCIs
+  uint64_t m_checksum; ///< FNV-1a checksum of the DL DCIs
+
+private:
+  /**
+   * Add a value to the checksum
+   * \param v the value
+   */
+  void Hash (uint32_t v)
+  {
+    for (int i = 0; i < 4; i++)
+      {
+        m_checksum = (m_checksum ^ ((v >> (8 * i)) & 0xff)) * 1099511628211ULL;
+      }
+  }
+};
+
+/// Scheduler CSCHED SAP user ignoring the confirmations
+class BenchCschedSapUser : public FfMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+};
+
+/**
+ * Report the RLC buffer of all the UEs
+ * \param sched the scheduler SAP
+ * \param nUe the number of UEs
+ */
+static void
+ReportBuffers (FfMacSchedSapProvider* sched, uint16_t nUe)
+{
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters buffer;
+  buffer.m_logicalChannelIdentity = 3;
+  buffer.m_rlcTransmissionQueueSize = 10000000;
+  buffer.m_rlcTransmissionQueueHolDelay = 0;
+  buffer.m_rlcRetransmissionQueueSize = 0;
+  buffer.m_rlcRetransmissionHolDelay = 0;
+  buffer.m_rlcStatusPduSize = 0;
+  for (uint16_t rnti = 1; rnti <= nUe; rnti++)
+    {
+      buffer.m_rnti = rnti;
+      sched->SchedDlRlcBufferReq (buffer);
+    }
+}
+
+/**
+ * Report the wideband and subband CQIs of all the UEs
+ * \param sched the scheduler SAP
+ * \param nUe the number of UEs
+ * \param rbgNum the number of RBGs
+ * \param tti the current TTI
+ */
+static void
+ReportCqis (FfMacSchedSapProvider* sched, uint16_t nUe, uint32_t rbgNum, uint32_t tti)
+{
+  FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqis;
+  cqis.m_sfnSf = 0;
+  for (uint16_t rnti = 1; rnti <= nUe; rnti++)
+    {
+      CqiListElement_s wb;
+      wb.m_rnti = rnti;
+      wb.m_ri = 1;
+      wb.m_cqiType = CqiListElement_s::P10;
+      wb.m_wbCqi.push_back (1 + (rnti * 7 + tti / 10) % 15);
+      wb.m_wbPmi = 0;
+      cqis.m_cqiList.push_back (wb);
+
+      CqiListElement_s sb;
+      sb.m_rnti = rnti;
+      sb.m_ri = 1;
+      sb.m_cqiType = CqiListElement_s::A30;
+      sb.m_wbPmi = 0;
+      for (uint32_t i = 0; i < rbgNum; i++)
+        {
+          HigherLayerSelected_s rbg;
+          rbg.m_sbPmi = 0;
+          rbg.m_sbCqi.push_back (1 + (rnti * 7 + i * 3 + tti / 10) % 15);
+          sb.m_sbMeasResult.m_higherLayerSelected.push_back (rbg);
+        }
+      cqis.m_cqiList.push_back (sb);
+    }
+  sched->SchedDlCqiInfoReq (cqis);
+}
+
+/**
+ * Run the benchmark of a scheduler
+ * \param schedulerType the type of the scheduler
+ * \param nUe the number of UEs
+ * \param nTti the number of TTIs
+ */
+static void
+RunScheduler (std::string schedulerType, uint16_t nUe, uint32_t nTti)
+{
+  const uint8_t bandwidth = 100;
+  const uint32_t rbgNum = 25;
+
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  factory.Set ("HarqEnabled", BooleanValue (false));
+  Ptr<FfMacScheduler> scheduler = factory.Create<FfMacScheduler> ();
+  Ptr<LteFfrAlgorithm> ffr = CreateObject<LteFrNoOpAlgorithm> ();
+  ffr->SetDlBandwidth (bandwidth);
+  ffr->SetUlBandwidth (bandwidth);
+  scheduler->SetLteFfrSapProvider (ffr->GetLteFfrSapProvider ());
+  ffr->SetLteFfrSapUser (scheduler->GetLteFfrSapUser ());
+  BenchSchedSapUser schedSapUser;
+  BenchCschedSapUser cschedSapUser;
+  scheduler->SetFfMacSchedSapUser (&schedSapUser);
+  scheduler->SetFfMacCschedSapUser (&cschedSapUser);
+  scheduler->Initialize ();
+  ffr->Initialize ();
+  FfMacCschedSapProvider* csched = scheduler->GetFfMacCschedSapProvider ();
+  FfMacSchedSapProvider* sched = scheduler->GetFfMacSchedSapProvider ();
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cell;
+  cell.m_dlBandwidth = bandwidth;
+  cell.m_ulBandwidth = bandwidth;
+  csched->CschedCellConfigReq (cell);
+  for (uint16_t rnti = 1; rnti <= nUe; rnti++)
+    {
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ue;
+      ue.m_rnti = rnti;
+      ue.m_transmissionMode = 0;
+      ue.m_reconfigureFlag = false;
+      csched->CschedUeConfigReq (ue);
+
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 1;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_GBR;
+      lc.m_qci = 1;
+      lc.m_eRabMaximulBitrateUl = 0;
+      lc.m_eRabMaximulBitrateDl = 0;
+      lc.m_eRabGuaranteedBitrateUl = 0;
+      lc.m_eRabGuaranteedBitrateDl = 64000 * (1 + rnti % 4);
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+      lcConfig.m_rnti = rnti;
+      lcConfig.m_reconfigureFlag = false;
+      lcConfig.m_logicalChannelConfigList.push_back (lc);
+      csched->CschedLcConfigReq (lcConfig);
+    }
+
+  FfMacSchedSapProvider::SchedDlTriggerReqParameters trigger;
+  int64_t elapsedMs = 0;
+  SystemWallClockMs clock;
+  for (uint32_t tti = 0; tti < nTti; tti++)
+    {
+      if (tti % 100 == 0)
+        {
+          ReportBuffers (sched, nUe);
+        }
+      if (tti % 10 == 0)
+        {
+          ReportCqis (sched, nUe, rbgNum, tti);
+        }
+      trigger.m_sfnSf = (((tti / 10) % 1024 + 1) << 4) | (tti % 10);
+      clock.Start ();
+      sched->SchedDlTriggerReq (trigger);
+      elapsedMs += clock.End ();
+    }
+  ffr->Dispose ();
+  scheduler->Dispose ();
+
+  std::cout << schedulerType << " " << nUe << " UEs: "
+            << 1000.0 * elapsedMs / nTti << " us/TTI, "
+            << (double) schedSapUser.m_dcis / nTti << " DCIs/TTI, "
+            << "checksum " << std::hex << schedSapUser.m_checksum << std::dec << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string schedulers = "ns3::PfFfMacScheduler,ns3::PssFfMacScheduler";
+  std::string nUes = "50,500";
+  uint32_t nTti = 2000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the DL scheduling of the FF MAC schedulers");
+  cmd.AddValue ("schedulers", "comma-separated list of scheduler types", schedulers);
+  cmd.AddValue ("nUe", "comma-separated list of numbers of UEs", nUes);
+  cmd.AddValue ("nTti", "number of DL TTIs per run", nTti);
+  cmd.Parse (argc, argv);
+
+  std::istringstream schedulerList (schedulers);
+  std::string schedulerType;
+  while (std::getline (schedulerList, schedulerType, ','))
+    {
+      std::istringstream ueList (nUes);
+      std::string nUe;
+      while (std::getline (ueList, nUe, ','))
+        {
+          RunScheduler (schedulerType, std::atoi (nUe.c_str ()), nTti);
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the UE measurements and the DL-CQI generation of
+// LteUePhy in a grid of cells, with moving UEs attached to the closest
+// cell, once with the CQI subsampling disabled and once with it enabled
+// (LteHelper::UseCqiSubsampling).  For each run it reports the elapsed
+// time, the number of DL-CQIs computed and reused by the UEs, and the
+// number of UE measurement reports, which do not depend on the subsampling.
+// Sample usage:  ./waf --run 'bench-lte-ue-measurements --nEnb=16 --nUe=32 --simTime=2'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <cmath>
+#include <iostream>
+
+using namespace ns3;
+
+/// Number of UE measurement reports
+static uint64_t g_reports = 0;
+
+/**
+ * Count the UE measurement reports
+ * \param rnti the RNTI of the UE
+ * \param cellId the measured cell
+ * \param rsrp the RSRP
+ * \param rsrq the RSRQ
+ * \param servingCell whether the cell is the serving cell
+ * \param componentCarrierId the component carrier ID
+ */
+static void
+CountReport (uint16_t rnti, uint16_t cellId, double rsrp, double rsrq, bool servingCell, uint8_t componentCarrierId)
+{
+  g_reports++;
+}
+
+/**
+ * Run the scenario
+ * \param nEnb the number of cells
+ * \param nUe the number of UEs
+ * \param simTime the simulated time, in seconds
+ * \param subsampling whether the CQI subsampling is enabled
+ */
+static void
+RunScenario (uint32_t nEnb, uint32_t nUe, double simTime, bool subsampling)
+{
+  g_reports = 0;
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseCqiSubsampling", BooleanValue (subsampling));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (nEnb);
+  NodeContainer ueNodes;
+  ueNodes.Create (nUe);
+
+  uint32_t side = std::ceil (std::sqrt (nEnb));
+  double distance = 500.0;
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> enbPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nEnb; i++)
+    {
+      enbPositions->Add (Vector (distance * (i % side), distance * (i / side), 30.0));
+    }
+  mobility.SetPositionAllocator (enbPositions);
+  mobility.Install (enbNodes);
+
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nUe; i++)
+    {
+      uePositions->Add (Vector (37.0 + std::fmod (113.0 * i, distance * side),
+                                71.0 + std::fmod (97.0 * i, distance * side), 1.5));
+    }
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+  for (uint32_t i = 0; i < nUe; i++)
+    {
+      ueNodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (20.0, 10.0, 0.0));
+    }
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+  EpsBearer bearer (EpsBearer::GBR_CONV_VOICE);
+  lteHelper->ActivateDataRadioBearer (ueDevs, bearer);
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/ReportUeMeasurements",
+                                 MakeCallback (&CountReport));
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  int64_t deltaMs = time.End ();
+
+  uint64_t evaluations = 0;
+  uint64_t reuses = 0;
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      Ptr<LteUePhy> phy = ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetPhy ();
+      evaluations += phy->GetMeasurementEngine ().GetCqiEvaluations ();
+      reuses += phy->GetMeasurementEngine ().GetCqiReuses ();
+    }
+  Simulator::Destroy ();
+
+  std::cout << "subsampling " << (subsampling ? "on " : "off") << ": "
+            << deltaMs << " ms, "
+            << evaluations << " CQIs computed, "
+            << reuses << " CQIs reused, "
+            << g_reports << " measurement reports" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nEnb = 9;
+  uint32_t nUe = 18;
+  double simTime = 1.0;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the UE measurements and the DL-CQI subsampling of LteUePhy");
+  cmd.AddValue ("nEnb", "number of cells", nEnb);
+  cmd.AddValue ("nUe", "number of UEs", nUe);
+  cmd.AddValue ("simTime", "simulated time, in seconds", simTime);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-lte-ue-measurements with " << nEnb << " cells, "
+            << nUe << " UEs, " << simTime << " s" << std::endl;
+  RunScenario (nEnb, nUe, simTime, false);
+  RunScenario (nEnb, nUe, simTime, true);
+
+  return 0;
+}
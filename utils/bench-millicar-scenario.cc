@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark a millicar sidelink scenario at
+// scale: a number of vehicles drive on a lane at a given distance from
+// each other, which sets the density of the scenario, and each of them
+// sends a UDP flow to the vehicle ahead of it.  At the end of the run it
+// prints a single line JSON report with the wall time, the simulated
+// seconds per wall second, the number of events processed, the number of
+// heap allocations and the peak RSS, in the same format as
+// bench-mmwave-scenario.
+// Sample usage:  ./waf --run 'bench-millicar-scenario --vehicles=8 --distance=20'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "bench-alloc-counter.h"
+#include <sys/resource.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+ * \return the peak resident set size of the process, in kB
+ */
+static long
+GetPeakRssKb (void)
+{
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    {
+      return -1;
+    }
+  return usage.ru_maxrss;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t vehicles = 2;
+  double distance = 20;
+  double speed = 20;
+  uint32_t antennaElements = 16;
+  double updatePeriod = 1;
+  uint32_t interPacketInterval = 100;
+  uint32_t packetSize = 1024;
+  double simTime = 0.5;
+  uint32_t run = 1;
+  std::string name = "";
+  std::string report = "";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark a millicar sidelink scenario with many vehicles");
+  cmd.AddValue ("vehicles", "number of vehicles", vehicles);
+  cmd.AddValue ("distance", "distance between consecutive vehicles, in m", distance);
+  cmd.AddValue ("speed", "speed of the vehicles, in m/s", speed);
+  cmd.AddValue ("antennaElements", "number of antenna elements of the vehicles (a square number)", antennaElements);
+  cmd.AddValue ("updatePeriod", "update period of the channel, in ms (0 to never update it)", updatePeriod);
+  cmd.AddValue ("iip", "interval between the UDP packets, in us", interPacketInterval);
+  cmd.AddValue ("packetSize", "size of the UDP packets, in bytes", packetSize);
+  cmd.AddValue ("simTime", "simulated time, in s", simTime);
+  cmd.AddValue ("run", "run number of the random number generator", run);
+  cmd.AddValue ("name", "name of the scenario in the report", name);
+  cmd.AddValue ("report", "file the JSON report is appended to", report);
+  cmd.Parse (argc, argv);
+
+  RngSeedManager::SetRun (run);
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseAmc", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWaveVehicularPropagationLossModel::ChannelCondition", StringValue ("a"));
+  Config::SetDefault ("ns3::MmWaveVehicularSpectrumPropagationLossModel::UpdatePeriod", TimeValue (MilliSeconds (updatePeriod)));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::AntennaElements", UintegerValue (antennaElements));
+  Config::SetDefault ("ns3::MmWaveVehicularNetDevice::RlcType", StringValue ("LteRlcUm"));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::SchedulingPatternOption", EnumValue (2));
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (500 * 1024));
+
+  if (name.empty ())
+    {
+      std::ostringstream oss;
+      oss << "millicar-v" << vehicles << "-d" << distance << "-a" << antennaElements
+          << "-p" << updatePeriod;
+      name = oss.str ();
+    }
+
+  std::cout << "Running bench-millicar-scenario with vehicles=" << vehicles << ", distance=" << distance
+            << " m, antennaElements=" << antennaElements << ", updatePeriod=" << updatePeriod
+            << " ms, simTime=" << simTime << " s" << std::endl;
+
+  SystemWallClockMs time;
+  time.Start ();
+  uint64_t allocations = GetAllocationCount ();
+
+  NodeContainer n;
+  n.Create (vehicles);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (n);
+  for (uint32_t i = 0; i < vehicles; i++)
+    {
+      n.Get (i)->GetObject<MobilityModel> ()->SetPosition (Vector (0.0, i * distance, 0.0));
+      n.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (0.0, speed, 0.0));
+    }
+
+  Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+  helper->SetNumerology (3);
+  helper->SetPropagationLossModelType ("ns3::MmWaveVehicularPropagationLossModel");
+  helper->SetSpectrumPropagationLossModelType ("ns3::MmWaveVehicularSpectrumPropagationLossModel");
+  NetDeviceContainer devs = helper->InstallMmWaveVehicularNetDevices (n);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  ipv4.Assign (devs);
+  helper->PairDevices (devs);
+
+  // each vehicle sends a flow to the one ahead of it
+  uint16_t port = 4000;
+  for (uint32_t i = 0; i + 1 < vehicles; i++)
+    {
+      UdpServerHelper server (port);
+      ApplicationContainer serverApps = server.Install (n.Get (i + 1));
+      serverApps.Start (Seconds (0.0));
+
+      UdpClientHelper client (n.Get (i + 1)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal (), port);
+      client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+      client.SetAttribute ("Interval", TimeValue (MicroSeconds (interPacketInterval)));
+      client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+      ApplicationContainer clientApps = client.Install (n.Get (i));
+      clientApps.Start (MilliSeconds (10));
+      clientApps.Stop (Seconds (simTime));
+    }
+
+  uint64_t setupMs = time.End ();
+  uint64_t setupAllocations = GetAllocationCount () - allocations;
+
+  time.Start ();
+  allocations = GetAllocationCount ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  uint64_t runMs = time.End ();
+  uint64_t runAllocations = GetAllocationCount () - allocations;
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::ostringstream json;
+  json << "{\"name\": \"" << name << "\""
+       << ", \"program\": \"bench-millicar-scenario\""
+       << ", \"vehicles\": " << vehicles
+       << ", \"distance\": " << distance
+       << ", \"antennaElements\": " << antennaElements
+       << ", \"updatePeriodMs\": " << updatePeriod
+       << ", \"simTime\": " << simTime
+       << ", \"setupMs\": " << setupMs
+       << ", \"wallMs\": " << runMs
+       << ", \"simSecondsPerWallSecond\": " << (runMs > 0 ? simTime * 1000.0 / runMs : 0.0)
+       << ", \"events\": " << events
+       << ", \"eventsPerSecond\": " << (runMs > 0 ? events * 1000.0 / runMs : 0.0)
+       << ", \"setupAllocations\": " << setupAllocations
+       << ", \"allocations\": " << runAllocations
+       << ", \"peakRssKb\": " << GetPeakRssKb ()
+       << "}";
+
+  std::cout << json.str () << std::endl;
+  if (!report.empty ())
+    {
+      std::ofstream out (report.c_str (), std::ios::app);
+      out << json.str () << std::endl;
+    }
+  return 0;
+}
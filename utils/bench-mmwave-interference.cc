@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the SINR computation of the mmWave
+// receivers.  A mmWaveInterference object, with the chunk processors that
+// MmWaveHelper installs on a UE, receives a sequence of transport blocks
+// while a number of interferers start and stop transmitting during each of
+// them.  It reports the number of heap allocations per received TB.
+// Sample usage:  ./waf --run 'bench-mmwave-interference --n=100000 --interferers=4'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/mmwave-interference.h"
+#include "ns3/mmwave-chunk-processor.h"
+#include "bench-alloc-counter.h"
+#include <iostream>
+
+using namespace ns3;
+using namespace mmwave;
+
+/// Sum of the SINR reported by the chunk processors, to use the results
+static double g_sinrSum = 0;
+
+/**
+ * Chunk processor callback
+ * \param sinr the average SINR of the TB
+ */
+static void
+ReportSinr (const SpectrumValue &sinr)
+{
+  g_sinrSum += sinr[0];
+}
+
+/// Parameters of the simulated receptions
+struct InterferenceParameters
+{
+  Ptr<mmWaveInterference> interference;   //!< the interference object of the receiver
+  Ptr<const SpectrumValue> signal;        //!< the PSD of the received TBs
+  Ptr<const SpectrumValue> interferer;    //!< the PSD of the interferers
+  uint32_t interferers;                   //!< number of interferers per TB
+  Time tbDuration;                        //!< duration of a TB
+  Time tbPeriod;                          //!< interval between the start of two TBs
+};
+
+/**
+ * Receive one TB, with the interferers starting at regular intervals during it
+ * \param p the parameters
+ */
+static void
+ReceiveTb (const InterferenceParameters &p)
+{
+  p.interference->StartRx (p.signal);
+  p.interference->AddSignal (p.signal, p.tbDuration);
+  for (uint32_t i = 0; i < p.interferers; i++)
+    {
+      Time offset = p.tbDuration * (i + 1) / (p.interferers + 1);
+      Simulator::Schedule (offset, &mmWaveInterference::AddSignal, p.interference, p.interferer, p.tbDuration);
+    }
+  Simulator::Schedule (p.tbDuration, &mmWaveInterference::EndRx, p.interference);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t numRbs = 72;
+  InterferenceParameters p;
+  p.interferers = 4;
+  p.tbDuration = MicroSeconds (100);
+  p.tbPeriod = MicroSeconds (101);
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the allocations of the mmWave SINR computation");
+  cmd.AddValue ("n", "number of received TBs", n);
+  cmd.AddValue ("rbs", "number of RBs of the spectrum model", numRbs);
+  cmd.AddValue ("interferers", "number of interferers starting during each TB", p.interferers);
+  cmd.Parse (argc, argv);
+
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < numRbs; i++)
+    {
+      freqs.push_back (28e9 + i * 14e6);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+  Ptr<SpectrumValue> noise = Create<SpectrumValue> (sm);
+  (*noise) = 1e-20;
+  Ptr<SpectrumValue> signal = Create<SpectrumValue> (sm);
+  (*signal) = 1e-17;
+  Ptr<SpectrumValue> interferer = Create<SpectrumValue> (sm);
+  (*interferer) = 1e-19;
+  p.signal = signal;
+  p.interferer = interferer;
+
+  // the chunk processors installed by MmWaveHelper on a UE data channel
+  p.interference = CreateObject<mmWaveInterference> ();
+  p.interference->SetNoisePowerSpectralDensity (noise);
+  Ptr<mmWaveChunkProcessor> pPower = Create<mmWaveChunkProcessor> ();
+  pPower->AddCallback (MakeCallback (&ReportSinr));
+  p.interference->AddPowerChunkProcessor (pPower);
+  Ptr<mmWaveChunkProcessor> pData = Create<mmWaveChunkProcessor> ();
+  pData->AddCallback (MakeCallback (&ReportSinr));
+  pData->AddCallback (MakeCallback (&ReportSinr));
+  p.interference->AddSinrChunkProcessor (pData);
+
+  std::cout << "Running bench-mmwave-interference with n=" << n
+            << " (" << numRbs << " RBs, " << p.interferers << " interferers per TB)" << std::endl;
+
+  // warm up
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (p.tbPeriod * i, &ReceiveTb, p);
+    }
+  Simulator::Run ();
+
+  SystemWallClockMs time;
+  uint64_t allocations = GetAllocationCount ();
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Simulator::Schedule (p.tbPeriod * i, &ReceiveTb, p);
+    }
+  Simulator::Run ();
+  uint64_t deltaMs = time.End ();
+  allocations = GetAllocationCount () - allocations;
+  Simulator::Destroy ();
+
+  std::cout << static_cast<double> (allocations) / n << " allocations/TB"
+            << " (" << deltaMs << " ms elapsed, "
+            << (deltaMs > 0 ? n * 1000.0 / deltaMs : 0.0) << " TBs/s, SINR sum " << g_sinrSum << ")"
+            << std::endl;
+  return 0;
+}
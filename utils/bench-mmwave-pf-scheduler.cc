@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the MmWaveFlexTtiPfMacScheduler
+// with a large number of UEs.  The scheduler is driven directly through its
+// SAPs: at each slot a random subset of the UEs reports new DL RLC buffer
+// sizes, the wideband CQIs are refreshed periodically with random values and
+// a SchedTriggerReq is issued.  It reports the time spent per slot and the
+// number of DL data TTIs allocated.
+// Sample usage:  ./waf --run 'bench-mmwave-pf-scheduler --n=10000 --ues=200'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/boolean.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/mmwave-flex-tti-pf-mac-scheduler.h"
+#include <iostream>
+#include <random>
+
+using namespace ns3;
+using namespace mmwave;
+
+/// Scheduler SAP user that counts the allocated TTIs
+class BenchSchedSapUser : public MmWaveMacSchedSapUser
+{
+public:
+  BenchSchedSapUser ()
+    : m_dlTtis (0)
+  {
+  }
+
+  virtual void SchedConfigInd (const struct SchedConfigIndParameters& params)
+  {
+    for (unsigned i = 0; i < params.m_slotAllocInfo.m_ttiAllocInfo.size (); i++)
+      {
+        const TtiAllocInfo &tti = params.m_slotAllocInfo.m_ttiAllocInfo[i];
+        if (tti.m_ttiType != TtiAllocInfo::CTRL && tti.m_tddMode == TtiAllocInfo::DL_slotAllocInfo)
+          {
+            m_dlTtis++;
+          }
+      }
+  }
+
+  uint64_t m_dlTtis;   //!< number of DL data TTIs allocated
+};
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000;
+  uint32_t ues = 200;
+  double activeFraction = 0.2;
+  uint32_t cqiPeriod = 8;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the MmWaveFlexTtiPfMacScheduler with many UEs");
+  cmd.AddValue ("n", "number of slots", n);
+  cmd.AddValue ("ues", "number of UEs", ues);
+  cmd.AddValue ("activeFraction", "fraction of the UEs that receive new DL data in each slot", activeFraction);
+  cmd.AddValue ("cqiPeriod", "period of the CQI reports, in slots", cqiPeriod);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-mmwave-pf-scheduler with n=" << n << ", ues=" << ues
+            << ", activeFraction=" << activeFraction << ", cqiPeriod=" << cqiPeriod << std::endl;
+
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  Ptr<MmWaveFlexTtiPfMacScheduler> scheduler = CreateObject<MmWaveFlexTtiPfMacScheduler> ();
+  scheduler->SetAttribute ("HarqEnabled", BooleanValue (false));
+  scheduler->ConfigureCommonParameters (config);
+  BenchSchedSapUser schedSapUser;
+  scheduler->SetMacSchedSapUser (&schedSapUser);
+  MmWaveMacSchedSapProvider *sched = scheduler->GetMacSchedSapProvider ();
+  MmWaveMacCschedSapProvider *csched = scheduler->GetMacCschedSapProvider ();
+
+  for (uint16_t rnti = 1; rnti <= ues; rnti++)
+    {
+      MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+      ueConfig.m_rnti = rnti;
+      ueConfig.m_transmissionMode = 0;
+      csched->CschedUeConfigReq (ueConfig);
+    }
+
+  std::mt19937 gen (1);
+  std::uniform_int_distribution<uint16_t> rntiDist (1, ues);
+  std::uniform_int_distribution<uint32_t> sizeDist (100, 20000);
+  std::uniform_int_distribution<int> cqiDist (1, 15);
+  uint32_t activePerSlot = activeFraction * ues;
+
+  SystemWallClockMs time;
+  time.Start ();
+  SfnSf sfn (0, 0, 0);
+  for (uint32_t slot = 0; slot < n; slot++)
+    {
+      if (slot % cqiPeriod == 0)
+        {
+          MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiParams;
+          cqiParams.m_sfnsf = sfn;
+          for (uint16_t rnti = 1; rnti <= ues; rnti++)
+            {
+              DlCqiInfo cqi;
+              cqi.m_rnti = rnti;
+              cqi.m_ri = 1;
+              cqi.m_cqiType = DlCqiInfo::WB;
+              cqi.m_wbCqi = cqiDist (gen);
+              cqi.m_wbPmi = 0;
+              cqiParams.m_cqiList.push_back (cqi);
+            }
+          sched->SchedDlCqiInfoReq (cqiParams);
+        }
+
+      for (uint32_t i = 0; i < activePerSlot; i++)
+        {
+          MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters bufferParams;
+          bufferParams.m_rnti = rntiDist (gen);
+          bufferParams.m_logicalChannelIdentity = 3;
+          bufferParams.m_rlcTransmissionQueueSize = sizeDist (gen);
+          bufferParams.m_rlcTransmissionQueueHolDelay = 0;
+          bufferParams.m_rlcRetransmissionQueueSize = 0;
+          bufferParams.m_rlcRetransmissionHolDelay = 0;
+          bufferParams.m_rlcStatusPduSize = 0;
+          sched->SchedDlRlcBufferReq (bufferParams);
+        }
+
+      MmWaveMacSchedSapProvider::SchedTriggerReqParameters triggerParams;
+      triggerParams.m_snfSf = sfn;
+      sched->SchedTriggerReq (triggerParams);
+
+      // advance to the next slot
+      if (++sfn.m_slotNum == config->GetSlotsPerSubframe ())
+        {
+          sfn.m_slotNum = 0;
+          if (++sfn.m_sfNum == config->GetSubframesPerFrame ())
+            {
+              sfn.m_sfNum = 0;
+              sfn.m_frameNum++;
+            }
+        }
+    }
+  uint64_t deltaMs = time.End ();
+
+  std::cout << (n > 0 ? deltaMs * 1000.0 / n : 0.0) << " us/slot"
+            << " (" << deltaMs << " ms elapsed, "
+            << schedSapUser.m_dlTtis << " DL data TTIs allocated)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark a whole mmWave RAN scenario, as set
+// up by mmwave-example, at scale: a number of eNBs are placed on a line and
+// each of them serves a number of UEs placed on a circle around it, with a
+// GBR data radio bearer activated on every UE.  The antenna sizes, the
+// update period of the 3GPP channel and the speed of the UEs can be set.
+// At the end of the run it prints a single line JSON report with the wall
+// time, the simulated seconds per wall second, the number of events
+// processed, the number of heap allocations and the peak RSS, which
+// utils/run-benchmarks.py collects and utils/compare-benchmarks.py compares.
+// Sample usage:  ./waf --run 'bench-mmwave-scenario --cells=4 --uesPerCell=10'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mmwave-helper.h"
+#include "ns3/buildings-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "bench-alloc-counter.h"
+#include <sys/resource.h>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * \return the peak resident set size of the process, in kB
+ */
+static long
+GetPeakRssKb (void)
+{
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    {
+      return -1;
+    }
+  return usage.ru_maxrss;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t cells = 1;
+  uint32_t uesPerCell = 1;
+  uint32_t enbAntennas = 64;
+  uint32_t ueAntennas = 16;
+  double updatePeriod = 0;
+  double simTime = 0.5;
+  double isd = 200;
+  double ueDistance = 50;
+  double ueSpeed = 0;
+  uint32_t run = 1;
+  std::string name = "";
+  std::string report = "";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark a mmWave RAN scenario with many cells and UEs");
+  cmd.AddValue ("cells", "number of eNBs", cells);
+  cmd.AddValue ("uesPerCell", "number of UEs around each eNB", uesPerCell);
+  cmd.AddValue ("enbAntennas", "number of antenna elements of the eNBs (a square number)", enbAntennas);
+  cmd.AddValue ("ueAntennas", "number of antenna elements of the UEs (a square number)", ueAntennas);
+  cmd.AddValue ("updatePeriod", "update period of the 3GPP channel, in ms (0 to never update it)", updatePeriod);
+  cmd.AddValue ("simTime", "simulated time, in s", simTime);
+  cmd.AddValue ("isd", "distance between the eNBs, in m", isd);
+  cmd.AddValue ("ueDistance", "distance between the UEs and their eNB, in m", ueDistance);
+  cmd.AddValue ("ueSpeed", "speed of the UEs, in m/s", ueSpeed);
+  cmd.AddValue ("run", "run number of the random number generator", run);
+  cmd.AddValue ("name", "name of the scenario in the report", name);
+  cmd.AddValue ("report", "file the JSON report is appended to", report);
+  cmd.Parse (argc, argv);
+
+  RngSeedManager::SetRun (run);
+  Config::SetDefault ("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue (MilliSeconds (updatePeriod)));
+
+  if (name.empty ())
+    {
+      std::ostringstream oss;
+      oss << "mmwave-c" << cells << "-u" << uesPerCell << "-a" << enbAntennas << "x" << ueAntennas
+          << "-p" << updatePeriod;
+      name = oss.str ();
+    }
+
+  std::cout << "Running bench-mmwave-scenario with cells=" << cells << ", uesPerCell=" << uesPerCell
+            << ", enbAntennas=" << enbAntennas << ", ueAntennas=" << ueAntennas
+            << ", updatePeriod=" << updatePeriod << " ms, simTime=" << simTime << " s" << std::endl;
+
+  SystemWallClockMs time;
+  time.Start ();
+  uint64_t allocations = GetAllocationCount ();
+
+  Ptr<MmWaveHelper> mmWaveHelper = CreateObject<MmWaveHelper> ();
+  mmWaveHelper->SetMmWaveEnbNetDeviceAttribute ("AntennaNum", UintegerValue (enbAntennas));
+  mmWaveHelper->SetMmWaveUeNetDeviceAttribute ("AntennaNum", UintegerValue (ueAntennas));
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (cells);
+  ueNodes.Create (cells * uesPerCell);
+
+  Ptr<ListPositionAllocator> enbPositionAlloc = CreateObject<ListPositionAllocator> ();
+  Ptr<ListPositionAllocator> uePositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t c = 0; c < cells; c++)
+    {
+      enbPositionAlloc->Add (Vector (c * isd, 0.0, 10.0));
+      for (uint32_t u = 0; u < uesPerCell; u++)
+        {
+          double angle = 2 * M_PI * u / uesPerCell;
+          uePositionAlloc->Add (Vector (c * isd + ueDistance * std::cos (angle),
+                                        ueDistance * std::sin (angle), 1.6));
+        }
+    }
+
+  MobilityHelper enbMobility;
+  enbMobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  enbMobility.SetPositionAllocator (enbPositionAlloc);
+  enbMobility.Install (enbNodes);
+  BuildingsHelper::Install (enbNodes);
+
+  MobilityHelper ueMobility;
+  ueMobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  ueMobility.SetPositionAllocator (uePositionAlloc);
+  ueMobility.Install (ueNodes);
+  BuildingsHelper::Install (ueNodes);
+  for (uint32_t i = 0; i < ueNodes.GetN (); i++)
+    {
+      ueNodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (0.0, ueSpeed, 0.0));
+    }
+
+  NetDeviceContainer enbNetDev = mmWaveHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueNetDev = mmWaveHelper->InstallUeDevice (ueNodes);
+  mmWaveHelper->AttachToClosestEnb (ueNetDev, enbNetDev);
+
+  EpsBearer bearer (EpsBearer::GBR_CONV_VOICE);
+  mmWaveHelper->ActivateDataRadioBearer (ueNetDev, bearer);
+
+  uint64_t setupMs = time.End ();
+  uint64_t setupAllocations = GetAllocationCount () - allocations;
+
+  time.Start ();
+  allocations = GetAllocationCount ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  uint64_t runMs = time.End ();
+  uint64_t runAllocations = GetAllocationCount () - allocations;
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::ostringstream json;
+  json << "{\"name\": \"" << name << "\""
+       << ", \"program\": \"bench-mmwave-scenario\""
+       << ", \"cells\": " << cells
+       << ", \"uesPerCell\": " << uesPerCell
+       << ", \"enbAntennas\": " << enbAntennas
+       << ", \"ueAntennas\": " << ueAntennas
+       << ", \"updatePeriodMs\": " << updatePeriod
+       << ", \"ueSpeed\": " << ueSpeed
+       << ", \"simTime\": " << simTime
+       << ", \"setupMs\": " << setupMs
+       << ", \"wallMs\": " << runMs
+       << ", \"simSecondsPerWallSecond\": " << (runMs > 0 ? simTime * 1000.0 / runMs : 0.0)
+       << ", \"events\": " << events
+       << ", \"eventsPerSecond\": " << (runMs > 0 ? events * 1000.0 / runMs : 0.0)
+       << ", \"setupAllocations\": " << setupAllocations
+       << ", \"allocations\": " << runAllocations
+       << ", \"peakRssKb\": " << GetPeakRssKb ()
+       << "}";
+
+  std::cout << json.str () << std::endl;
+  if (!report.empty ())
+    {
+      std::ofstream out (report.c_str (), std::ios::app);
+      out << json.str () << std::endl;
+    }
+  return 0;
+}
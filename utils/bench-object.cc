@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark Object::GetObject lookups on the
+// aggregates of a mmWave UE node (Node, MobilityModel, MobilityBuildingInfo
+// and the internet stack), i.e. the lookups done by the channel models and
+// TraciClient on every transmission / position update, and the cost of
+// creating Objects, which includes the setup of their aggregate buffer.
+// Sample usage:  ./waf --run 'bench-object --n=1000000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/buildings-module.h"
+#include "ns3/mmwave-helper.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+using namespace mmwave;
+
+/// Aggregate members of the UE node looked up by the benchmarks
+static Ptr<Node> g_node;
+static Ptr<NetDevice> g_device;
+
+static void
+benchMobility (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> mobility = g_node->GetObject<MobilityModel> ();
+      NS_ASSERT (mobility != 0);
+    }
+}
+
+static void
+benchDeviceMobility (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> mobility = g_device->GetNode ()->GetObject<MobilityModel> ();
+      NS_ASSERT (mobility != 0);
+    }
+}
+
+static void
+benchBuildingInfo (uint32_t n)
+{
+  Ptr<MobilityModel> mobility = g_node->GetObject<MobilityModel> ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityBuildingInfo> info = mobility->GetObject<MobilityBuildingInfo> ();
+      NS_ASSERT (info != 0);
+    }
+}
+
+static void
+benchMixed (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> mobility = g_node->GetObject<MobilityModel> ();
+      Ptr<Ipv4> ipv4 = mobility->GetObject<Ipv4> ();
+      Ptr<Node> node = ipv4->GetObject<Node> ();
+      Ptr<TcpL4Protocol> tcp = node->GetObject<TcpL4Protocol> ();
+      NS_ASSERT (tcp != 0);
+    }
+}
+
+static void
+benchCreate (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      NS_ASSERT (mobility != 0);
+    }
+}
+
+static void
+benchCreateAggregate (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Object> object = CreateObject<Object> ();
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      object->AggregateObject (mobility);
+      NS_ASSERT (object->GetObject<MobilityModel> () == mobility);
+    }
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t lookups,
+          uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  Object::ResetGetObjectCacheStats ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  Object::GetObjectCacheStats stats = Object::GetGetObjectCacheStats ();
+  uint64_t total = stats.hits + stats.misses;
+  double nsPerLookup = minDelay * 1e6 / (static_cast<double> (n) * lookups);
+  std::cout << nsPerLookup << " ns/op"
+            << " (" << minDelay << " ms elapsed, cache hit rate "
+            << (total > 0 ? 100.0 * stats.hits / total : 0.0) << "% of "
+            << total << " scanned lookups)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000000;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Object::GetObject on a mmWave UE node");
+  cmd.AddValue ("n", "number of iterations", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  Ptr<MmWaveHelper> mmwaveHelper = CreateObject<MmWaveHelper> ();
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (1);
+  ueNodes.Create (1);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  BuildingsHelper::Install (enbNodes);
+  BuildingsHelper::Install (ueNodes);
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+
+  mmwaveHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevices = mmwaveHelper->InstallUeDevice (ueNodes);
+
+  g_node = ueNodes.Get (0);
+  g_device = ueDevices.Get (0);
+
+  uint32_t aggregates = 0;
+  for (Object::AggregateIterator it = g_node->GetAggregateIterator (); it.HasNext (); it.Next ())
+    {
+      aggregates++;
+    }
+  std::cout << "Running bench-object with n=" << n
+            << " on a UE node with " << aggregates << " aggregated objects" << std::endl;
+
+  runBench (&benchMobility, n, 1, minIterations, "Node -> MobilityModel");
+  runBench (&benchDeviceMobility, n, 1, minIterations, "NetDevice -> Node -> MobilityModel");
+  runBench (&benchBuildingInfo, n, 1, minIterations, "MobilityModel -> MobilityBuildingInfo");
+  runBench (&benchMixed, n, 4, minIterations, "MobilityModel, Ipv4, Node, TcpL4Protocol");
+  runBench (&benchCreate, n / 10, 1, minIterations, "CreateObject<MobilityModel>");
+  runBench (&benchCreateAggregate, n / 10, 1, minIterations, "CreateObject, aggregate a MobilityModel and look it up");
+
+  g_node = 0;
+  g_device = 0;
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the packet churn of the mmWave
+// RLC/MAC path: PDCP SDUs are segmented by an UM-like RLC into PDUs,
+// concatenated into a MAC PDU with a MmWaveMacPduHeader and the usual
+// packet tags, and the receiver undoes the whole process.  It reports the
+// number of heap allocations per simulated MAC PDU.
+// Sample usage:  ./waf --run 'bench-packet-churn --n=100000 --metadata=1'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/lte-pdcp-header.h"
+#include "ns3/lte-rlc-header.h"
+#include "ns3/lte-radio-bearer-tag.h"
+#include "ns3/mmwave-mac-pdu-header.h"
+#include "ns3/mmwave-mac-pdu-tag.h"
+#include "bench-alloc-counter.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+using namespace mmwave;
+
+/// Parameters of the simulated MAC PDUs
+struct ChurnParameters
+{
+  uint32_t sduSize;   //!< size of the PDCP SDUs
+  uint32_t tbSize;    //!< size of the transport blocks
+  uint32_t rlcPdus;   //!< number of RLC PDUs multiplexed in a TB
+};
+
+/**
+ * Build one MAC PDU out of the SDUs in the queue and decode it again.
+ *
+ * \param p the churn parameters
+ * \param sdu the SDU being segmented, replaced when fully transmitted
+ * \param offset the transmitted bytes of sdu
+ * \param pdcpSn the PDCP sequence number of the next SDU
+ */
+static void
+BuildAndDecodeMacPdu (const ChurnParameters &p, Ptr<Packet> &sdu, uint32_t &offset, uint16_t &pdcpSn)
+{
+  MmWaveMacPduHeader macHeader;
+  Ptr<Packet> macPdu;
+  uint32_t rlcPduSize = p.tbSize / p.rlcPdus;
+  for (uint32_t i = 0; i < p.rlcPdus; i++)
+    {
+      // RLC UM segmentation: one segment per PDU
+      if (offset == sdu->GetSize ())
+        {
+          LtePdcpHeader pdcpHeader;
+          pdcpHeader.SetDcBit (LtePdcpHeader::DATA_PDU);
+          pdcpHeader.SetSequenceNumber (pdcpSn++ & 0xfff);
+          sdu = Create<Packet> (p.sduSize);
+          sdu->AddHeader (pdcpHeader);
+          offset = 0;
+        }
+      uint32_t segment = std::min (rlcPduSize, sdu->GetSize () - offset);
+      Ptr<Packet> rlcPdu = sdu->CreateFragment (offset, segment);
+      offset += segment;
+      LteRlcHeader rlcHeader;
+      rlcHeader.SetFramingInfo (0);
+      rlcHeader.SetSequenceNumber (SequenceNumber10 (i));
+      rlcPdu->AddHeader (rlcHeader);
+
+      // MAC multiplexing
+      macHeader.AddSubheader (MacSubheader (3, rlcPdu->GetSize ()));
+      if (macPdu == 0)
+        {
+          macPdu = rlcPdu;
+        }
+      else
+        {
+          macPdu->AddAtEnd (rlcPdu);
+        }
+    }
+  macPdu->AddHeader (macHeader);
+  LteRadioBearerTag bearerTag (1, 3, 0);
+  macPdu->AddPacketTag (bearerTag);
+  MmWaveMacPduTag pduTag (SfnSf (1, 2, 3, 4), 2);
+  macPdu->AddPacketTag (pduTag);
+
+  // receiver: the PHY delivers a copy of the burst to the MAC
+  Ptr<Packet> rxPdu = macPdu->Copy ();
+  rxPdu->RemovePacketTag (pduTag);
+  rxPdu->RemovePacketTag (bearerTag);
+  MmWaveMacPduHeader rxMacHeader;
+  rxPdu->RemoveHeader (rxMacHeader);
+  std::vector<MacSubheader> subheaders = rxMacHeader.GetSubheaders ();
+  uint32_t rxOffset = 0;
+  for (uint32_t i = 0; i < subheaders.size (); i++)
+    {
+      Ptr<Packet> rlcPdu = rxPdu->CreateFragment (rxOffset, subheaders[i].m_size);
+      rxOffset += subheaders[i].m_size;
+      LteRlcHeader rxRlcHeader;
+      rlcPdu->RemoveHeader (rxRlcHeader);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  bool metadata = false;
+  ChurnParameters p;
+  p.sduSize = 1400;
+  p.tbSize = 4000;
+  p.rlcPdus = 2;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the Packet allocations of the mmWave RLC/MAC path");
+  cmd.AddValue ("n", "number of MAC PDUs", n);
+  cmd.AddValue ("metadata", "record the packet metadata", metadata);
+  cmd.AddValue ("sduSize", "size of the PDCP SDUs", p.sduSize);
+  cmd.AddValue ("tbSize", "size of the transport blocks", p.tbSize);
+  cmd.AddValue ("rlcPdus", "number of RLC PDUs per transport block", p.rlcPdus);
+  cmd.Parse (argc, argv);
+
+  if (metadata)
+    {
+      Packet::EnablePrinting ();
+    }
+
+  std::cout << "Running bench-packet-churn with n=" << n
+            << " (SDU " << p.sduSize << " B, TB " << p.tbSize << " B, "
+            << p.rlcPdus << " RLC PDUs per TB, metadata "
+            << (metadata ? "on" : "off") << ")" << std::endl;
+
+  Ptr<Packet> sdu = Create<Packet> (0);
+  uint32_t offset = 0;
+  uint16_t pdcpSn = 0;
+
+  // warm up the free lists of Buffer and PacketMetadata
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      BuildAndDecodeMacPdu (p, sdu, offset, pdcpSn);
+    }
+
+  SystemWallClockMs time;
+  uint64_t allocations = GetAllocationCount ();
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      BuildAndDecodeMacPdu (p, sdu, offset, pdcpSn);
+    }
+  uint64_t deltaMs = time.End ();
+  allocations = GetAllocationCount () - allocations;
+
+  std::cout << static_cast<double> (allocations) / n << " allocations/MAC PDU"
+            << " (" << deltaMs << " ms elapsed, "
+            << (deltaMs > 0 ? n * 1000.0 / deltaMs : 0.0) << " MAC PDUs/s)"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the cost of the transmission
+// opportunities of a full buffer RLC UM, UM low latency or AM entity as a
+// function of the number of SDUs in its transmission buffer.  For each
+// backlog the buffer is filled, and then the MAC grants n transmission
+// opportunities, each followed by the arrival of new SDUs, so that the
+// backlog stays constant.  The time per PDU should not depend on the backlog.  The AM
+// entity is acknowledged by a STATUS PDU every 256 PDUs.  The program also
+// reports the number of heap allocations per PDU done to build the PDUs,
+// and per SDU done to queue the SDUs.
+// Sample usage:  ./waf --run 'bench-rlc-buffer --n=100000 --backlogs=1000,10000,100000 --rlc=am'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/abort.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rlc-um.h"
+#include "ns3/lte-rlc-um-lowlat.h"
+#include "ns3/lte-rlc-am.h"
+#include "ns3/lte-rlc-am-header.h"
+#include "ns3/lte-rlc-sap.h"
+#include "ns3/lte-mac-sap.h"
+#include "bench-alloc-counter.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * MAC SAP provider which only counts the PDUs transmitted by the RLC.
+ */
+class BenchMacSapProvider : public LteMacSapProvider
+{
+public:
+  BenchMacSapProvider ()
+    : m_pdus (0)
+  {
+  }
+  virtual void TransmitPdu (TransmitPduParameters params)
+  {
+    m_pdus++;
+  }
+  virtual void ReportBufferStatus (ReportBufferStatusParameters params)
+  {
+  }
+
+  uint64_t m_pdus; //!< number of transmitted PDUs
+};
+
+/// Parameters and results of a benchmark run
+struct BenchParameters
+{
+  std::string rlc;          //!< RLC mode, "um", "um-lowlat" or "am"
+  uint32_t backlog;         //!< number of SDUs in the transmission buffer
+  uint32_t n;               //!< number of transmission opportunities
+  uint32_t sduSize;         //!< size of the SDUs
+  uint32_t tbSize;          //!< size of the transmission opportunities
+  int64_t deltaMs;          //!< elapsed time, in ms
+  uint64_t txAllocations;   //!< number of heap allocations to build the PDUs
+  uint64_t sdus;            //!< number of SDUs queued
+  uint64_t sduAllocations;  //!< number of heap allocations to queue the SDUs
+};
+
+/**
+ * Run n transmission opportunities on an RLC entity with a
+ * constant backlog of SDUs.  It is run as an event, as the RLC times
+ * its packets, and stops the simulator when done.
+ *
+ * \param p the parameters of the run, where the results are stored
+ */
+static void
+RunBacklog (BenchParameters *p)
+{
+  BenchMacSapProvider mac;
+  bool am = (p->rlc == "am");
+  Ptr<LteRlc> rlc;
+  if (am)
+    {
+      rlc = CreateObject<LteRlcAm> ();
+    }
+  else if (p->rlc == "um-lowlat")
+    {
+      rlc = CreateObject<LteRlcUmLowLat> ();
+    }
+  else
+    {
+      NS_ABORT_MSG_UNLESS (p->rlc == "um", "unknown RLC mode " << p->rlc);
+      rlc = CreateObject<LteRlcUm> ();
+    }
+  rlc->SetAttribute ("MaxTxBufferSize", UintegerValue ((p->backlog + 1) * (p->sduSize + 10)));
+  rlc->SetRnti (1);
+  rlc->SetLcId (3);
+  rlc->SetLteMacSapProvider (&mac);
+
+  LteRlcSapProvider::TransmitPdcpPduParameters sdu;
+  sdu.rnti = 1;
+  sdu.lcid = 3;
+  for (uint32_t i = 0; i < p->backlog; i++)
+    {
+      sdu.pdcpPdu = Create<Packet> (p->sduSize);
+      rlc->GetLteRlcSapProvider ()->TransmitPdcpPdu (sdu);
+    }
+
+  LteMacSapUser::TxOpportunityParameters txOp;
+  txOp.bytes = p->tbSize;
+  txOp.layer = 0;
+  txOp.harqId = 0;
+  txOp.componentCarrierId = 0;
+  txOp.rnti = 1;
+  txOp.lcid = 3;
+
+  LteMacSapUser::ReceivePduParameters status;
+  status.rnti = 1;
+  status.lcid = 3;
+
+  // the SDUs transmitted by each opportunity, on average
+  double sdusPerPdu = static_cast<double> (p->tbSize) / p->sduSize;
+  double sdus = 0;
+  p->txAllocations = 0;
+  p->sdus = 0;
+  p->sduAllocations = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < p->n; i++)
+    {
+      uint64_t allocations = GetAllocationCount ();
+      rlc->GetLteMacSapUser ()->NotifyTxOpportunity (txOp);
+      if (am && (mac.m_pdus % 256) == 0)
+        {
+          // acknowledge all the transmitted PDUs
+          LteRlcAmHeader rlcAmHeader;
+          rlcAmHeader.SetControlPdu (LteRlcAmHeader::STATUS_PDU);
+          rlcAmHeader.SetAckSn (SequenceNumber10 (mac.m_pdus % 1024));
+          status.p = Create<Packet> ();
+          status.p->AddHeader (rlcAmHeader);
+          rlc->GetLteMacSapUser ()->ReceivePdu (status);
+        }
+      p->txAllocations += GetAllocationCount () - allocations;
+      allocations = GetAllocationCount ();
+      for (sdus += sdusPerPdu; sdus >= 1; sdus--)
+        {
+          sdu.pdcpPdu = Create<Packet> (p->sduSize);
+          rlc->GetLteRlcSapProvider ()->TransmitPdcpPdu (sdu);
+          p->sdus++;
+        }
+      p->sduAllocations += GetAllocationCount () - allocations;
+    }
+  p->deltaMs = time.End ();
+
+  NS_ABORT_MSG_UNLESS (mac.m_pdus == p->n, "the RLC did not use all the transmission opportunities");
+  rlc->Dispose ();
+  Simulator::Stop ();
+}
+
+int main (int argc, char *argv[])
+{
+  BenchParameters p;
+  p.n = 100000;
+  p.rlc = "um";
+  p.sduSize = 1400;
+  p.tbSize = 1000;
+  std::string backlogs = "1000,10000,100000";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the transmission opportunities of a full buffer RLC entity");
+  cmd.AddValue ("n", "number of transmission opportunities per backlog", p.n);
+  cmd.AddValue ("rlc", "RLC mode: um, um-lowlat or am", p.rlc);
+  cmd.AddValue ("sduSize", "size of the PDCP SDUs", p.sduSize);
+  cmd.AddValue ("tbSize", "size of the transmission opportunities", p.tbSize);
+  cmd.AddValue ("backlogs", "comma separated list of backlogs, in SDUs", backlogs);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-rlc-buffer with n=" << p.n
+            << " (RLC " << p.rlc << ", SDU " << p.sduSize
+            << " B, TB " << p.tbSize << " B)" << std::endl;
+
+  std::istringstream iss (backlogs);
+  std::string backlog;
+  while (std::getline (iss, backlog, ','))
+    {
+      p.backlog = std::stoul (backlog);
+      Simulator::ScheduleNow (&RunBacklog, &p);
+      Simulator::Run ();
+      Simulator::Destroy ();
+      std::cout << "backlog " << p.backlog << " SDUs: "
+                << p.deltaMs * 1e6 / p.n << " ns/PDU, "
+                << static_cast<double> (p.txAllocations) / p.n << " allocations/PDU, "
+                << static_cast<double> (p.sduAllocations) / p.sdus << " allocations/SDU"
+                << " (" << p.deltaMs << " ms elapsed)" << std::endl;
+    }
+
+  return 0;
+}
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the eigenvector computation of
+// MmWaveSvdBeamforming for several antenna sizes.  For each size, a random
+// narrowband channel made of a few clusters with decreasing power evolves
+// slowly, as between two channel updates of the same link, and the dominant
+// eigenvector of the transmitter side spatial correlation matrix is computed
+// with a cold start (first row of the matrix) and with a warm start (the
+// eigenvector of the previous channel).
+// Sample usage:  ./waf --run 'bench-svd-beamforming --n=1000 --rxElements=16'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/mmwave-beamforming-model.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+using namespace ns3;
+using namespace mmwave;
+
+typedef ThreeGppAntennaArrayModel::ComplexVector ComplexVector;
+
+/// Result of the computation of the eigenvectors of a sequence of channels
+struct EigenResult
+{
+  uint64_t ms;          //!< elapsed time
+  uint64_t iterations;  //!< total number of power iterations
+};
+
+/**
+ * Compute the transmitter side spatial correlation matrix of a channel
+ * \param h the narrowband channel, rx x tx, row-major
+ * \param rx the number of receive antennas
+ * \param tx the number of transmit antennas
+ * \param q the correlation matrix, tx x tx, row-major
+ */
+static void
+Correlation (const ComplexVector &h, uint32_t rx, uint32_t tx, ComplexVector &q)
+{
+  q.assign (tx * tx, 0);
+  for (uint32_t i = 0; i < tx; i++)
+    {
+      for (uint32_t j = 0; j < tx; j++)
+        {
+          std::complex<double> sum (0, 0);
+          for (uint32_t a = 0; a < rx; a++)
+            {
+              sum += std::conj (h[a * tx + i]) * h[a * tx + j];
+            }
+          q[i * tx + j] = sum;
+        }
+    }
+}
+
+/**
+ * Compute the eigenvectors of a slowly varying channel
+ * \param rx the number of receive antennas
+ * \param tx the number of transmit antennas
+ * \param clusters the number of clusters of the channel
+ * \param n the number of channel updates
+ * \param drift the relative variation of the channel at each update
+ * \param warm whether the power iterations start from the previous eigenvector
+ * \param maxIterations the maximum number of power iterations
+ * \param tolerance the convergence tolerance
+ * \return the elapsed time and the number of iterations
+ */
+static EigenResult
+Run (uint32_t rx, uint32_t tx, uint32_t clusters, uint32_t n, double drift, bool warm,
+     uint32_t maxIterations, double tolerance)
+{
+  std::mt19937 gen (1);
+  std::normal_distribution<double> normal;
+  // each cluster contributes g * u * v^H, with the power decreasing by 3 dB
+  // from one cluster to the next
+  ComplexVector u (clusters * rx);
+  ComplexVector v (clusters * tx);
+  for (auto &x : u)
+    {
+      x = std::complex<double> (normal (gen), normal (gen));
+    }
+  for (auto &x : v)
+    {
+      x = std::complex<double> (normal (gen), normal (gen));
+    }
+
+  // precompute the channels, so that only the solver is timed
+  std::vector<ComplexVector> q (n);
+  ComplexVector h (rx * tx);
+  for (uint32_t k = 0; k < n; k++)
+    {
+      for (auto &x : u)
+        {
+          x = std::sqrt (1 - drift * drift) * x + drift * std::complex<double> (normal (gen), normal (gen));
+        }
+      for (auto &x : v)
+        {
+          x = std::sqrt (1 - drift * drift) * x + drift * std::complex<double> (normal (gen), normal (gen));
+        }
+      h.assign (rx * tx, 0);
+      for (uint32_t c = 0; c < clusters; c++)
+        {
+          double g = std::pow (0.5, c);
+          for (uint32_t a = 0; a < rx; a++)
+            {
+              for (uint32_t b = 0; b < tx; b++)
+                {
+                  h[a * tx + b] += g * u[c * rx + a] * std::conj (v[c * tx + b]);
+                }
+            }
+        }
+      Correlation (h, rx, tx, q[k]);
+    }
+
+  EigenResult r;
+  r.iterations = 0;
+  ComplexVector w;
+  ComplexVector scratch;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t k = 0; k < n; k++)
+    {
+      if (!warm || k == 0)
+        {
+          w.assign (q[k].begin (), q[k].begin () + tx);
+        }
+      r.iterations += MmWaveSvdBeamforming::GetFirstEigenvector (q[k], w, maxIterations, tolerance, scratch);
+    }
+  r.ms = time.End ();
+  return r;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 2000;
+  uint32_t rx = 16;
+  uint32_t clusters = 4;
+  double drift = 0.05;
+  uint32_t maxIterations = 30;
+  double tolerance = 1e-8;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the eigenvector computation of MmWaveSvdBeamforming");
+  cmd.AddValue ("n", "number of channel updates per antenna size", n);
+  cmd.AddValue ("rxElements", "number of elements of the receiver antenna", rx);
+  cmd.AddValue ("clusters", "number of clusters of the channel", clusters);
+  cmd.AddValue ("drift", "relative variation of the channel between updates", drift);
+  cmd.AddValue ("maxIterations", "maximum number of power iterations", maxIterations);
+  cmd.AddValue ("tolerance", "convergence tolerance of the power iterations", tolerance);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-svd-beamforming with n=" << n << ", rx=" << rx
+            << ", clusters=" << clusters
+            << ", drift=" << drift << std::endl;
+  std::cout << std::setw (8) << "tx" << std::setw (14) << "cold ms" << std::setw (14) << "cold iter"
+            << std::setw (14) << "warm ms" << std::setw (14) << "warm iter" << std::endl;
+
+  uint32_t sizes[] = {4, 16, 64, 256};
+  for (uint32_t tx : sizes)
+    {
+      EigenResult cold = Run (rx, tx, clusters, n, drift, false, maxIterations, tolerance);
+      EigenResult warm = Run (rx, tx, clusters, n, drift, true, maxIterations, tolerance);
+      std::cout << std::setw (8) << tx
+                << std::setw (14) << cold.ms << std::setw (14) << static_cast<double> (cold.iterations) / n
+                << std::setw (14) << warm.ms << std::setw (14) << static_cast<double> (warm.iterations) / n
+                << std::endl;
+    }
+  return 0;
+}
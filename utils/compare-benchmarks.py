@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""! Compare two reports of utils/run-benchmarks.py and flag the regressions.
+
+The scenarios are matched by name.  A metric regresses if it gets worse by
+more than --threshold percent with respect to the baseline; the program
+exits with status 1 if any metric regresses, so that it can be used as a
+gate.  Reports of different build profiles should not be compared, a
+warning is printed if they are.
+
+Sample usage:
+  ./utils/compare-benchmarks.py bench-old.json bench-new.json --threshold 10
+"""
+
+import argparse
+import json
+import sys
+
+## Compared metrics, with True if higher values are better
+METRICS = [
+    ('wallMs', False),
+    ('simSecondsPerWallSecond', True),
+    ('events', False),
+    ('allocations', False),
+    ('peakRssKb', False),
+]
+
+
+def load(path):
+    """! Load a report
+    @param path the report file
+    @return the report, and its results indexed by scenario name
+    """
+    with open(path) as f:
+        report = json.load(f)
+    return report, dict((r['name'], r) for r in report['results'])
+
+
+def change(old, new):
+    """! Relative change between two values, in percent
+    @param old the baseline value
+    @param new the new value
+    @return the change, or None if the baseline is zero
+    """
+    if old == 0:
+        return None
+    return (new - old) * 100.0 / old
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two benchmark reports')
+    parser.add_argument('baseline', help='baseline report')
+    parser.add_argument('current', help='report to check against the baseline')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='regression threshold, in percent (default: %(default)s)')
+    parser.add_argument('--metrics', default=','.join(m for m, _ in METRICS),
+                        help='comma separated list of the compared metrics (default: %(default)s)')
+    options = parser.parse_args()
+
+    baseline, old_results = load(options.baseline)
+    current, new_results = load(options.current)
+    if baseline.get('profile') != current.get('profile'):
+        print('warning: comparing %s binaries with %s binaries'
+              % (baseline.get('profile'), current.get('profile')))
+
+    metrics = [(m, higher) for m, higher in METRICS if m in options.metrics.split(',')]
+    regressions = 0
+    print('%-40s %-24s %14s %14s %9s' % ('scenario', 'metric', 'baseline', 'current', 'change'))
+    for name in sorted(set(old_results) & set(new_results)):
+        old = old_results[name]
+        new = new_results[name]
+        for metric, higher_is_better in metrics:
+            if metric not in old or metric not in new:
+                continue
+            delta = change(old[metric], new[metric])
+            if delta is None:
+                continue
+            worse = -delta if higher_is_better else delta
+            flag = ''
+            if worse > options.threshold:
+                flag = '  REGRESSION'
+                regressions += 1
+            elif worse < -options.threshold:
+                flag = '  improvement'
+            print('%-40s %-24s %14.6g %14.6g %+8.1f%%%s'
+                  % (name, metric, old[metric], new[metric], delta, flag))
+
+    for name in sorted(set(old_results) - set(new_results)):
+        print('%s: missing from %s' % (name, options.current))
+    for name in sorted(set(new_results) - set(old_results)):
+        print('%s: not in the baseline' % name)
+
+    if regressions:
+        print('%d regression(s) beyond %g%%' % (regressions, options.threshold))
+        return 1
+    print('No regression beyond %g%%' % options.threshold)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
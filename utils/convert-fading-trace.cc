@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts an ASCII fading trace, as generated by
+// fading_trace_generator.m, to the binary format of FadingTraceFile, which
+// TraceFadingLossModel memory-maps instead of parsing it.  The rbNum and
+// samplesNum values must match the RbNum and SamplesNum attributes used
+// with the trace.
+// Sample usage:
+//   ./waf --run 'convert-fading-trace --input=src/lte/model/fading-traces/fading_trace_EPA_3kmph.fad
+//                --output=fading_trace_EPA_3kmph.bin --format=float16'
+
+#include "ns3/command-line.h"
+#include "ns3/abort.h"
+#include "ns3/fading-trace-file.h"
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  uint32_t rbNum = 100;
+  uint32_t samplesNum = 10000;
+  std::string format = "float32";
+
+  CommandLine cmd;
+  cmd.Usage ("Convert an ASCII fading trace to the binary format of FadingTraceFile");
+  cmd.AddValue ("input", "ASCII fading trace", input);
+  cmd.AddValue ("output", "binary fading trace to write", output);
+  cmd.AddValue ("rbNum", "number of RBs of the trace", rbNum);
+  cmd.AddValue ("samplesNum", "number of samples per RB of the trace", samplesNum);
+  cmd.AddValue ("format", "type of the samples: float32 or float16", format);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (input.empty () || output.empty (), "the input and output traces must be set");
+  FadingTraceFile::SampleType type = FadingTraceFile::FLOAT32;
+  if (format == "float16")
+    {
+      type = FadingTraceFile::FLOAT16;
+    }
+  else
+    {
+      NS_ABORT_MSG_UNLESS (format == "float32", "unknown format " << format);
+    }
+
+  FadingTraceFile::ConvertTextTrace (input, output, rbNum, samplesNum, type);
+  std::cout << "Converted " << input << " to " << output << " (" << rbNum << " RBs, "
+            << samplesNum << " samples, " << format << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""! Run the mmWave and millicar scenario benchmarks and write a JSON report.
+
+The scenarios are the cartesian product of the parameters of a preset:
+cells x UEs per cell x antenna sizes x channel update period for
+bench-mmwave-scenario, vehicles x inter-vehicle distance for
+bench-millicar-scenario (which is skipped if the millicar module is not
+built).  Each scenario is run --repeat times and the median of each metric
+is reported, together with the revision of the tree and the build profile
+of the binaries.  The report can be compared with an earlier one by
+utils/compare-benchmarks.py.
+
+Sample usage:
+  ./waf build
+  ./utils/run-benchmarks.py --preset smoke --output bench-new.json
+  ./utils/compare-benchmarks.py bench-old.json bench-new.json --threshold 10
+"""
+
+import argparse
+import glob
+import itertools
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+## Scenario presets: for each program, the values of its parameters
+PRESETS = {
+    'smoke': {
+        'bench-mmwave-scenario': {
+            'cells': [1],
+            'uesPerCell': [1, 4],
+            'antennas': [(16, 4), (64, 16)],
+            'updatePeriod': [0, 10],
+            'simTime': [0.05],
+        },
+        'bench-millicar-scenario': {
+            'vehicles': [2, 4],
+            'distance': [20],
+            'simTime': [0.05],
+        },
+    },
+    'full': {
+        'bench-mmwave-scenario': {
+            'cells': [1, 2, 4],
+            'uesPerCell': [1, 4, 10],
+            'antennas': [(16, 4), (64, 16)],
+            'updatePeriod': [0, 1, 10],
+            'simTime': [0.2],
+        },
+        'bench-millicar-scenario': {
+            'vehicles': [2, 4, 8, 16],
+            'distance': [10, 20, 50],
+            'simTime': [0.2],
+        },
+    },
+}
+
+## Metrics of the reports, the median of the repetitions is reported
+METRICS = ['setupMs', 'wallMs', 'simSecondsPerWallSecond', 'events', 'eventsPerSecond',
+           'setupAllocations', 'allocations', 'peakRssKb']
+
+
+def scenario_arguments(program, params):
+    """! Expand the parameters of a program into the argument lists of its scenarios
+    @param program the name of the benchmark program
+    @param params the values of the parameters, as in PRESETS
+    @return a list of argument lists
+    """
+    keys = sorted(params.keys())
+    scenarios = []
+    for values in itertools.product(*[params[k] for k in keys]):
+        args = []
+        for key, value in zip(keys, values):
+            if key == 'antennas':
+                args += ['--enbAntennas=%d' % value[0], '--ueAntennas=%d' % value[1]]
+            else:
+                args.append('--%s=%s' % (key, value))
+        scenarios.append(args)
+    return scenarios
+
+
+def find_program(build_dir, program):
+    """! Find the binary of a benchmark program in the build directory
+    @param build_dir the waf build directory
+    @param program the name of the benchmark program
+    @return the path of the binary, or None if it was not built
+    """
+    matches = sorted(glob.glob(os.path.join(build_dir, 'utils', 'ns3*-%s-*' % program)))
+    matches = [m for m in matches if os.access(m, os.X_OK) and not m.endswith('.o')]
+    return matches[0] if matches else None
+
+
+def run_scenario(binary, args, env, timeout):
+    """! Run a scenario once, in a scratch directory so that traces are not left around
+    @param binary the benchmark binary
+    @param args the command line arguments
+    @param env the environment of the process
+    @param timeout the timeout of the run, in s
+    @return the JSON report printed by the program
+    """
+    with tempfile.TemporaryDirectory(prefix='ns3-bench-') as cwd:
+        proc = subprocess.run([binary] + args, cwd=cwd, env=env, timeout=timeout,
+                              stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              universal_newlines=True)
+    if proc.returncode != 0:
+        raise RuntimeError('%s exited with %d:\n%s' % (binary, proc.returncode, proc.stdout[-2000:]))
+    for line in reversed(proc.stdout.splitlines()):
+        if line.startswith('{'):
+            return json.loads(line)
+    raise RuntimeError('%s did not print a report:\n%s' % (binary, proc.stdout[-2000:]))
+
+
+def median(values):
+    """! Median of a list of numbers
+    @param values the numbers
+    @return the median
+    """
+    values = sorted(values)
+    n = len(values)
+    return values[n // 2] if n % 2 else (values[n // 2 - 1] + values[n // 2]) / 2.0
+
+
+def git_revision(top_dir):
+    """! Revision of the source tree
+    @param top_dir the top directory of the source tree
+    @return the revision, or None outside of a git checkout
+    """
+    try:
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'], cwd=top_dir,
+                                       stderr=subprocess.DEVNULL,
+                                       universal_newlines=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def build_profile(build_dir):
+    """! Build profile of the benchmark binaries, as in their file names
+    @param build_dir the waf build directory
+    @return the profile (e.g. debug or optimized), or None if it is unknown
+    """
+    binary = find_program(build_dir, 'bench-mmwave-scenario')
+    if binary is None:
+        return None
+    match = re.search(r'-bench-mmwave-scenario-(\w+)$', binary)
+    return match.group(1) if match else None
+
+
+def main():
+    top_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    parser = argparse.ArgumentParser(description='Run the scenario benchmarks and write a JSON report')
+    parser.add_argument('--build-dir', default=os.path.join(top_dir, 'build'),
+                        help='waf build directory (default: %(default)s)')
+    parser.add_argument('--preset', choices=sorted(PRESETS.keys()), default='smoke',
+                        help='scenario matrix to run (default: %(default)s)')
+    parser.add_argument('--filter', default=None,
+                        help='only run the scenarios whose program and arguments match this regular expression')
+    parser.add_argument('--repeat', type=int, default=1,
+                        help='number of runs of each scenario (default: %(default)s)')
+    parser.add_argument('--timeout', type=float, default=3600,
+                        help='timeout of each run, in s (default: %(default)s)')
+    parser.add_argument('--output', default='benchmarks.json',
+                        help='report file (default: %(default)s)')
+    options = parser.parse_args()
+
+    env = dict(os.environ)
+    lib_dir = os.path.join(options.build_dir, 'lib')
+    env['LD_LIBRARY_PATH'] = lib_dir + os.pathsep + env.get('LD_LIBRARY_PATH', '')
+
+    results = []
+    for program, params in sorted(PRESETS[options.preset].items()):
+        binary = find_program(options.build_dir, program)
+        if binary is None:
+            print('%s not built, skipping its scenarios' % program)
+            continue
+        for args in scenario_arguments(program, params):
+            if options.filter and not re.search(options.filter, ' '.join([program] + args)):
+                continue
+            # the repetitions use the same run number, so that only the
+            # timings change between them
+            runs = [run_scenario(binary, args, env, options.timeout)
+                    for i in range(options.repeat)]
+            result = dict(runs[0])
+            for metric in METRICS:
+                result[metric] = median([r[metric] for r in runs])
+            result['runs'] = len(runs)
+            results.append(result)
+            print('%-40s %10.0f ms %12d events %12d allocations %8d kB'
+                  % (result['name'], result['wallMs'], result['events'],
+                     result['allocations'], result['peakRssKb']))
+            sys.stdout.flush()
+
+    report = {
+        'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'host': platform.node(),
+        'machine': platform.machine(),
+        'revision': git_revision(top_dir),
+        'profile': build_profile(options.build_dir),
+        'preset': options.preset,
+        'results': results,
+    }
+    with open(options.output, 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print('Report written to %s' % options.output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())